@@ -0,0 +1,306 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2023                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "image.h"
+#include "image_palette.h"
+#include "image_tool.h"
+#include "math_base.h"
+#include "serialize.h"
+#include "system.h"
+#include "timing.h"
+#include "zzlib.h"
+
+namespace
+{
+    // The generator is seeded with a constant so that every run processes the same data.
+    std::mt19937 randomGenerator( 0 );
+
+    const char * nameFilter = nullptr;
+    uint32_t iterationMultiplier = 1;
+
+    // Runs the function once to warm up the caches and then the given number of times, printing the average time of one run.
+    template <typename Function>
+    void runBenchmark( const std::string & name, const uint32_t iterations, Function && function )
+    {
+        if ( nameFilter != nullptr && name.find( nameFilter ) == std::string::npos ) {
+            return;
+        }
+
+        function();
+
+        const uint32_t totalIterations = iterations * iterationMultiplier;
+
+        const fheroes2::Time timer;
+
+        for ( uint32_t i = 0; i < totalIterations; ++i ) {
+            function();
+        }
+
+        const double averageUs = timer.getS() * 1000000.0 / totalIterations;
+
+        std::cout << std::left << std::setw( 48 ) << name << std::right << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << averageUs << " us"
+                  << std::endl;
+    }
+
+    // Most of the pixels of game sprites are opaque, some of them are transparent and a few are shadows.
+    fheroes2::Sprite createSprite( const int32_t width, const int32_t height )
+    {
+        fheroes2::Sprite sprite( width, height );
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 0, 255 );
+        std::uniform_int_distribution<uint32_t> transformDistribution( 0, 15 );
+
+        const size_t size = static_cast<size_t>( width ) * height;
+        uint8_t * image = sprite.image();
+        uint8_t * transform = sprite.transform();
+
+        for ( size_t i = 0; i < size; ++i ) {
+            image[i] = static_cast<uint8_t>( colorDistribution( randomGenerator ) );
+
+            const uint32_t transformValue = transformDistribution( randomGenerator );
+            transform[i] = static_cast<uint8_t>( transformValue < 12 ? 0 : ( transformValue < 14 ? 1 : transformValue - 11 ) );
+        }
+
+        return sprite;
+    }
+
+    fheroes2::Image createSingleLayerImage( const int32_t width, const int32_t height )
+    {
+        fheroes2::Image image;
+        image._disableTransformLayer();
+        image.resize( width, height );
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 0, 255 );
+
+        const size_t size = static_cast<size_t>( width ) * height;
+        uint8_t * data = image.image();
+
+        for ( size_t i = 0; i < size; ++i ) {
+            data[i] = static_cast<uint8_t>( colorDistribution( randomGenerator ) );
+        }
+
+        return image;
+    }
+
+    // Encodes rows of repeated runs of raw pixels, transparent pixels and filled pixels in the format of ICN sprites.
+    std::vector<uint8_t> createICNData( const int32_t width, const int32_t height )
+    {
+        std::vector<uint8_t> data;
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 0, 255 );
+
+        for ( int32_t y = 0; y < height; ++y ) {
+            int32_t x = 0;
+
+            while ( x < width ) {
+                const int32_t rawCount = std::min( width - x, 32 );
+                data.push_back( static_cast<uint8_t>( rawCount ) );
+                for ( int32_t i = 0; i < rawCount; ++i ) {
+                    data.push_back( static_cast<uint8_t>( colorDistribution( randomGenerator ) ) );
+                }
+                x += rawCount;
+
+                const int32_t emptyCount = std::min( width - x, 8 );
+                if ( emptyCount > 0 ) {
+                    data.push_back( static_cast<uint8_t>( 0x80 + emptyCount ) );
+                    x += emptyCount;
+                }
+
+                const int32_t fillCount = std::min( width - x, 16 );
+                if ( fillCount > 1 ) {
+                    data.push_back( static_cast<uint8_t>( 0xC0 + fillCount ) );
+                    data.push_back( static_cast<uint8_t>( colorDistribution( randomGenerator ) ) );
+                    x += fillCount;
+                }
+            }
+
+            // End of row.
+            data.push_back( 0x00 );
+        }
+
+        // End of image.
+        data.push_back( 0x80 );
+
+        return data;
+    }
+
+    void setSyntheticGamePalette()
+    {
+        // The game palette uses 6 bits per color component.
+        std::vector<uint8_t> palette( 768 );
+        for ( size_t i = 0; i < palette.size(); ++i ) {
+            palette[i] = static_cast<uint8_t>( ( i * 7 ) % 64 );
+        }
+
+        fheroes2::setGamePalette( palette );
+    }
+
+    void runImageBenchmarks()
+    {
+        const fheroes2::Sprite sprite = createSprite( 200, 150 );
+        const fheroes2::Sprite background = createSprite( 640, 480 );
+        const fheroes2::Sprite largeBackground = createSprite( 1920, 1080 );
+
+        fheroes2::Image output( 640, 480 );
+        output.reset();
+
+        fheroes2::Image largeOutput( 1920, 1080 );
+        largeOutput.reset();
+
+        runBenchmark( "Blit 200x150 sprite", 2000, [&sprite, &output]() { fheroes2::Blit( sprite, output, 100, 100 ); } );
+        runBenchmark( "Blit 200x150 sprite flipped", 2000, [&sprite, &output]() { fheroes2::Blit( sprite, output, 100, 100, true ); } );
+        runBenchmark( "Blit 640x480", 500, [&background, &output]() { fheroes2::Blit( background, output ); } );
+        runBenchmark( "AlphaBlit 200x150 sprite", 1000, [&sprite, &output]() { fheroes2::AlphaBlit( sprite, output, 100, 100, 128 ); } );
+        runBenchmark( "AlphaBlit 640x480", 100, [&background, &output]() { fheroes2::AlphaBlit( background, output, 128 ); } );
+
+        std::vector<uint8_t> palette( 256 );
+        for ( size_t i = 0; i < palette.size(); ++i ) {
+            palette[i] = static_cast<uint8_t>( 255 - i );
+        }
+
+        runBenchmark( "ApplyPalette 640x480", 500, [&background, &output, &palette]() { fheroes2::ApplyPalette( background, output, palette ); } );
+        runBenchmark( "ApplyPalette 1920x1080", 100, [&largeBackground, &largeOutput, &palette]() { fheroes2::ApplyPalette( largeBackground, largeOutput, palette ); } );
+
+        runBenchmark( "Resize 640x480 to 1920x1080", 20, [&background, &largeOutput]() { fheroes2::Resize( background, largeOutput, false ); } );
+        runBenchmark( "Resize 640x480 to 1920x1080 subpixel", 5, [&background, &largeOutput]() { fheroes2::Resize( background, largeOutput, true ); } );
+        runBenchmark( "Resize 1920x1080 to 640x480 subpixel", 20, [&largeBackground, &output]() { fheroes2::Resize( largeBackground, output, true ); } );
+
+        runBenchmark( "CreateContour 200x150 sprite", 1000, [&sprite]() { const fheroes2::Sprite contour = fheroes2::CreateContour( sprite, 10 ); } );
+
+        runBenchmark( "addGradientShadow 200x150 sprite", 1000,
+                      [&sprite, &output]() { fheroes2::addGradientShadow( sprite, output, { 100, 100 }, { -5, 5 } ); } );
+
+        fheroes2::Image transposed( 480, 640 );
+        runBenchmark( "Transpose 640x480", 200, [&background, &transposed]() { fheroes2::Transpose( background, transposed ); } );
+
+        const fheroes2::Image singleLayer = createSingleLayerImage( 1920, 1080 );
+        fheroes2::Image singleLayerOutput;
+        singleLayerOutput._disableTransformLayer();
+        singleLayerOutput.resize( 1920, 1080 );
+
+        runBenchmark( "Copy 1920x1080 single-layer", 200, [&singleLayer, &singleLayerOutput]() { fheroes2::Copy( singleLayer, singleLayerOutput ); } );
+    }
+
+    void runDecodingBenchmarks()
+    {
+        const std::vector<uint8_t> icnData = createICNData( 320, 240 );
+
+        runBenchmark( "decodeICNSprite 320x240", 500, [&icnData]() {
+            const fheroes2::Sprite sprite = fheroes2::decodeICNSprite( icnData.data(), static_cast<uint32_t>( icnData.size() ), 320, 240, 0, 0 );
+        } );
+    }
+
+    void runSerializationBenchmarks()
+    {
+        const size_t valueCount = 256 * 1024;
+
+        std::vector<uint32_t> values( valueCount );
+        for ( uint32_t & value : values ) {
+            value = randomGenerator();
+        }
+
+        runBenchmark( "StreamBuf write and read 1 MB", 50, [&values]() {
+            StreamBuf buf;
+            buf.setbigendian( true );
+
+            for ( const uint32_t value : values ) {
+                buf << value;
+            }
+
+            uint32_t value = 0;
+            for ( size_t i = 0; i < values.size(); ++i ) {
+                buf >> value;
+            }
+        } );
+
+        std::error_code errorCode;
+        const std::filesystem::path tempDir = std::filesystem::temp_directory_path( errorCode );
+        if ( errorCode ) {
+            std::cerr << "Cannot find a temporary directory, the zlib benchmarks are skipped" << std::endl;
+            return;
+        }
+
+        const std::string filePath = ( tempDir / "fheroes2_bench_engine.tmp" ).string();
+
+        // Game data compresses well, so synthetic data with long runs are used instead of random noise.
+        StreamBuf data;
+        for ( size_t i = 0; i < valueCount; ++i ) {
+            data << static_cast<uint32_t>( i / 64 );
+        }
+
+        runBenchmark( "ZStreamBuf write 1 MB", 10, [&data, &filePath]() {
+            ZStreamBuf zb;
+            zb.putRaw( reinterpret_cast<const char *>( data.data() ), data.size() );
+
+            if ( !zb.write( filePath ) ) {
+                std::cerr << "Cannot write " << filePath << std::endl;
+            }
+        } );
+
+        runBenchmark( "ZStreamBuf read 1 MB", 10, [&filePath]() {
+            ZStreamBuf zb;
+
+            if ( !zb.read( filePath ) ) {
+                std::cerr << "Cannot read " << filePath << std::endl;
+            }
+        } );
+
+        std::filesystem::remove( filePath, errorCode );
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    for ( int i = 1; i < argc; ++i ) {
+        if ( std::strcmp( argv[i], "-n" ) == 0 && i + 1 < argc ) {
+            iterationMultiplier = static_cast<uint32_t>( std::max( std::atoi( argv[++i] ), 1 ) );
+        }
+        else if ( nameFilter == nullptr && argv[i][0] != '-' ) {
+            nameFilter = argv[i];
+        }
+        else {
+            const std::string baseName = System::GetBasename( argv[0] );
+
+            std::cerr << baseName << " measures the average time of the engine image, decoding and serialization routines on synthetic data." << std::endl
+                      << "Syntax: " << baseName << " [-n iteration_multiplier] [name_filter]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    setSyntheticGamePalette();
+
+    runImageBenchmarks();
+    runDecodingBenchmarks();
+    runSerializationBenchmarks();
+
+    return EXIT_SUCCESS;
+}
@@ -37,6 +37,8 @@ namespace fheroes2
         if ( count * ( fileRecordSize + _maxFilenameSize ) >= size )
             return false;
 
+        _files.reserve( count );
+
         StreamBuf fileEntries = _stream.toStreamBuf( count * fileRecordSize );
         const size_t nameEntriesSize = _maxFilenameSize * count;
         _stream.seek( size - nameEntriesSize );
@@ -69,6 +71,29 @@ namespace fheroes2
 
         return std::vector<uint8_t>();
     }
+
+    bool AGGFile::read( const std::string & fileName, std::vector<uint8_t> & output, const size_t offset )
+    {
+        auto it = _files.find( fileName );
+        if ( it == _files.end() ) {
+            return false;
+        }
+
+        const auto & fileParams = it->second;
+        if ( fileParams.first == 0 ) {
+            return false;
+        }
+
+        _stream.seek( fileParams.second );
+
+        output.resize( offset + fileParams.first );
+        if ( !_stream.readRaw( output.data() + offset, fileParams.first ) ) {
+            output.clear();
+            return false;
+        }
+
+        return true;
+    }
 }
 
 StreamBase & operator>>( StreamBase & st, fheroes2::ICNHeader & icn )
@@ -23,8 +23,8 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -43,11 +43,15 @@ namespace fheroes2
         bool open( const std::string & fileName );
         std::vector<uint8_t> read( const std::string & fileName );
 
+        // Reads the file into the output buffer placing it after the given number of bytes which are left for the caller.
+        // Returns false if the file does not exist or cannot be read.
+        bool read( const std::string & fileName, std::vector<uint8_t> & output, const size_t offset );
+
     private:
         static const size_t _maxFilenameSize = 15; // 8.3 ASCIIZ file name + 2-bytes padding
 
         StreamFile _stream;
-        std::map<std::string, std::pair<uint32_t, uint32_t>> _files;
+        std::unordered_map<std::string, std::pair<uint32_t, uint32_t>> _files;
     };
 
     struct ICNHeader
@@ -28,14 +28,17 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <fstream>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <ostream>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <SDL_audio.h>
 #include <SDL_error.h>
@@ -87,6 +90,13 @@ namespace
     // be acquired in any callback functions that can be called by SDL_Mixer.
     std::recursive_mutex audioMutex;
 
+    // This mutex prevents the audio from being closed while a music track is being created without holding the audioMutex. It should never be
+    // acquired before the audioMutex.
+    std::mutex musicCreationMutex;
+
+    // Sound samples are shared between the sample cache and the channels playing them. A sample is freed once nobody refers to it.
+    using SoundSample = std::shared_ptr<Mix_Chunk>;
+
     class SoundSampleManager
     {
     public:
@@ -96,16 +106,14 @@ namespace
         ~SoundSampleManager()
         {
             // Make sure that all sound samples have been eventually freed
-            assert( std::all_of( _channelSamples.begin(), _channelSamples.end(), []( const auto & item ) {
-                static const decltype( item.second ) nullQueue{ nullptr, nullptr };
-
-                return item.second == nullQueue;
-            } ) );
+            assert( _cachedSamples.empty() );
+            assert( std::all_of( _channelSamples.begin(), _channelSamples.end(),
+                                 []( const auto & item ) { return item.second.first == nullptr && item.second.second == nullptr; } ) );
         }
 
         SoundSampleManager & operator=( const SoundSampleManager & ) = delete;
 
-        void channelStarted( const int channelId, Mix_Chunk * sample )
+        void channelStarted( const int channelId, SoundSample sample )
         {
             assert( channelId >= 0 && sample != nullptr );
 
@@ -115,10 +123,10 @@ namespace
                 auto & sampleQueue = iter->second;
 
                 if ( sampleQueue.first == nullptr ) {
-                    sampleQueue.first = sample;
+                    sampleQueue.first = std::move( sample );
                 }
                 else if ( sampleQueue.second == nullptr ) {
-                    sampleQueue.second = sample;
+                    sampleQueue.second = std::move( sample );
                 }
                 else {
                     // The sample queue is already full, this shouldn't happen
@@ -128,7 +136,7 @@ namespace
                 return;
             }
 
-            const auto res = _channelSamples.try_emplace( channelId, std::make_pair( sample, nullptr ) );
+            const auto res = _channelSamples.try_emplace( channelId, std::make_pair( std::move( sample ), nullptr ) );
             if ( !res.second ) {
                 assert( 0 );
             }
@@ -161,16 +169,40 @@ namespace
                 auto & sampleQueue = iter->second;
                 assert( sampleQueue.first != nullptr );
 
-                Mix_FreeChunk( sampleQueue.first );
-
-                // Shift the sample queue
-                sampleQueue.first = sampleQueue.second;
+                // Shift the sample queue. The sample is freed here unless it is cached or played by another channel.
+                sampleQueue.first = std::move( sampleQueue.second );
                 sampleQueue.second = nullptr;
             }
         }
 
+        SoundSample getCachedSample( const int sampleId ) const
+        {
+            const auto iter = _cachedSamples.find( sampleId );
+            if ( iter == _cachedSamples.end() ) {
+                return {};
+            }
+
+            return iter->second;
+        }
+
+        void cacheSample( const int sampleId, SoundSample sample )
+        {
+            assert( sampleId >= 0 && sample != nullptr );
+
+            _cachedSamples[sampleId] = std::move( sample );
+        }
+
+        // Samples which are still being played are freed when their channels finish.
+        void clearCachedSamples()
+        {
+            _cachedSamples.clear();
+        }
+
     private:
-        std::map<int, std::pair<Mix_Chunk *, Mix_Chunk *>> _channelSamples;
+        std::map<int, std::pair<SoundSample, SoundSample>> _channelSamples;
+
+        // Samples converted to the audio device format, so SDL_Mixer does not need to decode the same sound every time it is played.
+        std::map<int, SoundSample> _cachedSamples;
 
         std::vector<int> _channelsToCleanup;
         // This mutex protects operations with _channelsToCleanup
@@ -193,36 +225,54 @@ namespace
         soundSampleManager.channelFinished( channelId );
     }
 
-    int playSound( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop )
+    SoundSample loadSoundSample( const uint8_t * ptr, const uint32_t size )
     {
-        assert( ptr != nullptr && size != 0 );
-
-        soundSampleManager.clearFinishedSamples();
-
         SDL_RWops * rwops = SDL_RWFromConstMem( ptr, size );
         if ( rwops == nullptr ) {
             ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << SDL_GetError() )
-            return -1;
+            return {};
         }
 
         Mix_Chunk * sample = Mix_LoadWAV_RW( rwops, 1 );
         if ( sample == nullptr ) {
             ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << Mix_GetError() )
-            return -1;
+            return {};
         }
 
-        const int channel = Mix_PlayChannel( channelId, sample, loop ? -1 : 0 );
-        if ( channel < 0 ) {
-            ERROR_LOG( "Failed to play an audio chunk for channel " << channelId << ". The error: " << Mix_GetError() )
+        return { sample, Mix_FreeChunk };
+    }
+
+    int playSound( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop, const int sampleId )
+    {
+        assert( ptr != nullptr && size != 0 );
 
-            Mix_FreeChunk( sample );
+        soundSampleManager.clearFinishedSamples();
 
+        SoundSample sample;
+        if ( sampleId >= 0 ) {
+            sample = soundSampleManager.getCachedSample( sampleId );
+        }
+
+        if ( sample == nullptr ) {
+            sample = loadSoundSample( ptr, size );
+            if ( sample == nullptr ) {
+                return -1;
+            }
+
+            if ( sampleId >= 0 ) {
+                soundSampleManager.cacheSample( sampleId, sample );
+            }
+        }
+
+        const int channel = Mix_PlayChannel( channelId, sample.get(), loop ? -1 : 0 );
+        if ( channel < 0 ) {
+            ERROR_LOG( "Failed to play an audio chunk for channel " << channelId << ". The error: " << Mix_GetError() )
             return channel;
         }
 
         // There can be a maximum of two items in the sample queue for a channel:
         // the previous sample (if it hasn't been freed yet) and the current one
-        soundSampleManager.channelStarted( channel, sample );
+        soundSampleManager.channelStarted( channel, std::move( sample ) );
 
         return channel;
     }
@@ -447,6 +497,53 @@ namespace
 
     void playMusic( const uint64_t musicUID, Music::PlaybackMode playbackMode );
 
+    // Reads the MIDI SoundFont files in the background so that the system caches them before they are loaded along with the first MIDI track.
+    class SoundFontPreloader final : public MultiThreading::AsyncManager
+    {
+    public:
+        void preload( std::vector<std::string> files )
+        {
+            std::scoped_lock<std::mutex> lock( _mutex );
+
+            _files = std::move( files );
+
+            notifyWorker();
+        }
+
+    private:
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            _taskFiles = std::move( _files );
+            _files.clear();
+
+            return false;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            std::vector<char> buffer( 1024 * 1024 );
+
+            for ( const std::string & file : _taskFiles ) {
+                std::ifstream stream( file, std::ios::binary );
+
+                while ( stream.read( buffer.data(), static_cast<std::streamsize>( buffer.size() ) ) ) {
+                    // Do nothing.
+                }
+            }
+
+            _taskFiles.clear();
+        }
+
+        // This variable can be accessed by multiple threads and it is protected by _mutex
+        std::vector<std::string> _files;
+        // This variable can be accessed only by the worker thread
+        std::vector<std::string> _taskFiles;
+    };
+
+    SoundFontPreloader soundFontPreloader;
+
     class MusicRestartManager final : public MultiThreading::AsyncManager
     {
     public:
@@ -528,7 +625,8 @@ namespace
         return ( musicType == Mix_MusicType::MUS_OGG ) || ( musicType == Mix_MusicType::MUS_MP3 ) || ( musicType == Mix_MusicType::MUS_FLAC );
     }
 
-    void playMusic( const uint64_t musicUID, Music::PlaybackMode playbackMode )
+    // Starts the playback of the given music track created for the track with the specified UID and takes the ownership of it.
+    void playMusic( const uint64_t musicUID, Music::PlaybackMode playbackMode, Mix_Music * mus )
     {
         // This function should never be called if a music track is currently playing.
         // Thus we have a guarantee that the Mix_HookMusicFinished()'s callback will
@@ -540,7 +638,6 @@ namespace
         const std::shared_ptr<MusicInfo> track = musicTrackManager.getTrackFromMusicDB( musicUID );
         assert( track );
 
-        Mix_Music * mus = track->createMusic();
         if ( mus == nullptr ) {
             musicTrackManager.resetCurrentTrack();
 
@@ -609,6 +706,47 @@ namespace
         musicTrackManager.musicStarted( mus );
     }
 
+    void playMusic( const uint64_t musicUID, Music::PlaybackMode playbackMode )
+    {
+        const std::shared_ptr<MusicInfo> track = musicTrackManager.getTrackFromMusicDB( musicUID );
+        assert( track );
+
+        playMusic( musicUID, playbackMode, track->createMusic() );
+    }
+
+    // Creation of a music track can take a lot of time, for example, MIDI SoundFonts are loaded for every MIDI track. So the track is created
+    // without holding the audioMutex to not block other threads which play sounds or control the playback in the meantime.
+    void playNewMusic( const uint64_t musicUID, const std::shared_ptr<MusicInfo> & track, const Music::PlaybackMode playbackMode )
+    {
+        Mix_Music * mus = nullptr;
+
+        {
+            const std::scoped_lock<std::mutex> lock( musicCreationMutex );
+
+            if ( !isInitialized ) {
+                return;
+            }
+
+            mus = track->createMusic();
+        }
+
+        const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+        if ( !isInitialized ) {
+            if ( mus != nullptr ) {
+                Mix_FreeMusic( mus );
+            }
+
+            return;
+        }
+
+        musicTrackManager.addTrackToMusicDB( musicUID, track );
+
+        Music::Stop();
+
+        playMusic( musicUID, playbackMode, mus );
+    }
+
     // By the Weber-Fechner law, humans subjective sound sensation is proportional logarithm of sound intensity.
     // So for linear changing sound intensity we have to change the volume exponential.
     // There is a good explanation at https://www.dr-lex.be/info-stuff/volumecontrols.html.
@@ -711,6 +849,7 @@ void Audio::Init()
     }
 
     musicRestartManager.createWorker();
+    soundFontPreloader.createWorker();
 
     Mix_ChannelFinished( channelFinished );
     Mix_HookMusicFinished( musicFinished );
@@ -741,10 +880,13 @@ void Audio::Quit()
         Mix_HookMusicFinished( nullptr );
 
         soundSampleManager.clearFinishedSamples();
+        soundSampleManager.clearCachedSamples();
 
         musicTrackManager.clearFinishedMusic();
         musicTrackManager.clearMusicDB();
 
+        const std::scoped_lock<std::mutex> musicCreationLock( musicCreationMutex );
+
         Mix_CloseAudio();
 #if SDL_VERSION_ATLEAST( 2, 0, 0 )
         Mix_Quit();
@@ -760,6 +902,7 @@ void Audio::Quit()
     // for it to join. The Mix_HookMusicFinished()'s callback can no longer be called
     // at the moment because it has been already unregistered.
     musicRestartManager.stopWorker();
+    soundFontPreloader.stopWorker();
 }
 
 void Audio::Mute()
@@ -836,7 +979,7 @@ int Mixer::getChannelCount()
     return mixerChannelCount;
 }
 
-int Mixer::Play( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop )
+int Mixer::Play( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop, const int sampleId /* = -1 */ )
 {
     if ( ptr == nullptr || size == 0 ) {
         // You are trying to play an empty sound. Check your logic!
@@ -850,10 +993,11 @@ int Mixer::Play( const uint8_t * ptr, const uint32_t size, const int channelId,
         return -1;
     }
 
-    return playSound( ptr, size, channelId, loop );
+    return playSound( ptr, size, channelId, loop, sampleId );
 }
 
-int Mixer::PlayFromDistance( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop, const int16_t angle, const uint8_t volumePercentage )
+int Mixer::PlayFromDistance( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop, const int16_t angle, const uint8_t volumePercentage,
+                             const int sampleId /* = -1 */ )
 {
     if ( ptr == nullptr || size == 0 ) {
         // You are trying to play an empty sound. Check your logic!
@@ -867,7 +1011,7 @@ int Mixer::PlayFromDistance( const uint8_t * ptr, const uint32_t size, const int
         return -1;
     }
 
-    const int channel = playSound( ptr, size, channelId, loop );
+    const int channel = playSound( ptr, size, channelId, loop, sampleId );
     if ( channel < 0 ) {
         return channel;
     }
@@ -877,6 +1021,34 @@ int Mixer::PlayFromDistance( const uint8_t * ptr, const uint32_t size, const int
     return channel;
 }
 
+bool Mixer::preloadSample( const int sampleId, const uint8_t * ptr, const uint32_t size )
+{
+    if ( sampleId < 0 || ptr == nullptr || size == 0 ) {
+        // You are trying to preload an empty sound. Check your logic!
+        assert( 0 );
+        return false;
+    }
+
+    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+    if ( !isInitialized ) {
+        return false;
+    }
+
+    if ( soundSampleManager.getCachedSample( sampleId ) != nullptr ) {
+        return true;
+    }
+
+    SoundSample sample = loadSoundSample( ptr, size );
+    if ( sample == nullptr ) {
+        return false;
+    }
+
+    soundSampleManager.cacheSample( sampleId, std::move( sample ) );
+
+    return true;
+}
+
 int Mixer::applySoundEffect( const int channelId, const int16_t angle, const uint8_t volumePercentage )
 {
     const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
@@ -976,17 +1148,7 @@ void Music::Play( const uint64_t musicUID, const std::vector<uint8_t> & v, const
         return;
     }
 
-    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
-
-    if ( !isInitialized ) {
-        return;
-    }
-
-    musicTrackManager.addTrackToMusicDB( musicUID, std::make_shared<MusicInfo>( v ) );
-
-    Stop();
-
-    playMusic( musicUID, playbackMode );
+    playNewMusic( musicUID, std::make_shared<MusicInfo>( v ), playbackMode );
 }
 
 void Music::Play( const uint64_t musicUID, const std::string & file, const PlaybackMode playbackMode )
@@ -996,17 +1158,7 @@ void Music::Play( const uint64_t musicUID, const std::string & file, const Playb
         return;
     }
 
-    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
-
-    if ( !isInitialized ) {
-        return;
-    }
-
-    musicTrackManager.addTrackToMusicDB( musicUID, std::make_shared<MusicInfo>( file ) );
-
-    Stop();
-
-    playMusic( musicUID, playbackMode );
+    playNewMusic( musicUID, std::make_shared<MusicInfo>( file ), playbackMode );
 }
 
 void Music::SetFadeInMs( const int timeMs )
@@ -1104,5 +1256,8 @@ void Music::SetMidiSoundFonts( const ListFiles & files )
 
     if ( Mix_SetSoundFonts( System::FileNameToUTF8( filePaths ).c_str() ) == 0 ) {
         ERROR_LOG( "Failed to set MIDI SoundFonts using paths " << filePaths << ". The error: " << Mix_GetError() )
+        return;
     }
+
+    soundFontPreloader.preload( std::vector<std::string>( files.begin(), files.end() ) );
 }
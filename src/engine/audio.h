@@ -50,8 +50,14 @@ namespace Mixer
     int getChannelCount();
 
     // To play the audio in a new channel set its value to -1. Returns channel ID. A negative value (-1) in case of failure.
-    int Play( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop );
-    int PlayFromDistance( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop, const int16_t angle, const uint8_t volumePercentage );
+    // If sample ID is not negative the decoded sample is kept in memory and reused next time the audio with the same ID is played.
+    // The audio data for the same sample ID must never change.
+    int Play( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop, const int sampleId = -1 );
+    int PlayFromDistance( const uint8_t * ptr, const uint32_t size, const int channelId, const bool loop, const int16_t angle, const uint8_t volumePercentage,
+                          const int sampleId = -1 );
+
+    // Decodes the audio and stores it in the sample cache without playing. Returns false in case of failure.
+    bool preloadSample( const int sampleId, const uint8_t * ptr, const uint32_t size );
 
     int applySoundEffect( const int channelId, const int16_t angle, const uint8_t volumePercentage );
 
@@ -20,11 +20,12 @@
 
 #include "h2d_file.h"
 
+#include <array>
 #include <cassert>
 #include <cstdint>
-#include <cstring>
 
 #include "image.h"
+#include "tools.h"
 
 namespace
 {
@@ -96,6 +97,27 @@ namespace fheroes2
         return _fileStream.getRaw( it->second.second );
     }
 
+    size_t H2DReader::getFileSize( const std::string & fileName ) const
+    {
+        const auto it = _fileNameAndOffset.find( fileName );
+        if ( it == _fileNameAndOffset.end() ) {
+            return 0;
+        }
+
+        return it->second.second;
+    }
+
+    bool H2DReader::readFilePart( const std::string & fileName, const size_t offset, uint8_t * data, const size_t size )
+    {
+        const auto it = _fileNameAndOffset.find( fileName );
+        if ( it == _fileNameAndOffset.end() || offset + size > it->second.second ) {
+            return false;
+        }
+
+        _fileStream.seek( it->second.first + offset );
+        return _fileStream.readRaw( data, size );
+    }
+
     std::set<std::string> H2DReader::getAllFileNames() const
     {
         std::set<std::string> names;
@@ -107,6 +129,18 @@ namespace fheroes2
         return names;
     }
 
+    std::map<std::string, uint32_t> H2DReader::getFileChecksums()
+    {
+        std::map<std::string, uint32_t> checksums;
+
+        for ( const auto & value : _fileNameAndOffset ) {
+            const std::vector<uint8_t> data = getFile( value.first );
+            checksums.try_emplace( value.first, calculateCRC32( data.data(), data.size() ) );
+        }
+
+        return checksums;
+    }
+
     bool H2DWriter::write( const std::string & path ) const
     {
         if ( _fileData.empty() ) {
@@ -171,27 +205,42 @@ namespace fheroes2
         return true;
     }
 
+    std::map<std::string, uint32_t> H2DWriter::getFileChecksums() const
+    {
+        std::map<std::string, uint32_t> checksums;
+
+        for ( const auto & data : _fileData ) {
+            checksums.try_emplace( data.first, calculateCRC32( data.second.data(), data.second.size() ) );
+        }
+
+        return checksums;
+    }
+
     bool readImageFromH2D( H2DReader & reader, const std::string & name, Sprite & image )
     {
-        const std::vector<uint8_t> & data = reader.getFile( name );
-        if ( data.size() < 4 + 4 + 4 + 4 + 1 ) {
+        // The image data is read directly into the image buffers to avoid copying the whole file into an intermediate buffer.
+        std::array<uint8_t, 4 + 4 + 4 + 4> header;
+
+        const size_t fileSize = reader.getFileSize( name );
+        if ( fileSize < header.size() + 1 || !reader.readFilePart( name, 0, header.data(), header.size() ) ) {
             // Empty or invalid image.
             return false;
         }
 
-        StreamBuf stream( data );
+        StreamBuf stream( header.data(), header.size() );
         const int32_t width = static_cast<int32_t>( stream.getLE32() );
         const int32_t height = static_cast<int32_t>( stream.getLE32() );
         const int32_t x = static_cast<int32_t>( stream.getLE32() );
         const int32_t y = static_cast<int32_t>( stream.getLE32() );
-        if ( static_cast<size_t>( width * height * 2 + 4 + 4 + 4 + 4 ) != data.size() ) {
+        if ( static_cast<size_t>( width * height * 2 + 4 + 4 + 4 + 4 ) != fileSize ) {
             return false;
         }
 
         const size_t size = static_cast<size_t>( width * height );
         image.resize( width, height );
-        memcpy( image.image(), data.data() + 4 + 4 + 4 + 4, size );
-        memcpy( image.transform(), data.data() + 4 + 4 + 4 + 4 + size, size );
+        if ( !reader.readFilePart( name, header.size(), image.image(), size ) || !reader.readFilePart( name, header.size() + size, image.transform(), size ) ) {
+            return false;
+        }
 
         image.setPosition( x, y );
 
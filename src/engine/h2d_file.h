@@ -20,10 +20,12 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -43,11 +45,21 @@ namespace fheroes2
         // Returns non-empty vector if requested file exists.
         std::vector<uint8_t> getFile( const std::string & fileName );
 
+        // Returns the size of the requested file or 0 if this file does not exist.
+        size_t getFileSize( const std::string & fileName ) const;
+
+        // Reads a part of the requested file starting from the given offset directly into the given buffer. Returns false if this file
+        // does not exist or is too small.
+        bool readFilePart( const std::string & fileName, const size_t offset, uint8_t * data, const size_t size );
+
         std::set<std::string> getAllFileNames() const;
 
+        // Returns the CRC32 checksums of the contents of all files by their names.
+        std::map<std::string, uint32_t> getFileChecksums();
+
     private:
-        // Relationship between file name in non-capital letters and its offset from the start of the archive.
-        std::map<std::string, std::pair<uint32_t, uint32_t>> _fileNameAndOffset;
+        // Relationship between file name in non-capital letters and its offset and size from the start of the archive.
+        std::unordered_map<std::string, std::pair<uint32_t, uint32_t>> _fileNameAndOffset;
 
         // Stream for reading h2d file.
         StreamFile _fileStream;
@@ -65,6 +77,9 @@ namespace fheroes2
         // Add all entries from a H2D reader.
         bool add( H2DReader & reader );
 
+        // Returns the CRC32 checksums of the contents of all files by their names.
+        std::map<std::string, uint32_t> getFileChecksums() const;
+
     private:
         std::map<std::string, std::vector<uint8_t>> _fileData;
     };
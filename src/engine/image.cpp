@@ -26,9 +26,12 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <mutex>
 #include <type_traits>
 
 #include "image_palette.h"
+#include "thread.h"
 
 namespace
 {
@@ -346,12 +349,12 @@ namespace
 
     uint8_t GetPALColorId( const uint8_t red, const uint8_t green, const uint8_t blue )
     {
-        static uint8_t rgbToId[64 * 64 * 64];
-        static bool isInitialized = false;
-        if ( !isInitialized ) {
-            isInitialized = true;
+        // Images can be processed by several threads at once, so the table is built as a function-local static which is thread-safe.
+        static const std::vector<uint8_t> rgbToId = []() {
             const uint32_t size = 64 * 64 * 64;
 
+            std::vector<uint8_t> colorIds( size );
+
             uint32_t r = 0;
             uint32_t g = 0;
             uint32_t b = 0;
@@ -383,28 +386,153 @@ namespace
                     }
                 }
 
-                rgbToId[id] = static_cast<uint8_t>( bestPos ); // it's safe to cast
+                colorIds[id] = static_cast<uint8_t>( bestPos ); // it's safe to cast
             }
-        }
+
+            return colorIds;
+        }();
 
         return rgbToId[red + green * 64 + blue * 64 * 64];
     }
 
-    void ApplyRawPalette( const fheroes2::Image & in, int32_t inX, int32_t inY, fheroes2::Image & out, int32_t outX, int32_t outY, int32_t width, int32_t height,
-                          const uint8_t * palette )
+    // Sprites mostly consist of long runs of fully opaque or fully transparent pixels. Transform layer values of multiple pixels
+    // are checked at once to copy or skip such runs without per pixel branching.
+    using PixelBlock = uint64_t;
+
+    const int32_t pixelBlockSize = static_cast<int32_t>( sizeof( PixelBlock ) );
+
+    const PixelBlock transparentPixelBlock = 0x0101010101010101;
+
+    PixelBlock getPixelBlock( const uint8_t * data )
     {
-        if ( !Verify( in, inX, inY, out, outX, outY, width, height ) ) {
+        PixelBlock block;
+        memcpy( &block, data, sizeof( PixelBlock ) );
+        return block;
+    }
+
+    void blitPixel( const uint8_t imageIn, const uint8_t transformIn, uint8_t & imageOut )
+    {
+        if ( transformIn > 0 ) { // apply a transformation
+            if ( transformIn != 1 ) { // skip pixel
+                imageOut = *( transformTable + transformIn * 256 + imageOut );
+            }
+        }
+        else { // copy a pixel
+            imageOut = imageIn;
+        }
+    }
+
+    void blitPixel( const uint8_t imageIn, const uint8_t transformIn, uint8_t & imageOut, uint8_t & transformOut )
+    {
+        if ( transformIn == 1 ) { // skip pixel
             return;
         }
 
-        const int32_t widthIn = in.width();
-        const int32_t widthOut = out.width();
+        if ( transformIn > 0 && transformOut == 0 ) { // apply a transformation
+            imageOut = *( transformTable + transformIn * 256 + imageOut );
+        }
+        else { // copy a pixel
+            transformOut = transformIn;
+            imageOut = imageIn;
+        }
+    }
+
+    void blitRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, int32_t width )
+    {
+        for ( ; width >= pixelBlockSize; width -= pixelBlockSize, imageIn += pixelBlockSize, transformIn += pixelBlockSize, imageOut += pixelBlockSize ) {
+            const PixelBlock transformBlock = getPixelBlock( transformIn );
+            if ( transformBlock == 0 ) {
+                memcpy( imageOut, imageIn, pixelBlockSize );
+            }
+            else if ( transformBlock != transparentPixelBlock ) {
+                for ( int32_t i = 0; i < pixelBlockSize; ++i ) {
+                    blitPixel( imageIn[i], transformIn[i], imageOut[i] );
+                }
+            }
+        }
+
+        for ( ; width > 0; --width, ++imageIn, ++transformIn, ++imageOut ) {
+            blitPixel( *imageIn, *transformIn, *imageOut );
+        }
+    }
 
-        const uint8_t * imageInY = in.image() + static_cast<ptrdiff_t>( inY ) * widthIn + inX;
-        uint8_t * imageOutY = out.image() + static_cast<ptrdiff_t>( outY ) * widthOut + outX;
+    void blitRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, int32_t width )
+    {
+        for ( ; width >= pixelBlockSize;
+              width -= pixelBlockSize, imageIn += pixelBlockSize, transformIn += pixelBlockSize, imageOut += pixelBlockSize, transformOut += pixelBlockSize ) {
+            const PixelBlock transformBlock = getPixelBlock( transformIn );
+            if ( transformBlock == 0 ) {
+                memcpy( imageOut, imageIn, pixelBlockSize );
+                memset( transformOut, 0, pixelBlockSize );
+            }
+            else if ( transformBlock != transparentPixelBlock ) {
+                for ( int32_t i = 0; i < pixelBlockSize; ++i ) {
+                    blitPixel( imageIn[i], transformIn[i], imageOut[i], transformOut[i] );
+                }
+            }
+        }
+
+        for ( ; width > 0; --width, ++imageIn, ++transformIn, ++imageOut, ++transformOut ) {
+            blitPixel( *imageIn, *transformIn, *imageOut, *transformOut );
+        }
+    }
+
+    // Input pointers of flipped rows point to the last pixel of the row and are moving backwards.
+    void blitFlippedRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, int32_t width )
+    {
+        for ( ; width >= pixelBlockSize; width -= pixelBlockSize, imageIn -= pixelBlockSize, transformIn -= pixelBlockSize, imageOut += pixelBlockSize ) {
+            const PixelBlock transformBlock = getPixelBlock( transformIn - ( pixelBlockSize - 1 ) );
+            if ( transformBlock == 0 ) {
+                for ( int32_t i = 0; i < pixelBlockSize; ++i ) {
+                    imageOut[i] = *( imageIn - i );
+                }
+            }
+            else if ( transformBlock != transparentPixelBlock ) {
+                for ( int32_t i = 0; i < pixelBlockSize; ++i ) {
+                    blitPixel( *( imageIn - i ), *( transformIn - i ), imageOut[i] );
+                }
+            }
+        }
+
+        for ( ; width > 0; --width, --imageIn, --transformIn, ++imageOut ) {
+            blitPixel( *imageIn, *transformIn, *imageOut );
+        }
+    }
+
+    void blitFlippedRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, int32_t width )
+    {
+        for ( ; width >= pixelBlockSize;
+              width -= pixelBlockSize, imageIn -= pixelBlockSize, transformIn -= pixelBlockSize, imageOut += pixelBlockSize, transformOut += pixelBlockSize ) {
+            const PixelBlock transformBlock = getPixelBlock( transformIn - ( pixelBlockSize - 1 ) );
+            if ( transformBlock == 0 ) {
+                for ( int32_t i = 0; i < pixelBlockSize; ++i ) {
+                    imageOut[i] = *( imageIn - i );
+                }
+                memset( transformOut, 0, pixelBlockSize );
+            }
+            else if ( transformBlock != transparentPixelBlock ) {
+                for ( int32_t i = 0; i < pixelBlockSize; ++i ) {
+                    blitPixel( *( imageIn - i ), *( transformIn - i ), imageOut[i], transformOut[i] );
+                }
+            }
+        }
+
+        for ( ; width > 0; --width, --imageIn, --transformIn, ++imageOut, ++transformOut ) {
+            blitPixel( *imageIn, *transformIn, *imageOut, *transformOut );
+        }
+    }
+
+    // Areas smaller than this are processed by the calling thread as the synchronization would cost more than the processing itself.
+    const int32_t parallelPaletteMinPixels = 512 * 512;
+    const int32_t paletteBandHeight = 64;
+
+    // The transform layer pointer is nullptr for single-layer input images. All the pointers point to the top left pixel of the area.
+    void applyRawPaletteRows( const uint8_t * imageInY, const uint8_t * transformInY, const int32_t widthIn, uint8_t * imageOutY, const int32_t widthOut,
+                              const int32_t width, const int32_t height, const uint8_t * palette )
+    {
         const uint8_t * imageInYEnd = imageInY + static_cast<ptrdiff_t>( height ) * widthIn;
 
-        if ( in.singleLayer() ) {
+        if ( transformInY == nullptr ) {
             // All pixels in a single-layer image do not have any transform values so there is no need to check for them.
             for ( ; imageInY != imageInYEnd; imageInY += widthIn, imageOutY += widthOut ) {
                 const uint8_t * imageInX = imageInY;
@@ -417,8 +545,6 @@ namespace
             }
         }
         else {
-            const uint8_t * transformInY = in.transform() + static_cast<ptrdiff_t>( inY ) * widthIn + inX;
-
             for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
                 const uint8_t * imageInX = imageInY;
                 const uint8_t * transformInX = transformInY;
@@ -433,6 +559,284 @@ namespace
             }
         }
     }
+
+    void ApplyRawPalette( const fheroes2::Image & in, int32_t inX, int32_t inY, fheroes2::Image & out, int32_t outX, int32_t outY, int32_t width, int32_t height,
+                          const uint8_t * palette )
+    {
+        if ( !Verify( in, inX, inY, out, outX, outY, width, height ) ) {
+            return;
+        }
+
+        // Rows can be processed independently only if no row is read after another row has been written to the same place.
+        const bool isShiftedInPlace = ( &in == &out ) && ( inX != outX || inY != outY );
+
+        const int32_t widthIn = in.width();
+        const int32_t widthOut = out.width();
+
+        // The first non-const access to the output image may detach its data so it must be done on the calling thread. The output pointer is
+        // obtained first as the output image can also be the input one.
+        uint8_t * imageOut = out.image() + static_cast<ptrdiff_t>( outY ) * widthOut + outX;
+        const ptrdiff_t offsetIn = static_cast<ptrdiff_t>( inY ) * widthIn + inX;
+        const uint8_t * imageIn = in.image() + offsetIn;
+        const uint8_t * transformIn = in.singleLayer() ? nullptr : in.transform() + offsetIn;
+
+        if ( width * height < parallelPaletteMinPixels || isShiftedInPlace ) {
+            applyRawPaletteRows( imageIn, transformIn, widthIn, imageOut, widthOut, width, height, palette );
+            return;
+        }
+
+        // Full-screen fading effects apply palettes to the entire display for every frame, so large areas are split into bands of rows.
+        const int32_t bandCount = ( height + paletteBandHeight - 1 ) / paletteBandHeight;
+
+        MultiThreading::getThreadPool().parallelFor( 0, static_cast<size_t>( bandCount ), [=]( const size_t band ) {
+            const int32_t offsetY = static_cast<int32_t>( band ) * paletteBandHeight;
+            const int32_t bandHeight = std::min( paletteBandHeight, height - offsetY );
+
+            const ptrdiff_t bandOffsetIn = static_cast<ptrdiff_t>( offsetY ) * widthIn;
+
+            applyRawPaletteRows( imageIn + bandOffsetIn, transformIn == nullptr ? nullptr : transformIn + bandOffsetIn, widthIn,
+                                 imageOut + static_cast<ptrdiff_t>( offsetY ) * widthOut, widthOut, width, bandHeight, palette );
+        } );
+    }
+
+    const int32_t parallelResizeMinPixels = 512 * 512;
+    const int32_t resizeBandHeight = 64;
+
+    // Resizes the rows of the output area from yBegin (inclusive) to yEnd (exclusive). The pointers point to the top left pixels of the areas and
+    // the transform layer pointers are nullptr for single-layer images. Both images must have the same layers.
+    void resizeRows( const uint8_t * imageIn, const uint8_t * transformIn, const int32_t widthIn, const int32_t widthRoiIn, const int32_t heightRoiIn,
+                     uint8_t * imageOut, uint8_t * transformOut, const int32_t widthOut, const int32_t widthRoiOut, const int32_t heightRoiOut,
+                     const bool isSubpixelAccuracy, const int32_t yBegin, const int32_t yEnd )
+    {
+        const uint8_t * imageInY = imageIn;
+        uint8_t * imageOutY = imageOut + yBegin * widthOut;
+
+        if ( isSubpixelAccuracy ) {
+            std::vector<double> positionX( widthRoiOut );
+            for ( int32_t x = 0; x < widthRoiOut; ++x ) {
+                positionX[x] = static_cast<double>( x * widthRoiIn ) / widthRoiOut;
+            }
+
+            const uint8_t * gamePalette = fheroes2::getGamePalette();
+
+            if ( transformIn == nullptr ) {
+                for ( int32_t y = yBegin; y < yEnd; ++y, imageOutY += widthOut ) {
+                    const double posY = static_cast<double>( y * heightRoiIn ) / heightRoiOut;
+                    const int32_t startY = static_cast<int32_t>( posY );
+                    const double coeffY = posY - startY;
+
+                    uint8_t * imageOutX = imageOutY;
+
+                    for ( int32_t x = 0; x < widthRoiOut; ++x, ++imageOutX ) {
+                        const double posX = positionX[x];
+                        const int32_t startX = static_cast<int32_t>( posX );
+                        const int32_t offsetIn = startY * widthIn + startX;
+
+                        const uint8_t * imageInX = imageInY + offsetIn;
+
+                        if ( posX < widthRoiIn - 1 && posY < heightRoiIn - 1 ) {
+                            const double coeffX = posX - startX;
+                            const double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
+                            const double coeff2 = coeffX * ( 1 - coeffY );
+                            const double coeff3 = ( 1 - coeffX ) * coeffY;
+                            const double coeff4 = coeffX * coeffY;
+
+                            const uint8_t * id1 = gamePalette + static_cast<uint32_t>( *imageInX ) * 3;
+                            const uint8_t * id2 = gamePalette + static_cast<uint32_t>( *( imageInX + 1 ) ) * 3;
+                            const uint8_t * id3 = gamePalette + static_cast<uint32_t>( *( imageInX + widthIn ) ) * 3;
+                            const uint8_t * id4 = gamePalette + static_cast<uint32_t>( *( imageInX + widthIn + 1 ) ) * 3;
+
+                            const double red = *id1 * coeff1 + *id2 * coeff2 + *id3 * coeff3 + *id4 * coeff4 + 0.5;
+                            const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + *( id3 + 1 ) * coeff3 + *( id4 + 1 ) * coeff4 + 0.5;
+                            const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + *( id3 + 2 ) * coeff3 + *( id4 + 2 ) * coeff4 + 0.5;
+
+                            *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
+                        }
+                        else {
+                            *imageOutX = *imageInX;
+                        }
+                    }
+                }
+            }
+            else {
+                const uint8_t * transformInY = transformIn;
+                uint8_t * transformOutY = transformOut + yBegin * widthOut;
+
+                for ( int32_t y = yBegin; y < yEnd; ++y, imageOutY += widthOut, transformOutY += widthOut ) {
+                    const double posY = static_cast<double>( y * heightRoiIn ) / heightRoiOut;
+                    const int32_t startY = static_cast<int32_t>( posY );
+                    const double coeffY = posY - startY;
+
+                    uint8_t * imageOutX = imageOutY;
+                    uint8_t * transformOutX = transformOutY;
+
+                    for ( int32_t x = 0; x < widthRoiOut; ++x, ++imageOutX, ++transformOutX ) {
+                        const double posX = positionX[x];
+                        const int32_t startX = static_cast<int32_t>( posX );
+                        const int32_t offsetIn = startY * widthIn + startX;
+
+                        const uint8_t * imageInX = imageInY + offsetIn;
+                        const uint8_t * transformInX = transformInY + offsetIn;
+
+                        if ( posX < widthIn - 1 && posY < heightRoiIn - 1 ) {
+                            if ( *transformInX == 0 && *( transformInX + 1 ) == 0 && *( transformInX + widthRoiIn ) == 0 && *( transformInX + widthRoiIn + 1 ) == 0 ) {
+                                const double coeffX = posX - startX;
+                                const double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
+                                const double coeff2 = coeffX * ( 1 - coeffY );
+                                const double coeff3 = ( 1 - coeffX ) * coeffY;
+                                const double coeff4 = coeffX * coeffY;
+
+                                const uint8_t * id1 = gamePalette + static_cast<uint32_t>( *imageInX ) * 3;
+                                const uint8_t * id2 = gamePalette + static_cast<uint32_t>( *( imageInX + 1 ) ) * 3;
+                                const uint8_t * id3 = gamePalette + static_cast<uint32_t>( *( imageInX + widthIn ) ) * 3;
+                                const uint8_t * id4 = gamePalette + static_cast<uint32_t>( *( imageInX + widthIn + 1 ) ) * 3;
+
+                                const double red = *id1 * coeff1 + *id2 * coeff2 + *id3 * coeff3 + *id4 * coeff4 + 0.5;
+                                const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + *( id3 + 1 ) * coeff3 + *( id4 + 1 ) * coeff4 + 0.5;
+                                const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + *( id3 + 2 ) * coeff3 + *( id4 + 2 ) * coeff4 + 0.5;
+
+                                *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
+                            }
+                            else {
+                                *imageOutX = *imageInX;
+                            }
+                        }
+                        else {
+                            *imageOutX = *imageInX;
+                        }
+
+                        *transformOutX = *transformInX;
+                    }
+                }
+            }
+        }
+        else {
+            const uint8_t * imageOutYEnd = imageOutY + widthOut * ( yEnd - yBegin );
+            int32_t idY = yBegin;
+
+            // Pre-calculation of X position
+            std::vector<int32_t> positionX( widthRoiOut );
+            for ( int32_t x = 0; x < widthRoiOut; ++x ) {
+                positionX[x] = ( x * widthRoiIn ) / widthRoiOut;
+            }
+
+            if ( transformIn == nullptr ) {
+                for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, ++idY ) {
+                    uint8_t * imageOutX = imageOutY;
+
+                    const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
+                    const uint8_t * imageInX = imageInY + offset;
+
+                    for ( const int32_t posX : positionX ) {
+                        *imageOutX = *( imageInX + posX );
+                        ++imageOutX;
+                    }
+                }
+            }
+            else {
+                const uint8_t * transformInY = transformIn;
+                uint8_t * transformOutY = transformOut + yBegin * widthOut;
+
+                for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, transformOutY += widthOut, ++idY ) {
+                    uint8_t * imageOutX = imageOutY;
+                    uint8_t * transformOutX = transformOutY;
+
+                    const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
+                    const uint8_t * imageInX = imageInY + offset;
+                    const uint8_t * transformInX = transformInY + offset;
+
+                    for ( const int32_t posX : positionX ) {
+                        *imageOutX = *( imageInX + posX );
+                        *transformOutX = *( transformInX + posX );
+                        ++imageOutX;
+                        ++transformOutX;
+                    }
+                }
+            }
+        }
+    }
+
+    // Keeps freed large image buffers grouped by their size to give them to the next images of a similar size.
+    class ImageBufferPool
+    {
+    public:
+        // Smaller buffers are cheap to allocate so they are not pooled.
+        static constexpr size_t minPooledSize = 256 * 1024;
+
+        static constexpr size_t bucketSizeStep = 64 * 1024;
+
+        static constexpr size_t maxCachedSize = 64 * 1024 * 1024;
+
+        std::shared_ptr<uint8_t[]> allocate( const size_t size )
+        {
+            if ( size < minPooledSize ) {
+                return std::shared_ptr<uint8_t[]>( new uint8_t[size] );
+            }
+
+            const size_t bucketSize = ( size + bucketSizeStep - 1 ) / bucketSizeStep * bucketSizeStep;
+
+            std::unique_ptr<uint8_t[]> buffer;
+
+            {
+                const std::lock_guard<std::mutex> lock( _mutex );
+
+                auto iter = _buffers.find( bucketSize );
+                if ( iter != _buffers.end() ) {
+                    buffer = std::move( iter->second.back() );
+
+                    iter->second.pop_back();
+                    if ( iter->second.empty() ) {
+                        _buffers.erase( iter );
+                    }
+
+                    _statistics.cachedBytes -= bucketSize;
+                    ++_statistics.hits;
+                }
+                else {
+                    ++_statistics.misses;
+                }
+            }
+
+            if ( !buffer ) {
+                buffer.reset( new uint8_t[bucketSize] );
+            }
+
+            return { buffer.release(), [this, bucketSize]( uint8_t * data ) { release( data, bucketSize ); } };
+        }
+
+        fheroes2::ImageBufferPoolStatistics statistics()
+        {
+            const std::lock_guard<std::mutex> lock( _mutex );
+
+            return _statistics;
+        }
+
+    private:
+        std::mutex _mutex;
+        std::map<size_t, std::vector<std::unique_ptr<uint8_t[]>>> _buffers;
+        fheroes2::ImageBufferPoolStatistics _statistics;
+
+        void release( uint8_t * data, const size_t bucketSize )
+        {
+            std::unique_ptr<uint8_t[]> buffer( data );
+
+            const std::lock_guard<std::mutex> lock( _mutex );
+
+            if ( _statistics.cachedBytes + bucketSize > maxCachedSize ) {
+                return;
+            }
+
+            _buffers[bucketSize].emplace_back( std::move( buffer ) );
+            _statistics.cachedBytes += bucketSize;
+        }
+    };
+
+    ImageBufferPool & imageBufferPool()
+    {
+        // The pool is never destroyed as images stored in static objects can be destroyed after it.
+        static ImageBufferPool * pool = new ImageBufferPool();
+        return *pool;
+    }
 }
 
 namespace fheroes2
@@ -478,6 +882,8 @@ namespace fheroes2
 
     uint8_t * Image::image()
     {
+        detach( true );
+
         return _data.get();
     }
 
@@ -497,9 +903,14 @@ namespace fheroes2
     void Image::fill( const uint8_t value )
     {
         if ( !empty() ) {
+            // The whole data is overwritten so there is no need to copy the shared data.
+            detach( false );
+
             const size_t totalSize = static_cast<size_t>( _width ) * _height;
             memset( image(), value, totalSize );
-            memset( transform(), static_cast<uint8_t>( 0 ), totalSize );
+            if ( !_singleLayer ) {
+                memset( transform(), static_cast<uint8_t>( 0 ), totalSize );
+            }
         }
     }
 
@@ -517,7 +928,7 @@ namespace fheroes2
 
         const size_t size = static_cast<size_t>( width_ ) * height_;
 
-        _data.reset( new uint8_t[size * 2] );
+        _data = imageBufferPool().allocate( _singleLayer ? size : size * 2 );
 
         _width = width_;
         _height = height_;
@@ -526,33 +937,70 @@ namespace fheroes2
     void Image::reset()
     {
         if ( !empty() ) {
+            // The whole data is overwritten so there is no need to copy the shared data.
+            detach( false );
+
             const size_t totalSize = static_cast<size_t>( _width ) * _height;
             memset( image(), static_cast<uint8_t>( 0 ), totalSize );
-            // Set the transform layer to skip all data.
-            memset( transform(), static_cast<uint8_t>( 1 ), totalSize );
+            if ( !_singleLayer ) {
+                // Set the transform layer to skip all data.
+                memset( transform(), static_cast<uint8_t>( 1 ), totalSize );
+            }
         }
     }
 
-    void Image::copy( const Image & image )
-    {
-        if ( !image._data ) {
-            clear();
+    void Image::copy( const Image & image )
+    {
+        if ( !image._data ) {
+            clear();
+
+            return;
+        }
+
+        // The data is copied only when one of the images is going to be modified.
+        _data = image._data;
+
+        _width = image._width;
+        _height = image._height;
+
+        _singleLayer = image._singleLayer;
+    }
+
+    void Image::_disableTransformLayer()
+    {
+        if ( _singleLayer ) {
+            return;
+        }
+
+        _singleLayer = true;
 
+        if ( !_data ) {
             return;
         }
 
-        const size_t size = static_cast<size_t>( image._width ) * image._height;
+        // Release the memory of the transform layer keeping the content of the image layer.
+        const size_t size = static_cast<size_t>( _width ) * _height;
 
-        if ( image._width != _width || image._height != _height ) {
-            _data.reset( new uint8_t[size * 2] );
+        std::shared_ptr<uint8_t[]> data = imageBufferPool().allocate( size );
+        memcpy( data.get(), _data.get(), size );
 
-            _width = image._width;
-            _height = image._height;
+        _data = std::move( data );
+    }
+
+    void Image::detach( const bool keepContent )
+    {
+        if ( !_data || _data.use_count() == 1 ) {
+            return;
         }
 
-        _singleLayer = image._singleLayer;
+        const size_t size = static_cast<size_t>( _width ) * _height * ( _singleLayer ? 1 : 2 );
+
+        std::shared_ptr<uint8_t[]> data = imageBufferPool().allocate( size );
+        if ( keepContent ) {
+            memcpy( data.get(), _data.get(), size );
+        }
 
-        memcpy( _data.get(), image._data.get(), size * 2 );
+        _data = std::move( data );
     }
 
     Sprite::Sprite( const int32_t width_, const int32_t height_, const int32_t x_ /* = 0 */, const int32_t y_ /* = 0 */ )
@@ -725,6 +1173,11 @@ namespace fheroes2
         }
     }
 
+    ImageBufferPoolStatistics getImageBufferPoolStatistics()
+    {
+        return imageBufferPool().statistics();
+    }
+
     void addGradientShadow( const Sprite & in, Image & out, const Point & outPos, const Point & shadowOffset )
     {
         if ( in.empty() || out.empty() || ( shadowOffset.x == 0 && shadowOffset.y == 0 ) || ( outPos.x < 0 ) || ( outPos.y < 0 ) ) {
@@ -931,6 +1384,17 @@ namespace fheroes2
                     const uint8_t * imageOutXEnd = imageOutX + width;
 
                     for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX ) {
+                        // Skip runs of transparent pixels without blending every pixel.
+                        while ( imageOutXEnd - imageOutX >= pixelBlockSize && getPixelBlock( transformInX - ( pixelBlockSize - 1 ) ) == transparentPixelBlock ) {
+                            imageInX -= pixelBlockSize;
+                            transformInX -= pixelBlockSize;
+                            imageOutX += pixelBlockSize;
+                        }
+
+                        if ( imageOutX == imageOutXEnd ) {
+                            break;
+                        }
+
                         if ( *transformInX == 1 ) { // skip pixel
                             continue;
                         }
@@ -985,6 +1449,17 @@ namespace fheroes2
                     const uint8_t * imageInXEnd = imageInX + width;
 
                     for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
+                        // Skip runs of transparent pixels without blending every pixel.
+                        while ( imageInXEnd - imageInX >= pixelBlockSize && getPixelBlock( transformInX ) == transparentPixelBlock ) {
+                            imageInX += pixelBlockSize;
+                            transformInX += pixelBlockSize;
+                            imageOutX += pixelBlockSize;
+                        }
+
+                        if ( imageInX == imageInXEnd ) {
+                            break;
+                        }
+
                         if ( *transformInX == 1 ) { // skip pixel
                             continue;
                         }
@@ -1137,116 +1612,43 @@ namespace fheroes2
             return;
         }
 
+        if ( in.singleLayer() ) {
+            // There is no transform layer to blit so it is a plain flipped copy.
+            Flip( in, in.width() - inX - width, inY, out, outX, outY, width, height, true, false );
+            return;
+        }
+
         const int32_t widthIn = in.width();
         const int32_t widthOut = out.width();
 
-        if ( flip ) {
-            const int32_t offsetInY = inY * widthIn + widthIn - 1 - inX;
-            const uint8_t * imageInY = in.image() + offsetInY;
-            const uint8_t * transformInY = in.transform() + offsetInY;
-
-            const int32_t offsetOutY = outY * widthOut + outX;
-            uint8_t * imageOutY = out.image() + offsetOutY;
-            const uint8_t * imageOutYEnd = imageOutY + height * widthOut;
+        const int32_t offsetInY = flip ? inY * widthIn + widthIn - 1 - inX : inY * widthIn + inX;
+        const uint8_t * imageInY = in.image() + offsetInY;
+        const uint8_t * transformInY = in.transform() + offsetInY;
 
-            if ( out.singleLayer() ) {
-                assert( !in.singleLayer() );
-                for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
+        const int32_t offsetOutY = outY * widthOut + outX;
+        uint8_t * imageOutY = out.image() + offsetOutY;
+        const uint8_t * imageOutYEnd = imageOutY + height * widthOut;
 
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                            }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
+        if ( out.singleLayer() ) {
+            assert( !in.singleLayer() );
+            for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
+                if ( flip ) {
+                    blitFlippedRow( imageInY, transformInY, imageOutY, width );
                 }
-            }
-            else {
-                uint8_t * transformOutY = out.transform() + offsetOutY;
-
-                for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
-
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                else {
+                    blitRow( imageInY, transformInY, imageOutY, width );
                 }
             }
         }
         else {
-            const int32_t offsetInY = inY * widthIn + inX;
-            const uint8_t * imageInY = in.image() + offsetInY;
-            const uint8_t * transformInY = in.transform() + offsetInY;
-
-            const int32_t offsetOutY = outY * widthOut + outX;
-            uint8_t * imageOutY = out.image() + offsetOutY;
-            const uint8_t * imageInYEnd = imageInY + height * widthIn;
-
-            if ( out.singleLayer() ) {
-                assert( !in.singleLayer() );
-                for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
+            uint8_t * transformOutY = out.transform() + offsetOutY;
 
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                            }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
+            for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
+                if ( flip ) {
+                    blitFlippedRow( imageInY, transformInY, imageOutY, transformOutY, width );
                 }
-            }
-            else {
-                uint8_t * transformOutY = out.transform() + offsetOutY;
-
-                for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                else {
+                    blitRow( imageInY, transformInY, imageOutY, transformOutY, width );
                 }
             }
         }
@@ -2662,158 +3064,47 @@ namespace fheroes2
             return;
         }
 
-        const int32_t widthIn = in.width();
-        const int32_t widthOut = out.width();
-
-        const int32_t offsetInY = inY * widthIn + inX;
-        const int32_t offsetOutY = outY * widthOut + outX;
-
-        const uint8_t * imageInY = in.image() + offsetInY;
-        uint8_t * imageOutY = out.image() + offsetOutY;
-
-        if ( isSubpixelAccuracy ) {
-            std::vector<double> positionX( widthRoiOut );
-            for ( int32_t x = 0; x < widthRoiOut; ++x ) {
-                positionX[x] = static_cast<double>( x * widthRoiIn ) / widthRoiOut;
-            }
-
-            const uint8_t * gamePalette = getGamePalette();
-
-            if ( in.singleLayer() && out.singleLayer() ) {
-                for ( int32_t y = 0; y < heightRoiOut; ++y, imageOutY += widthOut ) {
-                    const double posY = static_cast<double>( y * heightRoiIn ) / heightRoiOut;
-                    const int32_t startY = static_cast<int32_t>( posY );
-                    const double coeffY = posY - startY;
-
-                    uint8_t * imageOutX = imageOutY;
-
-                    for ( int32_t x = 0; x < widthRoiOut; ++x, ++imageOutX ) {
-                        const double posX = positionX[x];
-                        const int32_t startX = static_cast<int32_t>( posX );
-                        const int32_t offsetIn = startY * widthIn + startX;
-
-                        const uint8_t * imageInX = imageInY + offsetIn;
-
-                        if ( posX < widthRoiIn - 1 && posY < heightRoiIn - 1 ) {
-                            const double coeffX = posX - startX;
-                            const double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
-                            const double coeff2 = coeffX * ( 1 - coeffY );
-                            const double coeff3 = ( 1 - coeffX ) * coeffY;
-                            const double coeff4 = coeffX * coeffY;
-
-                            const uint8_t * id1 = gamePalette + static_cast<uint32_t>( *imageInX ) * 3;
-                            const uint8_t * id2 = gamePalette + static_cast<uint32_t>( *( imageInX + 1 ) ) * 3;
-                            const uint8_t * id3 = gamePalette + static_cast<uint32_t>( *( imageInX + widthIn ) ) * 3;
-                            const uint8_t * id4 = gamePalette + static_cast<uint32_t>( *( imageInX + widthIn + 1 ) ) * 3;
-
-                            const double red = *id1 * coeff1 + *id2 * coeff2 + *id3 * coeff3 + *id4 * coeff4 + 0.5;
-                            const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + *( id3 + 1 ) * coeff3 + *( id4 + 1 ) * coeff4 + 0.5;
-                            const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + *( id3 + 2 ) * coeff3 + *( id4 + 2 ) * coeff4 + 0.5;
-
-                            *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
-                        }
-                        else {
-                            *imageOutX = *imageInX;
-                        }
-                    }
-                }
+        if ( in.singleLayer() != out.singleLayer() ) {
+            // Only one of the images has a transform layer. Resize into an image with the same layers as the input one and copy the result.
+            Image resized;
+            if ( in.singleLayer() ) {
+                resized._disableTransformLayer();
             }
-            else {
-                const uint8_t * transformInY = in.transform() + offsetInY;
-                uint8_t * transformOutY = out.transform() + offsetOutY;
-
-                for ( int32_t y = 0; y < heightRoiOut; ++y, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const double posY = static_cast<double>( y * heightRoiIn ) / heightRoiOut;
-                    const int32_t startY = static_cast<int32_t>( posY );
-                    const double coeffY = posY - startY;
-
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-
-                    for ( int32_t x = 0; x < widthRoiOut; ++x, ++imageOutX, ++transformOutX ) {
-                        const double posX = positionX[x];
-                        const int32_t startX = static_cast<int32_t>( posX );
-                        const int32_t offsetIn = startY * widthIn + startX;
-
-                        const uint8_t * imageInX = imageInY + offsetIn;
-                        const uint8_t * transformInX = transformInY + offsetIn;
-
-                        if ( posX < widthIn - 1 && posY < heightRoiIn - 1 ) {
-                            if ( *transformInX == 0 && *( transformInX + 1 ) == 0 && *( transformInX + widthRoiIn ) == 0 && *( transformInX + widthRoiIn + 1 ) == 0 ) {
-                                const double coeffX = posX - startX;
-                                const double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
-                                const double coeff2 = coeffX * ( 1 - coeffY );
-                                const double coeff3 = ( 1 - coeffX ) * coeffY;
-                                const double coeff4 = coeffX * coeffY;
-
-                                const uint8_t * id1 = gamePalette + static_cast<uint32_t>( *imageInX ) * 3;
-                                const uint8_t * id2 = gamePalette + static_cast<uint32_t>( *( imageInX + 1 ) ) * 3;
-                                const uint8_t * id3 = gamePalette + static_cast<uint32_t>( *( imageInX + widthIn ) ) * 3;
-                                const uint8_t * id4 = gamePalette + static_cast<uint32_t>( *( imageInX + widthIn + 1 ) ) * 3;
-
-                                const double red = *id1 * coeff1 + *id2 * coeff2 + *id3 * coeff3 + *id4 * coeff4 + 0.5;
-                                const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + *( id3 + 1 ) * coeff3 + *( id4 + 1 ) * coeff4 + 0.5;
-                                const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + *( id3 + 2 ) * coeff3 + *( id4 + 2 ) * coeff4 + 0.5;
-
-                                *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
-                            }
-                            else {
-                                *imageOutX = *imageInX;
-                            }
-                        }
-                        else {
-                            *imageOutX = *imageInX;
-                        }
+            resized.resize( widthRoiOut, heightRoiOut );
 
-                        *transformOutX = *transformInX;
-                    }
-                }
-            }
+            Resize( in, inX, inY, widthRoiIn, heightRoiIn, resized, 0, 0, widthRoiOut, heightRoiOut, isSubpixelAccuracy );
+            Copy( resized, 0, 0, out, outX, outY, widthRoiOut, heightRoiOut );
+            return;
         }
-        else {
-            const uint8_t * imageOutYEnd = imageOutY + widthOut * heightRoiOut;
-            int32_t idY = 0;
 
-            // Pre-calculation of X position
-            std::vector<int32_t> positionX( widthRoiOut );
-            for ( int32_t x = 0; x < widthRoiOut; ++x ) {
-                positionX[x] = ( x * widthRoiIn ) / widthRoiOut;
-            }
+        const int32_t widthIn = in.width();
+        const int32_t widthOut = out.width();
 
-            if ( in.singleLayer() && out.singleLayer() ) {
-                for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, ++idY ) {
-                    uint8_t * imageOutX = imageOutY;
+        // The first non-const access to the output image may detach its data so it must be done on the calling thread. The output pointers are
+        // obtained first as the output image can also be the input one.
+        const int32_t offsetOut = outY * widthOut + outX;
+        uint8_t * imageOut = out.image() + offsetOut;
+        uint8_t * transformOut = out.singleLayer() ? nullptr : out.transform() + offsetOut;
 
-                    const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
-                    const uint8_t * imageInX = imageInY + offset;
+        const int32_t offsetIn = inY * widthIn + inX;
+        const uint8_t * imageIn = in.image() + offsetIn;
+        const uint8_t * transformIn = in.singleLayer() ? nullptr : in.transform() + offsetIn;
 
-                    for ( const int32_t posX : positionX ) {
-                        *imageOutX = *( imageInX + posX );
-                        ++imageOutX;
-                    }
-                }
-            }
-            else {
-                const uint8_t * transformInY = in.transform() + offsetInY;
-                uint8_t * transformOutY = out.transform() + offsetOutY;
+        if ( widthRoiOut * heightRoiOut < parallelResizeMinPixels || &in == &out ) {
+            resizeRows( imageIn, transformIn, widthIn, widthRoiIn, heightRoiIn, imageOut, transformOut, widthOut, widthRoiOut, heightRoiOut, isSubpixelAccuracy, 0,
+                        heightRoiOut );
+            return;
+        }
 
-                for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, transformOutY += widthOut, ++idY ) {
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
+        // Every output row depends only on the input image, so large areas like high resolution backgrounds are split into bands of rows.
+        const int32_t bandCount = ( heightRoiOut + resizeBandHeight - 1 ) / resizeBandHeight;
 
-                    const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
-                    const uint8_t * imageInX = imageInY + offset;
-                    const uint8_t * transformInX = transformInY + offset;
+        MultiThreading::getThreadPool().parallelFor( 0, static_cast<size_t>( bandCount ), [=]( const size_t band ) {
+            const int32_t yBegin = static_cast<int32_t>( band ) * resizeBandHeight;
 
-                    for ( const int32_t posX : positionX ) {
-                        *imageOutX = *( imageInX + posX );
-                        *transformOutX = *( transformInX + posX );
-                        ++imageOutX;
-                        ++transformOutX;
-                    }
-                }
-            }
-        }
+            resizeRows( imageIn, transformIn, widthIn, widthRoiIn, heightRoiIn, imageOut, transformOut, widthOut, widthRoiOut, heightRoiOut, isSubpixelAccuracy,
+                        yBegin, std::min( yBegin + resizeBandHeight, heightRoiOut ) );
+        } );
     }
 
     void SetPixel( Image & image, const int32_t x, const int32_t y, const uint8_t value )
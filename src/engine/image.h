@@ -19,6 +19,8 @@
  ***************************************************************************/
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -57,17 +59,27 @@ namespace fheroes2
             return _height;
         }
 
+        // Copies of an image share the data, so the first non-const access to the layers after copying allocates a separate buffer for this
+        // image. It modifies the image and is not thread-safe: call makeUnique() on the calling thread before writing into the same image
+        // from several threads.
         virtual uint8_t * image();
 
         virtual const uint8_t * image() const;
 
+        // The same as image(): the first non-const access after copying detaches the data of this image.
         uint8_t * transform()
         {
+            assert( !_singleLayer );
+
+            detach( true );
+
             return _data.get() + width() * height();
         }
 
         const uint8_t * transform() const
         {
+            assert( !_singleLayer );
+
             return _data.get() + width() * height();
         }
 
@@ -76,14 +88,21 @@ namespace fheroes2
             return !_data;
         }
 
+        // Makes sure that the data of this image is not shared with its copies. After this call the non-const image() and transform() methods
+        // do not modify the image until it is copied again, so several threads can write into it.
+        void makeUnique()
+        {
+            detach( true );
+        }
+
         void reset(); // makes image fully transparent (transform layer is set to 1)
         void clear(); // makes the image empty
 
         // Fill 'image' layer with given value, setting 'transform' layer to 0.
         void fill( const uint8_t value );
 
-        // This is an optional indicator for image processing functions.
-        // The whole image still consists of 2 layers but transform layer might be ignored in computations.
+        // Single-layer images have no transform layer at all: only the image layer is allocated for them.
+        // Image processing functions must check this before accessing the transform layer.
         bool singleLayer() const
         {
             return _singleLayer;
@@ -91,17 +110,20 @@ namespace fheroes2
 
         // BE CAREFUL! This method disables transform layer usage. Use only for display / video related images which are for end rendering purposes!
         // The name of this method starts from _ on purpose to do not mix with other public methods.
-        void _disableTransformLayer()
-        {
-            _singleLayer = true;
-        }
+        void _disableTransformLayer();
 
     private:
         void copy( const Image & image );
 
+        // Makes sure that the data is not shared with other images before modifying it.
+        void detach( const bool keepContent );
+
         int32_t _width{ 0 };
         int32_t _height{ 0 };
-        std::unique_ptr<uint8_t[]> _data; // holds 2 image layers
+
+        // Holds 2 image layers or only the image layer for single-layer images. Copies of an image share the data until one of them
+        // requests a non-const pointer to it, so pointers obtained before copying an image must not be used to modify it after copying.
+        std::shared_ptr<uint8_t[]> _data;
 
         // Only for images which are not used for any other operations except displaying on screen.
         bool _singleLayer{ false };
@@ -195,6 +217,19 @@ namespace fheroes2
         bool _isRestored{ false };
     };
 
+    struct ImageBufferPoolStatistics
+    {
+        // Allocations of large image buffers which were served by the pool or by the heap.
+        uint64_t hits{ 0 };
+        uint64_t misses{ 0 };
+
+        // The size of buffers kept by the pool for future use.
+        size_t cachedBytes{ 0 };
+    };
+
+    // Large image buffers are not freed but kept for images of the same size, like backgrounds of the same dialog opened again.
+    ImageBufferPoolStatistics getImageBufferPoolStatistics();
+
     // Apply shadow that gradually reduces strength using 'in' image shape. Shadow is applied to the 'out' image.
     void addGradientShadow( const Sprite & in, Image & out, const Point & outPos, const Point & shadowOffset );
 
@@ -21,9 +21,12 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <map>
 #include <set>
 #include <utility>
@@ -49,14 +52,21 @@
 #include "audio.h"
 #include "image.h"
 #include "localevent.h"
+#include "logging.h"
 #include "pal.h"
 #include "screen.h"
+#include "serialize.h"
 #include "tools.h"
 
 namespace
 {
     const uint32_t globalLoopSleepTime{ 1 };
 
+    // The longest time to wait for new events, about one frame at 60 Hz. Anything polled outside of events stays responsive.
+    const uint64_t maxEventWaitTime{ 16 };
+
+    const uint32_t colorCyclingRedrawTime{ 220 };
+
     int getSDLKey( const fheroes2::Key key )
     {
         switch ( key ) {
@@ -765,7 +775,7 @@ namespace
             if ( _preRenderDrawing != nullptr )
                 _preRenderDrawing();
 
-            if ( _timer.getMs() >= 220 ) {
+            if ( _timer.getMs() >= colorCyclingRedrawTime ) {
                 _timer.reset();
                 palette = PAL::GetCyclingPalette( _counter );
                 ++_counter;
@@ -784,7 +794,18 @@ namespace
 
         bool isRedrawRequired() const
         {
-            return !_isPaused && _prevDraw.getMs() >= 220;
+            return !_isPaused && _prevDraw.getMs() >= colorCyclingRedrawTime;
+        }
+
+        // Returns the time in milliseconds until the next redraw is required.
+        uint64_t getTimeToRedraw() const
+        {
+            if ( _isPaused ) {
+                return maxEventWaitTime;
+            }
+
+            const uint64_t passedMs = _prevDraw.getMs();
+            return passedMs >= colorCyclingRedrawTime ? 0 : colorCyclingRedrawTime - passedMs;
         }
 
         void registerDrawing( void ( *preRenderDrawing )(), void ( *postRenderDrawing )() )
@@ -820,6 +841,34 @@ namespace
 
     ColorCycling colorCycling;
 
+    // The recorded events are stored in memory as they are, so a recording can be replayed only by a build with the same SDL version.
+    constexpr uint32_t inputRecordingFileId = 0x46483249; // "FH2I"
+
+    bool isRecordedInputEvent( const uint32_t eventType )
+    {
+        switch ( eventType ) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+#if SDL_VERSION_ATLEAST( 2, 0, 0 )
+        case SDL_MOUSEWHEEL:
+        case SDL_CONTROLLERAXISMOTION:
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERUP:
+        case SDL_FINGERMOTION:
+#endif
+            return true;
+        default:
+            break;
+        }
+
+        return false;
+    }
+
     bool ApplyCycling( std::vector<uint8_t> & palette )
     {
         return colorCycling.applyCycling( palette );
@@ -867,6 +916,145 @@ LocalEvent & LocalEvent::GetClean()
     return le;
 }
 
+bool LocalEvent::startInputRecording( const std::string & filePath )
+{
+    if ( _inputRecordingMode != InputRecordingMode::NONE ) {
+        ERROR_LOG( "Input is already being recorded or replayed." )
+        return false;
+    }
+
+    _inputRecordingFilePath = filePath;
+    _recordedInputEvents.clear();
+    _eventProcessingCallId = 0;
+    _inputRecordingMode = InputRecordingMode::RECORD;
+
+    return true;
+}
+
+bool LocalEvent::startInputReplay( const std::string & filePath )
+{
+    if ( _inputRecordingMode != InputRecordingMode::NONE ) {
+        ERROR_LOG( "Input is already being recorded or replayed." )
+        return false;
+    }
+
+    StreamFile file;
+    if ( !file.open( filePath, "rb" ) ) {
+        ERROR_LOG( "Failed to open the input recording file " << filePath )
+        return false;
+    }
+
+    if ( file.get32() != inputRecordingFileId || file.get32() != sizeof( SDL_Event ) ) {
+        ERROR_LOG( "The input recording file " << filePath << " is made by an incompatible version of the game." )
+        return false;
+    }
+
+    std::vector<RecordedInputEvent> events;
+
+    while ( file.tell() < file.size() ) {
+        RecordedInputEvent recordedEvent{};
+        recordedEvent.callId = file.get32();
+
+        const std::vector<uint8_t> data = file.getRaw( sizeof( SDL_Event ) );
+        if ( file.fail() || data.size() != sizeof( SDL_Event ) ) {
+            ERROR_LOG( "The input recording file " << filePath << " is corrupted." )
+            return false;
+        }
+
+        std::memcpy( &recordedEvent.event, data.data(), sizeof( SDL_Event ) );
+        events.push_back( recordedEvent );
+    }
+
+    _recordedInputEvents = std::move( events );
+    _replayedInputEventCount = 0;
+    _eventProcessingCallId = 0;
+
+    _replayLastFrameId = fheroes2::Display::instance().lastFrameStatistics().frameId;
+    _replayFrameCount = 0;
+    _replayRedrawTime = 0;
+    _replayPresentTime = 0;
+
+    _inputRecordingMode = InputRecordingMode::REPLAY;
+
+    VERBOSE_LOG( "Replaying " << _recordedInputEvents.size() << " input events from " << filePath )
+
+    return true;
+}
+
+void LocalEvent::stopInputRecording()
+{
+    if ( _inputRecordingMode != InputRecordingMode::RECORD ) {
+        return;
+    }
+
+    _inputRecordingMode = InputRecordingMode::NONE;
+
+    StreamFile file;
+    if ( !file.open( _inputRecordingFilePath, "wb" ) ) {
+        ERROR_LOG( "Failed to create the input recording file " << _inputRecordingFilePath )
+        return;
+    }
+
+    file.put32( inputRecordingFileId );
+    file.put32( sizeof( SDL_Event ) );
+
+    for ( const RecordedInputEvent & recordedEvent : _recordedInputEvents ) {
+        file.put32( recordedEvent.callId );
+        file.putRaw( reinterpret_cast<const char *>( &recordedEvent.event ), sizeof( SDL_Event ) );
+    }
+
+    if ( file.fail() ) {
+        ERROR_LOG( "Failed to write the input recording file " << _inputRecordingFilePath )
+        return;
+    }
+
+    VERBOSE_LOG( "Recorded " << _recordedInputEvents.size() << " input events to " << _inputRecordingFilePath )
+
+    _recordedInputEvents.clear();
+}
+
+void LocalEvent::replayInputEvents()
+{
+    logReplayFrameStatistics();
+
+    while ( _replayedInputEventCount < _recordedInputEvents.size() && _recordedInputEvents[_replayedInputEventCount].callId <= _eventProcessingCallId ) {
+        SDL_PushEvent( &_recordedInputEvents[_replayedInputEventCount].event );
+        ++_replayedInputEventCount;
+    }
+
+    if ( _replayedInputEventCount < _recordedInputEvents.size() ) {
+        return;
+    }
+
+    _inputRecordingMode = InputRecordingMode::NONE;
+    _recordedInputEvents.clear();
+
+    if ( _replayFrameCount == 0 ) {
+        VERBOSE_LOG( "Input replay is finished, no frames were rendered." )
+        return;
+    }
+
+    VERBOSE_LOG( "Input replay is finished, frames: " << _replayFrameCount << ", average redraw: " << _replayRedrawTime / _replayFrameCount
+                                                      << " us, average present: " << _replayPresentTime / _replayFrameCount << " us" )
+}
+
+void LocalEvent::logReplayFrameStatistics()
+{
+    const fheroes2::Display::FrameStatistics & frame = fheroes2::Display::instance().lastFrameStatistics();
+    if ( frame.frameId == _replayLastFrameId ) {
+        return;
+    }
+
+    _replayLastFrameId = frame.frameId;
+
+    ++_replayFrameCount;
+    _replayRedrawTime += frame.redrawTime;
+    _replayPresentTime += frame.presentTime;
+
+    VERBOSE_LOG( "Frame " << frame.frameId << ", call " << _eventProcessingCallId << ": redraw " << frame.redrawTime << " us, present " << frame.presentTime
+                          << " us, areas: " << frame.renderAreaCount << ", pixels: " << frame.renderPixelCount )
+}
+
 bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing, const bool allowExit /* = false */ )
 {
     // Event processing might be computationally heavy.
@@ -895,8 +1083,18 @@ bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing, const bool
     ResetModes( MOUSE_CLICKED );
     ResetModes( MOUSE_WHEEL );
 
+    ++_eventProcessingCallId;
+
+    if ( _inputRecordingMode == InputRecordingMode::REPLAY ) {
+        replayInputEvents();
+    }
+
 #if SDL_VERSION_ATLEAST( 2, 0, 0 )
     while ( SDL_PollEvent( &event ) ) {
+        if ( _inputRecordingMode == InputRecordingMode::RECORD && isRecordedInputEvent( event.type ) ) {
+            _recordedInputEvents.push_back( { _eventProcessingCallId, event } );
+        }
+
         switch ( event.type ) {
         case SDL_WINDOWEVENT:
             if ( event.window.event == SDL_WINDOWEVENT_CLOSE ) {
@@ -996,6 +1194,10 @@ bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing, const bool
     }
 #else
     while ( SDL_PollEvent( &event ) ) {
+        if ( _inputRecordingMode == InputRecordingMode::RECORD && isRecordedInputEvent( event.type ) ) {
+            _recordedInputEvents.push_back( { _eventProcessingCallId, event } );
+        }
+
         switch ( event.type ) {
         case SDL_ACTIVEEVENT:
             if ( HandleActiveEvent( event.active ) ) {
@@ -1038,26 +1240,62 @@ bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing, const bool
     }
 #endif
 
-    renderRoi = fheroes2::getBoundaryRect( renderRoi, _mouseCursorRenderArea );
+    // High polling rate mice and touch screens can generate hundreds of motion events per frame, so the cursor
+    // is moved only once to the latest pointer position after all events have been processed.
+    if ( _isMouseCursorMoved ) {
+        _isMouseCursorMoved = false;
+
+        if ( _globalMouseMotionEventHook ) {
+            _mouseCursorRenderArea = _globalMouseMotionEventHook( mouse_cu.x, mouse_cu.y );
+        }
+    }
+
+    // The mouse cursor area is kept separately from the rest of the changes, so a cursor far away from other changes doesn't make
+    // the whole screen to be rendered.
+    fheroes2::RenderRegion renderRegion( renderRoi );
+    renderRegion.add( _mouseCursorRenderArea );
+
+    display.addEventProcessingTime( eventProcessingTimer.getUs() );
 
     if ( sleepAfterEventProcessing ) {
-        if ( renderRoi != fheroes2::Rect() ) {
-            display.render( renderRoi );
+        if ( !renderRegion.empty() ) {
+            display.render( renderRegion );
         }
 
+        uint64_t waitTime = globalLoopSleepTime;
+
+#if SDL_VERSION_ATLEAST( 2, 0, 0 )
+        // Game controller axes are polled on every call so there is no waiting for events in this case.
+        if ( _gameController == nullptr ) {
+            waitTime = std::max<uint64_t>( waitTime, std::min( { _nextEventWaitTime, maxEventWaitTime, colorCycling.getTimeToRedraw() } ) );
+        }
+#endif
+
         // Make sure not to delay any further if the processing time within this function was more than the expected waiting time.
-        if ( eventProcessingTimer.getMs() < globalLoopSleepTime ) {
-            static_assert( globalLoopSleepTime == 1, "Make sure that you sleep for the difference between times since you change the sleep time." );
-            SDL_Delay( globalLoopSleepTime );
+        const uint64_t processingTime = eventProcessingTimer.getMs();
+        if ( processingTime < waitTime ) {
+            const fheroes2::Time idleTimer;
+
+#if SDL_VERSION_ATLEAST( 2, 0, 0 )
+            // Wake up as soon as a new event arrives. The event stays in the queue to be processed by the next call.
+            SDL_WaitEventTimeout( nullptr, static_cast<int>( waitTime - processingTime ) );
+#else
+            SDL_Delay( static_cast<uint32_t>( waitTime - processingTime ) );
+#endif
+
+            display.addIdleTime( idleTimer.getUs() );
         }
     }
     else {
         // Since rendering is going to be just after the call of this method we need to update rendering area only.
-        if ( renderRoi != fheroes2::Rect() ) {
-            display.updateNextRenderRoi( renderRoi );
+        for ( const fheroes2::Rect & roi : renderRegion.areas() ) {
+            display.updateNextRenderRoi( roi );
         }
     }
 
+    // The wait time is valid only for one call.
+    _nextEventWaitTime = 0;
+
     return true;
 }
 
@@ -1136,9 +1374,7 @@ void LocalEvent::HandleTouchEvent( const SDL_TouchFingerEvent & event )
 
         SetModes( MOUSE_MOTION );
 
-        if ( _globalMouseMotionEventHook ) {
-            _mouseCursorRenderArea = _globalMouseMotionEventHook( mouse_cu.x, mouse_cu.y );
-        }
+        _isMouseCursorMoved = true;
 
         // If there is a two-finger gesture in progress, the first finger is only used to move the cursor.
         // The operation of the left mouse button is not simulated.
@@ -1357,9 +1593,7 @@ void LocalEvent::ProcessControllerAxisMotion()
         mouse_cu.x = static_cast<int32_t>( _emulatedPointerPosX );
         mouse_cu.y = static_cast<int32_t>( _emulatedPointerPosY );
 
-        if ( _globalMouseMotionEventHook ) {
-            _mouseCursorRenderArea = _globalMouseMotionEventHook( mouse_cu.x, mouse_cu.y );
-        }
+        _isMouseCursorMoved = true;
     }
 
     // map scroll with right stick
@@ -1475,9 +1709,7 @@ void LocalEvent::HandleMouseMotionEvent( const SDL_MouseMotionEvent & motion )
     _emulatedPointerPosX = mouse_cu.x;
     _emulatedPointerPosY = mouse_cu.y;
 
-    if ( _globalMouseMotionEventHook ) {
-        _mouseCursorRenderArea = _globalMouseMotionEventHook( motion.x, motion.y );
-    }
+    _isMouseCursorMoved = true;
 }
 
 void LocalEvent::HandleMouseButtonEvent( const SDL_MouseButtonEvent & button )
@@ -30,6 +30,7 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <SDL_events.h>
 #include <SDL_version.h>
@@ -199,6 +200,13 @@ public:
 
     bool HandleEvents( const bool sleepAfterEventProcessing = true, const bool allowExit = false );
 
+    // Allow the next call of HandleEvents() to wait for new events up to the given time instead of the minimal sleep time.
+    // It is used when it is known that nothing has to be redrawn until this time.
+    void setNextEventWaitTime( const uint64_t waitMs )
+    {
+        _nextEventWaitTime = waitMs;
+    }
+
     bool MouseMotion() const
     {
         return ( modes & MOUSE_MOTION ) == MOUSE_MOTION;
@@ -303,6 +311,15 @@ public:
         }
     }
 
+    // Input recording and replay are used to make repeatable rendering benchmarks. During recording all input events are stored
+    // along with the number of the HandleEvents() call they were received in. During replay the recorded events are put back into
+    // the event queue by the same calls and the timings of every rendered frame are logged.
+    bool startInputRecording( const std::string & filePath );
+    bool startInputReplay( const std::string & filePath );
+
+    // Writes the recorded events to the file. Does nothing if the input is not being recorded.
+    void stopInputRecording();
+
 private:
     LocalEvent();
 
@@ -313,6 +330,9 @@ private:
     static void StopSounds();
     static void ResumeSounds();
 
+    void replayInputEvents();
+    void logReplayFrameStatistics();
+
 #if SDL_VERSION_ATLEAST( 2, 0, 0 )
     void HandleMouseWheelEvent( const SDL_MouseWheelEvent & );
     void HandleControllerAxisEvent( const SDL_ControllerAxisEvent & motion );
@@ -377,6 +397,35 @@ private:
 
     fheroes2::Rect _mouseCursorRenderArea;
 
+    // The pointer position has changed during the current event processing and the cursor has to be moved
+    bool _isMouseCursorMoved = false;
+
+    uint64_t _nextEventWaitTime = 0;
+
+    enum class InputRecordingMode
+    {
+        NONE,
+        RECORD,
+        REPLAY
+    };
+
+    struct RecordedInputEvent
+    {
+        uint32_t callId;
+        SDL_Event event;
+    };
+
+    InputRecordingMode _inputRecordingMode = InputRecordingMode::NONE;
+    std::string _inputRecordingFilePath;
+    std::vector<RecordedInputEvent> _recordedInputEvents;
+    size_t _replayedInputEventCount = 0;
+    uint32_t _eventProcessingCallId = 0;
+
+    uint64_t _replayLastFrameId = 0;
+    uint64_t _replayFrameCount = 0;
+    uint64_t _replayRedrawTime = 0;
+    uint64_t _replayPresentTime = 0;
+
     // used to convert user-friendly pointer speed values into more usable ones
     const double CONTROLLER_SPEED_MOD = 2000000.0;
     double _controllerPointerSpeed = 10.0 / CONTROLLER_SPEED_MOD;
@@ -20,7 +20,11 @@
 
 #include <array>
 #include <cassert>
+#include <csignal>
+#include <cstddef>
 #include <ctime>
+#include <utility>
+#include <vector>
 
 #if defined( _WIN32 )
 #define WIN32_LEAN_AND_MEAN
@@ -33,12 +37,195 @@
 
 #include "logging.h"
 #include "system.h"
+#include "thread.h"
 
 namespace
 {
     int debugLevel = DBG_ALL_WARN;
     bool textSupportMode = false;
 
+    void writeMessages( const std::vector<std::string> & messages, const size_t droppedMessages )
+    {
+        if ( messages.empty() && droppedMessages == 0 ) {
+            return;
+        }
+
+#if defined( TARGET_NINTENDO_SWITCH ) || defined( _WIN32 )
+        const std::scoped_lock<std::mutex> lock( Logging::logMutex );
+
+        for ( const std::string & message : messages ) {
+            Logging::logFile << message << '\n';
+#if defined( _WIN32 ) && defined( WITH_DEBUG )
+            std::cerr << message << '\n';
+#endif
+        }
+
+        if ( droppedMessages > 0 ) {
+            Logging::logFile << droppedMessages << " debug messages were dropped because of too frequent logging" << '\n';
+        }
+
+        Logging::logFile.flush();
+#else
+        for ( const std::string & message : messages ) {
+            std::cerr << message << '\n';
+        }
+
+        if ( droppedMessages > 0 ) {
+            std::cerr << droppedMessages << " debug messages were dropped because of too frequent logging" << '\n';
+        }
+
+        std::cerr.flush();
+#endif
+    }
+
+    class DebugMessageWriter final : public MultiThreading::AsyncManager
+    {
+    public:
+        void start()
+        {
+            createWorker();
+
+            std::scoped_lock<std::mutex> lock( _mutex );
+
+            _isRunning = true;
+        }
+
+        void stop()
+        {
+            {
+                std::scoped_lock<std::mutex> lock( _mutex );
+
+                _isRunning = false;
+            }
+
+            stopWorker();
+
+            flush();
+        }
+
+        void push( std::string message, const bool writeImmediately )
+        {
+            {
+                std::scoped_lock<std::mutex> lock( _mutex );
+
+                if ( _isRunning && !writeImmediately ) {
+                    if ( _messages.size() < maxPendingMessages ) {
+                        _messages.emplace_back( std::move( message ) );
+                    }
+                    else {
+                        ++_droppedMessages;
+                    }
+
+                    notifyWorker();
+                    return;
+                }
+            }
+
+            // There is no background thread or the message must not wait for it, write the message right away after all pending messages
+            const std::scoped_lock<std::mutex> outputLock( _outputMutex );
+
+            writePendingMessages();
+
+            writeMessages( { std::move( message ) }, 0 );
+        }
+
+        void flush()
+        {
+            const std::scoped_lock<std::mutex> outputLock( _outputMutex );
+
+            writePendingMessages();
+        }
+
+        // This method is called by the fatal signal handler. The crashed thread may already hold one of the mutexes, so the messages
+        // are written only if both mutexes can be acquired without waiting.
+        void flushOnCrash()
+        {
+            std::unique_lock<std::mutex> outputLock( _outputMutex, std::try_to_lock );
+            if ( !outputLock.owns_lock() ) {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock( _mutex, std::try_to_lock );
+            if ( !lock.owns_lock() ) {
+                return;
+            }
+
+            writeMessages( _messages, _droppedMessages );
+
+            _messages.clear();
+            _droppedMessages = 0;
+        }
+
+    private:
+        // The number of pending messages after which new messages are dropped to not consume all memory in case of very verbose logging
+        static constexpr size_t maxPendingMessages = 16384;
+
+        // This mutex protects the actual output and guarantees that messages are written in the order they were queued
+        std::mutex _outputMutex;
+
+        std::vector<std::string> _messages;
+        std::vector<std::string> _messagesToWrite;
+        size_t _droppedMessages{ 0 };
+        bool _isRunning{ false };
+
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            // Messages will be taken in executeTask() while holding _outputMutex
+            return false;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            flush();
+        }
+
+        // This method should be called only while holding _outputMutex
+        void writePendingMessages()
+        {
+            size_t droppedMessages = 0;
+
+            {
+                std::scoped_lock<std::mutex> lock( _mutex );
+
+                std::swap( _messages, _messagesToWrite );
+                std::swap( droppedMessages, _droppedMessages );
+            }
+
+            writeMessages( _messagesToWrite, droppedMessages );
+
+            _messagesToWrite.clear();
+        }
+    };
+
+    DebugMessageWriter & getDebugMessageWriter()
+    {
+        // This object is never destroyed because messages can be written during the destruction of other static objects
+        static DebugMessageWriter * writer = new DebugMessageWriter();
+        return *writer;
+    }
+
+    // Assertion failures raise SIGABRT, so they are handled here as well.
+    const std::array<int, 4> fatalSignals{ SIGABRT, SIGFPE, SIGILL, SIGSEGV };
+
+    extern "C" void fatalSignalHandler( int signalNumber )
+    {
+        // Writing to a stream is not async-signal-safe but the application is about to terminate anyway. The debug messages written
+        // just before a crash are usually the most valuable ones.
+        getDebugMessageWriter().flushOnCrash();
+
+        std::signal( signalNumber, SIG_DFL );
+        std::raise( signalNumber );
+    }
+
+    void setFatalSignalHandler( void ( *handler )( int ) )
+    {
+        for ( const int signalNumber : fatalSignals ) {
+            std::signal( signalNumber, handler );
+        }
+    }
+
 #if defined( _WIN32 )
     // Sets the Windows console codepage to the system codepage
     class ConsoleCPSwitcher
@@ -101,7 +288,16 @@ namespace Logging
 
     std::string GetTimeString()
     {
-        const tm tmi = System::GetTM( std::time( nullptr ) );
+        // Many messages are usually written within the same second so the formatted time is reused
+        thread_local std::time_t cachedTime = 0;
+        thread_local std::string cachedTimeString;
+
+        const std::time_t currentTime = std::time( nullptr );
+        if ( currentTime == cachedTime && !cachedTimeString.empty() ) {
+            return cachedTimeString;
+        }
+
+        const tm tmi = System::GetTM( currentTime );
 
         std::array<char, 256> buf;
 
@@ -111,7 +307,10 @@ namespace Logging
             return "<TIMESTAMP ERROR>";
         }
 
-        return std::string( buf.data() );
+        cachedTime = currentTime;
+        cachedTimeString.assign( buf.data() );
+
+        return cachedTimeString;
     }
 
     void InitLog()
@@ -131,6 +330,33 @@ namespace Logging
         openlog( "fheroes2", LOG_CONS | LOG_NDELAY, LOG_USER );
         setlogmask( LOG_UPTO( LOG_WARNING ) );
 #endif
+
+#if !defined( TARGET_PS_VITA ) && !defined( MACOS_APP_BUNDLE ) && !defined( ANDROID )
+        getDebugMessageWriter().start();
+
+        setFatalSignalHandler( fatalSignalHandler );
+#endif
+    }
+
+    void FinalizeLog()
+    {
+#if !defined( TARGET_PS_VITA ) && !defined( MACOS_APP_BUNDLE ) && !defined( ANDROID )
+        setFatalSignalHandler( SIG_DFL );
+
+        getDebugMessageWriter().stop();
+#endif
+    }
+
+    void writeDebugMessage( std::string message, const bool writeImmediately )
+    {
+        getDebugMessageWriter().push( std::move( message ), writeImmediately );
+    }
+
+    void flushDebugMessages()
+    {
+#if !defined( TARGET_PS_VITA ) && !defined( MACOS_APP_BUNDLE ) && !defined( ANDROID )
+        getDebugMessageWriter().flush();
+#endif
     }
 
     void setDebugLevel( const int level )
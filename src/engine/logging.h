@@ -86,8 +86,39 @@ namespace Logging
     std::string GetTimeString();
 
     // Initialize logging. Some systems require writing logging information into a file.
+    // Debug messages are written by a background thread after this call until FinalizeLog() is called. The pending messages are also
+    // written when the application crashes due to a fatal signal or an assertion failure.
     void InitLog();
 
+    // Write all pending debug messages and stop the background thread. Messages are written synchronously after this call.
+    void FinalizeLog();
+
+    // Queue a debug message to be written by the background thread. If the thread is not running or 'writeImmediately' is true
+    // the message is written by the calling thread together with all pending messages before returning.
+    // If too many messages are pending, the new ones are dropped and only their number is reported later. Immediate messages are never dropped.
+    void writeDebugMessage( std::string message, const bool writeImmediately );
+
+    // Write all pending debug messages. This is done before writing any message synchronously to keep the order of messages.
+    void flushDebugMessages();
+
+    class LogInitializer
+    {
+    public:
+        LogInitializer()
+        {
+            InitLog();
+        }
+
+        LogInitializer( const LogInitializer & ) = delete;
+
+        ~LogInitializer()
+        {
+            FinalizeLog();
+        }
+
+        LogInitializer & operator=( const LogInitializer & ) = delete;
+    };
+
     void setDebugLevel( const int level );
     int getDebugLevel();
 
@@ -143,20 +174,36 @@ namespace Logging
     }
 #endif
 
+// Debug messages are formatted by the calling thread but written by a background thread on the platforms which write them into
+// STDERR or a file, so that tracing in the AI and battle code does not wait for slow console or file output. Warnings are written
+// synchronously as they usually precede a failure and must not be lost if the application crashes right after them.
+#if defined( TARGET_PS_VITA ) || defined( MACOS_APP_BUNDLE ) || defined( ANDROID )
+#define DEBUG_COUT( x, writeImmediately ) COUT( x )
+#else
+#define DEBUG_COUT( x, writeImmediately )                                                                                                                                \
+    {                                                                                                                                                                    \
+        std::ostringstream _debug_message; /* The name was chosen on purpose to avoid name collisions with outer code blocks. */                                         \
+        _debug_message << x;                                                                                                                                             \
+        Logging::writeDebugMessage( _debug_message.str(), writeImmediately );                                                                                            \
+    }
+#endif
+
 #define VERBOSE_LOG( x )                                                                                                                                                 \
     {                                                                                                                                                                    \
+        Logging::flushDebugMessages();                                                                                                                                   \
         COUT( Logging::GetTimeString() << ": [VERBOSE]\t" << __FUNCTION__ << ":  " << x );                                                                               \
     }
 
 #define ERROR_LOG( x )                                                                                                                                                   \
     {                                                                                                                                                                    \
+        Logging::flushDebugMessages();                                                                                                                                   \
         COUT( Logging::GetTimeString() << ": [ERROR]\t" << __FUNCTION__ << ":  " << x );                                                                                 \
     }
 
 #ifdef WITH_DEBUG
 #define DEBUG_LOG( x, y, z )                                                                                                                                             \
     if ( IS_DEBUG( x, y ) ) {                                                                                                                                            \
-        COUT( Logging::GetTimeString() << ": [" << Logging::GetDebugOptionName( x ) << "]\t" << __FUNCTION__ << ":  " << z );                                            \
+        DEBUG_COUT( Logging::GetTimeString() << ": [" << Logging::GetDebugOptionName( x ) << "]\t" << __FUNCTION__ << ":  " << z, ( y ) == DBG_WARN );                   \
     }
 #else
 #define DEBUG_LOG( x, y, z )
@@ -20,6 +20,7 @@
 
 #include "pal.h"
 
+#include <array>
 #include <cassert>
 #include <cstring>
 
@@ -27,6 +28,8 @@ namespace
 {
     const size_t paletteSize = 256;
 
+    const uint32_t cyclingPaletteCount = 20;
+
     const std::vector<uint8_t> yellowTextTable
         = { 0,   0,   0,   0,   0,   0, 0, 0, 0, 0, 114, 115, 115, 116, 117, 117, 118, 119, 119, 120, 121, 121, 122, 123, 123, 124, 125, 125, 126, 127, 127, 128,
             129, 129, 130, 130, 130, 0, 0, 0, 0, 0, 0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
@@ -145,28 +148,40 @@ namespace
     };
 }
 
-std::vector<uint8_t> PAL::GetCyclingPalette( const uint32_t stepId )
+const std::vector<uint8_t> & PAL::GetCyclingPalette( const uint32_t stepId )
 {
-    std::vector<uint8_t> palette = PAL::GetPalette( PaletteType::STANDARD );
+    // Color sets have lengths of 4 and 5 so all cycling palettes repeat every 20 steps. They are generated only once.
+    static const std::array<std::vector<uint8_t>, cyclingPaletteCount> cyclingPalettes = []() {
+        static const std::vector<CyclingColorSet> cycleSet = { { 214, 4, false }, { 218, 4, false }, { 231, 5, true }, { 238, 4, false } };
 
-    static const std::vector<CyclingColorSet> cycleSet = { { 214, 4, false }, { 218, 4, false }, { 231, 5, true }, { 238, 4, false } };
+        std::array<std::vector<uint8_t>, cyclingPaletteCount> palettes;
 
-    for ( const CyclingColorSet & colorSet : cycleSet ) {
-        for ( uint32_t id = 0; id < colorSet.length; ++id ) {
-            uint32_t newColorID;
-            if ( colorSet.forward ) {
-                newColorID = colorSet.start + ( ( id + stepId ) % colorSet.length );
-            }
-            else {
-                const uint32_t lastColorID = colorSet.length - 1;
-                newColorID = colorSet.start + lastColorID - ( ( lastColorID + stepId - id ) % colorSet.length );
-            }
+        for ( uint32_t step = 0; step < cyclingPaletteCount; ++step ) {
+            std::vector<uint8_t> & palette = palettes[step];
+            palette = PAL::GetPalette( PaletteType::STANDARD );
+
+            for ( const CyclingColorSet & colorSet : cycleSet ) {
+                assert( cyclingPaletteCount % colorSet.length == 0 );
 
-            palette[colorSet.start + id] = static_cast<uint8_t>( newColorID );
+                for ( uint32_t id = 0; id < colorSet.length; ++id ) {
+                    uint32_t newColorID;
+                    if ( colorSet.forward ) {
+                        newColorID = colorSet.start + ( ( id + step ) % colorSet.length );
+                    }
+                    else {
+                        const uint32_t lastColorID = colorSet.length - 1;
+                        newColorID = colorSet.start + lastColorID - ( ( lastColorID + step - id ) % colorSet.length );
+                    }
+
+                    palette[colorSet.start + id] = static_cast<uint8_t>( newColorID );
+                }
+            }
         }
-    }
 
-    return palette;
+        return palettes;
+    }();
+
+    return cyclingPalettes[stepId % cyclingPaletteCount];
 }
 
 const std::vector<uint8_t> & PAL::GetPalette( const PaletteType type )
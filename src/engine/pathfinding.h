@@ -20,12 +20,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
-// Base representation of the dataset that mirrors the 2D map being traversed
+// Base representation of the dataset that mirrors the 2D map being traversed. This structure is intentionally non-polymorphic
+// to keep the pathfinder cache compact: derived structures should hide resetNode() with their own implementation, since
+// Pathfinder always works with the exact type of its nodes.
 template <class T>
 struct PathfindingNode
 {
@@ -39,9 +44,9 @@ struct PathfindingNode
         , _cost( cost )
         , _objectID( object )
     {}
-    virtual ~PathfindingNode() = default;
+
     // Sets node values back to the defaults; used before processing new path
-    virtual void resetNode()
+    void resetNode()
     {
         _from = -1;
         _cost = 0;
@@ -49,6 +54,107 @@ struct PathfindingNode
     }
 };
 
+// Monotone priority queue (radix heap) of node indexes keyed on the path cost. It is suitable for Dijkstra-like searches
+// with non-negative movement penalties where the key of each new node is never less than the key of the last extracted node.
+// Obsolete entries are not removed from the queue, they should be skipped by the caller when extracted.
+class PathfindingQueue
+{
+public:
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    void clear()
+    {
+        for ( std::vector<std::pair<uint32_t, int>> & bucket : _buckets ) {
+            bucket.clear();
+        }
+
+        _lastKey = 0;
+        _size = 0;
+    }
+
+    void push( const uint32_t key, const int node )
+    {
+        assert( key >= _lastKey );
+
+        _buckets[getBucketId( key )].emplace_back( key, node );
+        ++_size;
+    }
+
+    // Extracts the node with the lowest key, returns the key along with the node index
+    std::pair<uint32_t, int> pop()
+    {
+        assert( !empty() );
+
+        if ( _buckets[0].empty() ) {
+            size_t bucketId = 1;
+            while ( _buckets[bucketId].empty() ) {
+                ++bucketId;
+                assert( bucketId < _buckets.size() );
+            }
+
+            std::vector<std::pair<uint32_t, int>> & bucket = _buckets[bucketId];
+
+            _lastKey = bucket.front().first;
+            for ( const std::pair<uint32_t, int> & item : bucket ) {
+                if ( item.first < _lastKey ) {
+                    _lastKey = item.first;
+                }
+            }
+
+            // All the items of this bucket are guaranteed to be moved to the buckets with lower ids
+            for ( const std::pair<uint32_t, int> & item : bucket ) {
+                _buckets[getBucketId( item.first )].push_back( item );
+            }
+
+            bucket.clear();
+        }
+
+        const std::pair<uint32_t, int> result = _buckets[0].back();
+        _buckets[0].pop_back();
+        --_size;
+
+        return result;
+    }
+
+private:
+    // Each key is placed to the bucket whose id is the position of the most significant bit where the key differs from the last extracted key
+    size_t getBucketId( uint32_t key ) const
+    {
+        key ^= _lastKey;
+
+        size_t bucketId = 0;
+        while ( key != 0 ) {
+            key >>= 1;
+            ++bucketId;
+        }
+
+        return bucketId;
+    }
+
+    std::array<std::vector<std::pair<uint32_t, int>>, 33> _buckets;
+    uint32_t _lastKey = 0;
+    size_t _size = 0;
+};
+
+// Storage of the pathfinding nodes along with the information required to reset them lazily
+template <class T>
+struct PathfindingCache
+{
+    std::vector<T> nodes;
+
+    // Generation of each node: the node is considered to be in its default state if its generation differs from the current one
+    std::vector<uint32_t> generations;
+    uint32_t currentGeneration = 0;
+
+    size_t getMemoryUsage() const
+    {
+        return nodes.capacity() * sizeof( T ) + generations.capacity() * sizeof( uint32_t );
+    }
+};
+
 // Template class has to be either PathfindingNode or its derivative
 template <class T>
 class Pathfinder
@@ -60,19 +166,95 @@ public:
 
     virtual uint32_t getDistance( int targetIndex ) const
     {
-        assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
-
-        return _cache[targetIndex]._cost;
+        return getCachedNode( targetIndex )._cost;
     }
 
     virtual const T & getNode( int targetIndex ) const
     {
-        assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
+        return getCachedNode( targetIndex );
+    }
 
-        return _cache[targetIndex];
+    // Returns the estimated memory in bytes occupied by the cached pathfinding results.
+    virtual size_t getMemoryUsage() const
+    {
+        return _cache.getMemoryUsage();
     }
 
 protected:
-    std::vector<T> _cache;
+    // Resizes the cache, all nodes are set to their default state
+    void resizeCache( const size_t size )
+    {
+        _cache.nodes.clear();
+        _cache.nodes.resize( size );
+
+        _cache.generations.clear();
+        _cache.generations.resize( size, 0 );
+
+        _cache.currentGeneration = 0;
+    }
+
+    // Resets all nodes of the cache to their default state. Nodes are not modified immediately, instead each node is reset on
+    // its first access after this call.
+    void invalidateCache()
+    {
+        ++_cache.currentGeneration;
+
+        // Generation counter has overflowed, make sure that no node is considered up-to-date by mistake
+        if ( _cache.currentGeneration == 0 ) {
+            std::fill( _cache.generations.begin(), _cache.generations.end(), 0 );
+
+            _cache.currentGeneration = 1;
+        }
+    }
+
+    // Exchanges the contents of the cache with the contents of the given storage, so that the results of different evaluations
+    // can be kept without copying
+    void swapCache( PathfindingCache<T> & other ) noexcept
+    {
+        std::swap( _cache.nodes, other.nodes );
+        std::swap( _cache.generations, other.generations );
+        std::swap( _cache.currentGeneration, other.currentGeneration );
+    }
+
+    // Returns the node of the cache, resetting it first if it was not accessed since the last cache invalidation
+    T & getCachedNode( const int nodeIndex )
+    {
+        assert( nodeIndex >= 0 && static_cast<size_t>( nodeIndex ) < _cache.nodes.size() );
+
+        T & node = _cache.nodes[nodeIndex];
+        uint32_t & generation = _cache.generations[nodeIndex];
+
+        if ( generation != _cache.currentGeneration ) {
+            node.resetNode();
+
+            generation = _cache.currentGeneration;
+        }
+
+        return node;
+    }
+
+    // Returns the node of the cache, or the node in its default state if the requested node was not accessed since the last
+    // cache invalidation
+    const T & getCachedNode( const int nodeIndex ) const
+    {
+        assert( nodeIndex >= 0 && static_cast<size_t>( nodeIndex ) < _cache.nodes.size() );
+
+        if ( _cache.generations[nodeIndex] != _cache.currentGeneration ) {
+            static const T defaultNode;
+
+            return defaultNode;
+        }
+
+        return _cache.nodes[nodeIndex];
+    }
+
+    size_t getCacheSize() const
+    {
+        return _cache.nodes.size();
+    }
+
     int _pathStart = -1;
+
+private:
+    PathfindingCache<T> _cache;
 };
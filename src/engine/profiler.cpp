@@ -0,0 +1,227 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2023                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "profiler.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "logging.h"
+
+namespace
+{
+    struct ZoneInfo
+    {
+        const char * name;
+        int64_t startUs;
+        int64_t durationUs;
+        uint32_t threadId;
+        Profiler::AllocationStatistics allocations;
+    };
+
+    // This variable has constant initialization so it can be safely used by operator new of any thread at any time.
+    thread_local Profiler::AllocationStatistics threadAllocations;
+
+    Profiler::AllocationStatistics getAllocationsSince( const Profiler::AllocationStatistics & start )
+    {
+        return { threadAllocations.count - start.count, threadAllocations.bytes - start.bytes };
+    }
+
+    std::atomic<bool> isSessionActive{ false };
+    std::chrono::steady_clock::time_point sessionStartTime;
+
+    // The zones are kept in a ring buffer so a long session keeps the most recent zones and does not consume all the memory.
+    const size_t maxZoneCount = 1 << 18;
+
+    std::mutex zoneMutex;
+    std::vector<ZoneInfo> zones;
+    size_t nextZoneIndex{ 0 };
+    uint64_t overwrittenZoneCount{ 0 };
+
+    uint32_t getCurrentThreadId()
+    {
+        static std::atomic<uint32_t> nextThreadId{ 0 };
+        thread_local const uint32_t threadId = nextThreadId++;
+
+        return threadId;
+    }
+
+    int64_t getMicroseconds( const std::chrono::steady_clock::duration duration )
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>( duration ).count();
+    }
+
+    void writeEscapedString( std::ofstream & stream, const char * str )
+    {
+        for ( ; *str != '\0'; ++str ) {
+            if ( *str == '"' || *str == '\\' ) {
+                stream << '\\';
+            }
+
+            stream << *str;
+        }
+    }
+}
+
+namespace Profiler
+{
+    Session::Session( std::string filePath )
+        : _filePath( std::move( filePath ) )
+    {
+        assert( !isSessionActive );
+
+        {
+            const std::scoped_lock<std::mutex> lock( zoneMutex );
+
+            zones.clear();
+            nextZoneIndex = 0;
+            overwrittenZoneCount = 0;
+            sessionStartTime = std::chrono::steady_clock::now();
+        }
+
+        isSessionActive = true;
+    }
+
+    Session::~Session()
+    {
+        isSessionActive = false;
+
+        const std::scoped_lock<std::mutex> lock( zoneMutex );
+
+        std::ofstream stream( _filePath, std::ios::out | std::ios::trunc );
+        if ( !stream ) {
+            ERROR_LOG( "Unable to write the profiler trace to " << _filePath )
+            return;
+        }
+
+        stream << "{\"traceEvents\":[";
+
+        // Once the buffer is full the oldest zone is the next one to be overwritten.
+        for ( size_t i = 0; i < zones.size(); ++i ) {
+            const ZoneInfo & zone = zones[( nextZoneIndex + i ) % zones.size()];
+
+            if ( i > 0 ) {
+                stream << ',';
+            }
+
+            stream << "\n{\"name\":\"";
+            writeEscapedString( stream, zone.name );
+            stream << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.threadId << ",\"ts\":" << zone.startUs << ",\"dur\":" << zone.durationUs;
+#if defined( WITH_ALLOCATION_TRACKER )
+            stream << ",\"args\":{\"allocations\":" << zone.allocations.count << ",\"allocated bytes\":" << zone.allocations.bytes << '}';
+#endif
+            stream << '}';
+        }
+
+        stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        if ( overwrittenZoneCount > 0 ) {
+            VERBOSE_LOG( "The profiler trace contains only the last " << zones.size() << " zones, " << overwrittenZoneCount << " older zones were discarded" )
+        }
+
+        zones.clear();
+        zones.shrink_to_fit();
+        nextZoneIndex = 0;
+    }
+
+    Zone::Zone( const char * name )
+        : _name( isSessionActive ? name : nullptr )
+    {
+        if ( _name != nullptr ) {
+            _startTime = std::chrono::steady_clock::now();
+            _startAllocations = threadAllocations;
+        }
+    }
+
+    Zone::~Zone()
+    {
+        if ( _name == nullptr || !isSessionActive ) {
+            return;
+        }
+
+        const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+        const uint32_t threadId = getCurrentThreadId();
+        const AllocationStatistics allocations = getAllocationsSince( _startAllocations );
+
+        const std::scoped_lock<std::mutex> lock( zoneMutex );
+
+        const ZoneInfo zone{ _name, getMicroseconds( _startTime - sessionStartTime ), getMicroseconds( endTime - _startTime ), threadId, allocations };
+
+        if ( zones.size() < maxZoneCount ) {
+            zones.push_back( zone );
+            return;
+        }
+
+        zones[nextZoneIndex] = zone;
+        nextZoneIndex = ( nextZoneIndex + 1 ) % maxZoneCount;
+        ++overwrittenZoneCount;
+    }
+
+    AllocationLog::AllocationLog( const char * name )
+        : _name( name )
+        , _startAllocations( threadAllocations )
+    {}
+
+    AllocationLog::~AllocationLog()
+    {
+        const AllocationStatistics allocations = getAllocationsSince( _startAllocations );
+
+        COUT( _name << ": " << allocations.count << " heap allocations, " << allocations.bytes << " bytes" )
+    }
+
+    AllocationStatistics getThreadAllocationStatistics()
+    {
+        return threadAllocations;
+    }
+}
+
+#if defined( WITH_ALLOCATION_TRACKER )
+// The replaceable global allocation functions. Array and non-throwing forms call these ones by default.
+void * operator new( std::size_t size )
+{
+    ++threadAllocations.count;
+    threadAllocations.bytes += size;
+
+    void * ptr = std::malloc( size == 0 ? 1 : size );
+    if ( ptr == nullptr ) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t /* size */ ) noexcept
+{
+    std::free( ptr );
+}
+#endif
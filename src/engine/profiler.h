@@ -0,0 +1,107 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2023                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// The profiler collects the time spent in named zones and writes it in the Chrome trace event format which can be opened by
+// chrome://tracing, Perfetto or Tracy (via its import-chrome tool). Zones are compiled in only if WITH_PROFILER is defined,
+// otherwise PROFILE_ZONE() expands to nothing.
+//
+// If WITH_ALLOCATION_TRACKER is defined the global operator new and delete are replaced to count heap allocations of every thread.
+// The count and the size of allocations made within a zone are added to the trace, PROFILE_ALLOCATIONS() writes them to the log.
+namespace Profiler
+{
+    struct AllocationStatistics
+    {
+        uint64_t count{ 0 };
+        uint64_t bytes{ 0 };
+    };
+
+    // Returns the allocations made by the current thread since its start. Always zero if allocation tracking is disabled.
+    AllocationStatistics getThreadAllocationStatistics();
+
+    // Collects the zones during its lifetime and writes them to the given file when destroyed. Only one session may exist at a time.
+    // The number of stored zones is limited: once the limit is reached the oldest zones are overwritten by the new ones.
+    class Session
+    {
+    public:
+        explicit Session( std::string filePath );
+        Session( const Session & ) = delete;
+
+        ~Session();
+
+        Session & operator=( const Session & ) = delete;
+
+    private:
+        std::string _filePath;
+    };
+
+    // Measures the time between its creation and destruction. The name must be a string literal.
+    class Zone
+    {
+    public:
+        explicit Zone( const char * name );
+        Zone( const Zone & ) = delete;
+
+        ~Zone();
+
+        Zone & operator=( const Zone & ) = delete;
+
+    private:
+        const char * _name;
+        std::chrono::steady_clock::time_point _startTime;
+        AllocationStatistics _startAllocations;
+    };
+
+    // Writes the count and the size of allocations made by the current thread during its lifetime to the log. The name must be a string literal.
+    class AllocationLog
+    {
+    public:
+        explicit AllocationLog( const char * name );
+        AllocationLog( const AllocationLog & ) = delete;
+
+        ~AllocationLog();
+
+        AllocationLog & operator=( const AllocationLog & ) = delete;
+
+    private:
+        const char * _name;
+        AllocationStatistics _startAllocations;
+    };
+}
+
+#define PROFILE_ZONE_CONCAT_IMPL( x, y ) x##y
+#define PROFILE_ZONE_CONCAT( x, y ) PROFILE_ZONE_CONCAT_IMPL( x, y )
+
+#if defined( WITH_PROFILER )
+#define PROFILE_ZONE( name ) const Profiler::Zone PROFILE_ZONE_CONCAT( profilerZone, __LINE__ )( name )
+#else
+#define PROFILE_ZONE( name )
+#endif
+
+#if defined( WITH_ALLOCATION_TRACKER )
+#define PROFILE_ALLOCATIONS( name ) const Profiler::AllocationLog PROFILE_ZONE_CONCAT( allocationLog, __LINE__ )( name )
+#else
+#define PROFILE_ALLOCATIONS( name )
+#endif
@@ -26,6 +26,20 @@
 #include "logging.h"
 #include "rand.h"
 
+namespace
+{
+    bool useLegacySeededGenerator = false;
+
+    uint64_t getSplitMix64Hash( const uint64_t seed )
+    {
+        uint64_t value = seed + 0x9E3779B97F4A7C15;
+        value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9;
+        value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EB;
+
+        return value ^ ( value >> 31 );
+    }
+}
+
 std::mt19937 & Rand::CurrentThreadRandomDevice()
 {
     thread_local std::random_device rd;
@@ -49,10 +63,28 @@ uint32_t Rand::GetWithSeed( uint32_t from, uint32_t to, uint32_t seed )
     if ( from > to )
         std::swap( from, to );
 
-    std::uniform_int_distribution<uint32_t> distrib( from, to );
-    std::mt19937 seededGen( seed );
+    if ( useLegacySeededGenerator ) {
+        std::uniform_int_distribution<uint32_t> distrib( from, to );
+        std::mt19937 seededGen( seed );
+
+        return distrib( seededGen );
+    }
+
+    // Map the upper 32 bits of the hash to the range by multiplication instead of a division.
+    const uint64_t range = static_cast<uint64_t>( to ) - from + 1;
+    const uint64_t value = getSplitMix64Hash( seed ) >> 32;
+
+    return from + static_cast<uint32_t>( ( value * range ) >> 32 );
+}
 
-    return distrib( seededGen );
+void Rand::setLegacySeededGenerator( const bool enable )
+{
+    useLegacySeededGenerator = enable;
+}
+
+bool Rand::isLegacySeededGenerator()
+{
+    return useLegacySeededGenerator;
 }
 
 uint32_t Rand::GetWithGen( uint32_t from, uint32_t to, std::mt19937 & gen )
@@ -40,8 +40,14 @@ namespace Rand
 
     uint32_t Get( uint32_t from, uint32_t to = 0 );
 
+    // Returns a number in the [from, to] range which depends only on the seed. The number is produced by a SplitMix64 hash of the seed
+    // which is much cheaper than seeding a new std::mt19937 for every call.
     uint32_t GetWithSeed( uint32_t from, uint32_t to, uint32_t seed );
 
+    // Games saved by older versions used a std::mt19937 seeded for every number. This mode is kept to continue such games identically.
+    void setLegacySeededGenerator( const bool enable );
+    bool isLegacySeededGenerator();
+
     template <typename T, typename std::enable_if<std::is_enum<T>::value>::type * = nullptr>
     T GetWithSeed( const T from, const T to, const uint32_t seed )
     {
@@ -131,9 +137,10 @@ namespace Rand
         template <typename T>
         const T & Get( const std::vector<T> & vec ) const
         {
+            assert( !vec.empty() );
+
             ++_currentSeed;
-            std::mt19937 seededGen( _currentSeed );
-            return Rand::GetWithGen( vec, seededGen );
+            return vec[Rand::GetWithSeed( 0, static_cast<uint32_t>( vec.size() - 1 ), _currentSeed )];
         }
 
         template <class T>
@@ -19,14 +19,17 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
 #include <ostream>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include <SDL_error.h>
 #include <SDL_stdinc.h>
@@ -51,7 +54,9 @@
 
 #include "image_palette.h"
 #include "logging.h"
+#include "profiler.h"
 #include "screen.h"
+#include "thread.h"
 #include "tools.h"
 
 namespace
@@ -95,6 +100,46 @@ namespace
         return resolutions[id];
     }
 
+    // Images with more pixels than this are converted into 32-bit format in several row bands on worker threads
+    const int32_t parallelPaletteConversionMinPixels = 512 * 512;
+    const int32_t paletteConversionBandHeight = 64;
+
+    void convertPaletteRows( uint32_t * out, const uint8_t * in, const int32_t width, const int32_t height, const int32_t stride, const uint32_t * transform )
+    {
+        for ( int32_t y = 0; y < height; ++y, out += stride, in += stride ) {
+            int32_t x = 0;
+
+            // Independent lookups let the CPU process several pixels at once
+            for ( ; x + 4 <= width; x += 4 ) {
+                out[x] = transform[in[x]];
+                out[x + 1] = transform[in[x + 1]];
+                out[x + 2] = transform[in[x + 2]];
+                out[x + 3] = transform[in[x + 3]];
+            }
+
+            for ( ; x < width; ++x ) {
+                out[x] = transform[in[x]];
+            }
+        }
+    }
+
+    void convertPaletteImage( uint32_t * out, const uint8_t * in, const int32_t width, const int32_t height, const int32_t stride, const uint32_t * transform )
+    {
+        if ( width * height < parallelPaletteConversionMinPixels ) {
+            convertPaletteRows( out, in, width, height, stride, transform );
+            return;
+        }
+
+        const int32_t bandCount = ( height + paletteConversionBandHeight - 1 ) / paletteConversionBandHeight;
+
+        MultiThreading::getThreadPool().parallelFor( 0, static_cast<size_t>( bandCount ), [out, in, width, height, stride, transform]( const size_t band ) {
+            const int32_t offsetY = static_cast<int32_t>( band ) * paletteConversionBandHeight;
+            const int32_t bandHeight = std::min( paletteConversionBandHeight, height - offsetY );
+
+            convertPaletteRows( out + offsetY * stride, in + offsetY * stride, width, bandHeight, stride, transform );
+        } );
+    }
+
     bool IsLowerThanDefaultRes( const fheroes2::ResolutionInfo & value )
     {
         return value.gameWidth < fheroes2::Display::DEFAULT_WIDTH || value.gameHeight < fheroes2::Display::DEFAULT_HEIGHT;
@@ -278,13 +323,7 @@ namespace
 
             if ( fullFrame ) {
                 if ( surface->format->BitsPerPixel == 32 ) {
-                    uint32_t * out = static_cast<uint32_t *>( surface->pixels );
-                    const uint32_t * outEnd = out + imageWidth * imageHeight;
-                    const uint8_t * in = imageIn;
-                    const uint32_t * transform = _palette32Bit.data();
-
-                    for ( ; out != outEnd; ++out, ++in )
-                        *out = *( transform + *in );
+                    convertPaletteImage( static_cast<uint32_t *>( surface->pixels ), imageIn, imageWidth, imageHeight, imageWidth, _palette32Bit.data() );
                 }
                 else if ( surface->format->BitsPerPixel == 8 ) {
                     if ( surface->pixels != imageIn ) {
@@ -302,19 +341,8 @@ namespace
             }
             else {
                 if ( surface->format->BitsPerPixel == 32 ) {
-                    uint32_t * outY = static_cast<uint32_t *>( surface->pixels );
-                    const uint32_t * outYEnd = outY + imageWidth * roi.height;
-                    const uint8_t * inY = imageIn + roi.x + roi.y * imageWidth;
-                    const uint32_t * transform = _palette32Bit.data();
-
-                    for ( ; outY != outYEnd; outY += imageWidth, inY += imageWidth ) {
-                        uint32_t * outX = outY;
-                        const uint32_t * outXEnd = outX + roi.width;
-                        const uint8_t * inX = inY;
-
-                        for ( ; outX != outXEnd; ++outX, ++inX )
-                            *outX = *( transform + *inX );
-                    }
+                    convertPaletteImage( static_cast<uint32_t *>( surface->pixels ), imageIn + roi.x + roi.y * imageWidth, roi.width, roi.height, imageWidth,
+                                         _palette32Bit.data() );
                 }
                 else if ( surface->format->BitsPerPixel == 8 ) {
                     if ( surface->pixels != imageIn ) {
@@ -457,6 +485,20 @@ namespace
                 return;
             }
 
+            // Cursor images are switched very often, for example on every hover over a different object, so the created cursors are reused.
+            // All of them are converted using the current palette, so they become outdated when the palette changes.
+            if ( !std::equal( _cachedPalette.begin(), _cachedPalette.end(), currentPalette ) ) {
+                clear();
+                std::copy( currentPalette, currentPalette + _cachedPalette.size(), _cachedPalette.begin() );
+            }
+
+            for ( const CachedCursor & cached : _cachedCursors ) {
+                if ( cached.offsetX == offsetX && cached.offsetY == offsetY && isSameImage( cached.image, image ) ) {
+                    setCursor( cached.cursor );
+                    return;
+                }
+            }
+
             SDL_Surface * surface = SDL_CreateRGBSurface( 0, image.width(), image.height(), 32, 0xFF, 0xFF00, 0xFF0000, 0xFF000000 );
             if ( surface == nullptr ) {
                 ERROR_LOG( "Failed to create a surface of " << image.width() << " x " << image.height() << " size for cursor. The error: " << SDL_GetError() )
@@ -497,23 +539,25 @@ namespace
             }
 
             SDL_Cursor * tempCursor = SDL_CreateColorCursor( surface, offsetX, offsetY );
+            SDL_FreeSurface( surface );
+
             if ( tempCursor == nullptr ) {
                 ERROR_LOG( "Failed to create a cursor. The error description: " << SDL_GetError() )
-            }
-            else {
-                SDL_SetCursor( tempCursor );
-            }
 
-            const int returnCode = SDL_ShowCursor( _show ? SDL_ENABLE : SDL_DISABLE );
-            if ( returnCode < 0 ) {
-                ERROR_LOG( "Failed to set cursor state. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                const int returnCode = SDL_ShowCursor( _show ? SDL_ENABLE : SDL_DISABLE );
+                if ( returnCode < 0 ) {
+                    ERROR_LOG( "Failed to set cursor state. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                }
+                return;
             }
-            SDL_FreeSurface( surface );
 
-            if ( tempCursor != nullptr ) {
+            if ( _cachedCursors.size() >= maxCachedCursors ) {
                 clear();
-                std::swap( _cursor, tempCursor );
             }
+
+            _cachedCursors.push_back( { image, offsetX, offsetY, tempCursor } );
+
+            setCursor( tempCursor );
         }
 
         void enableSoftwareEmulation( const bool enable ) override
@@ -551,7 +595,6 @@ namespace
 
     protected:
         RenderCursor()
-            : _cursor( nullptr )
         {
             // SDL 2 handles mouse properly without any emulation.
             _emulation = false;
@@ -563,14 +606,52 @@ namespace
         }
 
     private:
-        SDL_Cursor * _cursor;
+        struct CachedCursor
+        {
+            fheroes2::Image image;
+            int32_t offsetX;
+            int32_t offsetY;
+            SDL_Cursor * cursor;
+        };
+
+        // The game uses less than a hundred distinct cursor images.
+        static const size_t maxCachedCursors = 128;
+
+        std::vector<CachedCursor> _cachedCursors;
+
+        std::array<uint8_t, 256 * 3> _cachedPalette{};
+
+        static bool isSameImage( const fheroes2::Image & first, const fheroes2::Image & second )
+        {
+            if ( first.width() != second.width() || first.height() != second.height() || first.singleLayer() != second.singleLayer() ) {
+                return false;
+            }
+
+            const size_t size = static_cast<size_t>( first.width() ) * first.height();
+            if ( !std::equal( first.image(), first.image() + size, second.image() ) ) {
+                return false;
+            }
+
+            return first.singleLayer() || std::equal( first.transform(), first.transform() + size, second.transform() );
+        }
+
+        void setCursor( SDL_Cursor * cursor ) const
+        {
+            SDL_SetCursor( cursor );
+
+            const int returnCode = SDL_ShowCursor( _show ? SDL_ENABLE : SDL_DISABLE );
+            if ( returnCode < 0 ) {
+                ERROR_LOG( "Failed to set cursor state. The error value: " << returnCode << ", description: " << SDL_GetError() )
+            }
+        }
 
         void clear()
         {
-            if ( _cursor != nullptr ) {
-                SDL_FreeCursor( _cursor );
-                _cursor = nullptr;
+            for ( const CachedCursor & cached : _cachedCursors ) {
+                SDL_FreeCursor( cached.cursor );
             }
+
+            _cachedCursors.clear();
         }
     };
 #else
@@ -1013,6 +1094,11 @@ namespace
         }
 
         void render( const fheroes2::Display & display, const fheroes2::Rect & roi ) override
+        {
+            renderRegion( display, fheroes2::RenderRegion( roi ) );
+        }
+
+        void renderRegion( const fheroes2::Display & display, const fheroes2::RenderRegion & region ) override
         {
             if ( _surface == nullptr )
                 return;
@@ -1030,26 +1116,9 @@ namespace
                 return;
             }
 
-            copyImageToSurface( display, _surface, roi );
-
-            const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
-            if ( fullFrame ) {
-                const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
-                }
-            }
-            else {
-                SDL_Rect area;
-                area.x = roi.x;
-                area.y = roi.y;
-                area.w = roi.width;
-                area.h = roi.height;
-
-                const int returnCode = SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
-                }
+            // Only the changed areas are uploaded to the texture while the texture itself is rendered once.
+            for ( const fheroes2::Rect & roi : region.areas() ) {
+                updateTexture( display, roi );
             }
 
             int returnCode = SDL_RenderClear( _renderer );
@@ -1199,6 +1268,31 @@ namespace
 
         bool _isVSyncEnabled;
 
+        void updateTexture( const fheroes2::Display & display, const fheroes2::Rect & roi )
+        {
+            copyImageToSurface( display, _surface, roi );
+
+            const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
+            if ( fullFrame ) {
+                const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
+                if ( returnCode < 0 ) {
+                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                }
+            }
+            else {
+                SDL_Rect area;
+                area.x = roi.x;
+                area.y = roi.y;
+                area.w = roi.width;
+                area.h = roi.height;
+
+                const int returnCode = SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
+                if ( returnCode < 0 ) {
+                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                }
+            }
+        }
+
         uint32_t renderFlags() const
         {
             if ( _isVSyncEnabled ) {
@@ -1305,6 +1399,13 @@ namespace
                 return false;
             }
 
+#if SDL_VERSION_ATLEAST( 2, 0, 5 )
+            returnCode = SDL_RenderSetIntegerScale( _renderer, ( isIntegerScaling() ? SDL_TRUE : SDL_FALSE ) );
+            if ( returnCode < 0 ) {
+                ERROR_LOG( "Failed to set integer scaling for rendering. The error value: " << returnCode << ", description: " << SDL_GetError() )
+            }
+#endif
+
             _texture = SDL_CreateTextureFromSurface( _renderer, _surface );
             if ( _texture == nullptr ) {
                 ERROR_LOG( "Failed to create a texture from a surface of " << width_ << " x " << height_ << " size. The error: " << SDL_GetError() )
@@ -1550,6 +1651,74 @@ namespace fheroes2
         Display::instance().linkRenderSurface( surface );
     }
 
+    void RenderRegion::add( const Rect & roi )
+    {
+        if ( roi.width <= 0 || roi.height <= 0 ) {
+            return;
+        }
+
+        // The merged area can intersect other areas as well, so the search starts over after each merge.
+        Rect area( roi );
+        for ( size_t i = 0; i < _areas.size(); ) {
+            if ( _areas[i] & area ) {
+                area = getBoundaryRect( area, _areas[i] );
+                _areas.erase( _areas.begin() + static_cast<std::ptrdiff_t>( i ) );
+                i = 0;
+            }
+            else {
+                ++i;
+            }
+        }
+
+        _areas.push_back( area );
+
+        if ( _areas.size() <= _maxAreas ) {
+            return;
+        }
+
+        // Too many areas: merge the pair which adds the least number of extra pixels to render.
+        const auto getSquare = []( const Rect & rect ) { return static_cast<int64_t>( rect.width ) * rect.height; };
+
+        size_t bestFirst = 0;
+        size_t bestSecond = 1;
+        int64_t bestExtraSquare = -1;
+
+        for ( size_t i = 0; i < _areas.size(); ++i ) {
+            for ( size_t j = i + 1; j < _areas.size(); ++j ) {
+                const int64_t extraSquare = getSquare( getBoundaryRect( _areas[i], _areas[j] ) ) - getSquare( _areas[i] ) - getSquare( _areas[j] );
+                if ( bestExtraSquare < 0 || extraSquare < bestExtraSquare ) {
+                    bestExtraSquare = extraSquare;
+                    bestFirst = i;
+                    bestSecond = j;
+                }
+            }
+        }
+
+        const Rect merged = getBoundaryRect( _areas[bestFirst], _areas[bestSecond] );
+
+        _areas.erase( _areas.begin() + static_cast<std::ptrdiff_t>( bestSecond ) );
+        _areas.erase( _areas.begin() + static_cast<std::ptrdiff_t>( bestFirst ) );
+
+        add( merged );
+    }
+
+    void RenderRegion::add( const RenderRegion & region )
+    {
+        for ( const Rect & roi : region._areas ) {
+            add( roi );
+        }
+    }
+
+    Rect RenderRegion::boundary() const
+    {
+        Rect result;
+        for ( const Rect & roi : _areas ) {
+            result = getBoundaryRect( result, roi );
+        }
+
+        return result;
+    }
+
     Display::Display()
         : _engine( RenderEngine::create() )
         , _cursor( RenderCursor::create() )
@@ -1581,7 +1750,7 @@ namespace fheroes2
         // deallocate engine resources
         _engine->clear();
 
-        _prevRoi = {};
+        _prevRoi.clear();
 
         // allocate engine resources
         if ( !_engine->allocate( info, isFullScreen ) ) {
@@ -1590,9 +1759,6 @@ namespace fheroes2
 
         Image::resize( info.gameWidth, info.gameHeight );
         _screenSize = { info.screenWidth, info.screenHeight };
-
-        // To detect some UI artifacts by invalid code let's put all transform data into pixel skipping mode.
-        std::fill( transform(), transform() + width() * height(), static_cast<uint8_t>( 1 ) );
     }
 
     Display & Display::instance()
@@ -1603,11 +1769,24 @@ namespace fheroes2
 
     void Display::render( const Rect & roi )
     {
-        Rect temp( roi );
-        if ( !getActiveArea( temp, width(), height() ) )
+        render( RenderRegion( roi ) );
+    }
+
+    void Display::render( const RenderRegion & region )
+    {
+        PROFILE_ZONE( "Display render" );
+
+        RenderRegion temp;
+        for ( Rect roi : region.areas() ) {
+            if ( getActiveArea( roi, width(), height() ) ) {
+                temp.add( roi );
+            }
+        }
+
+        if ( temp.empty() )
             return;
 
-        getActiveArea( _prevRoi, width(), height() );
+        const Time presentTimer;
 
         if ( _cursor->isVisible() && _cursor->isSoftwareEmulation() && !_cursor->_image.empty() ) {
             const Sprite & cursorImage = _cursor->_image;
@@ -1618,12 +1797,14 @@ namespace fheroes2
                 // ROI must include cursor's area as well, otherwise cursor won't be rendered.
                 Rect cursorROI( cursorImage.x(), cursorImage.y(), cursorImage.width(), cursorImage.height() );
                 if ( getActiveArea( cursorROI, width(), height() ) ) {
-                    temp = getBoundaryRect( temp, cursorROI );
+                    temp.add( cursorROI );
                 }
             }
 
             // Previous position of cursor must be updated as well to avoid ghost effect.
-            _renderFrame( getBoundaryRect( temp, _prevRoi ) );
+            RenderRegion frameRegion( temp );
+            frameRegion.add( _prevRoi );
+            _renderFrame( frameRegion );
 
             if ( _postprocessing != nullptr ) {
                 _postprocessing();
@@ -1632,7 +1813,9 @@ namespace fheroes2
             Copy( backup, 0, 0, *this, backup.x(), backup.y(), backup.width(), backup.height() );
         }
         else {
-            _renderFrame( getBoundaryRect( temp, _prevRoi ) );
+            RenderRegion frameRegion( temp );
+            frameRegion.add( _prevRoi );
+            _renderFrame( frameRegion );
 
             if ( _postprocessing != nullptr ) {
                 _postprocessing();
@@ -1640,14 +1823,34 @@ namespace fheroes2
         }
 
         _prevRoi = temp;
+
+        _currentFrameStatistics.presentTime = presentTimer.getUs();
+        _currentFrameStatistics.frameTime = _frameTimer.getUs();
+        _frameTimer.reset();
+
+        const uint64_t measuredTime = _currentFrameStatistics.eventProcessingTime + _currentFrameStatistics.idleTime + _currentFrameStatistics.presentTime;
+        _currentFrameStatistics.redrawTime = _currentFrameStatistics.frameTime > measuredTime ? _currentFrameStatistics.frameTime - measuredTime : 0;
+
+        _currentFrameStatistics.renderAreaCount = temp.areas().size();
+        for ( const Rect & roi : temp.areas() ) {
+            _currentFrameStatistics.renderPixelCount += static_cast<int64_t>( roi.width ) * roi.height;
+        }
+
+        _currentFrameStatistics.frameId = _lastFrameStatistics.frameId + 1;
+
+        _lastFrameStatistics = _currentFrameStatistics;
+        _currentFrameStatistics = {};
     }
 
     void Display::updateNextRenderRoi( const Rect & roi )
     {
-        _prevRoi = getBoundaryRect( _prevRoi, roi );
+        Rect temp( roi );
+        if ( getActiveArea( temp, width(), height() ) ) {
+            _prevRoi.add( temp );
+        }
     }
 
-    void Display::_renderFrame( const Rect & roi ) const
+    void Display::_renderFrame( const RenderRegion & region ) const
     {
         bool updateImage = true;
         if ( _preprocessing != nullptr ) {
@@ -1665,7 +1868,7 @@ namespace fheroes2
         }
 
         if ( updateImage ) {
-            _engine->render( *this, roi );
+            _engine->renderRegion( *this, region );
         }
     }
 
@@ -1685,7 +1888,7 @@ namespace fheroes2
         _cursor.reset();
         clear();
 
-        _prevRoi = {};
+        _prevRoi.clear();
     }
 
     void Display::changePalette( const uint8_t * palette, const bool forceDefaultPaletteUpdate ) const
@@ -28,6 +28,7 @@
 
 #include "image.h"
 #include "math_base.h"
+#include "timing.h"
 
 namespace fheroes2
 {
@@ -80,6 +81,45 @@ namespace fheroes2
         int32_t screenHeight{ 0 };
     };
 
+    // A small set of screen areas to be rendered. Intersecting areas are merged together. When there are too many areas
+    // the closest ones are merged as well, so the set always consists of a few disjoint rectangles.
+    class RenderRegion
+    {
+    public:
+        RenderRegion() = default;
+
+        explicit RenderRegion( const Rect & roi )
+        {
+            add( roi );
+        }
+
+        void add( const Rect & roi );
+        void add( const RenderRegion & region );
+
+        bool empty() const
+        {
+            return _areas.empty();
+        }
+
+        void clear()
+        {
+            _areas.clear();
+        }
+
+        // Returns the rectangle covering all areas.
+        Rect boundary() const;
+
+        const std::vector<Rect> & areas() const
+        {
+            return _areas;
+        }
+
+    private:
+        static const size_t _maxAreas = 4;
+
+        std::vector<Rect> _areas;
+    };
+
     class BaseRenderEngine
     {
     public:
@@ -138,10 +178,22 @@ namespace fheroes2
             return _nearestScaling;
         }
 
+        // Scale the image only by a whole factor leaving black borders around it. Combined with nearest scaling it keeps pixels sharp.
+        void setIntegerScaling( const bool enable )
+        {
+            _integerScaling = enable;
+        }
+
+        bool isIntegerScaling() const
+        {
+            return _integerScaling;
+        }
+
     protected:
         BaseRenderEngine()
             : _isFullScreen( false )
             , _nearestScaling( false )
+            , _integerScaling( false )
         {
             // Do nothing.
         }
@@ -156,6 +208,12 @@ namespace fheroes2
             // Do nothing.
         }
 
+        // Render several areas of the image in one frame. Engines which can't update parts of the frame separately render the boundary of all areas.
+        virtual void renderRegion( const Display & display, const RenderRegion & region )
+        {
+            render( display, region.boundary() );
+        }
+
         virtual bool allocate( ResolutionInfo & /*unused*/, bool /*unused*/ )
         {
             return false;
@@ -178,6 +236,8 @@ namespace fheroes2
         bool _isFullScreen;
 
         bool _nearestScaling;
+
+        bool _integerScaling;
     };
 
     class Display : public Image
@@ -203,9 +263,46 @@ namespace fheroes2
 
         void render( const Rect & roi ); // render a part of image on screen. Prefer this method over full image if you don't draw full screen.
 
+        // Render several separate parts of image on screen. Only these parts are updated on screen.
+        void render( const RenderRegion & region );
+
         // Update the area which will be rendered on the next render() call.
         void updateNextRenderRoi( const Rect & roi );
 
+        // Timings in microseconds of the last rendered frame and the size of its rendered area.
+        struct FrameStatistics
+        {
+            // Time between the ends of the previous and the last rendered frames.
+            uint64_t frameTime{ 0 };
+            uint64_t eventProcessingTime{ 0 };
+            // Everything apart from event processing, waiting and presenting is considered as drawing of the frame.
+            uint64_t redrawTime{ 0 };
+            uint64_t presentTime{ 0 };
+            uint64_t idleTime{ 0 };
+
+            size_t renderAreaCount{ 0 };
+            int64_t renderPixelCount{ 0 };
+
+            // Sequential number of the rendered frame starting from 1.
+            uint64_t frameId{ 0 };
+        };
+
+        const FrameStatistics & lastFrameStatistics() const
+        {
+            return _lastFrameStatistics;
+        }
+
+        // These methods are called by the event processing loop to split the time of the next frame.
+        void addEventProcessingTime( const uint64_t timeUs )
+        {
+            _currentFrameStatistics.eventProcessingTime += timeUs;
+        }
+
+        void addIdleTime( const uint64_t timeUs )
+        {
+            _currentFrameStatistics.idleTime += timeUs;
+        }
+
         // Do not call this method. It serves as a patch over the basic class.
         void resize( int32_t width_, int32_t height_ ) override;
 
@@ -252,11 +349,15 @@ namespace fheroes2
 
         uint8_t * _renderSurface;
 
-        // Previous area drawn on the screen.
-        Rect _prevRoi;
+        // Previous areas drawn on the screen.
+        RenderRegion _prevRoi;
 
         Size _screenSize;
 
+        FrameStatistics _currentFrameStatistics;
+        FrameStatistics _lastFrameStatistics;
+        Time _frameTimer;
+
         // Only for cases of direct drawing on rendered 8-bit image.
         void linkRenderSurface( uint8_t * surface )
         {
@@ -265,7 +366,7 @@ namespace fheroes2
 
         Display();
 
-        void _renderFrame( const Rect & roi ) const; // prepare and render a frame
+        void _renderFrame( const RenderRegion & region ) const; // prepare and render a frame
     };
 
     class Cursor
@@ -111,6 +111,15 @@ StreamBase & StreamBase::operator>>( int32_t & v )
     return *this;
 }
 
+StreamBase & StreamBase::operator>>( int64_t & v )
+{
+    const uint64_t high = get32();
+    const uint64_t low = get32();
+
+    v = static_cast<int64_t>( ( high << 32 ) | low );
+    return *this;
+}
+
 StreamBase & StreamBase::operator>>( std::string & v )
 {
     uint32_t size = get32();
@@ -173,6 +182,15 @@ StreamBase & StreamBase::operator<<( const int32_t v )
     return *this;
 }
 
+StreamBase & StreamBase::operator<<( const int64_t v )
+{
+    const uint64_t unsignedValue = static_cast<uint64_t>( v );
+
+    put32( static_cast<uint32_t>( unsignedValue >> 32 ) );
+    put32( static_cast<uint32_t>( unsignedValue & 0xFFFFFFFF ) );
+    return *this;
+}
+
 StreamBase & StreamBase::operator<<( const uint32_t v )
 {
     put32( v );
@@ -626,6 +644,22 @@ std::vector<uint8_t> StreamFile::getRaw( size_t sz )
     return v;
 }
 
+bool StreamFile::readRaw( uint8_t * data, const size_t size )
+{
+    assert( data != nullptr || size == 0 );
+
+    if ( size == 0 || !_file ) {
+        return size == 0;
+    }
+
+    if ( std::fread( data, size, 1, _file ) != 1 ) {
+        setfail( true );
+        return false;
+    }
+
+    return true;
+}
+
 void StreamFile::putRaw( const char * ptr, size_t sz )
 {
     if ( _file )
@@ -28,6 +28,8 @@
 #include <array>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <deque>
 #include <iterator>
 #include <list>
 #include <map>
@@ -121,6 +123,7 @@ public:
     StreamBase & operator>>( int16_t & v );
     StreamBase & operator>>( uint32_t & v );
     StreamBase & operator>>( int32_t & v );
+    StreamBase & operator>>( int64_t & v );
     StreamBase & operator>>( std::string & v );
 
     StreamBase & operator>>( fheroes2::Point & point_ );
@@ -132,6 +135,8 @@ public:
     StreamBase & operator<<( const int16_t v );
     StreamBase & operator<<( const uint32_t v );
     StreamBase & operator<<( const int32_t v );
+    // 64-bit values are stored as two 32-bit values, the high part goes first.
+    StreamBase & operator<<( const int64_t v );
     StreamBase & operator<<( const std::string & v );
 
     StreamBase & operator<<( const fheroes2::Point & point_ );
@@ -146,6 +151,11 @@ public:
     StreamBase & operator>>( std::vector<Type> & v )
     {
         const uint32_t size = get32();
+        if constexpr ( isBulkSerializable<Type> ) {
+            getBulk( v, size );
+            return *this;
+        }
+
         v.resize( size );
         for ( typename std::vector<Type>::iterator it = v.begin(); it != v.end(); ++it )
             *this >> *it;
@@ -162,6 +172,16 @@ public:
         return *this;
     }
 
+    template <class Type>
+    StreamBase & operator>>( std::deque<Type> & v )
+    {
+        const uint32_t size = get32();
+        v.resize( size );
+        for ( typename std::deque<Type>::iterator it = v.begin(); it != v.end(); ++it )
+            *this >> *it;
+        return *this;
+    }
+
     template <class Type1, class Type2>
     StreamBase & operator>>( std::map<Type1, Type2> & v )
     {
@@ -185,6 +205,11 @@ public:
     StreamBase & operator<<( const std::vector<Type> & v )
     {
         put32( static_cast<uint32_t>( v.size() ) );
+        if constexpr ( isBulkSerializable<Type> ) {
+            putBulk( v );
+            return *this;
+        }
+
         for ( typename std::vector<Type>::const_iterator it = v.begin(); it != v.end(); ++it )
             *this << *it;
         return *this;
@@ -199,6 +224,15 @@ public:
         return *this;
     }
 
+    template <class Type>
+    StreamBase & operator<<( const std::deque<Type> & v )
+    {
+        put32( static_cast<uint32_t>( v.size() ) );
+        for ( typename std::deque<Type>::const_iterator it = v.begin(); it != v.end(); ++it )
+            *this << *it;
+        return *this;
+    }
+
     template <class Type1, class Type2>
     StreamBase & operator<<( const std::map<Type1, Type2> & v )
     {
@@ -231,6 +265,87 @@ protected:
 
     void setconstbuf( bool );
     void setfail( bool );
+
+private:
+    // Integer types which are serialized as their plain bytes in the stream byte order, so that vectors of them can be
+    // serialized with a single raw read or write instead of per element calls.
+    template <class Type>
+    static constexpr bool isBulkSerializable = std::is_same_v<Type, char> || std::is_same_v<Type, uint8_t> || std::is_same_v<Type, uint16_t>
+                                               || std::is_same_v<Type, int16_t> || std::is_same_v<Type, uint32_t> || std::is_same_v<Type, int32_t>;
+
+    // This conversion is symmetric so it is used both for reading and writing.
+    template <class Type>
+    Type toStreamByteOrder( const Type value ) const
+    {
+        static_assert( std::is_unsigned_v<Type> );
+
+        if constexpr ( sizeof( Type ) == 1 ) {
+            return value;
+        }
+        else if constexpr ( sizeof( Type ) == 2 ) {
+            return bigendian() ? htobe16( value ) : htole16( value );
+        }
+        else {
+            static_assert( sizeof( Type ) == 4 );
+            return bigendian() ? htobe32( value ) : htole32( value );
+        }
+    }
+
+    template <class Type>
+    void getBulk( std::vector<Type> & v, const uint32_t size )
+    {
+        v.clear();
+
+        if ( size == 0 ) {
+            return;
+        }
+
+        // Do not trust the size read from the stream to not allocate memory for the data that does not exist
+        if ( size > sizeg() / sizeof( Type ) ) {
+            setfail( true );
+            return;
+        }
+
+        const std::vector<uint8_t> raw = getRaw( size * sizeof( Type ) );
+        if ( raw.size() != size * sizeof( Type ) ) {
+            setfail( true );
+            return;
+        }
+
+        using UnsignedType = std::make_unsigned_t<Type>;
+
+        v.resize( size );
+
+        for ( size_t i = 0; i < v.size(); ++i ) {
+            UnsignedType value;
+            std::memcpy( &value, raw.data() + i * sizeof( Type ), sizeof( Type ) );
+            v[i] = static_cast<Type>( toStreamByteOrder( value ) );
+        }
+    }
+
+    template <class Type>
+    void putBulk( const std::vector<Type> & v )
+    {
+        using UnsignedType = std::make_unsigned_t<Type>;
+
+        if constexpr ( sizeof( Type ) == 1 ) {
+            putRaw( reinterpret_cast<const char *>( v.data() ), v.size() );
+        }
+        else {
+            // Convert the data in chunks to avoid a large temporary allocation
+            std::array<UnsignedType, 1024> chunk;
+
+            for ( size_t offset = 0; offset < v.size(); offset += chunk.size() ) {
+                const size_t count = std::min( chunk.size(), v.size() - offset );
+
+                for ( size_t i = 0; i < count; ++i ) {
+                    chunk[i] = toStreamByteOrder( static_cast<UnsignedType>( v[offset + i] ) );
+                }
+
+                putRaw( reinterpret_cast<const char *>( chunk.data() ), count * sizeof( Type ) );
+            }
+        }
+    }
 };
 
 class StreamBuf : public StreamBase
@@ -252,6 +367,11 @@ public:
     size_t size() const;
     size_t capacity() const;
 
+    size_t tell() const
+    {
+        return tellg();
+    }
+
     void seek( size_t );
     void skip( size_t ) override;
 
@@ -327,6 +447,9 @@ public:
     std::vector<uint8_t> getRaw( size_t = 0 /* all data */ ) override;
     void putRaw( const char *, size_t ) override;
 
+    // Reads data directly into the given buffer avoiding an intermediate copy. Returns false if not enough data is available.
+    bool readRaw( uint8_t * data, const size_t size );
+
     std::string toString( size_t = 0 /* all data */ );
 
 protected:
@@ -32,6 +32,7 @@
 #include "image.h"
 #include "serialize.h"
 #include "smacker.h"
+#include "thread.h"
 
 namespace
 {
@@ -206,6 +207,8 @@ SMKVideoSequence::SMKVideoSequence( const std::string & filePath )
 
 SMKVideoSequence::~SMKVideoSequence()
 {
+    _waitForNextFrame();
+
     if ( _videoFile != nullptr ) {
         smk_close( _videoFile );
     }
@@ -236,6 +239,8 @@ void SMKVideoSequence::resetFrame()
     if ( _videoFile == nullptr )
         return;
 
+    _waitForNextFrame();
+
     smk_first( _videoFile );
     _currentFrameId = 0;
 }
@@ -248,6 +253,8 @@ void SMKVideoSequence::getNextFrame( fheroes2::Image & image, const int32_t x, c
         return;
     }
 
+    _waitForNextFrame();
+
     const uint8_t * data = smk_get_video( _videoFile );
     const uint8_t * paletteData = smk_get_palette( _videoFile );
 
@@ -308,12 +315,22 @@ void SMKVideoSequence::getNextFrame( fheroes2::Image & image, const int32_t x, c
 
     ++_currentFrameId;
     if ( _currentFrameId < _frameCount ) {
-        smk_next( _videoFile );
+        // The frame data has been copied so libsmacker's frame buffer can be reused for the next frame.
+        _nextFrameDecoding = MultiThreading::getThreadPool().submit( [videoFile = _videoFile]() { smk_next( videoFile ); } );
     }
 }
 
-std::vector<uint8_t> SMKVideoSequence::getCurrentPalette() const
+void SMKVideoSequence::_waitForNextFrame()
 {
+    if ( _nextFrameDecoding.valid() ) {
+        _nextFrameDecoding.get();
+    }
+}
+
+std::vector<uint8_t> SMKVideoSequence::getCurrentPalette()
+{
+    _waitForNextFrame();
+
     const uint8_t * paletteData = smk_get_palette( _videoFile );
     assert( paletteData != nullptr );
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <cstdint>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -44,7 +45,7 @@ public:
     // If the image is smaller than the frame then only a part of the frame will be drawn.
     void getNextFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette );
 
-    std::vector<uint8_t> getCurrentPalette() const;
+    std::vector<uint8_t> getCurrentPalette();
 
     const std::vector<std::vector<uint8_t>> & getAudioChannels() const;
 
@@ -59,6 +60,9 @@ public:
     }
 
 private:
+    // The next frame is decoded on a worker thread while the current one is being shown. This method must be called before accessing the video file.
+    void _waitForNextFrame();
+
     std::vector<std::vector<uint8_t>> _audioChannel;
     int32_t _width;
     int32_t _height;
@@ -68,4 +72,6 @@ private:
     unsigned long _currentFrameId;
 
     struct smk_t * _videoFile;
+
+    std::future<void> _nextFrameDecoding;
 };
@@ -39,6 +39,11 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #else
+#include <cctype>
+#include <ctime>
+#include <map>
+#include <mutex>
+
 #include <dirent.h>
 #include <unistd.h>
 
@@ -53,8 +58,6 @@
 
 #if defined( _WIN32 ) || defined( ANDROID )
 #include "logging.h"
-#else
-#include <strings.h>
 #endif
 
 #include <SDL_version.h>
@@ -159,6 +162,91 @@ namespace
 
         return result;
     }
+
+    // Entries of a directory indexed by their lowercase names. If there are several entries whose names differ only in case, then the first
+    // one returned by readdir() is used, just like in the case of the linear case-insensitive search.
+    struct DirectoryListing
+    {
+        std::map<std::string, std::string> entries;
+
+        time_t modificationTime{ 0 };
+    };
+
+#if !defined( TARGET_PS_VITA )
+    std::mutex directoryListingsMutex;
+    std::map<std::string, DirectoryListing> directoryListings;
+#endif
+
+    std::string toLowerCase( std::string str )
+    {
+        for ( char & ch : str ) {
+            ch = static_cast<char>( std::tolower( static_cast<unsigned char>( ch ) ) );
+        }
+
+        return str;
+    }
+
+    bool readDirectoryListing( const std::string & dirPath, DirectoryListing & listing )
+    {
+        DIR * d = opendir( dirPath.c_str() );
+        if ( d == nullptr ) {
+            return false;
+        }
+
+        listing.entries.clear();
+
+        for ( const struct dirent * e = readdir( d ); e != nullptr; e = readdir( d ) ) {
+            listing.entries.try_emplace( toLowerCase( e->d_name ), e->d_name );
+        }
+
+        closedir( d );
+
+        return true;
+    }
+
+    // Finds the name of the entry of the given directory which matches the given name case-insensitively. The directory listings are cached
+    // and re-read only when the modification time of the directory changes.
+    bool findDirectoryEntry( const std::string & dirPath, const std::string & name, std::string & entryName )
+    {
+#if defined( TARGET_PS_VITA )
+        // There is no way to check whether the directory has been modified, so it has to be read every time.
+        DirectoryListing listing;
+        if ( !readDirectoryListing( dirPath, listing ) ) {
+            return false;
+        }
+#else
+        struct stat fs;
+
+        if ( stat( dirPath.c_str(), &fs ) || !S_ISDIR( fs.st_mode ) ) {
+            return false;
+        }
+
+        const std::scoped_lock<std::mutex> lock( directoryListingsMutex );
+
+        auto [listingIter, isNewListing] = directoryListings.try_emplace( dirPath );
+        DirectoryListing & listing = listingIter->second;
+
+        // The modification time has a resolution of one second, so if the directory has been modified during the current second, it may be
+        // modified again without changing this time. Such a listing is re-read on the next access.
+        if ( isNewListing || listing.modificationTime != fs.st_mtime || listing.modificationTime >= time( nullptr ) ) {
+            if ( !readDirectoryListing( dirPath, listing ) ) {
+                directoryListings.erase( listingIter );
+                return false;
+            }
+
+            listing.modificationTime = fs.st_mtime;
+        }
+#endif
+
+        const auto entryIter = listing.entries.find( toLowerCase( name ) );
+        if ( entryIter == listing.entries.end() ) {
+            return false;
+        }
+
+        entryName = entryIter->second;
+
+        return true;
+    }
 #endif
 
     std::string_view trimTrailingSeparators( std::string_view path )
@@ -449,6 +537,29 @@ bool System::Unlink( const std::string & path )
 #endif
 }
 
+bool System::getFileStatus( const std::string & path, uint64_t & size, int64_t & modificationTime )
+{
+    const std::filesystem::path filePath( path );
+
+    std::error_code ec;
+
+    // Using the non-throwing overloads
+    const uintmax_t fileSize = std::filesystem::file_size( filePath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    const std::filesystem::file_time_type fileTime = std::filesystem::last_write_time( filePath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    size = static_cast<uint64_t>( fileSize );
+    modificationTime = static_cast<int64_t>( fileTime.time_since_epoch().count() );
+
+    return true;
+}
+
 #if !defined( _WIN32 ) && !defined( ANDROID )
 // based on: https://github.com/OneSadCookie/fcaseopen
 bool System::GetCaseInsensitivePath( const std::string & path, std::string & correctedPath )
@@ -459,31 +570,15 @@ bool System::GetCaseInsensitivePath( const std::string & path, std::string & cor
         return false;
     }
 
-    DIR * d;
-    bool last = false;
     const char * curDir = ".";
     const char * delimiter = "/";
 
     if ( path[0] == delimiter[0] ) {
         correctedPath.append( delimiter );
-
-        d = opendir( delimiter );
-    }
-    else {
-        d = opendir( curDir );
     }
 
     const std::vector<std::string> splittedPath = splitUnixPath( path, delimiter );
     for ( std::vector<std::string>::const_iterator subPathIter = splittedPath.begin(); subPathIter != splittedPath.end(); ++subPathIter ) {
-        if ( !d ) {
-            return false;
-        }
-
-        if ( last ) {
-            closedir( d );
-            return false;
-        }
-
         if ( subPathIter != splittedPath.begin() ) {
             correctedPath.append( delimiter );
         }
@@ -498,7 +593,7 @@ bool System::GetCaseInsensitivePath( const std::string & path, std::string & cor
         // GetCaseInsensitivePath() calls become very expensive on such systems.
         //
         // The idea is to try to open current subpath as a directory and avoid
-        // directory traversal altogether. Otherwise fall back to linear
+        // directory traversal altogether. Otherwise fall back to the cached
         // case-insensitive search.
 
         std::string absSubpath = correctedPath + *subPathIter;
@@ -506,38 +601,20 @@ bool System::GetCaseInsensitivePath( const std::string & path, std::string & cor
         if ( de ) {
             correctedPath = std::move( absSubpath );
 
-            closedir( d );
-            d = opendir( correctedPath.c_str() );
-
             closedir( de );
             continue;
         }
 
-        const struct dirent * e = readdir( d );
-        while ( e ) {
-            if ( strcasecmp( ( *subPathIter ).c_str(), e->d_name ) == 0 ) {
-                correctedPath += e->d_name;
-
-                closedir( d );
-                d = opendir( correctedPath.c_str() );
-
-                break;
-            }
-
-            e = readdir( d );
-        }
-
-        if ( !e ) {
+        std::string entryName;
+        if ( !findDirectoryEntry( correctedPath.empty() ? curDir : correctedPath, *subPathIter, entryName ) ) {
             correctedPath += *subPathIter;
-            last = true;
+            return false;
         }
-    }
 
-    if ( d ) {
-        closedir( d );
+        correctedPath += entryName;
     }
 
-    return !last;
+    return true;
 }
 #else
 bool System::GetCaseInsensitivePath( const std::string & path, std::string & correctedPath )
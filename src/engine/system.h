@@ -24,6 +24,7 @@
 #ifndef H2SYSTEM_H
 #define H2SYSTEM_H
 
+#include <cstdint>
 #include <ctime>
 #include <string>
 #include <string_view>
@@ -53,6 +54,10 @@ namespace System
     bool IsDirectory( const std::string & path, bool writable = false );
     bool Unlink( const std::string & path );
 
+    // Gets the size and the time of the last modification of the given file. The modification time should only be compared with
+    // other values returned by this function. Returns true on success and false on error.
+    bool getFileStatus( const std::string & path, uint64_t & size, int64_t & modificationTime );
+
     bool GetCaseInsensitivePath( const std::string & path, std::string & correctedPath );
 
     // Resolves the wildcard pattern 'glob' and appends matching paths to 'fileNames'. Supported wildcards are '?' and '*'.
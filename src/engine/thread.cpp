@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2022                                                    *
+ *   Copyright (C) 2022 - 2023                                             *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
  *   it under the terms of the GNU General Public License as published by  *
@@ -22,6 +22,7 @@
 
 #include <cassert>
 #include <memory>
+#include <utility>
 
 namespace MultiThreading
 {
@@ -98,4 +99,125 @@ namespace MultiThreading
             manager->executeTask();
         }
     }
+
+    ThreadPool::ThreadPool( const size_t workerCount )
+    {
+        _workers.reserve( workerCount );
+
+        for ( size_t i = 0; i < workerCount; ++i ) {
+            _workers.emplace_back( ThreadPool::_workerThread, this );
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::scoped_lock<std::mutex> lock( _mutex );
+
+            _exitFlag = true;
+        }
+
+        _workerNotification.notify_all();
+
+        for ( std::thread & worker : _workers ) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::addTask( std::function<void()> task )
+    {
+        if ( _workers.empty() ) {
+            task();
+            return;
+        }
+
+        {
+            std::scoped_lock<std::mutex> lock( _mutex );
+
+            _tasks.emplace_back( std::move( task ) );
+        }
+
+        _workerNotification.notify_one();
+    }
+
+    void ThreadPool::_workerThread( ThreadPool * pool )
+    {
+        assert( pool != nullptr );
+
+        while ( true ) {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock( pool->_mutex );
+
+                pool->_workerNotification.wait( lock, [pool] { return pool->_exitFlag || !pool->_tasks.empty(); } );
+
+                // All the submitted tasks should be completed before exit
+                if ( pool->_tasks.empty() ) {
+                    assert( pool->_exitFlag );
+                    return;
+                }
+
+                task = std::move( pool->_tasks.front() );
+                pool->_tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+    void ThreadPool::ParallelForState::run()
+    {
+        while ( true ) {
+            const size_t first = next.fetch_add( chunkSize );
+            if ( first >= end ) {
+                return;
+            }
+
+            const size_t last = std::min( first + chunkSize, end );
+
+            try {
+                for ( size_t i = first; i < last; ++i ) {
+                    ( *callback )( i );
+                }
+            }
+            catch ( ... ) {
+                std::scoped_lock<std::mutex> lock( mutex );
+
+                if ( !exception ) {
+                    exception = std::current_exception();
+                }
+            }
+
+            bool isCompleted = false;
+
+            {
+                std::scoped_lock<std::mutex> lock( mutex );
+
+                assert( remaining >= last - first );
+                remaining -= last - first;
+
+                isCompleted = ( remaining == 0 );
+            }
+
+            if ( isCompleted ) {
+                completion.notify_all();
+            }
+        }
+    }
+
+    void ThreadPool::ParallelForState::wait()
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+
+        completion.wait( lock, [this] { return remaining == 0; } );
+    }
+
+    ThreadPool & getThreadPool()
+    {
+        // The calling thread also takes part in the parallel processing, so there is no need to have a worker for each hardware thread
+        static ThreadPool pool( std::max( std::thread::hardware_concurrency(), 1U ) - 1 );
+
+        return pool;
+    }
 }
@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2022                                                    *
+ *   Copyright (C) 2022 - 2023                                             *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
  *   it under the terms of the GNU General Public License as published by  *
@@ -20,11 +20,20 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace MultiThreading
 {
@@ -71,4 +80,125 @@ namespace MultiThreading
 
         static void _workerThread( AsyncManager * manager );
     };
+
+    // Pool of worker threads executing independent tasks in the order they were submitted. Unlike AsyncManager it is not bound to
+    // any particular kind of task, so different subsystems can share the same set of threads.
+    class ThreadPool
+    {
+    public:
+        // If the number of workers is 0 then all tasks are executed by the thread that submits them.
+        explicit ThreadPool( const size_t workerCount );
+        ThreadPool( const ThreadPool & ) = delete;
+
+        // Waits for all already submitted tasks to complete and joins the worker threads.
+        ~ThreadPool();
+
+        ThreadPool & operator=( const ThreadPool & ) = delete;
+
+        size_t getWorkerCount() const
+        {
+            return _workers.size();
+        }
+
+        // Schedules the execution of the given callable object. The returned future can be used to get the result of the call
+        // or the exception thrown by it.
+        template <typename Func>
+        std::future<std::invoke_result_t<std::decay_t<Func>>> submit( Func && func )
+        {
+            using ResultType = std::invoke_result_t<std::decay_t<Func>>;
+
+            auto task = std::make_shared<std::packaged_task<ResultType()>>( std::forward<Func>( func ) );
+            std::future<ResultType> result = task->get_future();
+
+            addTask( [task]() { ( *task )(); } );
+
+            return result;
+        }
+
+        // Calls func( index ) for every index in [begin, end) using both the worker threads and the calling thread. The order of calls
+        // is not defined, so the calls must not depend on each other. Returns when all calls are completed. If any call throws an
+        // exception, the first such exception is rethrown by this method after all calls are completed.
+        template <typename Func>
+        void parallelFor( const size_t begin, const size_t end, const Func & func )
+        {
+            if ( begin >= end ) {
+                return;
+            }
+
+            const size_t count = end - begin;
+
+            if ( _workers.empty() || count == 1 ) {
+                for ( size_t i = begin; i < end; ++i ) {
+                    func( i );
+                }
+
+                return;
+            }
+
+            // Split the work into chunks which are several times smaller than the share of each thread to balance the load
+            const size_t threadCount = _workers.size() + 1;
+            const size_t chunkSize = std::max<size_t>( 1, count / ( threadCount * 4 ) );
+
+            auto state = std::make_shared<ParallelForState>( begin, end, chunkSize );
+
+            const std::function<void( size_t )> callback = std::cref( func );
+            state->callback = &callback;
+
+            // Helper tasks may start after all the work is done and the callback no longer exists: in this case they do nothing.
+            const size_t helperCount = std::min( _workers.size(), ( count + chunkSize - 1 ) / chunkSize - 1 );
+            for ( size_t i = 0; i < helperCount; ++i ) {
+                addTask( [state]() { state->run(); } );
+            }
+
+            state->run();
+            state->wait();
+
+            if ( state->exception ) {
+                std::rethrow_exception( state->exception );
+            }
+        }
+
+    private:
+        struct ParallelForState
+        {
+            ParallelForState( const size_t begin, const size_t end_, const size_t chunkSize_ )
+                : next( begin )
+                , end( end_ )
+                , chunkSize( chunkSize_ )
+                , remaining( end_ - begin )
+            {}
+
+            // Processes chunks of indexes until there are no more of them
+            void run();
+
+            // Waits until all indexes are processed
+            void wait();
+
+            std::atomic<size_t> next;
+            const size_t end;
+            const size_t chunkSize;
+
+            const std::function<void( size_t )> * callback{ nullptr };
+
+            std::mutex mutex;
+            std::condition_variable completion;
+            size_t remaining;
+            std::exception_ptr exception;
+        };
+
+        void addTask( std::function<void()> task );
+
+        static void _workerThread( ThreadPool * pool );
+
+        std::vector<std::thread> _workers;
+        std::deque<std::function<void()>> _tasks;
+
+        std::mutex _mutex;
+        std::condition_variable _workerNotification;
+
+        bool _exitFlag{ false };
+    };
+
+    // Returns the thread pool shared by all subsystems. The number of its workers depends on the number of hardware threads.
+    ThreadPool & getThreadPool();
 }
@@ -45,6 +45,12 @@ namespace fheroes2
         return time.count();
     }
 
+    uint64_t Time::getUs() const
+    {
+        const auto time = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - _startTime );
+        return time.count();
+    }
+
     TimeDelay::TimeDelay( const uint64_t delayMs )
         : _prevTime( std::chrono::steady_clock::now() )
         , _delayMs( delayMs )
@@ -67,6 +73,18 @@ namespace fheroes2
         return passedMs >= delayMs;
     }
 
+    uint64_t TimeDelay::getRemainingMs() const
+    {
+        return getRemainingMs( _delayMs );
+    }
+
+    uint64_t TimeDelay::getRemainingMs( const uint64_t delayMs ) const
+    {
+        const auto time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - _prevTime );
+        const uint64_t passedMs = time.count();
+        return passedMs >= delayMs ? 0 : delayMs - passedMs;
+    }
+
     void TimeDelay::reset()
     {
         _prevTime = std::chrono::steady_clock::now();
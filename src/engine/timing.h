@@ -41,6 +41,9 @@ namespace fheroes2
         // Returns rounded time in milliseconds.
         uint64_t getMs() const;
 
+        // Returns rounded time in microseconds.
+        uint64_t getUs() const;
+
     private:
         std::chrono::time_point<std::chrono::steady_clock> _startTime;
     };
@@ -62,6 +65,10 @@ namespace fheroes2
         bool isPassed() const;
         bool isPassed( const uint64_t delayMs ) const;
 
+        // Returns the time in milliseconds left until the delay is passed, 0 if it is already passed.
+        uint64_t getRemainingMs() const;
+        uint64_t getRemainingMs( const uint64_t delayMs ) const;
+
         // Reset delay by starting the count from the current time.
         void reset();
 
@@ -30,6 +30,8 @@
 #include <map>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -144,45 +146,6 @@ namespace
         LOCALE_UK
     };
 
-    struct chunk
-    {
-        uint32_t offset;
-        uint32_t length;
-
-        chunk()
-            : offset( 0 )
-            , length( 0 )
-        {
-            // Do nothing.
-        }
-
-        chunk( const uint32_t off, const uint32_t len )
-            : offset( off )
-            , length( len )
-        {
-            // Do nothing.
-        }
-    };
-
-    uint32_t crc32b( const char * msg )
-    {
-        uint32_t crc = 0xFFFFFFFF;
-        uint32_t index = 0;
-
-        while ( msg[index] ) {
-            crc ^= static_cast<uint32_t>( msg[index] );
-
-            for ( int bit = 0; bit < 8; ++bit ) {
-                const uint32_t poly = ( crc & 1 ) ? 0xEDB88320 : 0x0;
-                crc = ( crc >> 1 ) ^ poly;
-            }
-
-            ++index;
-        }
-
-        return ~crc;
-    }
-
     std::string getTag( const std::string & str, const std::string & tag, const std::string & sep )
     {
         std::string res;
@@ -211,7 +174,8 @@ namespace
         uint32_t hash_offset;
         LocaleType locale;
         StreamBuf buf;
-        std::map<uint32_t, chunk> hash_offsets;
+        // Translations by original strings, both point to the data in 'buf'
+        std::unordered_map<std::string_view, const char *> translations;
         std::string domain;
         std::string encoding;
         std::string plural_forms;
@@ -231,12 +195,11 @@ namespace
 
         const char * ngettext( const char * str, size_t plural )
         {
-            std::map<uint32_t, chunk>::const_iterator it = hash_offsets.find( crc32b( str ) );
-            if ( it == hash_offsets.end() )
+            const auto it = translations.find( str );
+            if ( it == translations.end() )
                 return stripContext( str );
 
-            buf.seek( ( *it ).second.offset );
-            const uint8_t * ptr = buf.data();
+            const char * ptr = it->second;
 
             while ( plural > 0 ) {
                 while ( *ptr )
@@ -245,7 +208,7 @@ namespace
                 ++ptr;
             }
 
-            return reinterpret_cast<const char *>( ptr );
+            return ptr;
         }
 
         bool open( const std::string & file )
@@ -303,6 +266,8 @@ namespace
 
             uint32_t totalTranslationStrings = count;
 
+            translations.reserve( count );
+
             // generate hash table
             for ( uint32_t index = 0; index < count; ++index ) {
                 buf.seek( offset_strings1 + index * 8 /* length, offset */ );
@@ -316,9 +281,12 @@ namespace
 
                 const uint32_t offset1 = buf.get32();
                 buf.seek( offset1 );
-                const std::string msg1 = buf.toString( length1 );
 
-                const uint32_t crc = crc32b( msg1.c_str() );
+                // For strings with plural forms only the singular form is used as a key. The key points to the data in 'buf' so it must not be copied.
+                const char * msg1Data = reinterpret_cast<const char *>( buf.data() );
+                const char * msg1End = std::find( msg1Data, msg1Data + std::min( static_cast<size_t>( length1 ), buf.size() ), '\0' );
+                const std::string_view msg1( msg1Data, static_cast<size_t>( msg1End - msg1Data ) );
+
                 buf.seek( offset_strings2 + index * 8 /* length, offset */ );
 
                 const uint32_t length2 = buf.get32();
@@ -329,12 +297,10 @@ namespace
                 }
 
                 const uint32_t offset2 = buf.get32();
+                buf.seek( offset2 );
 
-                std::map<uint32_t, chunk>::const_iterator it = hash_offsets.find( crc );
-                if ( it == hash_offsets.end() )
-                    hash_offsets[crc] = chunk( offset2, length2 );
-                else {
-                    ERROR_LOG( "Incorrect hash value for: " << msg1 )
+                if ( !translations.try_emplace( msg1, reinterpret_cast<const char *>( buf.data() ) ).second ) {
+                    ERROR_LOG( "Duplicate translation for: " << msg1 )
                 }
             }
 
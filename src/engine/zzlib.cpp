@@ -24,6 +24,8 @@
 #include "zzlib.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 #include <vector>
@@ -31,12 +33,25 @@
 #include <zconf.h>
 #include <zlib.h>
 
+#include "endian_h2.h"
 #include "logging.h"
+#include "thread.h"
 
 namespace
 {
+    constexpr uint16_t FORMAT_VERSION_1 = 1;
     constexpr uint16_t FORMAT_VERSION_0 = 0;
 
+    // Since FORMAT_VERSION_1 the data of a chunk is split into blocks of this size (the last block can be smaller) which are
+    // zipped independently. Each block is preceded by its raw size and its zipped size.
+    constexpr size_t zipBlockSize = 256 * 1024;
+
+    // Number of blocks that ZStreamFile accumulates before zipping them in parallel
+    constexpr size_t zipBlockCount = 8;
+
+    // Size of the block header: raw size and zipped size
+    constexpr size_t zipBlockHeaderSize = 8;
+
     std::vector<uint8_t> zlibDecompress( const uint8_t * src, const size_t srcSize, size_t realSize = 0 )
     {
         if ( src == nullptr || srcSize == 0 ) {
@@ -100,6 +115,75 @@ namespace
         return res;
     }
 
+    uint32_t readBE32( const uint8_t * data )
+    {
+        return ( static_cast<uint32_t>( data[0] ) << 24 ) | ( static_cast<uint32_t>( data[1] ) << 16 ) | ( static_cast<uint32_t>( data[2] ) << 8 )
+               | static_cast<uint32_t>( data[3] );
+    }
+
+    // Unzips the data stored in FORMAT_VERSION_1. The blocks are unzipped in parallel directly to their places in the result.
+    std::vector<uint8_t> unzipBlocks( const std::vector<uint8_t> & zip, const size_t rawSize )
+    {
+        struct Block
+        {
+            size_t zipOffset;
+            size_t zipSize;
+            size_t rawOffset;
+            size_t rawSize;
+        };
+
+        std::vector<Block> blocks;
+
+        size_t zipOffset = 0;
+        size_t rawOffset = 0;
+
+        while ( zipOffset < zip.size() ) {
+            if ( zip.size() - zipOffset < zipBlockHeaderSize ) {
+                ERROR_LOG( "The zipped block header is truncated" )
+                return {};
+            }
+
+            const size_t blockRawSize = readBE32( zip.data() + zipOffset );
+            const size_t blockZipSize = readBE32( zip.data() + zipOffset + 4 );
+            zipOffset += zipBlockHeaderSize;
+
+            if ( blockRawSize == 0 || blockZipSize == 0 || blockZipSize > zip.size() - zipOffset || blockRawSize > rawSize - rawOffset ) {
+                ERROR_LOG( "Invalid size of the zipped block" )
+                return {};
+            }
+
+            blocks.push_back( { zipOffset, blockZipSize, rawOffset, blockRawSize } );
+
+            zipOffset += blockZipSize;
+            rawOffset += blockRawSize;
+        }
+
+        if ( rawOffset != rawSize ) {
+            ERROR_LOG( "The size of the unzipped blocks does not match the size of the data" )
+            return {};
+        }
+
+        std::vector<uint8_t> res( rawSize );
+        std::atomic<bool> isFailed{ false };
+
+        MultiThreading::getThreadPool().parallelFor( 0, blocks.size(), [&zip, &blocks, &res, &isFailed]( const size_t idx ) {
+            const Block & block = blocks[idx];
+
+            uLongf dstSizeULong = static_cast<uLongf>( block.rawSize );
+            const int ret = uncompress( res.data() + block.rawOffset, &dstSizeULong, zip.data() + block.zipOffset, static_cast<uLong>( block.zipSize ) );
+            if ( ret != Z_OK || dstSizeULong != block.rawSize ) {
+                isFailed = true;
+            }
+        } );
+
+        if ( isFailed ) {
+            ERROR_LOG( "Failed to unzip the data blocks" )
+            return {};
+        }
+
+        return res;
+    }
+
     std::vector<uint8_t> zlibCompress( const uint8_t * src, const size_t srcSize )
     {
         if ( src == nullptr || srcSize == 0 ) {
@@ -153,14 +237,18 @@ bool ZStreamBuf::read( const std::string & fn, const size_t offset /* = 0 */ )
     }
 
     const uint16_t version = sf.get16();
-    if ( version != FORMAT_VERSION_0 ) {
+    if ( version != FORMAT_VERSION_0 && version != FORMAT_VERSION_1 ) {
         return false;
     }
 
     sf.skip( 2 ); // Unused bytes
 
     const std::vector<uint8_t> zip = sf.getRaw( zipSize );
-    const std::vector<uint8_t> raw = zlibDecompress( zip.data(), zip.size(), rawSize );
+    if ( zip.size() != zipSize ) {
+        return false;
+    }
+
+    const std::vector<uint8_t> raw = ( version == FORMAT_VERSION_0 ) ? zlibDecompress( zip.data(), zip.size(), rawSize ) : unzipBlocks( zip, rawSize );
     if ( raw.size() != rawSize ) {
         return false;
     }
@@ -193,6 +281,228 @@ bool ZStreamBuf::write( const std::string & fn, const bool append /* = false */
     return !sf.fail();
 }
 
+ZStreamFile::ZStreamFile()
+    : _chunkOffset( 0 )
+    , _rawSize( 0 )
+    , _zipSize( 0 )
+    , _isOpen( false )
+{
+    _file.setbigendian( true );
+}
+
+ZStreamFile::~ZStreamFile() = default;
+
+bool ZStreamFile::open( const std::string & fn )
+{
+    if ( _isOpen ) {
+        ERROR_LOG( "The stream is already open" )
+        return false;
+    }
+
+    if ( !_file.open( fn, "r+b" ) ) {
+        return false;
+    }
+
+    _chunkOffset = _file.size();
+    _file.seek( _chunkOffset );
+
+    // Sizes will be written once all the data is zipped
+    _file.put32( 0 );
+    _file.put32( 0 );
+    _file.put16( FORMAT_VERSION_1 );
+    _file.put16( 0 ); // Unused bytes
+
+    _isOpen = true;
+
+    _input.reserve( zipBlockSize * zipBlockCount );
+
+    _rawSize = 0;
+    _zipSize = 0;
+
+    setfail( false );
+
+    return true;
+}
+
+bool ZStreamFile::close()
+{
+    if ( !_isOpen ) {
+        return false;
+    }
+
+    if ( !fail() ) {
+        zipInput();
+    }
+
+    _isOpen = false;
+    _input.clear();
+
+    if ( !fail() && ( _rawSize == 0 || _rawSize > UINT32_MAX || _zipSize > UINT32_MAX ) ) {
+        ERROR_LOG( "Invalid size of the zipped data" )
+        setfail( true );
+    }
+
+    if ( !fail() ) {
+        _file.seek( _chunkOffset );
+        _file.put32( static_cast<uint32_t>( _rawSize ) );
+        _file.put32( static_cast<uint32_t>( _zipSize ) );
+    }
+
+    _file.close();
+
+    return !fail();
+}
+
+void ZStreamFile::zipInput()
+{
+    if ( _input.empty() ) {
+        return;
+    }
+
+    const size_t blockCount = ( _input.size() + zipBlockSize - 1 ) / zipBlockSize;
+
+    std::vector<std::vector<uint8_t>> zippedBlocks( blockCount );
+
+    MultiThreading::getThreadPool().parallelFor( 0, blockCount, [this, &zippedBlocks]( const size_t idx ) {
+        const size_t offset = idx * zipBlockSize;
+
+        zippedBlocks[idx] = zlibCompress( _input.data() + offset, std::min( zipBlockSize, _input.size() - offset ) );
+    } );
+
+    for ( size_t idx = 0; idx < blockCount; ++idx ) {
+        const std::vector<uint8_t> & zip = zippedBlocks[idx];
+        if ( zip.empty() ) {
+            ERROR_LOG( "Failed to zip the data block" )
+            setfail( true );
+            return;
+        }
+
+        _file.put32( static_cast<uint32_t>( std::min( zipBlockSize, _input.size() - idx * zipBlockSize ) ) );
+        _file.put32( static_cast<uint32_t>( zip.size() ) );
+        _file.putRaw( reinterpret_cast<const char *>( zip.data() ), zip.size() );
+
+        _zipSize += zipBlockHeaderSize + zip.size();
+    }
+
+    if ( _file.fail() ) {
+        setfail( true );
+        return;
+    }
+
+    _rawSize += _input.size();
+    _input.clear();
+}
+
+void ZStreamFile::skip( size_t /* unused */ )
+{
+    setfail( true );
+}
+
+uint16_t ZStreamFile::getBE16()
+{
+    setfail( true );
+    return 0;
+}
+
+uint16_t ZStreamFile::getLE16()
+{
+    setfail( true );
+    return 0;
+}
+
+uint32_t ZStreamFile::getBE32()
+{
+    setfail( true );
+    return 0;
+}
+
+uint32_t ZStreamFile::getLE32()
+{
+    setfail( true );
+    return 0;
+}
+
+void ZStreamFile::putBE16( uint16_t val )
+{
+    val = htobe16( val );
+    putRaw( reinterpret_cast<const char *>( &val ), sizeof( val ) );
+}
+
+void ZStreamFile::putLE16( uint16_t val )
+{
+    val = htole16( val );
+    putRaw( reinterpret_cast<const char *>( &val ), sizeof( val ) );
+}
+
+void ZStreamFile::putBE32( uint32_t val )
+{
+    val = htobe32( val );
+    putRaw( reinterpret_cast<const char *>( &val ), sizeof( val ) );
+}
+
+void ZStreamFile::putLE32( uint32_t val )
+{
+    val = htole32( val );
+    putRaw( reinterpret_cast<const char *>( &val ), sizeof( val ) );
+}
+
+std::vector<uint8_t> ZStreamFile::getRaw( size_t /* unused */ )
+{
+    setfail( true );
+    return {};
+}
+
+void ZStreamFile::putRaw( const char * ptr, size_t sz )
+{
+    if ( !_isOpen ) {
+        setfail( true );
+        return;
+    }
+
+    while ( sz > 0 && !fail() ) {
+        const size_t count = std::min( sz, zipBlockSize * zipBlockCount - _input.size() );
+        _input.insert( _input.end(), ptr, ptr + count );
+
+        ptr += count;
+        sz -= count;
+
+        if ( _input.size() == zipBlockSize * zipBlockCount ) {
+            zipInput();
+        }
+    }
+}
+
+size_t ZStreamFile::sizeg() const
+{
+    return 0;
+}
+
+size_t ZStreamFile::sizep() const
+{
+    return 0;
+}
+
+size_t ZStreamFile::tellg() const
+{
+    return 0;
+}
+
+size_t ZStreamFile::tellp() const
+{
+    return _rawSize + _input.size();
+}
+
+uint8_t ZStreamFile::get8()
+{
+    setfail( true );
+    return 0;
+}
+
+void ZStreamFile::put8( const uint8_t v )
+{
+    putRaw( reinterpret_cast<const char *>( &v ), 1 );
+}
+
 fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer )
 {
     if ( imageData == nullptr || imageSize == 0 || width <= 0 || height <= 0 )
@@ -27,6 +27,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "image.h"
 #include "serialize.h"
@@ -47,6 +48,67 @@ public:
     bool write( const std::string & fn, const bool append = false ) const;
 };
 
+// Write-only stream that zips the data on the fly and appends it to a file as a single zipped chunk
+// which can be read back using ZStreamBuf::read(). Unlike ZStreamBuf, it never keeps more than a small
+// fixed-size portion of the data in memory. The data is split into blocks which are zipped independently
+// in parallel, so this chunk uses a different format version than ZStreamBuf::write() does.
+class ZStreamFile : public StreamBase
+{
+public:
+    ZStreamFile();
+    ZStreamFile( const ZStreamFile & ) = delete;
+    ZStreamFile( ZStreamFile && ) = delete;
+
+    ZStreamFile & operator=( const ZStreamFile & ) = delete;
+    ZStreamFile & operator=( ZStreamFile && ) = delete;
+
+    ~ZStreamFile() override;
+
+    // Opens an existing file to append a zipped chunk to its end. Returns true on success and false on error.
+    bool open( const std::string & fn );
+
+    // Zips the remaining data, finalizes the chunk header and closes the file. If this method is not called
+    // or fails, the chunk is left with a zero zipped size and will be rejected by ZStreamBuf::read(). Returns
+    // true on success and false on error.
+    bool close();
+
+    // Reading is not supported, all read methods just mark the stream as failed.
+    void skip( size_t ) override;
+
+    uint16_t getBE16() override;
+    uint16_t getLE16() override;
+    uint32_t getBE32() override;
+    uint32_t getLE32() override;
+
+    void putBE16( uint16_t ) override;
+    void putLE16( uint16_t ) override;
+    void putBE32( uint32_t ) override;
+    void putLE32( uint32_t ) override;
+
+    std::vector<uint8_t> getRaw( size_t = 0 /* all data */ ) override;
+    void putRaw( const char *, size_t ) override;
+
+protected:
+    size_t sizeg() const override;
+    size_t sizep() const override;
+    size_t tellg() const override;
+    size_t tellp() const override;
+
+    uint8_t get8() override;
+    void put8( const uint8_t v ) override;
+
+private:
+    StreamFile _file;
+    std::vector<uint8_t> _input;
+    size_t _chunkOffset;
+    size_t _rawSize;
+    size_t _zipSize;
+    bool _isOpen;
+
+    // Zips the contents of the input buffer block by block and writes the result to the file.
+    void zipInput();
+};
+
 fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer );
 
 #endif
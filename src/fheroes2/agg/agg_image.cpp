@@ -26,6 +26,7 @@
 #include <cmath>
 #include <cstddef>
 #include <initializer_list>
+#include <future>
 #include <map>
 #include <memory>
 #include <random>
@@ -45,10 +46,12 @@
 #include "image_tool.h"
 #include "math_base.h"
 #include "pal.h"
+#include "profiler.h"
 #include "rand.h"
 #include "screen.h"
 #include "serialize.h"
 #include "text.h"
+#include "thread.h"
 #include "til.h"
 #include "tools.h"
 #include "translations.h"
@@ -69,6 +72,103 @@ namespace
 
     std::map<int, std::vector<fheroes2::Sprite>> _icnVsScaledSprite;
 
+    // Sprites of original ICNs are decoded on demand so the raw ICN data is kept until all sprites are decoded.
+    struct ICNRawData
+    {
+        // The body is shared with prefetching tasks which might still be running after the raw data is released.
+        std::shared_ptr<const std::vector<uint8_t>> body;
+        std::vector<std::pair<uint32_t, uint32_t>> spriteDataInfo; // offset and size of sprite data
+        std::vector<fheroes2::ICNHeader> headers;
+        std::vector<bool> isDecoded;
+        size_t decodedCount{ 0 };
+
+        // All sprites decoded by a worker thread if prefetching was requested.
+        std::future<std::vector<fheroes2::Sprite>> prefetchedSprites;
+    };
+
+    std::vector<ICNRawData> _icnVsRawData( ICN::LASTICN );
+
+    // Handheld devices have a limited amount of memory so not recently used ICNs are evicted between game modes.
+#if defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+    size_t _icnMemoryBudget = 128 * 1024 * 1024;
+#else
+    size_t _icnMemoryBudget = 0;
+#endif
+
+    uint64_t _icnUseTime = 0;
+    std::vector<uint64_t> _icnLastUseTime( ICN::LASTICN, 0 );
+
+    // Fonts are modified in place while generating alphabets so they cannot be reloaded from AGG files.
+    std::vector<bool> _isICNPinned = []() {
+        std::vector<bool> isPinned( ICN::LASTICN, false );
+        for ( const int id : { ICN::FONT, ICN::SMALFONT, ICN::BUTTON_GOOD_FONT_RELEASED, ICN::BUTTON_GOOD_FONT_PRESSED, ICN::BUTTON_EVIL_FONT_RELEASED,
+                               ICN::BUTTON_EVIL_FONT_PRESSED, ICN::YELLOW_FONT, ICN::YELLOW_SMALLFONT, ICN::GRAY_FONT, ICN::GRAY_SMALL_FONT, ICN::WHITE_LARGE_FONT } ) {
+            isPinned[id] = true;
+        }
+        return isPinned;
+    }();
+
+    fheroes2::AGG::ICNCacheStatistics _icnCacheStatistics;
+
+    uint32_t _alphabetVersion = 0;
+
+    // Button fonts are generated for this language when they are requested for the first time.
+    fheroes2::SupportedLanguage _buttonFontLanguage = fheroes2::SupportedLanguage::English;
+
+    size_t getImageMemorySize( const fheroes2::Image & image )
+    {
+        // Every image has image and transform layers.
+        return static_cast<size_t>( image.width() ) * image.height() * 2;
+    }
+
+    size_t getICNMemorySize( const int id )
+    {
+        const ICNRawData & rawData = _icnVsRawData[id];
+        size_t size = rawData.body ? rawData.body->size() : 0;
+
+        for ( const fheroes2::Sprite & sprite : _icnVsSprite[id] ) {
+            size += getImageMemorySize( sprite );
+        }
+
+        const auto scaledIter = _icnVsScaledSprite.find( id );
+        if ( scaledIter != _icnVsScaledSprite.end() ) {
+            for ( const fheroes2::Sprite & sprite : scaledIter->second ) {
+                size += getImageMemorySize( sprite );
+            }
+        }
+
+        return size;
+    }
+
+    // Code within this file accesses sprites of ICNs directly without GetICN( icnId, index ) call for every sprite.
+    // While an instance of this class exists all requested ICNs are decoded entirely.
+    class FullICNDecodingScope
+    {
+    public:
+        FullICNDecodingScope()
+        {
+            ++_depth;
+        }
+
+        FullICNDecodingScope( const FullICNDecodingScope & ) = delete;
+        FullICNDecodingScope & operator=( const FullICNDecodingScope & ) = delete;
+
+        ~FullICNDecodingScope()
+        {
+            --_depth;
+        }
+
+        static bool isActive()
+        {
+            return _depth > 0;
+        }
+
+    private:
+        static int _depth;
+    };
+
+    int FullICNDecodingScope::_depth = 0;
+
     // Some resources are language dependent. These are mostly buttons with a text of them.
     // Once a user changes a language we have to update resources. To do this we need to clear the existing images.
 
@@ -296,6 +396,8 @@ namespace
                 return;
             }
 
+            const FullICNDecodingScope fullDecodingScope;
+
             fheroes2::AGG::GetICN( ICN::FONT, 0 );
             fheroes2::AGG::GetICN( ICN::SMALFONT, 0 );
             fheroes2::AGG::GetICN( ICN::BUTTON_GOOD_FONT_RELEASED, 0 );
@@ -474,9 +576,65 @@ namespace fheroes2
 {
     namespace AGG
     {
-        void LoadOriginalICN( const int id )
+        void decodeOriginalICNSprite( const int id, const uint32_t index )
+        {
+            ICNRawData & rawData = _icnVsRawData[id];
+            if ( rawData.isDecoded.empty() ) {
+                // All sprites are decoded.
+                return;
+            }
+
+            if ( rawData.isDecoded.size() != _icnVsSprite[id].size() ) {
+                // The ICN has been replaced.
+                rawData = {};
+                return;
+            }
+
+            if ( rawData.isDecoded[index] ) {
+                return;
+            }
+
+            if ( rawData.prefetchedSprites.valid() ) {
+                // Wait for the prefetching to complete if it is still running.
+                std::vector<Sprite> sprites = rawData.prefetchedSprites.get();
+                assert( sprites.size() == rawData.isDecoded.size() );
+
+                for ( size_t i = 0; i < sprites.size(); ++i ) {
+                    if ( !rawData.isDecoded[i] ) {
+                        _icnVsSprite[id][i] = std::move( sprites[i] );
+                    }
+                }
+
+                rawData = {};
+                return;
+            }
+
+            const ICNHeader & header = rawData.headers[index];
+            const std::pair<uint32_t, uint32_t> & dataInfo = rawData.spriteDataInfo[index];
+
+            _icnVsSprite[id][index]
+                = decodeICNSprite( rawData.body->data() + dataInfo.first, dataInfo.second, header.width, header.height, header.offsetX, header.offsetY );
+
+            rawData.isDecoded[index] = true;
+            ++rawData.decodedCount;
+
+            if ( rawData.decodedCount == rawData.isDecoded.size() ) {
+                rawData = {};
+            }
+        }
+
+        void decodeAllOriginalICNSprites( const int id )
+        {
+            const uint32_t count = static_cast<uint32_t>( _icnVsSprite[id].size() );
+            for ( uint32_t i = 0; i < count && !_icnVsRawData[id].isDecoded.empty(); ++i ) {
+                decodeOriginalICNSprite( id, i );
+            }
+        }
+
+        // Reads the ICN body and sprite headers without decoding sprites.
+        void loadOriginalICNData( const int id )
         {
-            const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::GetString( id ) );
+            std::vector<uint8_t> body = ::AGG::getDataFromAggFile( ICN::GetString( id ) );
 
             if ( body.empty() ) {
                 return;
@@ -490,12 +648,14 @@ namespace fheroes2
                 return;
             }
 
-            _icnVsSprite[id].resize( count );
+            ICNRawData rawData;
+            rawData.headers.resize( count );
+            rawData.spriteDataInfo.resize( count );
 
             for ( uint32_t i = 0; i < count; ++i ) {
                 imageStream.seek( headerSize + i * 13 );
 
-                ICNHeader header1;
+                ICNHeader & header1 = rawData.headers[i];
                 imageStream >> header1;
 
                 uint32_t sizeData = 0;
@@ -515,10 +675,23 @@ namespace fheroes2
                                                             "Make sure that you own an official version of the game." );
                 }
 
-                const uint8_t * data = body.data() + headerSize + header1.offsetData;
-
-                _icnVsSprite[id][i] = decodeICNSprite( data, sizeData, header1.width, header1.height, header1.offsetX, header1.offsetY );
+                rawData.spriteDataInfo[i] = { headerSize + header1.offsetData, sizeData };
             }
+
+            rawData.body = std::make_shared<const std::vector<uint8_t>>( std::move( body ) );
+            rawData.isDecoded.resize( count, false );
+
+            _icnVsSprite[id].clear();
+            _icnVsSprite[id].resize( count );
+            _icnVsRawData[id] = std::move( rawData );
+        }
+
+        void LoadOriginalICN( const int id )
+        {
+            PROFILE_ZONE( "Load ICN" );
+
+            loadOriginalICNData( id );
+            decodeAllOriginalICNSprites( id );
         }
 
         // Helper function for LoadModifiedICN
@@ -3686,8 +3859,7 @@ namespace fheroes2
             case ICN::BUTTON_GOOD_FONT_PRESSED:
             case ICN::BUTTON_EVIL_FONT_RELEASED:
             case ICN::BUTTON_EVIL_FONT_PRESSED: {
-                generateBaseButtonFont( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED],
-                                        _icnVsSprite[ICN::BUTTON_EVIL_FONT_RELEASED], _icnVsSprite[ICN::BUTTON_EVIL_FONT_PRESSED] );
+                generateButtonAlphabet( _buttonFontLanguage, _icnVsSprite );
                 return true;
             }
             case ICN::HISCORE: {
@@ -3811,8 +3983,20 @@ namespace fheroes2
 
         size_t GetMaximumICNIndex( int id )
         {
-            if ( _icnVsSprite[id].empty() && !LoadModifiedICN( id ) ) {
-                LoadOriginalICN( id );
+            if ( _icnVsSprite[id].empty() ) {
+                bool isModified = false;
+                {
+                    const FullICNDecodingScope fullDecodingScope;
+                    isModified = LoadModifiedICN( id );
+                }
+
+                if ( !isModified ) {
+                    loadOriginalICNData( id );
+                }
+            }
+
+            if ( FullICNDecodingScope::isActive() ) {
+                decodeAllOriginalICNSprites( id );
             }
 
             return _icnVsSprite[id].size();
@@ -3850,7 +4034,11 @@ namespace fheroes2
                     const bool verticalFlip = ( shapeId & 1 ) != 0;
 
                     for ( size_t i = 0; i < count; ++i ) {
-                        currentTIL[i] = Flip( originalTIL[i], horizontalFlip, verticalFlip );
+                        // Flipped ground tiles must stay single-layer as the original ones to avoid a useless transform layer.
+                        Image & flippedTIL = currentTIL[i];
+                        flippedTIL._disableTransformLayer();
+                        flippedTIL.resize( width, height );
+                        Flip( originalTIL[i], 0, 0, flippedTIL, 0, 0, width, height, horizontalFlip, verticalFlip );
                     }
                 }
             }
@@ -3872,15 +4060,12 @@ namespace fheroes2
             }
         }
 
-        const Sprite & GetScaledICN( const int icnId, const uint32_t index )
+        // Sets the size and the position of a scaled sprite for the current resolution. Returns true if the sprite must be resized.
+        bool updateScaledICNLayout( const int icnId, const uint32_t index )
         {
             const Sprite & originalIcn = _icnVsSprite[icnId][index];
             const Display & display = Display::instance();
 
-            if ( display.width() == Display::DEFAULT_WIDTH && display.height() == Display::DEFAULT_HEIGHT ) {
-                return originalIcn;
-            }
-
             if ( _icnVsScaledSprite[icnId].empty() ) {
                 _icnVsScaledSprite[icnId].resize( _icnVsSprite[icnId].size() );
             }
@@ -3897,20 +4082,31 @@ namespace fheroes2
             const int32_t offsetY = static_cast<int32_t>( std::lround( display.height() - Display::DEFAULT_HEIGHT * scaleFactor ) ) / 2;
             assert( offsetX >= 0 && offsetY >= 0 );
 
-            // Resize only if needed
-            if ( resizedIcn.height() != resizedHeight || resizedIcn.width() != resizedWidth ) {
+            const bool isResizeNeeded = ( resizedIcn.height() != resizedHeight || resizedIcn.width() != resizedWidth );
+            if ( isResizeNeeded ) {
                 resizedIcn.resize( resizedWidth, resizedHeight );
-                resizedIcn.setPosition( static_cast<int32_t>( std::lround( originalIcn.x() * scaleFactor ) ) + offsetX,
-                                        static_cast<int32_t>( std::lround( originalIcn.y() * scaleFactor ) ) + offsetY );
-                Resize( originalIcn, resizedIcn, false );
             }
-            else {
-                // No need to resize but we have to update the offset.
-                resizedIcn.setPosition( static_cast<int32_t>( std::lround( originalIcn.x() * scaleFactor ) ) + offsetX,
-                                        static_cast<int32_t>( std::lround( originalIcn.y() * scaleFactor ) ) + offsetY );
+
+            resizedIcn.setPosition( static_cast<int32_t>( std::lround( originalIcn.x() * scaleFactor ) ) + offsetX,
+                                    static_cast<int32_t>( std::lround( originalIcn.y() * scaleFactor ) ) + offsetY );
+
+            return isResizeNeeded;
+        }
+
+        const Sprite & GetScaledICN( const int icnId, const uint32_t index )
+        {
+            const Display & display = Display::instance();
+
+            if ( display.width() == Display::DEFAULT_WIDTH && display.height() == Display::DEFAULT_HEIGHT ) {
+                return _icnVsSprite[icnId][index];
+            }
+
+            // Resize only if needed
+            if ( updateScaledICNLayout( icnId, index ) ) {
+                Resize( _icnVsSprite[icnId][index], _icnVsScaledSprite[icnId][index], false );
             }
 
-            return resizedIcn;
+            return _icnVsScaledSprite[icnId][index];
         }
 
         const Sprite & GetICN( int icnId, uint32_t index )
@@ -3919,10 +4115,21 @@ namespace fheroes2
                 return errorImage;
             }
 
+            if ( _icnVsSprite[icnId].empty() ) {
+                ++_icnCacheStatistics.misses;
+            }
+            else {
+                ++_icnCacheStatistics.hits;
+            }
+
             if ( index >= GetMaximumICNIndex( icnId ) ) {
                 return errorImage;
             }
 
+            decodeOriginalICNSprite( icnId, index );
+
+            _icnLastUseTime[icnId] = ++_icnUseTime;
+
             if ( IsScalableICN( icnId ) ) {
                 return GetScaledICN( icnId, index );
             }
@@ -3936,6 +4143,8 @@ namespace fheroes2
                 return 0;
             }
 
+            _icnLastUseTime[icnId] = ++_icnUseTime;
+
             return static_cast<uint32_t>( GetMaximumICNIndex( icnId ) );
         }
 
@@ -4117,6 +4326,8 @@ namespace fheroes2
 
         void updateLanguageDependentResources( const SupportedLanguage language, const bool loadOriginalAlphabet )
         {
+            const FullICNDecodingScope fullDecodingScope;
+
             if ( loadOriginalAlphabet || !isAlphabetSupported( language ) ) {
                 if ( !alphabetPreserver.isPreserved() ) {
                     // This can happen when we try to change a language without loading assets.
@@ -4132,12 +4343,170 @@ namespace fheroes2
                 alphabetPreserver.restore();
                 generateAlphabet( language, _icnVsSprite );
             }
-            generateButtonAlphabet( language, _icnVsSprite );
+
+            // Button fonts are not used by many screens so they are generated on demand.
+            _buttonFontLanguage = language;
+            for ( const int id : { ICN::BUTTON_GOOD_FONT_RELEASED, ICN::BUTTON_GOOD_FONT_PRESSED, ICN::BUTTON_EVIL_FONT_RELEASED, ICN::BUTTON_EVIL_FONT_PRESSED } ) {
+                _icnVsSprite[id].clear();
+            }
 
             // Clear language dependent resources.
             for ( const int id : languageDependentIcnId ) {
                 _icnVsSprite[id].clear();
             }
+
+            ++_alphabetVersion;
+        }
+
+        uint32_t getAlphabetVersion()
+        {
+            return _alphabetVersion;
+        }
+
+        void prefetchICNs( const std::vector<int> & icnIds )
+        {
+            MultiThreading::ThreadPool & threadPool = MultiThreading::getThreadPool();
+            if ( threadPool.getWorkerCount() == 0 ) {
+                // There are no spare threads to decode sprites in the background.
+                return;
+            }
+
+            for ( const int id : icnIds ) {
+                if ( !IsValidICNId( id ) ) {
+                    continue;
+                }
+
+                // Modified ICNs are generated right away while sprites of original ICNs are decoded on demand.
+                GetMaximumICNIndex( id );
+
+                ICNRawData & rawData = _icnVsRawData[id];
+                if ( rawData.isDecoded.empty() || rawData.prefetchedSprites.valid() ) {
+                    continue;
+                }
+
+                rawData.prefetchedSprites = threadPool.submit( [body = rawData.body, spriteDataInfo = rawData.spriteDataInfo, headers = rawData.headers]() {
+                    std::vector<Sprite> sprites;
+                    sprites.reserve( headers.size() );
+
+                    for ( size_t i = 0; i < headers.size(); ++i ) {
+                        const ICNHeader & header = headers[i];
+                        sprites.emplace_back( decodeICNSprite( body->data() + spriteDataInfo[i].first, spriteDataInfo[i].second, header.width, header.height,
+                                                               header.offsetX, header.offsetY ) );
+                    }
+
+                    return sprites;
+                } );
+            }
+        }
+
+        void prepareScaledICNs()
+        {
+            const Display & display = Display::instance();
+            if ( display.width() == Display::DEFAULT_WIDTH && display.height() == Display::DEFAULT_HEIGHT ) {
+                return;
+            }
+
+            const FullICNDecodingScope fullDecodingScope;
+
+            std::vector<std::pair<int, uint32_t>> spritesToResize;
+
+            for ( const int id : { ICN::HEROES, ICN::BTNSHNGL, ICN::SHNGANIM, ICN::EDITOR } ) {
+                assert( IsScalableICN( id ) );
+
+                // All sprites of the ICN are decoded within the full decoding scope.
+                const uint32_t spriteCount = static_cast<uint32_t>( GetMaximumICNIndex( id ) );
+                for ( uint32_t index = 0; index < spriteCount; ++index ) {
+                    if ( updateScaledICNLayout( id, index ) ) {
+                        spritesToResize.emplace_back( id, index );
+                    }
+                }
+            }
+
+            // The sprite containers must not be accessed by the worker threads so the sprites are looked up in advance.
+            std::vector<std::pair<const Sprite *, Sprite *>> spritePairs;
+            spritePairs.reserve( spritesToResize.size() );
+
+            for ( const auto & [id, index] : spritesToResize ) {
+                spritePairs.emplace_back( &_icnVsSprite[id][index], &_icnVsScaledSprite[id][index] );
+            }
+
+            // Sprites are resized independently so the work is split between all available threads.
+            MultiThreading::getThreadPool().parallelFor( 0, spritePairs.size(), [&spritePairs]( const size_t i ) {
+                Resize( *spritePairs[i].first, *spritePairs[i].second, false );
+            } );
+        }
+
+        void setICNMemoryBudget( const size_t bytes )
+        {
+            _icnMemoryBudget = bytes;
+        }
+
+        void pinICN( const int icnId )
+        {
+            if ( IsValidICNId( icnId ) ) {
+                _isICNPinned[icnId] = true;
+            }
+        }
+
+        void trimICNCache()
+        {
+            if ( _icnMemoryBudget == 0 ) {
+                return;
+            }
+
+            std::vector<std::pair<uint64_t, int>> evictionCandidates;
+            size_t usedMemory = 0;
+
+            for ( int id = 0; id < static_cast<int>( _icnVsSprite.size() ); ++id ) {
+                if ( _icnVsSprite[id].empty() ) {
+                    continue;
+                }
+
+                usedMemory += getICNMemorySize( id );
+
+                if ( !_isICNPinned[id] ) {
+                    evictionCandidates.emplace_back( _icnLastUseTime[id], id );
+                }
+            }
+
+            if ( usedMemory <= _icnMemoryBudget ) {
+                return;
+            }
+
+            std::sort( evictionCandidates.begin(), evictionCandidates.end() );
+
+            for ( const auto & [lastUseTime, id] : evictionCandidates ) {
+                if ( usedMemory <= _icnMemoryBudget ) {
+                    break;
+                }
+
+                const size_t icnMemorySize = getICNMemorySize( id );
+
+                std::vector<Sprite>().swap( _icnVsSprite[id] );
+                _icnVsRawData[id] = {};
+                _icnVsScaledSprite.erase( id );
+
+                usedMemory -= icnMemorySize;
+                _icnCacheStatistics.evictedBytes += icnMemorySize;
+            }
+        }
+
+        const ICNCacheStatistics & getICNCacheStatistics()
+        {
+            return _icnCacheStatistics;
+        }
+
+        size_t getICNMemoryUsage()
+        {
+            size_t usedMemory = 0;
+
+            for ( int id = 0; id < static_cast<int>( _icnVsSprite.size() ); ++id ) {
+                if ( !_icnVsSprite[id].empty() ) {
+                    usedMemory += getICNMemorySize( id );
+                }
+            }
+
+            return usedMemory;
         }
     }
 }
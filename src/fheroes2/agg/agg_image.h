@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace fheroes2
 {
@@ -32,6 +34,13 @@ namespace fheroes2
 
     namespace AGG
     {
+        struct ICNCacheStatistics
+        {
+            uint64_t hits{ 0 };
+            uint64_t misses{ 0 };
+            uint64_t evictedBytes{ 0 };
+        };
+
         const Sprite & GetICN( int icnId, uint32_t index );
         uint32_t GetICNCount( int icnId );
 
@@ -49,5 +58,29 @@ namespace fheroes2
 
         // This function must be called only at the type of setting up a new language.
         void updateLanguageDependentResources( const SupportedLanguage language, const bool loadOriginalAlphabet );
+
+        // Returns a number which changes every time font glyphs are regenerated. Used to invalidate cached text metrics.
+        uint32_t getAlphabetVersion();
+
+        // Starts decoding sprites of the given ICNs on worker threads so they are ready by the time they are requested.
+        void prefetchICNs( const std::vector<int> & icnIds );
+
+        // Resizes all sprites of scalable ICNs for the current resolution at once using all available threads.
+        void prepareScaledICNs();
+
+        // Sets the memory budget in bytes for decoded ICN sprites. 0 means no limit.
+        void setICNMemoryBudget( const size_t bytes );
+
+        // Pinned ICNs are never evicted from memory.
+        void pinICN( const int icnId );
+
+        // Evicts the least recently used ICNs which are not pinned until memory usage fits the budget.
+        // Call it only when no references to ICN sprites are being held, for example, between game modes.
+        void trimICNCache();
+
+        const ICNCacheStatistics & getICNCacheStatistics();
+
+        // Returns the memory in bytes occupied by loaded ICNs.
+        size_t getICNMemoryUsage();
     }
 }
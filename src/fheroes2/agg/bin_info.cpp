@@ -20,13 +20,11 @@
 
 #include <cstdlib>
 #include <initializer_list>
-#include <map>
 #include <memory>
 #include <ostream>
 #include <utility>
 
 #include "agg.h"
-#include "battle_animation.h"
 #include "battle_cell.h"
 #include "bin_info.h"
 #include "logging.h"
@@ -45,16 +43,6 @@ namespace
 
 namespace Bin_Info
 {
-    class MonsterAnimCache
-    {
-    public:
-        AnimationReference createAnimReference( int monsterID ) const;
-        MonsterAnimInfo getAnimInfo( int monsterID );
-
-    private:
-        std::map<int, MonsterAnimInfo> _animMap;
-    };
-
     const size_t CORRECT_FRM_LENGTH = 821;
 
     // When base unit and its upgrade use the same FRM file (e.g. Archer and Ranger)
@@ -63,8 +51,8 @@ namespace Bin_Info
     const double SHOOT_SPEED_UPGRADE = 0.08;
     const double RANGER_SHOOT_SPEED = 0.78;
 
-    std::map<int, AnimationReference> animRefs;
-    MonsterAnimCache _infoCache;
+    // Animation info of all monsters indexed by monster ID. It is filled once by InitBinInfo() and never modified afterwards.
+    std::vector<MonsterAnimInfo> _monsterAnimInfos;
 
     const char * GetFilename( int monsterId )
     {
@@ -458,25 +446,6 @@ namespace Bin_Info
         }
     }
 
-    MonsterAnimInfo MonsterAnimCache::getAnimInfo( int monsterID )
-    {
-        std::map<int, MonsterAnimInfo>::iterator mapIterator = _animMap.find( monsterID );
-        if ( mapIterator != _animMap.end() ) {
-            return mapIterator->second;
-        }
-        else {
-            const MonsterAnimInfo info( monsterID, AGG::getDataFromAggFile( Bin_Info::GetFilename( monsterID ) ) );
-            if ( info.isValid() ) {
-                _animMap[monsterID] = info;
-                return info;
-            }
-            else {
-                DEBUG_LOG( DBG_GAME, DBG_WARN, "missing BIN FRM data: " << Bin_Info::GetFilename( monsterID ) << ", index: " << monsterID )
-            }
-        }
-        return MonsterAnimInfo();
-    }
-
     bool MonsterAnimInfo::isValid() const
     {
         if ( animationFrames.size() != SHOOT3_END + 1 )
@@ -514,19 +483,29 @@ namespace Bin_Info
         return angles.size() - 1;
     }
 
-    AnimationReference MonsterAnimCache::createAnimReference( int monsterID ) const
+    const MonsterAnimInfo & GetMonsterInfo( uint32_t monsterID )
     {
-        return AnimationReference( monsterID );
-    }
+        if ( monsterID >= _monsterAnimInfos.size() ) {
+            static const MonsterAnimInfo emptyInfo;
+            return emptyInfo;
+        }
 
-    MonsterAnimInfo GetMonsterInfo( uint32_t monsterID )
-    {
-        return _infoCache.getAnimInfo( monsterID );
+        return _monsterAnimInfos[monsterID];
     }
 
     void InitBinInfo()
     {
-        for ( int i = Monster::UNKNOWN; i < Monster::WATER_ELEMENT + 1; ++i )
-            animRefs[i] = _infoCache.createAnimReference( i );
+        _monsterAnimInfos.clear();
+        _monsterAnimInfos.reserve( Monster::WATER_ELEMENT + 1 );
+
+        for ( int i = Monster::UNKNOWN; i < Monster::WATER_ELEMENT + 1; ++i ) {
+            MonsterAnimInfo info( i, AGG::getDataFromAggFile( Bin_Info::GetFilename( i ) ) );
+            if ( !info.isValid() ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "missing BIN FRM data: " << Bin_Info::GetFilename( i ) << ", index: " << i )
+                info = MonsterAnimInfo();
+            }
+
+            _monsterAnimInfos.emplace_back( std::move( info ) );
+        }
     }
 }
@@ -90,7 +90,10 @@ namespace Bin_Info
         size_t getProjectileID( const double angle ) const;
     };
 
+    // Parses the animation info of all monsters. It must be called once the game resources are loaded.
     void InitBinInfo();
-    MonsterAnimInfo GetMonsterInfo( uint32_t monsterID );
+
+    // The returned info is valid for the whole duration of the game.
+    const MonsterAnimInfo & GetMonsterInfo( uint32_t monsterID );
 }
 #endif
@@ -24,6 +24,9 @@
 #ifndef H2AI_H
 #define H2AI_H
 
+#include <cstddef>
+#include <cstdint>
+
 #include "mp2.h"
 #include "rand.h"
 
@@ -110,6 +113,11 @@ namespace AI
 
         virtual void Reset();
         virtual void resetPathfinder() = 0;
+        // Same as resetPathfinder(), but only the results that could be affected by the change of the given tile are discarded
+        virtual void resetPathfinderAfterTileChange( const int32_t tileIndex ) = 0;
+
+        // Returns the estimated memory in bytes occupied by the pathfinder caches.
+        virtual size_t getPathfinderMemoryUsage() const = 0;
 
         // Should be called at the beginning of the battle even if no AI-controlled players are
         // involved in the battle - because of the possibility of using instant or auto battle
@@ -117,8 +125,15 @@ namespace AI
 
         virtual ~Base() = default;
 
+        // Returns the time in milliseconds spent by the last kingdom turn.
+        uint64_t getLastKingdomTurnDuration() const
+        {
+            return _lastKingdomTurnDurationMs;
+        }
+
     protected:
         int _personality = NONE;
+        uint64_t _lastKingdomTurnDurationMs{ 0 };
 
         Base() = default;
 
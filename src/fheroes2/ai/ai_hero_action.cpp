@@ -789,11 +789,6 @@ namespace
             hero.setVisitedForAllies( dst_index );
             world.ActionForMagellanMaps( hero.GetColor() );
 
-            if ( Players::isFriends( hero.GetColor(), Players::HumanColors() ) ) {
-                // Fully update fog directions if AI player is an ally.
-                Interface::GameArea::updateMapFogDirections();
-            }
-
             kingdom.OddFundsResource( payment );
         }
 
@@ -1895,15 +1890,17 @@ namespace AI
             fheroes2::Point heroAnimationOffset;
             int heroAnimationSpriteId = 0;
 
-            const bool hideAIMovements = ( conf.AIMoveSpeed() == 0 );
             const bool noMovementAnimation = ( conf.AIMoveSpeed() == 10 );
 
             const std::vector<Game::DelayType> delayTypes = { Game::CURRENT_AI_DELAY, Game::MAPS_DELAY };
 
             fheroes2::Display & display = fheroes2::Display::instance();
 
+            // Movement of a hero hidden by the fog is not animated so there is no need to wait between the steps.
+            bool isHeroHidden = !AIHeroesShowAnimation( hero, colors );
+
             LocalEvent & le = LocalEvent::Get();
-            while ( le.HandleEvents( !hideAIMovements && Game::isDelayNeeded( delayTypes ) ) ) {
+            while ( le.HandleEvents( !isHeroHidden && Game::isDelayNeeded( delayTypes ) ) ) {
 #if defined( WITH_DEBUG )
                 if ( HotKeyPressEvent( Game::HotKeyEvent::WORLD_TRANSFER_CONTROL_TO_AI ) && Players::Get( hero.GetColor() )->isAIAutoControlMode() ) {
                     if ( fheroes2::showStandardTextMessage( _( "Warning" ),
@@ -1920,7 +1917,9 @@ namespace AI
                     break;
                 }
 
-                if ( hideAIMovements || !AIHeroesShowAnimation( hero, colors ) ) {
+                isHeroHidden = !AIHeroesShowAnimation( hero, colors );
+
+                if ( isHeroHidden ) {
                     hero.Move( true );
                     recenterNeeded = true;
 
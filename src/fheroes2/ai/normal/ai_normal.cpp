@@ -21,11 +21,13 @@
 #include "ai_normal.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 
 #include "army.h"
 #include "heroes.h"
 #include "kingdom.h"
+#include "logging.h"
 #include "maps_tiles.h"
 #include "pairs.h"
 #include "payment.h"
@@ -47,6 +49,11 @@ namespace AI
         _pathfinder.reset();
     }
 
+    void Normal::resetPathfinderAfterTileChange( const int32_t tileIndex )
+    {
+        _pathfinder.resetAfterTileChange( tileIndex );
+    }
+
     void Normal::revealFog( const Maps::Tiles & tile, const Kingdom & kingdom )
     {
         const MP2::MapObjectType object = tile.GetObject();
@@ -77,19 +84,24 @@ namespace AI
 
     double Normal::getTargetArmyStrength( const Maps::Tiles & tile, const MP2::MapObjectType objectType )
     {
-        if ( !isMonsterStrengthCacheable( objectType ) ) {
+        if ( !isArmyStrengthCacheable( objectType ) ) {
             return Army( tile ).GetStrength();
         }
 
         const int32_t tileId = tile.GetIndex();
 
-        auto iter = _neutralMonsterStrengthCache.find( tileId );
-        if ( iter != _neutralMonsterStrengthCache.end() ) {
+        auto iter = _guardianArmyStrengthCache.find( tileId );
+        if ( iter != _guardianArmyStrengthCache.end() ) {
             // Cache hit.
+#if defined( WITH_DEBUG )
+            if ( std::fabs( iter->second - Army( tile ).GetStrength() ) > 0.001 ) {
+                DEBUG_LOG( DBG_AI, DBG_WARN, "Cached army strength is outdated for tile " << tileId << ", object type: " << MP2::StringObject( objectType ) )
+            }
+#endif
             return iter->second;
         }
 
-        auto newEntry = _neutralMonsterStrengthCache.emplace( tileId, Army( tile ).GetStrength() );
+        auto newEntry = _guardianArmyStrengthCache.emplace( tileId, Army( tile ).GetStrength() );
         return newEntry.first->second;
     }
 
@@ -166,6 +178,8 @@ namespace AI
 
     void Normal::updateMapActionObjectCache( const int mapIndex )
     {
+        _objectValueCache.clear();
+
         const Maps::Tiles & tile = world.GetTiles( mapIndex );
         const MP2::MapObjectType objectType = tile.GetObject();
         auto iter = std::lower_bound( _mapActionObjects.begin(), _mapActionObjects.end(), IndexObject{ mapIndex, objectType },
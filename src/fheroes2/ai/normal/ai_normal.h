@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <map>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,7 @@
 #include "mp2.h"
 #include "pairs.h"
 #include "resource.h"
+#include "timing.h"
 #include "world_pathfinding.h"
 
 class Castle;
@@ -261,8 +263,16 @@ namespace AI
         std::vector<AICastle> getSortedCastleList( const KingdomCastles & castles, const std::set<int> & castlesInDanger );
 
         double getObjectValue( const Heroes & hero, const int index, const int objectType, const double valueToIgnore, const uint32_t distanceToObject ) const;
+        // Same as getObjectValue() but the result is kept until the next hero movement or action.
+        double getCachedObjectValue( const Heroes & hero, const int index, const int objectType, const double valueToIgnore, const uint32_t distanceToObject );
         int getPriorityTarget( const HeroToMove & heroInfo, double & maxPriority );
         void resetPathfinder() override;
+        void resetPathfinderAfterTileChange( const int32_t tileIndex ) override;
+
+        size_t getPathfinderMemoryUsage() const override
+        {
+            return _pathfinder.getMemoryUsage();
+        }
 
         void battleBegins() override;
 
@@ -311,11 +321,28 @@ namespace AI
         std::vector<RegionStats> _regions;
         std::array<BudgetEntry, 7> _budget = { Resource::WOOD, Resource::MERCURY, Resource::ORE, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD };
         AIWorldPathfinder _pathfinder;
-        BattlePlanner _battlePlanner;
 
-        // Monster strength is constant over the same turn for AI but its calculation is a heavy operation.
-        // In order to avoid extra computations during AI turn it is important to keep cache of monster strength but update it when an action on a monster is taken.
-        std::map<int32_t, double> _neutralMonsterStrengthCache;
+        // The AI instance is shared by all battles, while the planner keeps the state of a particular battle. Every thread may run
+        // its own battle, so each thread has its own planner.
+        static thread_local BattlePlanner _battlePlanner;
+
+        // Strength of armies guarding map objects (neutral monsters, mine guardians, etc.) is constant over the same turn for AI but its calculation is
+        // a heavy operation. In order to avoid extra computations during AI turn it is important to keep cache of these armies' strength but update it when
+        // an action on the object is taken.
+        std::map<int32_t, double> _guardianArmyStrengthCache;
+
+        // Values of objects evaluated for heroes, keyed by hero ID, hero role, object index and distance to the object. Heroes are evaluated several
+        // times with different pathfinder settings before one of them moves, while the values do not depend on these settings.
+        std::map<std::tuple<int, int, int, uint32_t>, double> _objectValueCache;
+
+        // Time spent by the current kingdom turn and its limit taken from the settings (0 means no limit).
+        fheroes2::Time _turnTimer;
+        uint64_t _turnTimeLimitMs{ 0 };
+
+        bool isTurnTimeLimitReached( const uint64_t percentage = 100 ) const
+        {
+            return _turnTimeLimitMs > 0 && _turnTimer.getMs() * 100 >= _turnTimeLimitMs * percentage;
+        }
 
         void CastleTurn( Castle & castle, const bool defensiveStrategy );
 
@@ -334,9 +361,10 @@ namespace AI
         bool purchaseNewHeroes( const std::vector<AICastle> & sortedCastleList, const std::set<int> & castlesInDanger, const int32_t availableHeroCount,
                                 const bool moreTasksForHeroes );
 
-        static bool isMonsterStrengthCacheable( const MP2::MapObjectType objectType )
+        // Armies of heroes and castles can be changed by their owners, while the armies of all other objects can only be changed by an action on the object
+        static bool isArmyStrengthCacheable( const MP2::MapObjectType objectType )
         {
-            return objectType == MP2::OBJ_MONSTER;
+            return objectType != MP2::OBJ_HEROES && objectType != MP2::OBJ_CASTLE;
         }
 
         void updateMapActionObjectCache( const int mapIndex );
@@ -351,6 +379,9 @@ namespace AI
         // IMPORTANT!!! Do not call this method directly. Use other methods which call it internally.
         bool updateIndividualPriorityForCastle( const Castle & castle, const EnemyArmy & enemyArmy );
 
+        // Prepares the pathfinder for distance checks from the given enemy army to the kingdom's castles.
+        void prepareCastleThreatEvaluation( const Kingdom & kingdom, const EnemyArmy & enemyArmy );
+
         void removePriorityAttackTarget( const int32_t tileIndex );
 
         void updatePriorityAttackTarget( const Kingdom & kingdom, const Maps::Tiles & tile );
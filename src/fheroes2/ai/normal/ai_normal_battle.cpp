@@ -92,7 +92,8 @@ namespace AI
     {
         MeleeAttackOutcome bestOutcome;
 
-        Indexes nearbyIndexes = Board::GetAroundIndexes( defender );
+        const NearbyIndexes aroundDefender = Board::GetAroundIndexes( defender );
+        Indexes nearbyIndexes( aroundDefender.begin(), aroundDefender.end() );
         // Shuffle to make equal quality moves a bit unpredictable
         randomGenerator.Shuffle( nearbyIndexes );
 
@@ -122,11 +123,26 @@ namespace AI
         return bestOutcome;
     }
 
+    // The threat posed by each enemy unit to the current unit doesn't depend on the cell being evaluated, so it is calculated only once per decision
+    std::vector<double> getEnemyThreats( const Unit & currentUnit, const Battle::Units & enemies )
+    {
+        std::vector<double> threats;
+        threats.reserve( enemies.size() );
+
+        for ( const Unit * enemy : enemies ) {
+            threats.push_back( enemy->GetScoreQuality( currentUnit ) );
+        }
+
+        return threats;
+    }
+
     int32_t FindMoveToRetreat( const Indexes & moves, const Unit & currentUnit, const Battle::Units & enemies )
     {
         double lowestThreat = 0.0;
         int32_t targetCell = -1;
 
+        const std::vector<double> enemyThreats = getEnemyThreats( currentUnit, enemies );
+
         for ( const int moveIndex : moves ) {
             // Skip if this cell has adjacent enemies
             if ( Board::GetCell( moveIndex )->GetQuality() )
@@ -134,7 +150,9 @@ namespace AI
 
             double cellThreatLevel = 0.0;
 
-            for ( const Unit * enemy : enemies ) {
+            for ( size_t i = 0; i < enemies.size(); ++i ) {
+                const Unit * enemy = enemies[i];
+
                 uint32_t dist = Board::GetDistance( moveIndex, enemy->GetHeadIndex() );
                 if ( enemy->isWide() ) {
                     const uint32_t distanceFromTail = Board::GetDistance( moveIndex, enemy->GetTailIndex() );
@@ -142,7 +160,7 @@ namespace AI
                 }
 
                 const uint32_t range = std::max( 1u, enemy->GetMoveRange() );
-                cellThreatLevel += enemy->GetScoreQuality( currentUnit ) * ( 1.0 - static_cast<double>( dist ) / range );
+                cellThreatLevel += enemyThreats[i] * ( 1.0 - static_cast<double>( dist ) / range );
             }
 
             if ( targetCell == -1 || cellThreatLevel < lowestThreat ) {
@@ -158,17 +176,21 @@ namespace AI
         double lowestThreat = 0.0;
         int32_t targetCell = -1;
 
+        const std::vector<double> enemyThreats = getEnemyThreats( currentUnit, enemies );
+
         for ( const int moveIndex : moves ) {
             double cellThreatLevel = 0.0;
 
-            for ( const Unit * enemy : enemies ) {
+            for ( size_t i = 0; i < enemies.size(); ++i ) {
+                const Unit * enemy = enemies[i];
+
                 // Archers and Flyers are always threatening, skip
                 if ( enemy->isFlying() || ( enemy->isArchers() && !enemy->isHandFighting() ) ) {
                     continue;
                 }
 
                 if ( Board::GetDistance( moveIndex, enemy->GetHeadIndex() ) <= enemy->GetMoveRange() + 1 ) {
-                    cellThreatLevel += enemy->GetScoreQuality( currentUnit );
+                    cellThreatLevel += enemyThreats[i];
                 }
             }
 
@@ -577,7 +599,7 @@ namespace AI
             // Force archer to fight back by setting initial expectation to lowest possible (if we're losing battle)
             int bestOutcome = ( _myArmyStrength < _enemyArmyStrength ) ? -_highestDamageExpected : 0;
 
-            const Indexes & adjacentEnemies = Board::GetAdjacentEnemies( currentUnit );
+            const NearbyIndexes adjacentEnemies = Board::GetAdjacentEnemies( currentUnit );
             for ( const int cell : adjacentEnemies ) {
                 const Unit * enemy = Board::GetCell( cell )->GetUnit();
                 if ( enemy ) {
@@ -629,7 +651,7 @@ namespace AI
 
                 if ( currentUnit.isAbilityPresent( fheroes2::MonsterAbilityType::AREA_SHOT ) ) {
                     // TODO: update logic to handle tail case as well. Right now archers always shoot to head.
-                    const Indexes around = Board::GetAroundIndexes( enemy->GetHeadIndex() );
+                    const NearbyIndexes around = Board::GetAroundIndexes( enemy->GetHeadIndex() );
                     std::set<const Unit *> targetedUnits;
 
                     for ( const int32_t cellId : around ) {
@@ -807,7 +829,7 @@ namespace AI
             DEBUG_LOG( DBG_BATTLE, DBG_TRACE, unitToDefend->GetName() << " archer value " << archerValue << " distance: " << distanceToUnit )
 
             // 3. Search for enemy units blocking our archers within range move
-            const Indexes & adjacentEnemies = Board::GetAdjacentEnemies( *unitToDefend );
+            const NearbyIndexes adjacentEnemies = Board::GetAdjacentEnemies( *unitToDefend );
             for ( const int cell : adjacentEnemies ) {
                 const Unit * enemy = Board::GetCell( cell )->GetUnit();
                 if ( !enemy ) {
@@ -883,7 +905,7 @@ namespace AI
         }
 
         BattleTargetPair targetInfo;
-        std::map<const Unit *, Indexes> aroundIndexesCache;
+        std::map<const Unit *, NearbyIndexes> aroundIndexesCache;
 
         // First, try to find a unit nearby that can be attacked on this turn
         for ( const Unit * nearbyUnit : nearestUnits ) {
@@ -971,6 +993,8 @@ namespace AI
         return actions;
     }
 
+    thread_local BattlePlanner Normal::_battlePlanner;
+
     void Normal::BattleTurn( Arena & arena, const Unit & currentUnit, Actions & actions )
     {
         // Return immediately if our limit of turns has been exceeded
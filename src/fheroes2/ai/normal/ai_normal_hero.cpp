@@ -23,9 +23,10 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <list>
+#include <deque>
 #include <map>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -126,7 +127,7 @@ namespace
     {
         const uint32_t dist = pathfinder.getDistance( index );
 
-        const std::list<Route::Step> dimensionDoorSteps = pathfinder.getDimensionDoorPath( hero, index );
+        const std::deque<Route::Step> dimensionDoorSteps = pathfinder.getDimensionDoorPath( hero, index );
         if ( dimensionDoorSteps.empty() ) {
             return dist;
         }
@@ -718,7 +719,7 @@ namespace
     class ObjectValueStorage
     {
     public:
-        ObjectValueStorage( const Heroes & hero, const AI::Normal & ai, const double ignoreValue )
+        ObjectValueStorage( const Heroes & hero, AI::Normal & ai, const double ignoreValue )
             : _hero( hero )
             , _ai( ai )
             , _ignoreValue( ignoreValue )
@@ -731,7 +732,7 @@ namespace
                 return iter->second;
             }
 
-            const double value = _ai.getObjectValue( _hero, objectInfo.first, objectInfo.second, _ignoreValue, distance );
+            const double value = _ai.getCachedObjectValue( _hero, objectInfo.first, objectInfo.second, _ignoreValue, distance );
 
             _objectValue[objectInfo] = value;
             return value;
@@ -739,7 +740,7 @@ namespace
 
     private:
         const Heroes & _hero;
-        const AI::Normal & _ai;
+        AI::Normal & _ai;
         const double _ignoreValue;
         std::map<std::pair<int, int>, double> _objectValue;
     };
@@ -1636,6 +1637,21 @@ namespace AI
         return 0;
     }
 
+    double Normal::getCachedObjectValue( const Heroes & hero, const int index, const int objectType, const double valueToIgnore, const uint32_t distanceToObject )
+    {
+        const auto key = std::make_tuple( hero.GetID(), static_cast<int>( hero.getAIRole() ), index, distanceToObject );
+
+        const auto iter = _objectValueCache.find( key );
+        if ( iter != _objectValueCache.end() ) {
+            return iter->second;
+        }
+
+        const double value = getObjectValue( hero, index, objectType, valueToIgnore, distanceToObject );
+        _objectValueCache.emplace( key, value );
+
+        return value;
+    }
+
     int Normal::getCourierMainTarget( const Heroes & hero, const AIWorldPathfinder & pathfinder, double lowestPossibleValue ) const
     {
         assert( hero.getAIRole() == Heroes::Role::COURIER );
@@ -1752,20 +1768,24 @@ namespace AI
         ObjectValidator objectValidator( hero, _pathfinder, *this );
         ObjectValueStorage valueStorage( hero, *this, lowestPossibleValue );
 
-        auto getObjectValue = [&objectValidator, &valueStorage, this, heroStrength, &hero]( const int destination, uint32_t & distance, double & value,
-                                                                                            const MP2::MapObjectType type, const bool isDimensionDoor ) {
+        auto getValueOnTheWay = [&objectValidator, &valueStorage, this]( const IndexObject & pair ) {
+            if ( !objectValidator.isValid( pair.first ) || !std::binary_search( _mapActionObjects.begin(), _mapActionObjects.end(), pair ) ) {
+                return 0.0;
+            }
+
+            // Object is on the way, we don't loose any movement points.
+            // There is no need to reduce the quality of the object even if the path has others.
+            return std::max( valueStorage.value( pair, 0 ), 0.0 );
+        };
+
+        // All paths belong to the same pathfinder evaluation, so values accumulated along them are shared between all destinations.
+        std::vector<std::optional<double>> valuesOnTheWay;
+
+        auto getObjectValue = [&getValueOnTheWay, &valuesOnTheWay, this, heroStrength, &hero]( const int destination, uint32_t & distance, double & value,
+                                                                                               const MP2::MapObjectType type, const bool isDimensionDoor ) {
             if ( !isDimensionDoor ) {
                 // Dimension door path does not include any objects on the way.
-                std::vector<IndexObject> list = _pathfinder.getObjectsOnTheWay( destination );
-                for ( const IndexObject & pair : list ) {
-                    if ( objectValidator.isValid( pair.first ) && std::binary_search( _mapActionObjects.begin(), _mapActionObjects.end(), pair ) ) {
-                        const double extraValue = valueStorage.value( pair, 0 ); // object is on the way, we don't loose any movement points.
-                        if ( extraValue > 0 ) {
-                            // There is no need to reduce the quality of the object even if the path has others.
-                            value += extraValue;
-                        }
-                    }
-                }
+                value += _pathfinder.getValueOfObjectsOnTheWay( destination, getValueOnTheWay, valuesOnTheWay );
             }
 
             const Maps::Tiles & destinationTile = world.GetTiles( destination );
@@ -1867,14 +1887,20 @@ namespace AI
             }
         }
 
+        const bool canUseDimensionDoor = hero.HaveSpell( Spell::DIMENSIONDOOR );
+
         for ( const IndexObject & node : _mapActionObjects ) {
             // Skip if hero in patrol mode and object outside of reach
             if ( heroInPatrolMode && Maps::GetApproximateDistance( node.first, heroInfo.patrolCenter ) > heroInfo.patrolDistance )
                 continue;
 
-            if ( objectValidator.isValid( node.first ) ) {
-                uint32_t dist = _pathfinder.getDistance( node.first );
+            // The distance is taken from the pathfinder cache so it is much cheaper to check than the object validity.
+            // Objects which can't be reached by walking or by Dimension Door are skipped right away.
+            uint32_t dist = _pathfinder.getDistance( node.first );
+            if ( dist == 0 && !canUseDimensionDoor )
+                continue;
 
+            if ( objectValidator.isValid( node.first ) ) {
                 bool useDimensionDoor = false;
                 const uint32_t dimensionDoorDist = AIWorldPathfinder::calculatePathPenalty( _pathfinder.getDimensionDoorPath( hero, node.first ) );
                 if ( dimensionDoorDist > 0 && ( dist == 0 || dimensionDoorDist < dist / 2 ) ) {
@@ -2060,10 +2086,12 @@ namespace AI
             }
         }
 
-        if ( isMonsterStrengthCacheable( objectType ) ) {
-            _neutralMonsterStrengthCache.erase( tileIndex );
+        if ( isArmyStrengthCacheable( objectType ) ) {
+            _guardianArmyStrengthCache.erase( tileIndex );
         }
 
+        _objectValueCache.clear();
+
         updatePriorityTargets( hero, tileIndex, objectType );
 
         updateMapActionObjectCache( tileIndex );
@@ -2089,6 +2117,15 @@ namespace AI
         uint32_t currentProgressValue = startProgressValue;
 
         while ( !availableHeroes.empty() ) {
+            // The previous movement could change the state of the heroes and map objects.
+            _objectValueCache.clear();
+
+            if ( isTurnTimeLimitReached() ) {
+                DEBUG_LOG( DBG_AI, DBG_WARN,
+                           "Turn time limit of " << _turnTimeLimitMs << " ms is reached, " << availableHeroes.size() << " heroes stop moving for this turn" )
+                break;
+            }
+
             class AIWorldPathfinderStateRestorer
             {
             public:
@@ -2120,6 +2157,14 @@ namespace AI
             Heroes * bestHero = availableHeroes.front().hero;
             int bestTargetIndex = -1;
 
+            // When the turn time is almost spent only the strongest hero is evaluated and the best target found for him is taken.
+            const HeroToMove * strongestHero = nullptr;
+            if ( isTurnTimeLimitReached( 75 ) ) {
+                strongestHero = &( *std::max_element( availableHeroes.begin(), availableHeroes.end(), []( const HeroToMove & left, const HeroToMove & right ) {
+                    return left.hero->GetArmy().GetStrength() < right.hero->GetArmy().GetStrength();
+                } ) );
+            }
+
             {
                 const bool isLosingGame = bestHero->isLosingGame();
 
@@ -2135,6 +2180,10 @@ namespace AI
                     double maxPriority = 0;
 
                     for ( const HeroToMove & heroInfo : availableHeroes ) {
+                        if ( strongestHero != nullptr && &heroInfo != strongestHero ) {
+                            continue;
+                        }
+
                         double priority = -1;
                         const int targetIndex = getPriorityTarget( heroInfo, priority );
 
@@ -2151,6 +2200,18 @@ namespace AI
                 }
             }
 
+            if ( bestTargetIndex == -1 && strongestHero != nullptr ) {
+                // Only the strongest hero was evaluated so only he stops moving for this turn. The other heroes may still have something to do.
+                const Heroes * stoppedHero = strongestHero->hero;
+
+                DEBUG_LOG( DBG_AI, DBG_INFO, stoppedHero->GetName() << " has nothing to do while the turn time is almost spent, he stops moving for this turn" )
+
+                availableHeroes.erase( std::remove_if( availableHeroes.begin(), availableHeroes.end(),
+                                                       [stoppedHero]( const HeroToMove & item ) { return item.hero == stoppedHero; } ),
+                                       availableHeroes.end() );
+                continue;
+            }
+
             if ( bestTargetIndex == -1 ) {
                 // Possibly heroes have nothing to do because one of them is blocking the way. Move a random hero randomly and see what happens.
                 Rand::Shuffle( availableHeroes );
@@ -2188,7 +2249,7 @@ namespace AI
             int prevHeroPosition = bestHero->GetIndex();
 
             // check if we want to use Dimension Door spell or move regularly
-            std::list<Route::Step> dimensionPath = _pathfinder.getDimensionDoorPath( *bestHero, bestTargetIndex );
+            std::deque<Route::Step> dimensionPath = _pathfinder.getDimensionDoorPath( *bestHero, bestTargetIndex );
             uint32_t dimensionDoorDistance = AIWorldPathfinder::calculatePathPenalty( dimensionPath );
             uint32_t moveDistance = _pathfinder.getDistance( bestTargetIndex );
             if ( dimensionDoorDistance && ( !moveDistance || dimensionDoorDistance < moveDistance / 2 ) ) {
@@ -53,7 +53,9 @@
 #include "mus.h"
 #include "pairs.h"
 #include "players.h"
+#include "profiler.h"
 #include "resource.h"
+#include "settings.h"
 #include "skill.h"
 #include "spell.h"
 #include "world.h"
@@ -67,6 +69,14 @@ namespace
     // 1500 is slightly more than a fresh hero's maximum move points hired in a castle.
     const uint32_t movePointsFromCastle{ 1500 };
 
+    // 30 tiles, roughly how much maxed out hero can move in a turn.
+    const uint32_t threatDistanceLimit = 3000;
+
+    bool isTooFarToBeThreat( const int armyIndex, const int castleIndex )
+    {
+        return Maps::GetApproximateDistance( armyIndex, castleIndex ) * Maps::Ground::roadPenalty > threatDistanceLimit;
+    }
+
     struct HeroValue
     {
         Heroes * hero = nullptr;
@@ -529,6 +539,8 @@ namespace AI
         const TemporaryHeroEraser heroEraser( kingdom.GetHeroes() );
 
         for ( const EnemyArmy & enemyArmy : _enemyArmies ) {
+            prepareCastleThreatEvaluation( kingdom, enemyArmy );
+
             for ( const Castle * castle : kingdom.GetCastles() ) {
                 if ( castle == nullptr ) {
                     // How is it even possible? Check the logic!
@@ -551,6 +563,8 @@ namespace AI
         // if no our heroes exist. So we are temporary removing them from the map.
         const TemporaryHeroEraser heroEraser( kingdom.GetHeroes() );
 
+        prepareCastleThreatEvaluation( kingdom, enemyArmy );
+
         for ( const Castle * castle : kingdom.GetCastles() ) {
             if ( castle == nullptr ) {
                 // How is it even possible? Check the logic!
@@ -562,6 +576,21 @@ namespace AI
         }
     }
 
+    void Normal::prepareCastleThreatEvaluation( const Kingdom & kingdom, const EnemyArmy & enemyArmy )
+    {
+        const KingdomCastles & castles = kingdom.GetCastles();
+
+        const auto castlesToCheck = std::count_if( castles.begin(), castles.end(), [&enemyArmy]( const Castle * castle ) {
+            return castle != nullptr && !isTooFarToBeThreat( enemyArmy.index, castle->GetIndex() );
+        } );
+
+        // A separate goal-directed search is performed for every castle otherwise. When several castles are close enough to the enemy army
+        // it is cheaper to evaluate the entire map once, the following distance requests for this army are then taken from the cache.
+        if ( castlesToCheck > 1 ) {
+            _pathfinder.reEvaluateIfNeeded( enemyArmy.index, kingdom.GetColor(), enemyArmy.strength, Skill::Level::EXPERT );
+        }
+    }
+
     void Normal::updatePriorityForCastle( const Castle & castle )
     {
         // Since we are estimating danger for a castle and we need to know if an enemy hero can reach it
@@ -575,12 +604,9 @@ namespace AI
 
     bool Normal::updateIndividualPriorityForCastle( const Castle & castle, const EnemyArmy & enemyArmy )
     {
-        // 30 tiles, roughly how much maxed out hero can move in a turn.
-        const uint32_t threatDistanceLimit = 3000;
-
         const int castleIndex = castle.GetIndex();
         // skip precise distance check if army is too far to be a threat
-        if ( Maps::GetApproximateDistance( enemyArmy.index, castleIndex ) * Maps::Ground::roadPenalty > threatDistanceLimit ) {
+        if ( isTooFarToBeThreat( enemyArmy.index, castleIndex ) ) {
             return false;
         }
 
@@ -726,6 +752,9 @@ namespace AI
 
     void Normal::KingdomTurn( Kingdom & kingdom )
     {
+        PROFILE_ZONE( "AI kingdom turn" );
+        PROFILE_ALLOCATIONS( "AI kingdom turn" );
+
         const int myColor = kingdom.GetColor();
 
         if ( kingdom.isLoss() || myColor == Color::NONE ) {
@@ -733,6 +762,9 @@ namespace AI
             return;
         }
 
+        _turnTimer.reset();
+        _turnTimeLimitMs = static_cast<uint64_t>( Settings::Get().aiTurnTimeLimit() ) * 1000;
+
         // reset indicator
         Interface::StatusWindow & status = Interface::AdventureMap::Get().getStatusWindow();
         status.DrawAITurnProgress( 0 );
@@ -742,8 +774,8 @@ namespace AI
         KingdomHeroes & heroes = kingdom.GetHeroes();
         const KingdomCastles & castles = kingdom.GetCastles();
 
-        // Clear the cache of neutral monsters as their strength might have changed.
-        _neutralMonsterStrengthCache.clear();
+        // Clear the cache of guardian armies as their strength might have changed.
+        _guardianArmyStrengthCache.clear();
 
         DEBUG_LOG( DBG_AI, DBG_INFO, Color::String( myColor ) << " starts the turn: " << castles.size() << " castles, " << heroes.size() << " heroes" )
         DEBUG_LOG( DBG_AI, DBG_INFO, "Funds: " << kingdom.GetFunds().String() )
@@ -940,6 +972,10 @@ namespace AI
         }
 
         status.DrawAITurnProgress( 10 );
+
+        _lastKingdomTurnDurationMs = _turnTimer.getMs();
+
+        DEBUG_LOG( DBG_AI, DBG_INFO, Color::String( myColor ) << " finished the turn in " << _lastKingdomTurnDurationMs << " ms" )
     }
 
     bool Normal::purchaseNewHeroes( const std::vector<AICastle> & sortedCastleList, const std::set<int> & castlesInDanger, const int32_t availableHeroCount,
@@ -22,6 +22,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <map>
 #include <ostream>
 #include <vector>
 
@@ -181,12 +182,22 @@ namespace AI
             bestOutcome.updateOutcome( spellHeuristic, -1 );
         }
         else {
+            // The same units are hit from many candidate cells so the value of each unit is calculated only once.
+            std::map<const Unit *, double> unitValues;
+            auto cachedDamageHeuristic = [&damageHeuristic, &unitValues]( const Unit * unit ) {
+                const auto [iter, isInserted] = unitValues.try_emplace( unit, 0.0 );
+                if ( isInserted ) {
+                    iter->second = damageHeuristic( unit );
+                }
+                return iter->second;
+            };
+
             // Area of effect spells like Fireball
-            auto areaOfEffectCheck = [&damageHeuristic, &bestOutcome, &currentUnit, &retreating]( const TargetsInfo & targets, const int32_t index, int myColor ) {
+            auto areaOfEffectCheck = [&cachedDamageHeuristic, &bestOutcome, &currentUnit, &retreating]( const TargetsInfo & targets, const int32_t index, int myColor ) {
                 double spellHeuristic = 0;
                 for ( const TargetInfo & target : targets ) {
                     if ( target.defender->GetCurrentColor() == myColor ) {
-                        const double valueLost = damageHeuristic( target.defender );
+                        const double valueLost = cachedDamageHeuristic( target.defender );
                         // check if we're retreating and will lose current unit
                         if ( retreating && target.defender->isUID( currentUnit.GetUID() ) && std::fabs( valueLost - target.defender->GetStrength() ) < 0.001 ) {
                             // avoid this spell and return without updating the outcome
@@ -195,7 +206,7 @@ namespace AI
                         spellHeuristic -= valueLost;
                     }
                     else {
-                        spellHeuristic += damageHeuristic( target.defender );
+                        spellHeuristic += cachedDamageHeuristic( target.defender );
                     }
                 }
 
@@ -209,14 +220,14 @@ namespace AI
                     }
 
                     const int32_t index = enemy->GetHeadIndex();
-                    areaOfEffectCheck( arena.GetTargetsForSpells( _commander, spell, index ), index, _myColor );
+                    areaOfEffectCheck( arena.getPotentialSpellTargets( _commander, spell, index ), index, _myColor );
                 }
             }
             else {
                 const Board & board = *Arena::GetBoard();
                 for ( const Cell & cell : board ) {
                     const int32_t index = cell.GetIndex();
-                    areaOfEffectCheck( arena.GetTargetsForSpells( _commander, spell, index ), index, _myColor );
+                    areaOfEffectCheck( arena.getPotentialSpellTargets( _commander, spell, index ), index, _myColor );
                 }
             }
         }
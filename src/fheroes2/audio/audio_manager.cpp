@@ -189,16 +189,21 @@ namespace
     };
 
     std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
+    bool getDataFromAggFile( const std::string & key, const bool ignoreExpansion, std::vector<uint8_t> & output, const size_t offset );
 
     void LoadWAV( int m82, std::vector<uint8_t> & v )
     {
         DEBUG_LOG( DBG_GAME, DBG_TRACE, M82::GetString( m82 ) )
-        const std::vector<uint8_t> & body = getDataFromAggFile( M82::GetString( m82 ), false );
 
-        if ( !body.empty() ) {
-            StreamBuf wavHeader( 44 );
+        const size_t wavHeaderSize = 44;
+
+        // Read the sound data right after the space reserved for the WAV header to avoid copying it.
+        if ( getDataFromAggFile( M82::GetString( m82 ), false, v, wavHeaderSize ) ) {
+            const uint32_t bodySize = static_cast<uint32_t>( v.size() - wavHeaderSize );
+
+            StreamBuf wavHeader( wavHeaderSize );
             wavHeader.putLE32( 0x46464952 ); // RIFF marker ("RIFF")
-            wavHeader.putLE32( static_cast<uint32_t>( body.size() ) + 0x24 ); // Total size minus the size of this and previous fields
+            wavHeader.putLE32( bodySize + 0x24 ); // Total size minus the size of this and previous fields
             wavHeader.putLE32( 0x45564157 ); // File type header ("WAVE")
             wavHeader.putLE32( 0x20746D66 ); // Format sub-chunk marker ("fmt ")
             wavHeader.putLE32( 0x10 ); // Size of the format sub-chunk
@@ -209,12 +214,87 @@ namespace
             wavHeader.putLE16( 0x01 ); // Block align (BitsPerSample * NumberOfChannels) / 8
             wavHeader.putLE16( 0x08 ); // Bits per sample
             wavHeader.putLE32( 0x61746164 ); // Data sub-chunk marker ("data")
-            wavHeader.putLE32( static_cast<uint32_t>( body.size() ) ); // Size of the data sub-chunk
+            wavHeader.putLE32( bodySize ); // Size of the data sub-chunk
+
+            std::copy( wavHeader.data(), wavHeader.data() + wavHeaderSize, v.begin() );
+        }
+    }
+
+    // Increase this version every time the format of the MIDI cache file or the XMI to MIDI conversion changes
+    const uint16_t midiCacheFormatVersion = 1;
+
+    // Converted MIDI track, which is stored in the MIDI cache file to avoid XMI conversion on every run.
+    struct MidiCacheEntry
+    {
+        // Checksum of the original XMI data to detect changes of AGG files
+        uint32_t xmiChecksum{ 0 };
+        std::vector<uint8_t> midi;
+    };
+
+    std::map<int, MidiCacheEntry> midiFileCache;
+    bool isMidiFileCacheLoaded{ false };
+    bool isMidiFileCacheModified{ false };
+
+    std::string getMidiCacheFilePath()
+    {
+        return System::concatPath( System::GetDataDirectory( "fheroes2" ), "midi.cache" );
+    }
+
+    void loadMidiFileCache()
+    {
+        isMidiFileCacheLoaded = true;
+
+        StreamFile fs;
+        fs.setbigendian( true );
+
+        if ( !fs.open( getMidiCacheFilePath(), "rb" ) ) {
+            return;
+        }
+
+        uint16_t cacheFormatVersion = 0;
+        uint32_t entryCount = 0;
+
+        fs >> cacheFormatVersion >> entryCount;
+
+        if ( fs.fail() || cacheFormatVersion != midiCacheFormatVersion ) {
+            return;
+        }
+
+        for ( uint32_t i = 0; i < entryCount && !fs.fail(); ++i ) {
+            int32_t xmi = XMI::UNKNOWN;
+            MidiCacheEntry entry;
+
+            fs >> xmi >> entry.xmiChecksum >> entry.midi;
+
+            midiFileCache[xmi] = std::move( entry );
+        }
+
+        if ( fs.fail() ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "MIDI cache file is corrupted" )
+            midiFileCache.clear();
+        }
+    }
+
+    void saveMidiFileCache()
+    {
+        if ( !isMidiFileCacheModified ) {
+            return;
+        }
+
+        StreamFile fs;
+        fs.setbigendian( true );
+
+        if ( !fs.open( getMidiCacheFilePath(), "wb" ) ) {
+            return;
+        }
+
+        fs << midiCacheFormatVersion << static_cast<uint32_t>( midiFileCache.size() );
 
-            v.reserve( body.size() + 44 );
-            v.assign( wavHeader.data(), wavHeader.data() + 44 );
-            v.insert( v.begin() + 44, body.begin(), body.end() );
+        for ( const auto & [xmi, entry] : midiFileCache ) {
+            fs << static_cast<int32_t>( xmi ) << entry.xmiChecksum << entry.midi;
         }
+
+        isMidiFileCacheModified = false;
     }
 
     void LoadMID( int xmi, std::vector<uint8_t> & v )
@@ -222,9 +302,25 @@ namespace
         DEBUG_LOG( DBG_GAME, DBG_TRACE, XMI::GetString( xmi ) )
         const std::vector<uint8_t> & body = getDataFromAggFile( XMI::GetString( xmi ), xmi >= XMI::MIDI_ORIGINAL_KNIGHT );
 
-        if ( !body.empty() ) {
-            v = Music::Xmi2Mid( body );
+        if ( body.empty() ) {
+            return;
+        }
+
+        if ( !isMidiFileCacheLoaded ) {
+            loadMidiFileCache();
+        }
+
+        const uint32_t xmiChecksum = fheroes2::calculateCRC32( body.data(), body.size() );
+
+        MidiCacheEntry & entry = midiFileCache[xmi];
+        if ( entry.xmiChecksum != xmiChecksum || entry.midi.empty() ) {
+            entry.xmiChecksum = xmiChecksum;
+            entry.midi = Music::Xmi2Mid( body );
+
+            isMidiFileCacheModified = true;
         }
+
+        v = entry.midi;
     }
 
     std::map<int, std::vector<uint8_t>> wavDataCache;
@@ -252,6 +348,8 @@ namespace
 
     // Returns sound Channel ID, when error - returns `-1`.
     int PlaySoundImp( const int m82, const int soundVolume );
+    void preloadSoundImp( const int m82 );
+    void prepareMusicImp( const int xmi );
     void PlayMusicImp( const int trackId, const MusicSource musicType, const Music::PlaybackMode playbackMode );
     void playLoopSoundsImp( std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> soundEffects, const int soundVolume, const bool is3DAudioEnabled );
 
@@ -294,6 +392,28 @@ namespace
             notifyWorker();
         }
 
+        void pushPreloadSounds( const std::vector<int> & m82Sounds )
+        {
+            createWorker();
+
+            std::scoped_lock<std::mutex> lock( _mutex );
+
+            _soundsToPreload.insert( _soundsToPreload.end(), m82Sounds.begin(), m82Sounds.end() );
+
+            notifyWorker();
+        }
+
+        void pushPrepareMusic( const std::vector<int> & xmiTracks )
+        {
+            createWorker();
+
+            std::scoped_lock<std::mutex> lock( _mutex );
+
+            _musicToPrepare.insert( _musicToPrepare.end(), xmiTracks.begin(), xmiTracks.end() );
+
+            notifyWorker();
+        }
+
         void removeMusicTask()
         {
             std::scoped_lock<std::mutex> lock( _mutex );
@@ -340,6 +460,8 @@ namespace
             _musicTask.reset();
             _soundTasks.clear();
             _loopSoundTask.reset();
+            _soundsToPreload.clear();
+            _musicToPrepare.clear();
 
             _taskToExecute = TaskType::None;
         }
@@ -356,7 +478,9 @@ namespace
             None,
             PlayMusic,
             PlaySound,
-            PlayLoopSound
+            PlayLoopSound,
+            PreloadSound,
+            PrepareMusic
         };
 
         struct MusicTask
@@ -411,10 +535,14 @@ namespace
         std::optional<MusicTask> _musicTask;
         std::deque<SoundTask> _soundTasks;
         std::optional<LoopSoundTask> _loopSoundTask;
+        std::deque<int> _soundsToPreload;
+        std::deque<int> _musicToPrepare;
 
         MusicTask _currentMusicTask;
         SoundTask _currentSoundTask;
         LoopSoundTask _currentLoopSoundTask;
+        int _currentSoundToPreload{ M82::UNKNOWN };
+        int _currentMusicToPrepare{ XMI::UNKNOWN };
 
         std::atomic<TaskType> _taskToExecute{ TaskType::None };
 
@@ -450,6 +578,25 @@ namespace
                 return true;
             }
 
+            // Sounds are preloaded one by one only when there is nothing to play so the resource mutex is never held for long.
+            if ( !_soundsToPreload.empty() ) {
+                _currentSoundToPreload = _soundsToPreload.front();
+                _soundsToPreload.pop_front();
+
+                _taskToExecute = TaskType::PreloadSound;
+
+                return true;
+            }
+
+            if ( !_musicToPrepare.empty() ) {
+                _currentMusicToPrepare = _musicToPrepare.front();
+                _musicToPrepare.pop_front();
+
+                _taskToExecute = TaskType::PrepareMusic;
+
+                return true;
+            }
+
             _taskToExecute = TaskType::None;
 
             return false;
@@ -476,6 +623,12 @@ namespace
             case TaskType::PlayLoopSound:
                 playLoopSoundsImp( std::move( _currentLoopSoundTask.soundEffects ), _currentLoopSoundTask.soundVolume, _currentLoopSoundTask.is3DAudioEnabled );
                 return;
+            case TaskType::PreloadSound:
+                preloadSoundImp( _currentSoundToPreload );
+                return;
+            case TaskType::PrepareMusic:
+                prepareMusicImp( _currentMusicToPrepare );
+                return;
             default:
                 // How is it even possible? Did you add a new task?
                 assert( 0 );
@@ -508,6 +661,15 @@ namespace
         return g_midiHeroes2AGG.read( key );
     }
 
+    bool getDataFromAggFile( const std::string & key, const bool ignoreExpansion, std::vector<uint8_t> & output, const size_t offset )
+    {
+        if ( !ignoreExpansion && g_midiHeroes2xAGG.isGood() && g_midiHeroes2xAGG.read( key, output, offset ) ) {
+            return true;
+        }
+
+        return g_midiHeroes2AGG.read( key, output, offset );
+    }
+
     AsyncSoundManager g_asyncSoundManager;
 
     int PlaySoundImp( const int m82, const int soundVolume )
@@ -521,7 +683,7 @@ namespace
             return -1;
         }
 
-        const int channelId = Mixer::Play( &v[0], static_cast<uint32_t>( v.size() ), -1, false );
+        const int channelId = Mixer::Play( &v[0], static_cast<uint32_t>( v.size() ), -1, false, m82 );
         if ( channelId < 0 ) {
             // Failed to get a free channel.
             return -1;
@@ -651,6 +813,25 @@ namespace
         currentAudioLoopEffects.clear();
     }
 
+    void preloadSoundImp( const int m82 )
+    {
+        std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
+
+        const std::vector<uint8_t> & v = GetWAV( m82 );
+        if ( v.empty() ) {
+            return;
+        }
+
+        Mixer::preloadSample( m82, &v[0], static_cast<uint32_t>( v.size() ) );
+    }
+
+    void prepareMusicImp( const int xmi )
+    {
+        std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
+
+        GetMID( xmi );
+    }
+
     void playLoopSoundsImp( std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> soundEffects, const int soundVolume, const bool is3DAudioEnabled )
     {
         std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
@@ -787,10 +968,11 @@ namespace
 
                 int channelId = -1;
                 if ( is3DAudioEnabled ) {
-                    channelId = Mixer::PlayFromDistance( &audioData[0], static_cast<uint32_t>( audioData.size() ), -1, true, info.angle, info.volumePercentage );
+                    channelId
+                        = Mixer::PlayFromDistance( &audioData[0], static_cast<uint32_t>( audioData.size() ), -1, true, info.angle, info.volumePercentage, soundType );
                 }
                 else {
-                    channelId = Mixer::Play( &audioData[0], static_cast<uint32_t>( audioData.size() ), -1, true );
+                    channelId = Mixer::Play( &audioData[0], static_cast<uint32_t>( audioData.size() ), -1, true, soundType );
                 }
 
                 if ( channelId < 0 ) {
@@ -843,6 +1025,16 @@ namespace AudioManager
         if ( !expansionAGGFilePath.empty() && !g_midiHeroes2xAGG.open( expansionAGGFilePath ) ) {
             VERBOSE_LOG( "Failed to open HEROES2X.AGG file for audio playback." )
         }
+
+        if ( Audio::isValid() ) {
+            // Convert all MIDI tracks in the background so switching music never has to wait for it.
+            std::vector<int> xmiTracks;
+            for ( int xmi = XMI::MIDI0002; xmi <= XMI::MIDI_ORIGINAL_NECROMANCER; ++xmi ) {
+                xmiTracks.push_back( xmi );
+            }
+
+            g_asyncSoundManager.pushPrepareMusic( xmiTracks );
+        }
     }
 
     AudioInitializer::~AudioInitializer()
@@ -850,8 +1042,12 @@ namespace AudioManager
         g_asyncSoundManager.removeAllTasks();
         g_asyncSoundManager.stopWorker();
 
+        saveMidiFileCache();
+
         wavDataCache.clear();
         MIDDataCache.clear();
+        midiFileCache.clear();
+        isMidiFileCacheLoaded = false;
         currentAudioLoopEffects.clear();
     }
 
@@ -906,11 +1102,50 @@ namespace AudioManager
         g_asyncSoundManager.pushSound( m82, Settings::Get().SoundVolume() );
     }
 
+    void preloadSoundsAsync( const std::vector<int> & m82Sounds )
+    {
+        if ( !Audio::isValid() ) {
+            return;
+        }
+
+        std::vector<int> sounds;
+        sounds.reserve( m82Sounds.size() );
+
+        for ( const int m82 : m82Sounds ) {
+            if ( m82 != M82::UNKNOWN && std::find( sounds.begin(), sounds.end(), m82 ) == sounds.end() ) {
+                sounds.push_back( m82 );
+            }
+        }
+
+        g_asyncSoundManager.pushPreloadSounds( sounds );
+    }
+
     bool isExternalMusicFileAvailable( const int trackId )
     {
         return !getExternalMusicFile( trackId ).empty();
     }
 
+    size_t getCacheMemoryUsage()
+    {
+        std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
+
+        size_t usedMemory = 0;
+
+        for ( const auto & [m82, data] : wavDataCache ) {
+            usedMemory += data.capacity();
+        }
+
+        for ( const auto & [xmi, data] : MIDDataCache ) {
+            usedMemory += data.capacity();
+        }
+
+        for ( const auto & [xmi, entry] : midiFileCache ) {
+            usedMemory += entry.midi.capacity();
+        }
+
+        return usedMemory;
+    }
+
     void PlayMusic( const int trackId, const Music::PlaybackMode playbackMode )
     {
         if ( !Audio::isValid() ) {
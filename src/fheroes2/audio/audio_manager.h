@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
@@ -93,6 +94,9 @@ namespace AudioManager
     int PlaySound( const int m82 );
     void PlaySoundAsync( const int m82 );
 
+    // Loads and decodes the given sounds in the background so their first playback does not have to wait for it.
+    void preloadSoundsAsync( const std::vector<int> & m82Sounds );
+
     // Returns true if an external music file is available for the music track with the specified ID, otherwise returns false.
     bool isExternalMusicFileAvailable( const int trackId );
 
@@ -110,4 +114,7 @@ namespace AudioManager
 
     void stopSounds();
     void ResetAudio();
+
+    // Returns the memory in bytes occupied by the cached sound and music data.
+    size_t getCacheMemoryUsage();
 }
@@ -300,6 +300,8 @@ void Battle::Arena::ApplyAction( Command & cmd )
     default:
         break;
     }
+
+    _scoreQualityCache.clear();
 }
 
 void Battle::Arena::ApplyActionSpellCast( Command & cmd )
@@ -836,6 +838,17 @@ Battle::TargetsInfo Battle::Arena::TargetsForChainLightning( const HeroBase * he
 }
 
 Battle::TargetsInfo Battle::Arena::GetTargetsForSpells( const HeroBase * hero, const Spell & spell, int32_t dest, bool * playResistSound /* = nullptr */ )
+{
+    return getSpellTargets( hero, spell, dest, true, playResistSound );
+}
+
+Battle::TargetsInfo Battle::Arena::getPotentialSpellTargets( const HeroBase * hero, const Spell & spell, const int32_t dest )
+{
+    return getSpellTargets( hero, spell, dest, false, nullptr );
+}
+
+Battle::TargetsInfo Battle::Arena::getSpellTargets( const HeroBase * hero, const Spell & spell, const int32_t dest, const bool applyMagicResistance,
+                                                    bool * playResistSound )
 {
     TargetsInfo targets;
     targets.reserve( 8 );
@@ -961,7 +974,7 @@ Battle::TargetsInfo Battle::Arena::GetTargetsForSpells( const HeroBase * hero, c
         }
     }
 
-    if ( !ignoreMagicResistance ) {
+    if ( applyMagicResistance && !ignoreMagicResistance ) {
         // Mark magically resistant troops
         for ( auto & tgt : targets ) {
             const uint32_t resist = tgt.defender->GetMagicResist( spell, hero ? hero->GetPower() : 0, hero );
@@ -434,15 +434,46 @@ uint32_t AnimationReference::getIdleDelay() const
     return _monsterInfo.idleAnimationDelay;
 }
 
+const std::vector<int> & AnimationReference::getSubsequenceOffset( const size_t subsequence ) const
+{
+    if ( subsequence < _offsetX.size() ) {
+        return _offsetX[subsequence];
+    }
+
+    static const std::vector<int> empty;
+    return empty;
+}
+
+const AnimationReference & AnimationReference::get( const int monsterID )
+{
+    // Animation data never changes after the game resources are loaded so it is built only once for every monster type.
+    static const std::vector<std::unique_ptr<AnimationReference>> references = []() {
+        std::vector<std::unique_ptr<AnimationReference>> result;
+        result.reserve( Monster::WATER_ELEMENT + 1 );
+
+        for ( int id = Monster::UNKNOWN; id <= Monster::WATER_ELEMENT; ++id ) {
+            result.emplace_back( std::make_unique<AnimationReference>( id ) );
+        }
+
+        return result;
+    }();
+
+    if ( monsterID < Monster::UNKNOWN || monsterID > Monster::WATER_ELEMENT ) {
+        return *references[Monster::UNKNOWN];
+    }
+
+    return *references[monsterID];
+}
+
 AnimationState::AnimationState( int monsterID )
-    : AnimationReference( monsterID )
+    : _reference( AnimationReference::get( monsterID ) )
     , _animState( Monster_Info::STATIC )
-    , _currentSequence( _static )
+    , _currentSequence( _reference.getAnimationVector( Monster_Info::STATIC ) )
 {}
 
 bool AnimationState::switchAnimation( int animState, bool reverse )
 {
-    std::vector<int> seq = getAnimationVector( animState );
+    std::vector<int> seq = _reference.getAnimationVector( animState );
     if ( !seq.empty() ) {
         _animState = animState;
         if ( reverse )
@@ -462,7 +493,7 @@ bool AnimationState::switchAnimation( const std::vector<int> & animationList, bo
     std::vector<int> combinedAnimation;
 
     for ( std::vector<int>::const_iterator it = animationList.begin(); it != animationList.end(); ++it ) {
-        const std::vector<int> & seq = getAnimationVector( *it );
+        const std::vector<int> & seq = _reference.getAnimationVector( *it );
         if ( !seq.empty() ) {
             _animState = *it;
             combinedAnimation.insert( combinedAnimation.end(), seq.begin(), seq.end() );
@@ -548,9 +579,10 @@ int32_t AnimationState::getCurrentFrameXOffset() const
     // Get frame offset from _offsetX, analyzing in which subsequence it is.
     for ( const int32_t animSubsequence : animSubsequences ) {
         // Get the current subsequence end (it is the frame number after the last subsequence frame).
-        const size_t subequenceEnd = _offsetX[animSubsequence].size() + subequenceStart;
+        const std::vector<int> & subsequenceOffset = _reference.getSubsequenceOffset( animSubsequence );
+        const size_t subequenceEnd = subsequenceOffset.size() + subequenceStart;
         if ( currentFrame < subequenceEnd ) {
-            return _offsetX[animSubsequence][currentFrame - subequenceStart];
+            return subsequenceOffset[currentFrame - subequenceStart];
         }
         subequenceStart = subequenceEnd;
     }
@@ -80,14 +80,21 @@ protected:
     size_t _currentFrame;
 };
 
+// Immutable animation data of a monster type. Use get() to obtain the shared instance instead of building a copy per unit.
 class AnimationReference
 {
 public:
     AnimationReference();
     explicit AnimationReference( int id );
 
+    AnimationReference( const AnimationReference & ) = delete;
+
     virtual ~AnimationReference() = default;
 
+    AnimationReference & operator=( const AnimationReference & ) = delete;
+
+    static const AnimationReference & get( const int monsterID );
+
     const std::vector<int> & getAnimationVector( int animState ) const;
     std::vector<int> getAnimationOffset( int animState ) const;
     uint32_t getMoveSpeed() const;
@@ -98,6 +105,9 @@ public:
     int getTroopCountOffset( bool isReflect ) const;
     uint32_t getIdleDelay() const;
 
+    // Returns horizontal offsets of the given movement subsequence (Bin_Info::MonsterAnimInfo::MOVE_START, MOVE_MAIN, etc.).
+    const std::vector<int> & getSubsequenceOffset( const size_t subsequence ) const;
+
 protected:
     int _monsterID;
     Bin_Info::MonsterAnimInfo _monsterInfo;
@@ -120,11 +130,14 @@ protected:
     bool appendFrames( std::vector<int> & target, int animID );
 };
 
-class AnimationState : public AnimationReference
+// Per-unit animation cursor. The frame data itself is shared between all units of the same monster type.
+class AnimationState
 {
 public:
     explicit AnimationState( int monsterID );
-    ~AnimationState() override = default;
+
+    AnimationState( const AnimationState & ) = delete;
+    AnimationState & operator=( const AnimationState & ) = delete;
 
     bool switchAnimation( int animstate, bool reverse = false );
     bool switchAnimation( const std::vector<int> & animationList, bool reverse = false );
@@ -142,7 +155,43 @@ public:
     bool isLastFrame() const;
     bool isValid() const;
 
+    uint32_t getMoveSpeed() const
+    {
+        return _reference.getMoveSpeed();
+    }
+
+    uint32_t getFlightSpeed() const
+    {
+        return _reference.getFlightSpeed();
+    }
+
+    uint32_t getShootingSpeed() const
+    {
+        return _reference.getShootingSpeed();
+    }
+
+    fheroes2::Point getBlindOffset() const
+    {
+        return _reference.getBlindOffset();
+    }
+
+    fheroes2::Point getProjectileOffset( size_t direction ) const
+    {
+        return _reference.getProjectileOffset( direction );
+    }
+
+    int getTroopCountOffset( bool isReflect ) const
+    {
+        return _reference.getTroopCountOffset( isReflect );
+    }
+
+    uint32_t getIdleDelay() const
+    {
+        return _reference.getIdleDelay();
+    }
+
 private:
+    const AnimationReference & _reference;
     int _animState;
     AnimationSequence _currentSequence;
 };
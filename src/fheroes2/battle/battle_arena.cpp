@@ -26,7 +26,6 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
-#include <functional>
 #include <iterator>
 #include <ostream>
 #include <random>
@@ -61,6 +60,7 @@
 #include "math_base.h"
 #include "monster.h"
 #include "players.h"
+#include "profiler.h"
 #include "rand.h"
 #include "skill.h"
 #include "speed.h"
@@ -71,7 +71,8 @@
 
 namespace
 {
-    Battle::Arena * arena = nullptr;
+    // Every thread can run its own battle, so the current arena is tracked per thread
+    thread_local Battle::Arena * arena = nullptr;
 
     // Compute a new seed from a list of actions, so random actions happen differently depending on user inputs
     uint32_t UpdateRandomSeed( const uint32_t seed, const Battle::Actions & actions )
@@ -140,36 +141,51 @@ namespace
         return covrs.empty() ? ICN::UNKNOWN : Rand::GetWithGen( covrs, gen );
     }
 
-    Battle::Unit * GetCurrentUnit( Battle::Units & units1, Battle::Units & units2, const bool units1GoFirst, const bool ordersMode )
-    {
-        Battle::Unit * result = nullptr;
+    // A unit which is able to act on the current turn along with its speed. The speed is evaluated only once per order calculation.
+    using UnitSpeed = std::pair<Battle::Unit *, uint32_t>;
 
-        std::function<bool( const Battle::Unit * )> unitFilter = []( const Battle::Unit * unit ) { return unit->GetSpeed() > Speed::STANDING; };
+    // Returns the units of a given army which are able to act on the current turn, sorted from the fastest to the slowest while
+    // keeping the order of units with the same speed.
+    std::vector<UnitSpeed> getActingUnitsBySpeed( const Battle::Force & army )
+    {
+        std::vector<UnitSpeed> result;
+        result.reserve( army.getUnits().size() );
 
-        Battle::Units::iterator it1 = std::find_if( units1.begin(), units1.end(), unitFilter );
-        Battle::Units::iterator it2 = std::find_if( units2.begin(), units2.end(), unitFilter );
+        for ( Battle::Unit * unit : army.getUnits() ) {
+            assert( unit != nullptr );
 
-        if ( it1 != units1.end() && it2 != units2.end() ) {
-            if ( ( *it1 )->GetSpeed() == ( *it2 )->GetSpeed() ) {
-                result = units1GoFirst ? *it1 : *it2;
+            if ( !unit->isValid() ) {
+                continue;
             }
-            else {
-                result = ( ( *it1 )->GetSpeed() > ( *it2 )->GetSpeed() ) ? *it1 : *it2;
+
+            const uint32_t speed = unit->GetSpeed();
+            if ( speed > Speed::STANDING ) {
+                result.emplace_back( unit, speed );
             }
         }
-        else if ( it1 != units1.end() ) {
-            result = *it1;
-        }
-        else if ( it2 != units2.end() ) {
-            result = *it2;
-        }
 
-        if ( result && ordersMode ) {
-            if ( it1 != units1.end() && result == *it1 ) {
-                units1.erase( it1 );
+        std::stable_sort( result.begin(), result.end(), []( const UnitSpeed & first, const UnitSpeed & second ) { return first.second > second.second; } );
+
+        return result;
+    }
+
+    // Returns the first of the fastest units of a given army which are able to act on the current turn, or nullptr if there are no such units.
+    Battle::Unit * getFastestActingUnit( const Battle::Force & army, uint32_t & fastestSpeed )
+    {
+        Battle::Unit * result = nullptr;
+        fastestSpeed = Speed::STANDING;
+
+        for ( Battle::Unit * unit : army.getUnits() ) {
+            assert( unit != nullptr );
+
+            if ( !unit->isValid() ) {
+                continue;
             }
-            else if ( it2 != units2.end() && result == *it2 ) {
-                units2.erase( it2 );
+
+            const uint32_t speed = unit->GetSpeed();
+            if ( speed > fastestSpeed ) {
+                result = unit;
+                fastestSpeed = speed;
             }
         }
 
@@ -178,20 +194,24 @@ namespace
 
     Battle::Unit * GetCurrentUnit( const Battle::Force & army1, const Battle::Force & army2, const int preferredColor )
     {
-        Battle::Units units1( army1.getUnits(), true );
-        Battle::Units units2( army2.getUnits(), true );
+        uint32_t speed1 = Speed::STANDING;
+        uint32_t speed2 = Speed::STANDING;
 
-        units1.SortFastest();
-        units2.SortFastest();
+        Battle::Unit * unit1 = getFastestActingUnit( army1, speed1 );
+        Battle::Unit * unit2 = getFastestActingUnit( army2, speed2 );
 
-        Battle::Unit * result = GetCurrentUnit( units1, units2, preferredColor != army2.GetColor(), false );
-        if ( result == nullptr ) {
-            return result;
+        if ( unit1 == nullptr ) {
+            return unit2;
+        }
+        if ( unit2 == nullptr ) {
+            return unit1;
         }
 
-        assert( result->isValid() );
+        if ( speed1 == speed2 ) {
+            return ( preferredColor != army2.GetColor() ) ? unit1 : unit2;
+        }
 
-        return result;
+        return ( speed1 > speed2 ) ? unit1 : unit2;
     }
 
     void UpdateOrderOfUnits( const Battle::Force & army1, const Battle::Force & army2, const Battle::Unit * currentUnit, int preferredColor,
@@ -199,20 +219,21 @@ namespace
     {
         orderOfUnits.assign( orderHistory.begin(), orderHistory.end() );
 
-        Battle::Units units1( army1.getUnits(), true );
-        Battle::Units units2( army2.getUnits(), true );
+        const std::vector<UnitSpeed> units1 = getActingUnitsBySpeed( army1 );
+        const std::vector<UnitSpeed> units2 = getActingUnitsBySpeed( army2 );
 
-        units1.SortFastest();
-        units2.SortFastest();
+        // Both lists are already sorted so they just have to be merged, the army whose unit acted last yields on equal speeds
+        auto it1 = units1.begin();
+        auto it2 = units2.begin();
 
-        while ( true ) {
-            Battle::Unit * unit = GetCurrentUnit( units1, units2, preferredColor != army2.GetColor(), true );
-            if ( unit == nullptr ) {
-                break;
-            }
+        while ( it1 != units1.end() || it2 != units2.end() ) {
+            bool takeFirst = ( it2 == units2.end() );
 
-            assert( unit->isValid() );
+            if ( it1 != units1.end() && it2 != units2.end() ) {
+                takeFirst = ( it1->second == it2->second ) ? ( preferredColor != army2.GetColor() ) : ( it1->second > it2->second );
+            }
 
+            Battle::Unit * unit = takeFirst ? ( it1++ )->first : ( it2++ )->first;
             if ( unit == currentUnit ) {
                 continue;
             }
@@ -426,6 +447,9 @@ void Battle::Arena::TurnTroop( Unit * troop, const Units & orderHistory )
             return cell.GetQuality() == 0;
         } ) );
 
+        // The state of units could have been changed since the previous decision (morale, spell durations, etc.)
+        _scoreQualityCache.clear();
+
         Actions actions;
 
         if ( _interface ) {
@@ -466,9 +490,9 @@ void Battle::Arena::TurnTroop( Unit * troop, const Units & orderHistory )
         const uint32_t newSeed = UpdateRandomSeed( _randomGenerator.GetSeed(), actions );
         _randomGenerator.UpdateSeed( newSeed );
 
-        while ( !actions.empty() ) {
-            ApplyAction( actions.front() );
-            actions.pop_front();
+        // New actions can be added while the existing ones are being applied, so the index-based iteration is used here
+        for ( size_t actionIdx = 0; actionIdx < actions.size(); ++actionIdx ) {
+            ApplyAction( actions[actionIdx] );
 
             board.Reset();
 
@@ -500,6 +524,21 @@ void Battle::Arena::TurnTroop( Unit * troop, const Units & orderHistory )
     }
 }
 
+int32_t Battle::Arena::getScoreQuality( const Unit & attacker, const Unit & defender ) const
+{
+    const uint64_t key = ( static_cast<uint64_t>( attacker.GetUID() ) << 32 ) | defender.GetUID();
+
+    const auto iter = _scoreQualityCache.find( key );
+    if ( iter != _scoreQualityCache.end() ) {
+        return iter->second;
+    }
+
+    const int32_t score = attacker.calculateScoreQuality( defender );
+    _scoreQualityCache.emplace( key, score );
+
+    return score;
+}
+
 bool Battle::Arena::BattleValid() const
 {
     return _army1->isValid() && _army2->isValid() && 0 == result_game.army1 && 0 == result_game.army2;
@@ -507,6 +546,8 @@ bool Battle::Arena::BattleValid() const
 
 void Battle::Arena::Turns()
 {
+    PROFILE_ZONE( "Battle turn" );
+
     ++current_turn;
 
     DEBUG_LOG( DBG_BATTLE, DBG_TRACE, current_turn )
@@ -648,6 +689,8 @@ void Battle::Arena::TowerAction( const Tower & twr )
         return cell.GetQuality() == 0;
     } ) );
 
+    _scoreQualityCache.clear();
+
     board.SetEnemyQuality( twr );
 
     // Target unit and its quality
@@ -26,9 +26,9 @@
 
 #include <array>
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "battle.h"
@@ -61,7 +61,8 @@ namespace Battle
     class Interface;
     class Status;
 
-    class Actions : public std::list<Command>
+    // Commands are stored contiguously: an action list rarely contains more than a few commands
+    class Actions : public std::vector<Command>
     {};
 
     class TroopsUidGenerator
@@ -166,6 +167,10 @@ namespace Battle
 
         TargetsInfo GetTargetsForSpells( const HeroBase * hero, const Spell & spell, int32_t dest, bool * playResistSound = nullptr );
 
+        // Returns the units which would be affected by the spell cast at the given cell without rolling their magic resistance, so that
+        // evaluating a spell does not consume random numbers for every candidate cell. Chain Lightning targets still depend on random.
+        TargetsInfo getPotentialSpellTargets( const HeroBase * hero, const Spell & spell, const int32_t dest );
+
         bool isSpellcastDisabled() const;
         bool isDisableCastSpell( const Spell &, std::string * msg = nullptr );
 
@@ -185,6 +190,10 @@ namespace Battle
 
         bool IsShootingPenalty( const Unit &, const Unit & ) const;
 
+        // Returns the cached value of attacker.calculateScoreQuality( defender ). The cache is valid for one decision only and is
+        // reset when a new decision starts or an action is applied, since HP, spells and positions of units may change after that.
+        int32_t getScoreQuality( const Unit & attacker, const Unit & defender ) const;
+
         int GetICNCovr() const
         {
             return icn_covr;
@@ -235,6 +244,7 @@ namespace Battle
         static void TargetsApplySpell( const HeroBase * hero, const Spell & spell, TargetsInfo & targets );
 
         std::vector<int> GetCastleTargets() const;
+        TargetsInfo getSpellTargets( const HeroBase * hero, const Spell & spell, const int32_t dest, const bool applyMagicResistance, bool * playResistSound );
         TargetsInfo TargetsForChainLightning( const HeroBase * hero, int32_t attackedTroopIndex );
         std::vector<Unit *> FindChainLightningTargetIndexes( const HeroBase * hero, Unit * firstUnit );
 
@@ -302,6 +312,9 @@ namespace Battle
 
         TroopsUidGenerator _uidGenerator;
 
+        // Score quality of (attacker UID, defender UID) pairs evaluated during the current decision
+        mutable std::unordered_map<uint64_t, int32_t> _scoreQualityCache;
+
         enum
         {
             CHAIN_LIGHTNING_CREATURE_COUNT = 4
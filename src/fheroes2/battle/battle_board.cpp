@@ -28,6 +28,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
+#include <initializer_list>
 #include <memory>
 #include <ostream>
 #include <set>
@@ -51,6 +52,99 @@
 
 namespace
 {
+    constexpr bool isValidCellDirection( const int32_t index, const int dir )
+    {
+        if ( index < 0 || index >= ARENASIZE ) {
+            return false;
+        }
+
+        const int32_t x = index % ARENAW;
+        const int32_t y = index / ARENAW;
+
+        switch ( dir ) {
+        case Battle::CENTER:
+            return true;
+        case Battle::TOP_LEFT:
+            return !( 0 == y || ( 0 == x && ( y % 2 ) ) );
+        case Battle::TOP_RIGHT:
+            return !( 0 == y || ( ( ARENAW - 1 ) == x && !( y % 2 ) ) );
+        case Battle::LEFT:
+            return !( 0 == x );
+        case Battle::RIGHT:
+            return !( ( ARENAW - 1 ) == x );
+        case Battle::BOTTOM_LEFT:
+            return !( ( ARENAH - 1 ) == y || ( 0 == x && ( y % 2 ) ) );
+        case Battle::BOTTOM_RIGHT:
+            return !( ( ARENAH - 1 ) == y || ( ( ARENAW - 1 ) == x && !( y % 2 ) ) );
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    constexpr int32_t getCellIndexInDirection( const int32_t index, const int dir )
+    {
+        if ( index < 0 || index >= ARENASIZE ) {
+            return -1;
+        }
+
+        const int32_t y = index / ARENAW;
+
+        switch ( dir ) {
+        case Battle::CENTER:
+            return index;
+        case Battle::TOP_LEFT:
+            return index - ( ( y % 2 ) ? ARENAW + 1 : ARENAW );
+        case Battle::TOP_RIGHT:
+            return index - ( ( y % 2 ) ? ARENAW : ARENAW - 1 );
+        case Battle::LEFT:
+            return index - 1;
+        case Battle::RIGHT:
+            return index + 1;
+        case Battle::BOTTOM_LEFT:
+            return index + ( ( y % 2 ) ? ARENAW - 1 : ARENAW );
+        case Battle::BOTTOM_RIGHT:
+            return index + ( ( y % 2 ) ? ARENAW : ARENAW + 1 );
+        default:
+            break;
+        }
+
+        return -1;
+    }
+
+    constexpr std::array<Battle::NearbyIndexes, ARENASIZE> aroundIndexes = []() {
+        std::array<Battle::NearbyIndexes, ARENASIZE> result{};
+
+        for ( int32_t idx = 0; idx < ARENASIZE; ++idx ) {
+            // Clockwise, starting from the top left cell
+            for ( const int dir : { Battle::TOP_LEFT, Battle::TOP_RIGHT, Battle::RIGHT, Battle::BOTTOM_RIGHT, Battle::BOTTOM_LEFT, Battle::LEFT } ) {
+                if ( isValidCellDirection( idx, dir ) ) {
+                    result[idx].push_back( getCellIndexInDirection( idx, dir ) );
+                }
+            }
+        }
+
+        return result;
+    }();
+
+    // Cells where the head of a wide unit can move in one step, for a unit facing right and for a reflected unit
+    constexpr std::array<std::array<Battle::NearbyIndexes, ARENASIZE>, 2> moveWideIndexes = []() {
+        std::array<std::array<Battle::NearbyIndexes, ARENASIZE>, 2> result{};
+
+        for ( int32_t idx = 0; idx < ARENASIZE; ++idx ) {
+            for ( const bool reflect : { false, true } ) {
+                for ( const int dir : { Battle::LEFT, Battle::RIGHT, reflect ? Battle::TOP_LEFT : Battle::TOP_RIGHT, reflect ? Battle::BOTTOM_LEFT : Battle::BOTTOM_RIGHT } ) {
+                    if ( isValidCellDirection( idx, dir ) ) {
+                        result[reflect ? 1 : 0][idx].push_back( getCellIndexInDirection( idx, dir ) );
+                    }
+                }
+            }
+        }
+
+        return result;
+    }();
+
     uint32_t GetRandomObstaclePosition( std::mt19937 & gen )
     {
         return Rand::GetWithGen( 2, 8, gen ) + ( 11 * Rand::GetWithGen( 0, 8, gen ) );
@@ -142,7 +236,7 @@ void Battle::Board::SetPositionQuality( const Unit & b ) const
             continue;
         }
 
-        const Indexes around = GetAroundIndexes( *unit );
+        const NearbyIndexes around = GetAroundIndexes( *unit );
         for ( const int32_t index : around ) {
             Cell * cell2 = GetCell( index );
             if ( !cell2 || !cell2->isPassableForUnit( b ) )
@@ -213,7 +307,12 @@ uint32_t Battle::Board::GetDistance( int32_t index1, int32_t index2 )
 
 std::vector<Battle::Unit *> Battle::Board::GetNearestTroops( const Unit * startUnit, const std::vector<Battle::Unit *> & blackList )
 {
-    std::vector<std::pair<Battle::Unit *, uint32_t>> foundUnits;
+    // There are never more units on the board than a few dozens, so the buffer is reused between calls to avoid memory allocations.
+    // Chain Lightning calls this method for every next target.
+    thread_local std::vector<std::pair<Battle::Unit *, uint32_t>> foundUnits;
+    foundUnits.clear();
+
+    const int32_t startIndex = startUnit->GetHeadIndex();
 
     for ( Cell & cell : *this ) {
         Unit * cellUnit = cell.GetUnit();
@@ -221,21 +320,18 @@ std::vector<Battle::Unit *> Battle::Board::GetNearestTroops( const Unit * startU
             continue;
         }
 
+        // The black list contains only a few units
         const bool isBlackListed = std::find( blackList.begin(), blackList.end(), cellUnit ) != blackList.end();
         if ( !isBlackListed ) {
-            foundUnits.emplace_back( cellUnit, GetDistance( startUnit->GetHeadIndex(), cellUnit->GetHeadIndex() ) );
+            foundUnits.emplace_back( cellUnit, GetDistance( startIndex, cell.GetIndex() ) );
         }
     }
 
     std::sort( foundUnits.begin(), foundUnits.end(),
                []( const std::pair<Battle::Unit *, uint32_t> & first, const std::pair<Battle::Unit *, uint32_t> & second ) { return first.second < second.second; } );
 
-    std::vector<Battle::Unit *> units;
-    units.reserve( foundUnits.size() );
-
-    for ( const auto & foundUnit : foundUnits ) {
-        units.push_back( foundUnit.first );
-    }
+    std::vector<Battle::Unit *> units( foundUnits.size() );
+    std::transform( foundUnits.begin(), foundUnits.end(), units.begin(), []( const std::pair<Battle::Unit *, uint32_t> & foundUnit ) { return foundUnit.first; } );
 
     return units;
 }
@@ -283,7 +379,7 @@ int32_t Battle::Board::OptimalAttackValue( const Unit & attacker, const Unit & t
             return 0;
         }
 
-        Indexes aroundAttacker = GetAroundIndexes( position );
+        const NearbyIndexes aroundAttacker = GetAroundIndexes( position );
 
         std::set<const Unit *> unitsUnderAttack;
         Board * board = Arena::GetBoard();
@@ -364,63 +460,12 @@ int Battle::Board::DistanceFromOriginX( const int32_t index, const bool reflect
 
 bool Battle::Board::isValidDirection( const int32_t index, const int dir )
 {
-    if ( !isValidIndex( index ) ) {
-        return false;
-    }
-
-    const int32_t x = index % ARENAW;
-    const int32_t y = index / ARENAW;
-
-    switch ( dir ) {
-    case CENTER:
-        return true;
-    case TOP_LEFT:
-        return !( 0 == y || ( 0 == x && ( y % 2 ) ) );
-    case TOP_RIGHT:
-        return !( 0 == y || ( ( ARENAW - 1 ) == x && !( y % 2 ) ) );
-    case LEFT:
-        return !( 0 == x );
-    case RIGHT:
-        return !( ( ARENAW - 1 ) == x );
-    case BOTTOM_LEFT:
-        return !( ( ARENAH - 1 ) == y || ( 0 == x && ( y % 2 ) ) );
-    case BOTTOM_RIGHT:
-        return !( ( ARENAH - 1 ) == y || ( ( ARENAW - 1 ) == x && !( y % 2 ) ) );
-    default:
-        break;
-    }
-
-    return false;
+    return isValidCellDirection( index, dir );
 }
 
 int32_t Battle::Board::GetIndexDirection( const int32_t index, const int dir )
 {
-    if ( !isValidIndex( index ) ) {
-        return -1;
-    }
-
-    const int32_t y = index / ARENAW;
-
-    switch ( dir ) {
-    case CENTER:
-        return index;
-    case TOP_LEFT:
-        return index - ( ( y % 2 ) ? ARENAW + 1 : ARENAW );
-    case TOP_RIGHT:
-        return index - ( ( y % 2 ) ? ARENAW : ARENAW - 1 );
-    case LEFT:
-        return index - 1;
-    case RIGHT:
-        return index + 1;
-    case BOTTOM_LEFT:
-        return index + ( ( y % 2 ) ? ARENAW - 1 : ARENAW );
-    case BOTTOM_RIGHT:
-        return index + ( ( y % 2 ) ? ARENAW : ARENAW + 1 );
-    default:
-        break;
-    }
-
-    return -1;
+    return getCellIndexInDirection( index, dir );
 }
 
 int32_t Battle::Board::GetIndexAbsPosition( const fheroes2::Point & pt ) const
@@ -773,68 +818,30 @@ Battle::Cell * Battle::Board::GetCell( const int32_t position, const int dir /*
     return &board->at( idx );
 }
 
-Battle::Indexes Battle::Board::GetMoveWideIndexes( const int32_t head, const bool reflect )
+Battle::NearbyIndexes Battle::Board::GetMoveWideIndexes( const int32_t head, const bool reflect )
 {
     if ( !isValidIndex( head ) ) {
         return {};
     }
 
-    Indexes result;
-    result.reserve( 4 );
-
-    if ( isValidDirection( head, LEFT ) ) {
-        result.push_back( GetIndexDirection( head, LEFT ) );
-    }
-    if ( isValidDirection( head, RIGHT ) ) {
-        result.push_back( GetIndexDirection( head, RIGHT ) );
-    }
-
-    if ( reflect ) {
-        if ( isValidDirection( head, TOP_LEFT ) ) {
-            result.push_back( GetIndexDirection( head, TOP_LEFT ) );
-        }
-        if ( isValidDirection( head, BOTTOM_LEFT ) ) {
-            result.push_back( GetIndexDirection( head, BOTTOM_LEFT ) );
-        }
-    }
-    else {
-        if ( isValidDirection( head, TOP_RIGHT ) ) {
-            result.push_back( GetIndexDirection( head, TOP_RIGHT ) );
-        }
-        if ( isValidDirection( head, BOTTOM_RIGHT ) ) {
-            result.push_back( GetIndexDirection( head, BOTTOM_RIGHT ) );
-        }
-    }
-
-    return result;
+    return moveWideIndexes[reflect ? 1 : 0][head];
 }
 
-Battle::Indexes Battle::Board::GetAroundIndexes( const int32_t center )
+Battle::NearbyIndexes Battle::Board::GetAroundIndexes( const int32_t center )
 {
     if ( !isValidIndex( center ) ) {
         return {};
     }
 
-    Indexes result;
-    result.reserve( 6 );
-
-    for ( direction_t dir = TOP_LEFT; dir < CENTER; ++dir ) {
-        if ( !isValidDirection( center, dir ) ) {
-            continue;
-        }
-
-        result.push_back( GetIndexDirection( center, dir ) );
-    }
-
-    return result;
+    return aroundIndexes[center];
 }
 
-Battle::Indexes Battle::Board::GetAroundIndexes( const Unit & unit )
+Battle::NearbyIndexes Battle::Board::GetAroundIndexes( const Unit & unit )
 {
     return GetAroundIndexes( unit.GetPosition() );
 }
 
-Battle::Indexes Battle::Board::GetAroundIndexes( const Position & position )
+Battle::NearbyIndexes Battle::Board::GetAroundIndexes( const Position & position )
 {
     if ( position.GetHead() == nullptr ) {
         return {};
@@ -852,8 +859,7 @@ Battle::Indexes Battle::Board::GetAroundIndexes( const Position & position )
         return {};
     }
 
-    Indexes result;
-    result.reserve( 8 );
+    NearbyIndexes result;
 
     // Traversing cells in a clockwise direction
     if ( headIdx > tailIdx ) {
@@ -1046,12 +1052,11 @@ bool Battle::Board::CanAttackTargetFromPosition( const Unit & attacker, const Un
     return false;
 }
 
-Battle::Indexes Battle::Board::GetAdjacentEnemies( const Unit & unit )
+Battle::NearbyIndexes Battle::Board::GetAdjacentEnemies( const Unit & unit )
 {
-    Indexes result;
+    NearbyIndexes result;
     const bool isWide = unit.isWide();
     const int currentColor = unit.GetArmyColor();
-    result.reserve( isWide ? 8 : 6 );
 
     const int leftmostIndex = ( isWide && !unit.isReflect() ) ? unit.GetTailIndex() : unit.GetHeadIndex();
     const int x = leftmostIndex % ARENAW;
@@ -25,6 +25,9 @@
 #define H2BATTLE_BOARD_H
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <random>
 #include <string>
@@ -57,6 +60,53 @@ namespace Battle
 
     using Indexes = std::vector<int32_t>;
 
+    // List of cell indexes with a fixed capacity that is enough to store the indexes of all cells around a wide unit. Unlike Indexes, it never
+    // allocates memory, so it is used for the neighboring cell queries which are performed by AI and pathfinder in nested loops.
+    class NearbyIndexes
+    {
+    public:
+        constexpr NearbyIndexes() = default;
+
+        constexpr void push_back( const int32_t index )
+        {
+            assert( _size < _indexes.size() );
+
+            _indexes[_size] = index;
+            ++_size;
+        }
+
+        const int32_t * begin() const
+        {
+            return _indexes.data();
+        }
+
+        const int32_t * end() const
+        {
+            return _indexes.data() + _size;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        int32_t operator[]( const size_t idx ) const
+        {
+            assert( idx < _size );
+
+            return _indexes[idx];
+        }
+
+    private:
+        std::array<int32_t, 8> _indexes{};
+        size_t _size{ 0 };
+    };
+
     class Board : public std::vector<Cell>
     {
     public:
@@ -97,10 +147,11 @@ namespace Battle
         static bool isValidDirection( const int32_t index, const int dir );
         static int32_t GetIndexDirection( const int32_t index, const int dir );
         static Indexes GetDistanceIndexes( const int32_t center, const uint32_t radius );
-        static Indexes GetAroundIndexes( const int32_t center );
-        static Indexes GetAroundIndexes( const Unit & unit );
-        static Indexes GetAroundIndexes( const Position & position );
-        static Indexes GetMoveWideIndexes( const int32_t head, const bool reflect );
+        // Neighbors of every cell are precomputed, so these methods are cheap.
+        static NearbyIndexes GetAroundIndexes( const int32_t center );
+        static NearbyIndexes GetAroundIndexes( const Unit & unit );
+        static NearbyIndexes GetAroundIndexes( const Position & position );
+        static NearbyIndexes GetMoveWideIndexes( const int32_t head, const bool reflect );
         static bool isValidMirrorImageIndex( const int32_t index, const Unit * unit );
 
         // Checks whether a given unit is (in principle) capable of attacking during the current turn from a cell with a given index
@@ -108,7 +159,7 @@ namespace Battle
         // Checks whether this attacker is able to attack the target during the current turn from a position corresponding to a given index
         static bool CanAttackTargetFromPosition( const Unit & attacker, const Unit & target, const int32_t dst );
 
-        static Indexes GetAdjacentEnemies( const Unit & unit );
+        static NearbyIndexes GetAdjacentEnemies( const Unit & unit );
 
     private:
         void SetCobjObject( const int icn, const uint32_t dst );
@@ -1805,29 +1805,18 @@ void Battle::Interface::RedrawTroopSprite( const Unit & unit )
     }
     else if ( unit.Modes( SP_STONE ) ) {
         // Current monster can't be active if it's under Stunning effect.
-        const int monsterIcnId = unit.GetMonsterSprite();
-        fheroes2::Sprite monsterSprite = fheroes2::AGG::GetICN( monsterIcnId, unit.GetFrame() );
-        fheroes2::ApplyPalette( monsterSprite, PAL::GetPalette( PAL::PaletteType::GRAY ) );
-        drawTroopSprite( unit, monsterSprite );
+        drawTroopSprite( unit, _getPaletteAppliedUnitSprite( unit.GetMonsterSprite(), unit.GetFrame(), PAL::PaletteType::GRAY ) );
     }
     else if ( unit.Modes( CAP_MIRRORIMAGE ) ) {
-        fheroes2::Sprite monsterSprite;
-
-        if ( _currentUnit == &unit && b_current_sprite != nullptr ) {
-            monsterSprite = *b_current_sprite;
-        }
-        else {
-            const int monsterIcnId = unit.GetMonsterSprite();
-            monsterSprite = fheroes2::AGG::GetICN( monsterIcnId, unit.GetFrame() );
-        }
-
-        fheroes2::ApplyPalette( monsterSprite, PAL::GetPalette( PAL::PaletteType::MIRROR_IMAGE ) );
+        // The case of the current unit with the active sprite is handled above.
+        const int monsterIcnId = unit.GetMonsterSprite();
+        const fheroes2::Sprite & monsterSprite = _getPaletteAppliedUnitSprite( monsterIcnId, unit.GetFrame(), PAL::PaletteType::MIRROR_IMAGE );
 
         const fheroes2::Point drawnPosition = drawTroopSprite( unit, monsterSprite );
 
         if ( _currentUnit == &unit && b_current_sprite == nullptr ) {
             // Current unit's turn which is idling.
-            const fheroes2::Sprite & monsterContour = fheroes2::CreateContour( monsterSprite, _contourColor );
+            const fheroes2::Sprite & monsterContour = _getUnitContour( monsterIcnId, unit.GetFrame(), monsterSprite );
             fheroes2::Blit( monsterContour, _mainSurface, drawnPosition.x, drawnPosition.y, unit.isReflect() );
         }
     }
@@ -1841,12 +1830,49 @@ void Battle::Interface::RedrawTroopSprite( const Unit & unit )
 
         if ( _currentUnit == &unit && b_current_sprite == nullptr ) {
             // Current unit's turn which is idling.
-            const fheroes2::Sprite & monsterContour = fheroes2::CreateContour( monsterSprite, _contourColor );
+            const fheroes2::Sprite & monsterContour = _getUnitContour( monsterIcnId, unit.GetFrame(), monsterSprite );
             fheroes2::Blit( monsterContour, _mainSurface, drawnPosition.x, drawnPosition.y, unit.isReflect() );
         }
     }
 }
 
+const fheroes2::Sprite & Battle::Interface::_getUnitContour( const int monsterIcnId, const int frameId, const fheroes2::Image & monsterSprite )
+{
+    auto [iter, isInserted] = _unitContours.try_emplace( std::make_tuple( monsterIcnId, frameId, _contourColor ) );
+    if ( isInserted ) {
+        iter->second = fheroes2::CreateContour( monsterSprite, _contourColor );
+    }
+
+    return iter->second;
+}
+
+const fheroes2::Sprite & Battle::Interface::_getPaletteAppliedUnitSprite( const int monsterIcnId, const int frameId, const PAL::PaletteType paletteType )
+{
+    // Enough to hold all animation frames of several affected units.
+    const size_t maxCachedSprites = 64;
+
+    const PaletteAppliedSpriteKey key( monsterIcnId, frameId, paletteType );
+
+    auto lookupIter = _paletteAppliedUnitSpriteLookup.find( key );
+    if ( lookupIter != _paletteAppliedUnitSpriteLookup.end() ) {
+        _paletteAppliedUnitSprites.splice( _paletteAppliedUnitSprites.begin(), _paletteAppliedUnitSprites, lookupIter->second );
+        return lookupIter->second->second;
+    }
+
+    if ( _paletteAppliedUnitSprites.size() >= maxCachedSprites ) {
+        _paletteAppliedUnitSpriteLookup.erase( _paletteAppliedUnitSprites.back().first );
+        _paletteAppliedUnitSprites.pop_back();
+    }
+
+    fheroes2::Sprite sprite = fheroes2::AGG::GetICN( monsterIcnId, frameId );
+    fheroes2::ApplyPalette( sprite, PAL::GetPalette( paletteType ) );
+
+    _paletteAppliedUnitSprites.emplace_front( key, std::move( sprite ) );
+    _paletteAppliedUnitSpriteLookup.emplace( key, _paletteAppliedUnitSprites.begin() );
+
+    return _paletteAppliedUnitSprites.front().second;
+}
+
 fheroes2::Point Battle::Interface::drawTroopSprite( const Unit & unit, const fheroes2::Sprite & troopSprite )
 {
     const fheroes2::Rect & unitPosition = unit.GetRectPosition();
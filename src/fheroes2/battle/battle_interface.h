@@ -25,9 +25,12 @@
 #define H2BATTLE_INTERFACE_H
 
 #include <cstdint>
+#include <list>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -38,6 +41,7 @@
 #include "icn.h"
 #include "image.h"
 #include "math_base.h"
+#include "pal.h"
 #include "spell.h"
 #include "text.h"
 #include "ui_button.h"
@@ -350,6 +354,10 @@ namespace Battle
         void redrawPreRender();
         void RedrawArmies();
         void RedrawTroopSprite( const Unit & unit );
+        // Returns the contour of the given monster sprite frame. Contours depend only on the sprite shape so they are cached for the whole battle.
+        const fheroes2::Sprite & _getUnitContour( const int monsterIcnId, const int frameId, const fheroes2::Image & monsterSprite );
+        // Returns the monster sprite frame with the given palette applied. Only a limited number of the recently used sprites is kept.
+        const fheroes2::Sprite & _getPaletteAppliedUnitSprite( const int monsterIcnId, const int frameId, const PAL::PaletteType paletteType );
 
         fheroes2::Point drawTroopSprite( const Unit & unit, const fheroes2::Sprite & troopSprite );
 
@@ -443,6 +451,14 @@ namespace Battle
         bool _brightLandType; // used to determine current monster contour cycling colors
         uint32_t _contourCycle;
 
+        // Key is ICN ID, frame ID and contour color.
+        std::map<std::tuple<int, int, uint8_t>, fheroes2::Sprite> _unitContours;
+
+        // Recently used palette applied monster sprites, the most recent one is at the front.
+        using PaletteAppliedSpriteKey = std::tuple<int, int, PAL::PaletteType>;
+        std::list<std::pair<PaletteAppliedSpriteKey, fheroes2::Sprite>> _paletteAppliedUnitSprites;
+        std::map<PaletteAppliedSpriteKey, std::list<std::pair<PaletteAppliedSpriteKey, fheroes2::Sprite>>::iterator> _paletteAppliedUnitSpriteLookup;
+
         const Unit * _currentUnit;
         const Unit * _movingUnit;
         const Unit * _flyingUnit;
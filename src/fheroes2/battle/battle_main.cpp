@@ -24,28 +24,34 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <memory>
 #include <ostream>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "agg_image.h"
 #include "ai.h"
 #include "army.h"
 #include "army_troop.h"
 #include "artifact.h"
+#include "audio_manager.h"
 #include "battle.h"
 #include "battle_arena.h"
 #include "battle_army.h"
 #include "campaign_savedata.h"
 #include "dialog.h"
 #include "game.h"
+#include "game_delays.h"
 #include "heroes.h"
 #include "heroes_base.h"
 #include "kingdom.h"
 #include "logging.h"
 #include "monster.h"
+#include "monster_info.h"
 #include "players.h"
+#include "profiler.h"
 #include "rand.h"
 #include "settings.h"
 #include "skill.h"
@@ -156,6 +162,46 @@ namespace
         return seed;
     }
 
+    // Battle animations of monsters are large so their decoding is started as soon as the armies are known.
+    void prefetchMonsterSprites( const Army & army1, const Army & army2 )
+    {
+        std::vector<int> icnIds;
+
+        for ( const Army * army : { &army1, &army2 } ) {
+            for ( size_t i = 0; i < army->Size(); ++i ) {
+                const Troop * troop = army->GetTroop( i );
+                if ( troop->isValid() ) {
+                    icnIds.emplace_back( troop->GetMonsterSprite() );
+                }
+            }
+        }
+
+        fheroes2::AGG::prefetchICNs( icnIds );
+    }
+
+    // Monster sounds are played synchronously during the battle so they are decoded in advance.
+    void preloadMonsterSounds( const Army & army1, const Army & army2 )
+    {
+        std::vector<int> m82Sounds;
+
+        for ( const Army * army : { &army1, &army2 } ) {
+            for ( size_t i = 0; i < army->Size(); ++i ) {
+                const Troop * troop = army->GetTroop( i );
+                if ( !troop->isValid() ) {
+                    continue;
+                }
+
+                const fheroes2::MonsterSound & sounds = fheroes2::getMonsterData( troop->GetID() ).sounds;
+                for ( const int m82 : { sounds.meleeAttack, sounds.rangeAttack, sounds.movement, sounds.wince, sounds.death, sounds.takeoff, sounds.landing,
+                                        sounds.explosion } ) {
+                    m82Sounds.push_back( m82 );
+                }
+            }
+        }
+
+        AudioManager::preloadSoundsAsync( m82Sounds );
+    }
+
     uint32_t getBattleResult( const uint32_t army )
     {
         if ( army & Battle::RESULT_SURRENDER )
@@ -173,6 +219,8 @@ namespace
 
 Battle::Result Battle::Loader( Army & army1, Army & army2, int32_t mapsindex )
 {
+    PROFILE_ALLOCATIONS( "Battle" );
+
     Result result;
 
     // Validate the arguments - check if battle should even load
@@ -227,17 +275,29 @@ Battle::Result Battle::Loader( Army & army1, Army & army2, int32_t mapsindex )
         showBattle = true;
 #endif
 
+    // Battles between AI-controlled armies are shown in AI auto-control mode only to let the player follow the game, so there is no need
+    // to play their animations at the regular battle speed
+    bool isTurboBattle = false;
+
     if ( !showBattle ) {
         const Player * player1 = Players::Get( army1.GetColor() );
         const Player * player2 = Players::Get( army2.GetColor() );
 
         if ( ( player1 != nullptr && player1->isAIAutoControlMode() ) || ( player2 != nullptr && player2->isAIAutoControlMode() ) ) {
             showBattle = true;
+            isTurboBattle = true;
         }
     }
 
+    if ( showBattle ) {
+        prefetchMonsterSprites( army1, army2 );
+        preloadMonsterSounds( army1, army2 );
+    }
+
     const uint32_t battleSeed = computeBattleSeed( mapsindex, world.GetMapSeed(), army1, army2 );
 
+    Game::setTurboBattleSpeed( isTurboBattle );
+
     bool isBattleOver = false;
     while ( !isBattleOver ) {
         Rand::DeterministicRandomGenerator randomGenerator( battleSeed );
@@ -347,6 +407,8 @@ Battle::Result Battle::Loader( Army & army1, Army & army2, int32_t mapsindex )
         }
     }
 
+    Game::setTurboBattleSpeed( false );
+
     DEBUG_LOG( DBG_BATTLE, DBG_INFO, "army1 " << army1.String() )
     DEBUG_LOG( DBG_BATTLE, DBG_INFO, "army2 " << army2.String() )
 
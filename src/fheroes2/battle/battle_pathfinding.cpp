@@ -24,7 +24,6 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <set>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -42,6 +41,56 @@ namespace
 
 namespace Battle
 {
+    size_t BattlePathfinder::getNodeSlot( const BattleNodeIndex & nodeIdx )
+    {
+        const auto [headCellIdx, tailCellIdx] = nodeIdx;
+        assert( Board::isValidIndex( headCellIdx ) );
+
+        const size_t cellSlot = static_cast<size_t>( headCellIdx ) * nodeSlotsPerCell;
+
+        if ( tailCellIdx == -1 ) {
+            return cellSlot;
+        }
+
+        // The tail of a wide unit is always located in the adjacent cell of the same row
+        assert( tailCellIdx == headCellIdx - 1 || tailCellIdx == headCellIdx + 1 );
+
+        return cellSlot + ( tailCellIdx < headCellIdx ? 1 : 2 );
+    }
+
+    BattleNodeIndex BattlePathfinder::getNodeIndex( const size_t slot )
+    {
+        const int32_t headCellIdx = static_cast<int32_t>( slot / nodeSlotsPerCell );
+
+        switch ( slot % nodeSlotsPerCell ) {
+        case 0:
+            return { headCellIdx, -1 };
+        case 1:
+            return { headCellIdx, headCellIdx - 1 };
+        default:
+            return { headCellIdx, headCellIdx + 1 };
+        }
+    }
+
+    const BattleNode * BattlePathfinder::getNode( const BattleNodeIndex & nodeIdx ) const
+    {
+        const BattleNode & node = _cache[getNodeSlot( nodeIdx )];
+
+        return node._generation == _cacheGeneration ? &node : nullptr;
+    }
+
+    BattleNode & BattlePathfinder::getOrCreateNode( const BattleNodeIndex & nodeIdx )
+    {
+        BattleNode & node = _cache[getNodeSlot( nodeIdx )];
+
+        if ( node._generation != _cacheGeneration ) {
+            node = {};
+            node._generation = _cacheGeneration;
+        }
+
+        return node;
+    }
+
     void BattlePathfinder::reEvaluateIfNeeded( const Unit & unit )
     {
         assert( unit.GetHeadIndex() != -1 && ( !unit.isWide() || unit.GetTailIndex() != -1 ) );
@@ -73,8 +122,15 @@ namespace Battle
         const Castle * castle = Arena::GetCastle();
         const bool isMoatBuilt = castle && castle->isBuild( BUILD_MOAT );
 
-        _cache.clear();
-        _cache.try_emplace( _pathStart );
+        ++_cacheGeneration;
+
+        // Nodes of the previous graphs should never be mistaken for the nodes of the current one
+        if ( _cacheGeneration == 0 ) {
+            _cache.fill( {} );
+            _cacheGeneration = 1;
+        }
+
+        getOrCreateNode( _pathStart );
 
         // Flying units can land wherever they can fit
         if ( _isFlying ) {
@@ -95,7 +151,12 @@ namespace Battle
                     continue;
                 }
 
-                _cache.try_emplace( newNodeIdx, _pathStart, 1, 1 );
+                BattleNode & newNode = getOrCreateNode( newNodeIdx );
+                if ( newNode._from == BattleNodeIndex{ -1, -1 } ) {
+                    newNode._from = _pathStart;
+                    newNode._cost = 1;
+                    newNode._distance = 1;
+                }
             }
 
             return;
@@ -125,14 +186,13 @@ namespace Battle
             return -1;
         }();
 
-        std::vector<BattleNodeIndex> nodesToExplore;
-
-        nodesToExplore.reserve( ARENASIZE * 2 );
-        nodesToExplore.push_back( _pathStart );
+        _nodesToExplore.clear();
+        _nodesToExplore.reserve( ARENASIZE * 2 );
+        _nodesToExplore.push_back( _pathStart );
 
-        for ( size_t nodesToExploreIdx = 0; nodesToExploreIdx < nodesToExplore.size(); ++nodesToExploreIdx ) {
-            const BattleNodeIndex currentNodeIdx = nodesToExplore[nodesToExploreIdx];
-            const BattleNode & currentNode = _cache[currentNodeIdx];
+        for ( size_t nodesToExploreIdx = 0; nodesToExploreIdx < _nodesToExplore.size(); ++nodesToExploreIdx ) {
+            const BattleNodeIndex currentNodeIdx = _nodesToExplore[nodesToExploreIdx];
+            const BattleNode & currentNode = getOrCreateNode( currentNodeIdx );
 
             if ( _isWide ) {
                 assert( currentNodeIdx.first != -1 && currentNodeIdx.second != -1 );
@@ -169,13 +229,13 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : movementPenalty );
                     const uint32_t distance = currentNode._distance + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : 1 );
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = getOrCreateNode( newNodeIdx );
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode._from = currentNodeIdx;
                         newNode._cost = cost;
                         newNode._distance = distance;
 
-                        nodesToExplore.push_back( newNodeIdx );
+                        _nodesToExplore.push_back( newNodeIdx );
                     }
                 }
             }
@@ -208,13 +268,13 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + movementPenalty;
                     const uint32_t distance = currentNode._distance + 1;
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = getOrCreateNode( newNodeIdx );
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode._from = currentNodeIdx;
                         newNode._cost = cost;
                         newNode._distance = distance;
 
-                        nodesToExplore.push_back( newNodeIdx );
+                        _nodesToExplore.push_back( newNodeIdx );
                     }
                 }
             }
@@ -232,14 +292,12 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        if ( iter == _cache.end() ) {
+        const BattleNode * node = getNode( nodeIdx );
+        if ( node == nullptr ) {
             return false;
         }
 
-        const auto & [index, node] = *iter;
-
-        return ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node._cost <= _speed );
+        return ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node->_cost <= _speed );
     }
 
     uint32_t BattlePathfinder::getDistance( const Unit & unit, const Position & position )
@@ -250,37 +308,36 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
+        const BattleNode * node = getNode( nodeIdx );
+        assert( node != nullptr );
 
-        const auto & [index, node] = *iter;
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-        return node._distance;
+        return node->_distance;
     }
 
     Indexes BattlePathfinder::getAllAvailableMoves( const Unit & unit )
     {
         reEvaluateIfNeeded( unit );
 
-        std::set<int32_t> boardIndexes;
+        Indexes result;
+        result.reserve( ARENASIZE );
+
+        // Nodes are ordered by the head cell index, so the resulting indexes are sorted and all the nodes of the same cell are adjacent
+        for ( size_t slot = 0; slot < _cache.size(); ++slot ) {
+            const BattleNode & node = _cache[slot];
+            const BattleNodeIndex index = getNodeIndex( slot );
 
-        for ( const auto & [index, node] : _cache ) {
-            if ( index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
+            if ( node._generation != _cacheGeneration || index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
                 continue;
             }
 
-            assert( index.first != -1 );
-
-            boardIndexes.insert( index.first );
+            if ( result.empty() || result.back() != index.first ) {
+                result.push_back( index.first );
+            }
         }
 
-        Indexes result;
-
-        result.reserve( boardIndexes.size() );
-        result.assign( boardIndexes.begin(), boardIndexes.end() );
-
         return result;
     }
 
@@ -298,18 +355,18 @@ namespace Battle
         BattleNodeIndex lastReachableNodeIdx{ -1, -1 };
         BattleNodeIndex nodeIdx = targetNodeIdx;
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = getNode( nodeIdx ); node != nullptr; node = getNode( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
-            if ( index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } ) {
+            if ( index == _pathStart || node->_from == BattleNodeIndex{ -1, -1 } ) {
                 break;
             }
 
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
@@ -20,11 +20,12 @@
 
 #pragma once
 
+#include <array>
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "battle_board.h"
 
@@ -35,19 +36,6 @@ namespace Battle
 
     using BattleNodeIndex = std::pair<int32_t, int32_t>;
 
-    struct BattleNodeIndexHash final
-    {
-        std::size_t operator()( const BattleNodeIndex & index ) const noexcept
-        {
-            const uint64_t f = index.first;
-            const uint64_t s = index.second;
-
-            std::hash<uint64_t> hasher;
-
-            return hasher( ( f << 32 ) + s );
-        }
-    };
-
     struct BattleNode final
     {
         BattleNodeIndex _from = { -1, -1 };
@@ -55,6 +43,8 @@ namespace Battle
         uint32_t _cost = 0;
         // The distance to this cell, measured in the number of cells that needs to be passed to get here.
         uint32_t _distance = 0;
+        // The node belongs to the current graph only if this value matches the generation of the pathfinder cache
+        uint32_t _generation = 0;
 
         BattleNode() = default;
         BattleNode( BattleNodeIndex node, const uint32_t cost, const uint32_t distance )
@@ -92,7 +82,24 @@ namespace Battle
         // Rebuilds the graph of available positions for a given unit if necessary (if it is not already cached)
         void reEvaluateIfNeeded( const Unit & unit );
 
-        std::unordered_map<BattleNodeIndex, BattleNode, BattleNodeIndexHash> _cache;
+        // Returns the node with a given index if it belongs to the current graph, otherwise returns nullptr
+        const BattleNode * getNode( const BattleNodeIndex & nodeIdx ) const;
+
+        // Returns the node with a given index, adding an empty node to the current graph if necessary
+        BattleNode & getOrCreateNode( const BattleNodeIndex & nodeIdx );
+
+        // Each board cell has three node slots: for a unit without a tail and for a tail to the left or to the right of the head
+        static constexpr size_t nodeSlotsPerCell = 3;
+
+        static size_t getNodeSlot( const BattleNodeIndex & nodeIdx );
+        static BattleNodeIndex getNodeIndex( const size_t slot );
+
+        std::array<BattleNode, ARENASIZE * nodeSlotsPerCell> _cache;
+        // Incremented on every graph rebuild, which invalidates all nodes of the previous graph at once
+        uint32_t _cacheGeneration = 0;
+
+        // Reused between graph rebuilds to avoid memory reallocations
+        std::vector<BattleNodeIndex> _nodesToExplore;
 
         // Parameters of the unit for which the current cache is created
         BattleNodeIndex _pathStart = { -1, -1 };
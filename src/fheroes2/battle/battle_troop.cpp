@@ -1067,6 +1067,16 @@ uint32_t Battle::Unit::GetDefense() const
 }
 
 int32_t Battle::Unit::GetScoreQuality( const Unit & defender ) const
+{
+    const Arena * arena = GetArena();
+    if ( arena == nullptr ) {
+        return calculateScoreQuality( defender );
+    }
+
+    return arena->getScoreQuality( *this, defender );
+}
+
+int32_t Battle::Unit::calculateScoreQuality( const Unit & defender ) const
 {
     const Unit & attacker = *this;
 
@@ -161,7 +161,11 @@ namespace Battle
         uint32_t GetSpeed( bool skipStandingCheck, bool skipMovedCheck ) const;
         int GetControl() const override;
         uint32_t GetDamage( const Unit & ) const;
+        // Returns the value of this unit as a target for the given defender. The result is cached by the arena until the next
+        // battle action is applied, because the AI and the board evaluate the same pairs of units many times during one decision.
         int32_t GetScoreQuality( const Unit & ) const;
+        // Calculates the value returned by GetScoreQuality() bypassing the cache.
+        int32_t calculateScoreQuality( const Unit & defender ) const;
         uint32_t GetInitialCount() const;
         uint32_t GetDead() const;
         uint32_t GetHitPoints() const;
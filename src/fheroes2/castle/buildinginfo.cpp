@@ -569,7 +569,7 @@ bool BuildingInfo::DialogBuyBuilding( bool buttons ) const
     rbs.Redraw();
 
     if ( buttons ) {
-        if ( ALLOW_BUILD != castle.CheckBuyBuilding( building ) )
+        if ( ALLOW_BUILD != bcond )
             button1.disable();
 
         button1.draw();
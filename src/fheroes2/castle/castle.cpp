@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstddef>
 #include <iterator>
 #include <ostream>
 
@@ -66,6 +67,7 @@
 #include "skill.h"
 #include "spell.h"
 #include "spell_storage.h"
+#include "thread.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_dialog.h"
@@ -92,6 +94,311 @@ namespace
             gettext_noop( "Lankershire" ),  gettext_noop( "Lombard" ),     gettext_noop( "Timberhill" ),   gettext_noop( "Fenton" ),     gettext_noop( "Troy" ),
             gettext_noop( "Forder Oaks" ),  gettext_noop( "Meramec" ),     gettext_noop( "Quick Silver" ), gettext_noop( "Westmoor" ),   gettext_noop( "Willow" ),
             gettext_noop( "Sheltemburg" ),  gettext_noop( "Corackston" ) };
+
+    // Returns the requirements of the given building for the given race. Only single buildings and races are supported.
+    constexpr uint32_t calculateBuildingRequirement( const int race, const uint32_t build )
+    {
+        uint32_t requirement = 0;
+
+        switch ( build ) {
+        case BUILD_SPEC:
+            switch ( race ) {
+            case Race::WZRD:
+                requirement |= BUILD_MAGEGUILD1;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER2:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+            case Race::WZRD:
+            case Race::WRLK:
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER1;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER1;
+                requirement |= BUILD_TAVERN;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER3:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER1;
+                requirement |= BUILD_WELL;
+                break;
+
+            case Race::BARB:
+            case Race::SORC:
+            case Race::WZRD:
+            case Race::WRLK:
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER1;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER4:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER1;
+                requirement |= BUILD_TAVERN;
+                break;
+
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER1;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= BUILD_MAGEGUILD1;
+                break;
+
+            case Race::WZRD:
+            case Race::WRLK:
+                requirement |= DWELLING_MONSTER2;
+                break;
+
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= BUILD_THIEVESGUILD;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER5:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::WRLK:
+                requirement |= DWELLING_MONSTER3;
+                break;
+
+            case Race::WZRD:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= BUILD_MAGEGUILD1;
+                break;
+
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= BUILD_MAGEGUILD1;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER6:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::BARB:
+            case Race::SORC:
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            case Race::WRLK:
+            case Race::WZRD:
+                requirement |= DWELLING_MONSTER4;
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE2:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= BUILD_WELL;
+                break;
+
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER2;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE3:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::WZRD:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= BUILD_WELL;
+                break;
+
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER3;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE4:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::SORC:
+            case Race::WRLK:
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE5:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            case Race::WZRD:
+                requirement |= BUILD_SPEC;
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            case Race::NECR:
+                requirement |= BUILD_MAGEGUILD2;
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE6:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER6;
+                break;
+
+            case Race::WRLK:
+            case Race::WZRD:
+                requirement |= DWELLING_MONSTER6;
+                break;
+
+            default:
+                break;
+            }
+            break;
+        case DWELLING_UPGRADE7:
+            if ( race == Race::WRLK )
+                requirement |= DWELLING_UPGRADE6;
+            break;
+
+        default:
+            break;
+        }
+
+        return requirement;
+    }
+
+    // Number of playable races: Knight, Barbarian, Sorceress, Warlock, Wizard and Necromancer.
+    const size_t playableRaceCount = 6;
+
+    static_assert( Race::ALL == ( 1 << playableRaceCount ) - 1 );
+
+    // Requirements of all buildings for all playable races. The indices are the numbers of bits of the race and the building.
+    using BuildingRequirements = std::array<std::array<uint32_t, 32>, playableRaceCount>;
+
+    constexpr BuildingRequirements generateBuildingRequirements()
+    {
+        BuildingRequirements requirements{};
+
+        for ( size_t raceId = 0; raceId < requirements.size(); ++raceId ) {
+            for ( size_t buildId = 0; buildId < requirements[raceId].size(); ++buildId ) {
+                requirements[raceId][buildId] = calculateBuildingRequirement( 1 << raceId, static_cast<uint32_t>( 1 ) << buildId );
+            }
+        }
+
+        return requirements;
+    }
+
+    constexpr BuildingRequirements buildingRequirements = generateBuildingRequirements();
+
+    // Returns the number of the only set bit of the given value or -1 if there is no set bit or more than one.
+    int getSingleBitNumber( const uint32_t value )
+    {
+        if ( value == 0 || ( value & ( value - 1 ) ) != 0 ) {
+            return -1;
+        }
+
+        int bitNumber = 0;
+        for ( uint32_t bit = value; bit > 1; bit >>= 1 ) {
+            ++bitNumber;
+        }
+
+        return bitNumber;
+    }
 }
 
 Castle::Castle()
@@ -783,6 +1090,23 @@ void Castle::ActionNewWeek()
         return;
     }
 
+    // Neutral town: increase the garrison
+    if ( GetColor() == Color::NONE && world.GetWeekType().GetType() != WeekName::PLAGUE ) {
+        JoinRNDArmy();
+        // The probability that a town will get additional troops is 40%, castle always gets them
+        if ( isCastle() || Rand::Get( 1, 100 ) <= 40 ) {
+            JoinRNDArmy();
+        }
+    }
+}
+
+void Castle::updateWeeklyPopulation( const Week & week )
+{
+    // Skip the first week
+    if ( world.CountWeek() < 2 ) {
+        return;
+    }
+
     static const std::array<uint32_t, 12> allDwellings
         = { DWELLING_MONSTER1, DWELLING_MONSTER2, DWELLING_MONSTER3, DWELLING_MONSTER4, DWELLING_MONSTER5, DWELLING_MONSTER6,
             DWELLING_UPGRADE2, DWELLING_UPGRADE3, DWELLING_UPGRADE4, DWELLING_UPGRADE5, DWELLING_UPGRADE6, DWELLING_UPGRADE7 };
@@ -790,7 +1114,7 @@ void Castle::ActionNewWeek()
     const bool isNeutral = GetColor() == Color::NONE;
 
     // Increase the population
-    if ( world.GetWeekType().GetType() != WeekName::PLAGUE ) {
+    if ( week.GetType() != WeekName::PLAGUE ) {
         static const std::array<uint32_t, 6> basicDwellings
             = { DWELLING_MONSTER1, DWELLING_MONSTER2, DWELLING_MONSTER3, DWELLING_MONSTER4, DWELLING_MONSTER5, DWELLING_MONSTER6 };
 
@@ -828,7 +1152,7 @@ void Castle::ActionNewWeek()
         }
 
         // Week Of
-        if ( world.GetWeekType().GetType() == WeekName::MONSTERS && !world.BeginMonth() ) {
+        if ( week.GetType() == WeekName::MONSTERS && !world.BeginMonth() ) {
             for ( const uint32_t dwellingId : allDwellings ) {
                 // A building of exactly this level should be built (its upgraded versions should not be considered)
                 if ( !isExactBuildingBuilt( dwellingId ) ) {
@@ -837,7 +1161,7 @@ void Castle::ActionNewWeek()
 
                 const Monster mons( race, dwellingId );
 
-                if ( !mons.isValid() || mons.GetID() != world.GetWeekType().GetMonster() ) {
+                if ( !mons.isValid() || mons.GetID() != week.GetMonster() ) {
                     continue;
                 }
 
@@ -849,15 +1173,6 @@ void Castle::ActionNewWeek()
                 break;
             }
         }
-
-        // Neutral town: increase the garrison
-        if ( isNeutral ) {
-            JoinRNDArmy();
-            // The probability that a town will get additional troops is 40%, castle always gets them
-            if ( isCastle() || Rand::Get( 1, 100 ) <= 40 ) {
-                JoinRNDArmy();
-            }
-        }
     }
 
     // Monthly population growth bonuses should be calculated taking the weekly growth into account
@@ -865,13 +1180,13 @@ void Castle::ActionNewWeek()
         assert( world.GetMonth() > 1 );
 
         // Population halved
-        if ( world.GetWeekType().GetType() == WeekName::PLAGUE ) {
+        if ( week.GetType() == WeekName::PLAGUE ) {
             for ( uint32_t & dwellingRef : dwelling ) {
                 dwellingRef /= 2;
             }
         }
         // Month Of
-        else if ( world.GetWeekType().GetType() == WeekName::MONSTERS ) {
+        else if ( week.GetType() == WeekName::MONSTERS ) {
             for ( const uint32_t dwellingId : allDwellings ) {
                 // A building of exactly this level should be built (its upgraded versions should not be considered)
                 if ( !isExactBuildingBuilt( dwellingId ) ) {
@@ -880,7 +1195,7 @@ void Castle::ActionNewWeek()
 
                 const Monster mons( race, dwellingId );
 
-                if ( !mons.isValid() || mons.GetID() != world.GetWeekType().GetMonster() ) {
+                if ( !mons.isValid() || mons.GetID() != week.GetMonster() ) {
                     continue;
                 }
 
@@ -1167,268 +1482,14 @@ uint32_t Castle::getMonstersInDwelling( uint32_t dw ) const
 /* return requirement for building */
 uint32_t Castle::GetBuildingRequirement( uint32_t build ) const
 {
-    uint32_t requirement = 0;
-
-    switch ( build ) {
-    case BUILD_SPEC:
-        switch ( race ) {
-        case Race::WZRD:
-            requirement |= BUILD_MAGEGUILD1;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_MONSTER2:
-        switch ( race ) {
-        case Race::KNGT:
-        case Race::BARB:
-        case Race::WZRD:
-        case Race::WRLK:
-        case Race::NECR:
-            requirement |= DWELLING_MONSTER1;
-            break;
-
-        case Race::SORC:
-            requirement |= DWELLING_MONSTER1;
-            requirement |= BUILD_TAVERN;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_MONSTER3:
-        switch ( race ) {
-        case Race::KNGT:
-            requirement |= DWELLING_MONSTER1;
-            requirement |= BUILD_WELL;
-            break;
-
-        case Race::BARB:
-        case Race::SORC:
-        case Race::WZRD:
-        case Race::WRLK:
-        case Race::NECR:
-            requirement |= DWELLING_MONSTER1;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_MONSTER4:
-        switch ( race ) {
-        case Race::KNGT:
-            requirement |= DWELLING_MONSTER1;
-            requirement |= BUILD_TAVERN;
-            break;
-
-        case Race::BARB:
-            requirement |= DWELLING_MONSTER1;
-            break;
-
-        case Race::SORC:
-            requirement |= DWELLING_MONSTER3;
-            requirement |= BUILD_MAGEGUILD1;
-            break;
-
-        case Race::WZRD:
-        case Race::WRLK:
-            requirement |= DWELLING_MONSTER2;
-            break;
-
-        case Race::NECR:
-            requirement |= DWELLING_MONSTER3;
-            requirement |= BUILD_THIEVESGUILD;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_MONSTER5:
-        switch ( race ) {
-        case Race::KNGT:
-        case Race::BARB:
-            requirement |= DWELLING_MONSTER2;
-            requirement |= DWELLING_MONSTER3;
-            requirement |= DWELLING_MONSTER4;
-            break;
-
-        case Race::SORC:
-            requirement |= DWELLING_MONSTER4;
-            break;
-
-        case Race::WRLK:
-            requirement |= DWELLING_MONSTER3;
-            break;
-
-        case Race::WZRD:
-            requirement |= DWELLING_MONSTER3;
-            requirement |= BUILD_MAGEGUILD1;
-            break;
-
-        case Race::NECR:
-            requirement |= DWELLING_MONSTER2;
-            requirement |= BUILD_MAGEGUILD1;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_MONSTER6:
-        switch ( race ) {
-        case Race::KNGT:
-            requirement |= DWELLING_MONSTER2;
-            requirement |= DWELLING_MONSTER3;
-            requirement |= DWELLING_MONSTER4;
-            break;
-
-        case Race::BARB:
-        case Race::SORC:
-        case Race::NECR:
-            requirement |= DWELLING_MONSTER5;
-            break;
-
-        case Race::WRLK:
-        case Race::WZRD:
-            requirement |= DWELLING_MONSTER4;
-            requirement |= DWELLING_MONSTER5;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_UPGRADE2:
-        switch ( race ) {
-        case Race::KNGT:
-        case Race::BARB:
-            requirement |= DWELLING_MONSTER2;
-            requirement |= DWELLING_MONSTER3;
-            requirement |= DWELLING_MONSTER4;
-            break;
-
-        case Race::SORC:
-            requirement |= DWELLING_MONSTER2;
-            requirement |= BUILD_WELL;
-            break;
+    const int raceId = getSingleBitNumber( static_cast<uint32_t>( race ) );
+    const int buildId = getSingleBitNumber( build );
 
-        case Race::NECR:
-            requirement |= DWELLING_MONSTER2;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_UPGRADE3:
-        switch ( race ) {
-        case Race::KNGT:
-            requirement |= DWELLING_MONSTER2;
-            requirement |= DWELLING_MONSTER3;
-            requirement |= DWELLING_MONSTER4;
-            break;
-
-        case Race::SORC:
-            requirement |= DWELLING_MONSTER3;
-            requirement |= DWELLING_MONSTER4;
-            break;
-
-        case Race::WZRD:
-            requirement |= DWELLING_MONSTER3;
-            requirement |= BUILD_WELL;
-            break;
-
-        case Race::NECR:
-            requirement |= DWELLING_MONSTER3;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_UPGRADE4:
-        switch ( race ) {
-        case Race::KNGT:
-        case Race::BARB:
-            requirement |= DWELLING_MONSTER2;
-            requirement |= DWELLING_MONSTER3;
-            requirement |= DWELLING_MONSTER4;
-            break;
-
-        case Race::SORC:
-        case Race::WRLK:
-        case Race::NECR:
-            requirement |= DWELLING_MONSTER4;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_UPGRADE5:
-        switch ( race ) {
-        case Race::KNGT:
-            requirement |= DWELLING_MONSTER5;
-            break;
-
-        case Race::BARB:
-            requirement |= DWELLING_MONSTER5;
-            break;
-
-        case Race::WZRD:
-            requirement |= BUILD_SPEC;
-            requirement |= DWELLING_MONSTER5;
-            break;
-
-        case Race::NECR:
-            requirement |= BUILD_MAGEGUILD2;
-            requirement |= DWELLING_MONSTER5;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case DWELLING_UPGRADE6:
-        switch ( race ) {
-        case Race::KNGT:
-            requirement |= DWELLING_MONSTER6;
-            break;
-
-        case Race::WRLK:
-        case Race::WZRD:
-            requirement |= DWELLING_MONSTER6;
-            break;
-
-        default:
-            break;
-        }
-        break;
-    case DWELLING_UPGRADE7:
-        if ( race == Race::WRLK )
-            requirement |= DWELLING_UPGRADE6;
-        break;
-
-    default:
-        break;
+    if ( raceId < 0 || raceId >= static_cast<int>( playableRaceCount ) || buildId < 0 ) {
+        return 0;
     }
 
-    return requirement;
+    return buildingRequirements[raceId][buildId];
 }
 
 int Castle::CheckBuyBuilding( const uint32_t build ) const
@@ -1517,10 +1578,8 @@ int Castle::CheckBuyBuilding( const uint32_t build ) const
 
     const uint32_t requirement = Castle::GetBuildingRequirement( build );
 
-    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 ) {
-        if ( ( requirement & itr ) && !( building & itr ) ) {
-            return REQUIRES_BUILD;
-        }
+    if ( ( requirement & building ) != requirement ) {
+        return REQUIRES_BUILD;
     }
 
     if ( !GetKingdom().AllowPayment( PaymentConditions::BuyBuilding( race, build ) ) ) {
@@ -1539,19 +1598,29 @@ int Castle::GetAllBuildingStatus( const Castle & castle )
 
     const uint32_t rest = ~castle.building;
 
-    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 )
-        if ( ( rest & itr ) && ( ALLOW_BUILD == castle.CheckBuyBuilding( itr ) ) )
-            return ALLOW_BUILD;
+    // The status of each building is checked only once: ALLOW_BUILD has the highest priority, then LACK_RESOURCES, then REQUIRES_BUILD
+    int result = UNKNOWN_COND;
+
+    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 ) {
+        if ( !( rest & itr ) ) {
+            continue;
+        }
 
-    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 )
-        if ( ( rest & itr ) && ( LACK_RESOURCES == castle.CheckBuyBuilding( itr ) ) )
-            return LACK_RESOURCES;
+        const int status = castle.CheckBuyBuilding( itr );
 
-    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 )
-        if ( ( rest & itr ) && ( REQUIRES_BUILD == castle.CheckBuyBuilding( itr ) ) )
-            return REQUIRES_BUILD;
+        if ( status == ALLOW_BUILD ) {
+            return ALLOW_BUILD;
+        }
 
-    return UNKNOWN_COND;
+        if ( status == LACK_RESOURCES ) {
+            result = LACK_RESOURCES;
+        }
+        else if ( status == REQUIRES_BUILD && result == UNKNOWN_COND ) {
+            result = REQUIRES_BUILD;
+        }
+    }
+
+    return result;
 }
 
 bool Castle::AllowBuyBuilding( uint32_t build ) const
@@ -2705,6 +2774,15 @@ void AllCastles::AddCastle( Castle * castle )
     _castleTiles[center + fheroes2::Point( 0, -3 )] = id;
 }
 
+void AllCastles::NewWeek()
+{
+    const Week & week = world.GetWeekType();
+
+    MultiThreading::getThreadPool().parallelFor( 0, _castles.size(), [this, &week]( const size_t i ) { _castles[i]->updateWeeklyPopulation( week ); } );
+
+    std::for_each( _castles.begin(), _castles.end(), []( Castle * castle ) { castle->ActionNewWeek(); } );
+}
+
 void AllCastles::Scout( int colors ) const
 {
     for ( auto it = begin(); it != end(); ++it )
@@ -53,6 +53,7 @@ class HeroBase;
 class Heroes;
 class StreamBase;
 class Troop;
+class Week;
 
 enum building_t : uint32_t
 {
@@ -222,9 +223,13 @@ public:
     void ChangeColor( int );
 
     void ActionNewDay();
+    // Adds the weekly troops to the garrison of a neutral castle. Random numbers are used here so castles must be processed in a fixed order.
     void ActionNewWeek();
     void ActionNewMonth() const;
 
+    // Grows the dwelling population at the beginning of a week. Only this castle is modified so castles can be processed in parallel.
+    void updateWeeklyPopulation( const Week & week );
+
     void ActionPreBattle();
     void ActionAfterBattle( bool attacker_wins );
 
@@ -427,10 +432,7 @@ public:
         std::for_each( _castles.begin(), _castles.end(), []( Castle * castle ) { castle->ActionNewDay(); } );
     }
 
-    void NewWeek()
-    {
-        std::for_each( _castles.begin(), _castles.end(), []( Castle * castle ) { castle->ActionNewWeek(); } );
-    }
+    void NewWeek();
 
     void NewMonth()
     {
@@ -189,11 +189,13 @@ namespace
             const fheroes2::Key cancelEventKey = Game::getHotKeyForEvent( Game::HotKeyEvent::DEFAULT_CANCEL );
             const fheroes2::Key fullscreenEventKey = Game::getHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_FULLSCREEN );
             const fheroes2::Key textSupportModeEventKey = Game::getHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_TEXT_SUPPORT_MODE );
+            const fheroes2::Key performanceOverlayEventKey = Game::getHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_PERFORMANCE_OVERLAY );
 
             Game::setHotKeyForEvent( Game::HotKeyEvent::DEFAULT_OKAY, fheroes2::Key::NONE );
             Game::setHotKeyForEvent( Game::HotKeyEvent::DEFAULT_CANCEL, fheroes2::Key::NONE );
             Game::setHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_FULLSCREEN, fheroes2::Key::NONE );
             Game::setHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_TEXT_SUPPORT_MODE, fheroes2::Key::NONE );
+            Game::setHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_PERFORMANCE_OVERLAY, fheroes2::Key::NONE );
 
             const int returnValue = fheroes2::showMessage( fheroes2::Text{ _( Game::getHotKeyEventNameByEventId( hotKeyEvent ) ), fheroes2::FontType::normalWhite() },
                                                            fheroes2::Text{ "", fheroes2::FontType::normalWhite() }, Dialog::OK | Dialog::CANCEL, { &hotKeyUI } );
@@ -202,6 +204,7 @@ namespace
             Game::setHotKeyForEvent( Game::HotKeyEvent::DEFAULT_CANCEL, cancelEventKey );
             Game::setHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_FULLSCREEN, fullscreenEventKey );
             Game::setHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_TEXT_SUPPORT_MODE, textSupportModeEventKey );
+            Game::setHotKeyForEvent( Game::HotKeyEvent::GLOBAL_TOGGLE_PERFORMANCE_OVERLAY, performanceOverlayEventKey );
 
             // To avoid UI issues we need to reset restorer manually.
             hotKeyUI.reset();
@@ -119,6 +119,12 @@ namespace
             _restorer.restore();
         }
 
+        // Returns true if the radar has been updated, then the popup is not the only changed area of the screen.
+        bool isUpdated() const
+        {
+            return _performUpdate && _updatedPosition != _prevPosition;
+        }
+
     private:
         const bool _performUpdate;
         const fheroes2::Point _updatedPosition;
@@ -705,7 +711,10 @@ void Dialog::QuickInfo( const Castle & castle, const fheroes2::Point & position
         text.draw( dst_pt.x, dst_pt.y, display );
     }
 
-    display.render();
+    // Only the popup area is changed unless the radar has been updated.
+    const fheroes2::Rect renderRoi = radarUpdater.isUpdated() ? fheroes2::Rect( 0, 0, display.width(), display.height() ) : back.rect();
+
+    display.render( renderRoi );
 
     // quick info loop
     while ( le.HandleEvents() && le.MousePressRight() )
@@ -717,7 +726,7 @@ void Dialog::QuickInfo( const Castle & castle, const fheroes2::Point & position
     // Restore radar view
     radarUpdater.restore();
 
-    display.render();
+    display.render( renderRoi );
 }
 
 void Dialog::QuickInfo( const HeroBase & hero, const fheroes2::Point & position /* = {} */, const bool showOnRadar /* = false */,
@@ -919,7 +928,10 @@ void Dialog::QuickInfo( const HeroBase & hero, const fheroes2::Point & position
         Army::drawMultipleMonsterLines( hero.GetArmy(), cur_rt.x - 6, cur_rt.y + 60, 160, false, false );
     }
 
-    display.render();
+    // Only the popup area is changed unless the radar has been updated.
+    const fheroes2::Rect renderRoi = radarUpdater.isUpdated() ? fheroes2::Rect( 0, 0, display.width(), display.height() ) : restorer.rect();
+
+    display.render( renderRoi );
 
     // quick info loop
     while ( le.HandleEvents() && le.MousePressRight() )
@@ -931,5 +943,5 @@ void Dialog::QuickInfo( const HeroBase & hero, const fheroes2::Point & position
     // Restore radar view
     radarUpdater.restore();
 
-    display.render();
+    display.render( renderRoi );
 }
@@ -94,6 +94,11 @@ namespace Interface
 
         const uint32_t combinedRedraw = _redraw | force;
 
+        // The game area and the border cover almost the whole display so only other panels are tracked separately.
+        if ( combinedRedraw & ( REDRAW_GAMEAREA | REDRAW_BORDER ) ) {
+            setFullRedrawnArea();
+        }
+
         if ( combinedRedraw & REDRAW_GAMEAREA ) {
             // Render all except the fog.
             _gameArea.Redraw( fheroes2::Display::instance(), LEVEL_OBJECTS | LEVEL_HEROES | LEVEL_ROUTES );
@@ -104,6 +109,7 @@ namespace Interface
         if ( combinedRedraw & ( REDRAW_RADAR_CURSOR | REDRAW_RADAR ) ) {
             // Render the mini-map without fog.
             _radar.redrawForEditor( combinedRedraw & REDRAW_RADAR );
+            addRedrawnArea( _radar.GetRect() );
         }
 
         if ( combinedRedraw & REDRAW_BORDER ) {
@@ -113,6 +119,7 @@ namespace Interface
 
         if ( combinedRedraw & REDRAW_PANEL ) {
             _editorPanel._redraw();
+            addRedrawnArea( _editorPanel.getRect() );
         }
 
         if ( ( combinedRedraw & REDRAW_STATUS ) && ( display.height() > display.DEFAULT_HEIGHT + BORDERWIDTH ) ) {
@@ -120,6 +127,7 @@ namespace Interface
             // TODO: Make special status for Editor to display some map info, e.g. object properties under the cursor (castle garrison, amount of resources, etc.)
             // TODO: Decide where to output the status for low resolutions (reduce the number of displayed buttons - put some into sub-menu).
             _statusWindow._redraw();
+            addRedrawnArea( _statusWindow.GetRect() );
         }
 
         _redraw = 0;
@@ -21,6 +21,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 #include <exception>
 #include <iostream>
@@ -65,6 +66,8 @@
 #include "image_palette.h"
 #include "localevent.h"
 #include "logging.h"
+#include "profiler.h"
+#include "rand.h"
 #include "screen.h"
 #include "settings.h"
 #include "system.h"
@@ -254,13 +257,11 @@ int main( int argc, char ** argv )
     assert( argc == __argc );
 
     argv = __argv;
-#else
-    (void)argc;
 #endif
 
     try {
         const fheroes2::HardwareInitializer hardwareInitializer;
-        Logging::InitLog();
+        const Logging::LogInitializer logInitializer;
 
         COUT( GetCaption() )
 
@@ -268,6 +269,11 @@ int main( int argc, char ** argv )
         conf.SetProgramPath( argv[0] );
 
         InitConfigDir();
+
+#if defined( WITH_PROFILER )
+        const Profiler::Session profilerSession( System::concatPath( System::GetConfigDirectory( "fheroes2" ), "fheroes2_trace.json" ) );
+#endif
+
         InitDataDir();
         ReadConfigs();
 
@@ -310,6 +316,30 @@ int main( int argc, char ** argv )
 
         conf.setGameLanguage( conf.getGameLanguage() );
 
+        // fheroes2 --ai-benchmark <saved game file> [number of days]
+        if ( argc >= 3 && std::string( argv[1] ) == "--ai-benchmark" ) {
+            const int days = ( argc >= 4 ) ? std::atoi( argv[3] ) : 1;
+            Game::runAIBenchmark( argv[2], static_cast<uint32_t>( std::max( days, 1 ) ) );
+
+            return EXIT_SUCCESS;
+        }
+
+        // fheroes2 --record-input <input file> or fheroes2 --replay-input <input file>
+        if ( argc >= 3 && ( std::string( argv[1] ) == "--record-input" || std::string( argv[1] ) == "--replay-input" ) ) {
+            LocalEvent & le = LocalEvent::Get();
+
+            const bool isStarted = ( std::string( argv[1] ) == "--record-input" ) ? le.startInputRecording( argv[2] ) : le.startInputReplay( argv[2] );
+            if ( !isStarted ) {
+                return EXIT_FAILURE;
+            }
+
+            // The same input must lead to the same game, so the random generator of the main thread always starts from the same state.
+            Rand::CurrentThreadRandomDevice().seed( 0 );
+        }
+
+        // Start decoding the big main menu sprites on worker threads so they are ready by the time the intro is over.
+        fheroes2::AGG::prefetchICNs( { ICN::HEROES, ICN::BTNSHNGL, ICN::SHNGANIM, ICN::REDBACK } );
+
         if ( conf.isShowIntro() ) {
             fheroes2::showTeamInfo();
 
@@ -322,6 +352,8 @@ int main( int argc, char ** argv )
             const CursorRestorer cursorRestorer( true, Cursor::POINTER );
 
             Game::mainGameLoop( conf.isFirstGameRun() );
+
+            LocalEvent::Get().stopInputRecording();
         }
         catch ( const fheroes2::InvalidDataResources & ex ) {
             ERROR_LOG( ex.what() )
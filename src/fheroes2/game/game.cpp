@@ -65,6 +65,24 @@ namespace
     bool needFadeIn{ true };
 
     uint32_t maps_animation_frame = 0;
+
+    // Returns the offsets of tiles within the given distance from the center sorted by the distance to the center.
+    std::vector<fheroes2::Point> getSortedScanningOffsets( const int32_t scanningOffset )
+    {
+        std::vector<fheroes2::Point> offsets;
+        offsets.reserve( static_cast<size_t>( 2 * scanningOffset + 1 ) * ( 2 * scanningOffset + 1 ) );
+
+        for ( int32_t y = -scanningOffset; y <= scanningOffset; ++y ) {
+            for ( int32_t x = -scanningOffset; x <= scanningOffset; ++x ) {
+                offsets.emplace_back( x, y );
+            }
+        }
+
+        std::stable_sort( offsets.begin(), offsets.end(),
+                          []( const fheroes2::Point & p1, const fheroes2::Point & p2 ) { return p1.x * p1.x + p1.y * p1.y < p2.x * p2.x + p2.y * p2.y; } );
+
+        return offsets;
+    }
 }
 
 namespace Game
@@ -240,28 +258,22 @@ void Game::EnvironmentSoundMixer()
         ++scanningOffset;
     }
 
-    std::vector<fheroes2::Point> positions;
-    positions.reserve( 2 * 2 * scanningOffset * scanningOffset );
+    // The order of tiles around the center does not depend on the center so it is calculated only once.
+    static const std::vector<fheroes2::Point> stillHeroPositions = getSortedScanningOffsets( maxOffset );
+    static const std::vector<fheroes2::Point> movingHeroPositions = getSortedScanningOffsets( maxOffset + 1 );
 
-    for ( int32_t y = -scanningOffset; y <= scanningOffset; ++y ) {
-        const int32_t posY = y + center.y;
-        for ( int32_t x = -scanningOffset; x <= scanningOffset; ++x ) {
-            if ( Maps::isValidAbsPoint( x + center.x, posY ) ) {
-                positions.emplace_back( x, y );
-            }
-        }
-    }
-
-    // Sort positions by distance to the center.
-    std::stable_sort( positions.begin(), positions.end(),
-                      []( const fheroes2::Point & p1, const fheroes2::Point & p2 ) { return p1.x * p1.x + p1.y * p1.y < p2.x * p2.x + p2.y * p2.y; } );
+    const std::vector<fheroes2::Point> & positions = ( scanningOffset == maxOffset ) ? stillHeroPositions : movingHeroPositions;
 
     const double maxDistance = std::sqrt( ( maxOffset * maxOffset + maxOffset * maxOffset ) * TILEWIDTH * TILEWIDTH );
 
     const bool is3DAudioEnabled = Settings::Get().is3DAudioEnabled();
 
     for ( const fheroes2::Point & pos : positions ) {
-        const M82::SoundType soundType = M82::getAdventureMapTileSound( world.GetTiles( pos.x + center.x, pos.y + center.y ) );
+        if ( !Maps::isValidAbsPoint( pos.x + center.x, pos.y + center.y ) ) {
+            continue;
+        }
+
+        const M82::SoundType soundType = world.getTileSound( Maps::GetIndexFromAbsPoint( pos.x + center.x, pos.y + center.y ) );
         if ( soundType == M82::UNKNOWN ) {
             continue;
         }
@@ -55,6 +55,10 @@ namespace Game
 
     void mainGameLoop( bool isFirstGameRun );
 
+    // Loads the saved game and lets AI play all kingdoms for the given number of days without animations, delays and sound.
+    // The time spent by each kingdom and the number of pathfinder runs are written to the log.
+    void runAIBenchmark( const std::string & filePath, const uint32_t days );
+
     fheroes2::GameMode MainMenu( bool isFirstGameRun );
     fheroes2::GameMode NewGame();
     fheroes2::GameMode LoadGame();
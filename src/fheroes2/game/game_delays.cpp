@@ -23,10 +23,13 @@
 
 #include "game_delays.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <memory>
 
 #include "gamedefs.h"
+#include "localevent.h"
 #include "settings.h"
 #include "timing.h"
 
@@ -41,6 +44,8 @@ namespace
     int humanHeroMultiplier = 1;
     int aiHeroMultiplier = 1;
 
+    bool isTurboBattleSpeed = false;
+
     void SetupHeroMovement( const int speed, fheroes2::TimeDelay & delay, int & multiplier )
     {
         switch ( speed ) {
@@ -185,9 +190,13 @@ void Game::UpdateGameSpeed()
     SetupHeroMovement( conf.HeroesMoveSpeed(), delays[CURRENT_HERO_DELAY], humanHeroMultiplier );
     SetupHeroMovement( conf.AIMoveSpeed(), delays[CURRENT_AI_DELAY], aiHeroMultiplier );
 
-    const int32_t battleSpeed = conf.BattleSpeed();
+    const int32_t battleSpeed = isTurboBattleSpeed ? 10 : conf.BattleSpeed();
     // For the battle speed = 10 avoid the zero delay and set animation speed to the 1/3 of battleSpeedAdjustment step.
-    const double adjustedBattleSpeed = ( battleSpeed < 10 ) ? ( ( 10 - battleSpeed ) * battleSpeedAdjustment ) : ( battleSpeedAdjustment / 3 );
+    // Turbo battle speed goes even further and leaves only the minimal delays between animation frames.
+    double adjustedBattleSpeed = ( battleSpeed < 10 ) ? ( ( 10 - battleSpeed ) * battleSpeedAdjustment ) : ( battleSpeedAdjustment / 3 );
+    if ( isTurboBattleSpeed ) {
+        adjustedBattleSpeed = battleSpeedAdjustment / 10;
+    }
     // Reduce the Idle animation adjustment interval to: 1.2 for speed 1 ... 0.8 for speed 10.
     const double adjustedIdleAnimationSpeed = ( 28 - battleSpeed ) / 22.5;
 
@@ -216,10 +225,25 @@ int Game::AIHeroAnimSkip()
 
 uint32_t Game::ApplyBattleSpeed( uint32_t delay )
 {
+    if ( isTurboBattleSpeed ) {
+        return 1;
+    }
+
     const uint32_t battleSpeed = static_cast<uint32_t>( battleSpeedAdjustment * ( 10 - Settings::Get().BattleSpeed() ) * delay );
     return battleSpeed == 0 ? 1 : battleSpeed;
 }
 
+void Game::setTurboBattleSpeed( const bool enable )
+{
+    if ( isTurboBattleSpeed == enable ) {
+        return;
+    }
+
+    isTurboBattleSpeed = enable;
+
+    UpdateGameSpeed();
+}
+
 bool Game::hasEveryDelayPassed( const std::vector<Game::DelayType> & delayTypes )
 {
     for ( const Game::DelayType type : delayTypes ) {
@@ -233,20 +257,35 @@ bool Game::hasEveryDelayPassed( const std::vector<Game::DelayType> & delayTypes
 
 bool Game::isDelayNeeded( const std::vector<Game::DelayType> & delayTypes )
 {
+    uint64_t remainingMs = UINT64_MAX;
+
     for ( const Game::DelayType type : delayTypes ) {
         assert( type != Game::DelayType::CUSTOM_DELAY );
 
-        if ( delays[type].isPassed() ) {
+        const uint64_t delayRemainingMs = delays[type].getRemainingMs();
+        if ( delayRemainingMs == 0 ) {
             return false;
         }
+
+        remainingMs = std::min( remainingMs, delayRemainingMs );
     }
 
+    // Nothing is going to be animated until the nearest delay is passed so event processing can wait until then.
+    LocalEvent::Get().setNextEventWaitTime( remainingMs );
+
     return true;
 }
 
 bool Game::isCustomDelayNeeded( const uint64_t delayMs )
 {
-    return !delays[Game::DelayType::CUSTOM_DELAY].isPassed( delayMs );
+    const uint64_t remainingMs = delays[Game::DelayType::CUSTOM_DELAY].getRemainingMs( delayMs );
+    if ( remainingMs == 0 ) {
+        return false;
+    }
+
+    LocalEvent::Get().setNextEventWaitTime( remainingMs );
+
+    return true;
 }
 
 uint64_t Game::getAnimationDelayValue( const DelayType delayType )
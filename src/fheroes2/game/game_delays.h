@@ -86,6 +86,10 @@ namespace Game
 
     uint32_t ApplyBattleSpeed( uint32_t delay );
 
+    // Turbo battle speed ignores the battle speed setting and plays every battle animation with the minimal possible delays.
+    // It is used for battles that should be shown only because of AI auto-control mode.
+    void setTurboBattleSpeed( const bool enable );
+
     int HumanHeroAnimSkip();
     int AIHeroAnimSkip();
 
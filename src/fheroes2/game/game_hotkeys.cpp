@@ -41,6 +41,7 @@
 #include "tools.h"
 #include "translations.h"
 #include "ui_language.h"
+#include "ui_tool.h"
 
 namespace
 {
@@ -136,6 +137,8 @@ namespace
             = { HotKeyCategory::GLOBAL, gettext_noop( "hotkey|toggle fullscreen" ), fheroes2::Key::KEY_F4 };
         hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::GLOBAL_TOGGLE_TEXT_SUPPORT_MODE )]
             = { HotKeyCategory::GLOBAL, gettext_noop( "hotkey|toggle text support mode" ), fheroes2::Key::KEY_F10 };
+        hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::GLOBAL_TOGGLE_PERFORMANCE_OVERLAY )]
+            = { HotKeyCategory::GLOBAL, gettext_noop( "hotkey|toggle performance overlay" ), fheroes2::Key::KEY_F11 };
 
         hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::MAIN_MENU_NEW_GAME )]
             = { HotKeyCategory::MAIN_MENU, gettext_noop( "hotkey|new game" ), fheroes2::Key::KEY_N };
@@ -482,4 +485,12 @@ void Game::globalKeyDownEvent( const fheroes2::Key key, const int32_t modifier )
         conf.setTextSupportMode( !conf.isTextSupportModeEnabled() );
         conf.Save( Settings::configFileName );
     }
+    else if ( key == hotKeyEventInfo[hotKeyEventToInt( HotKeyEvent::GLOBAL_TOGGLE_PERFORMANCE_OVERLAY )].key ) {
+        conf.setPerformanceOverlay( !conf.isPerformanceOverlayEnabled() );
+        conf.Save( Settings::configFileName );
+
+        if ( conf.isPerformanceOverlayEnabled() ) {
+            fheroes2::logMemoryUsage();
+        }
+    }
 }
@@ -44,6 +44,7 @@ namespace Game
 
         GLOBAL_TOGGLE_FULLSCREEN,
         GLOBAL_TOGGLE_TEXT_SUPPORT_MODE,
+        GLOBAL_TOGGLE_PERFORMANCE_OVERLAY,
 
         MAIN_MENU_NEW_GAME,
         MAIN_MENU_LOAD_GAME,
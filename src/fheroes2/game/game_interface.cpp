@@ -127,35 +127,54 @@ void Interface::AdventureMap::redraw( const uint32_t force /* = 0 */ )
     const uint32_t combinedRedraw = _redraw | force;
     const bool hideInterface = conf.isHideInterfaceEnabled();
 
-    if ( combinedRedraw & REDRAW_GAMEAREA ) {
+    // The game area and the border cover almost the whole display so only other panels are tracked separately.
+    if ( combinedRedraw & ( REDRAW_GAMEAREA | REDRAW_BORDER ) ) {
+        setFullRedrawnArea();
+    }
+
+    if ( combinedRedraw & ( REDRAW_GAMEAREA | REDRAW_GAMEAREA_ANIMATION ) ) {
         _gameArea.Redraw( fheroes2::Display::instance(), LEVEL_ALL );
 
         if ( hideInterface && conf.ShowControlPanel() ) {
             controlPanel._redraw();
+            addRedrawnArea( controlPanel.GetArea() );
+        }
+
+        if ( !( combinedRedraw & ( REDRAW_GAMEAREA | REDRAW_BORDER ) ) ) {
+            // Only animated objects have been changed since the previous game area rendering.
+            for ( const fheroes2::Rect & roi : _gameArea.getAnimatedArea().areas() ) {
+                addRedrawnArea( roi );
+            }
         }
     }
 
     if ( ( hideInterface && conf.ShowRadar() ) || ( combinedRedraw & ( REDRAW_RADAR_CURSOR | REDRAW_RADAR ) ) ) {
         // Redraw radar map only if `REDRAW_RADAR` is set.
         _radar._redraw( combinedRedraw & REDRAW_RADAR );
+        addRedrawnArea( _radar.GetRect() );
     }
 
     if ( ( hideInterface && conf.ShowIcons() ) || ( combinedRedraw & REDRAW_ICONS ) ) {
         iconsPanel._redraw();
+        addRedrawnArea( iconsPanel.GetRect() );
     }
     else if ( combinedRedraw & REDRAW_HEROES ) {
         iconsPanel._redrawIcons( ICON_HEROES );
+        addRedrawnArea( iconsPanel.GetRect() );
     }
     else if ( combinedRedraw & REDRAW_CASTLES ) {
         iconsPanel._redrawIcons( ICON_CASTLES );
+        addRedrawnArea( iconsPanel.GetRect() );
     }
 
     if ( ( hideInterface && conf.ShowButtons() ) || ( combinedRedraw & REDRAW_BUTTONS ) ) {
         buttonsArea._redraw();
+        addRedrawnArea( buttonsArea.GetRect() );
     }
 
     if ( ( hideInterface && conf.ShowStatus() ) || ( combinedRedraw & REDRAW_STATUS ) ) {
         _statusWindow._redraw();
+        addRedrawnArea( _statusWindow.GetRect() );
     }
 
     if ( combinedRedraw & REDRAW_BORDER ) {
@@ -27,19 +27,26 @@
 #include <cctype>
 #include <cstdint>
 #include <ctime>
+#include <future>
+#include <map>
 #include <ostream>
+#include <utility>
+#include <vector>
 
 #include "campaign_savedata.h"
 #include "campaign_scenariodata.h"
 #include "dialog.h"
+#include "dir.h"
 #include "game.h"
 #include "game_over.h"
 #include "logging.h"
 #include "maps_fileinfo.h"
+#include "profiler.h"
 #include "save_format_version.h"
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "translations.h"
 #include "ui_dialog.h"
 #include "ui_language.h"
@@ -56,6 +63,20 @@ namespace
 
     std::string lastSaveName;
 
+    // Result of the autosave whose data is still being zipped and written to the file by a worker thread
+    std::future<bool> pendingAutoSave;
+
+    void waitForPendingAutoSave()
+    {
+        if ( !pendingAutoSave.valid() ) {
+            return;
+        }
+
+        if ( !pendingAutoSave.get() ) {
+            ERROR_LOG( "Failed to write the autosave file" )
+        }
+    }
+
     struct HeaderSAV
     {
         enum
@@ -100,6 +121,142 @@ namespace
     {
         return msg >> hdr.status >> hdr.info >> hdr.gameType;
     }
+
+    // Increase this version every time the format of the save file header cache file changes
+    const uint16_t saveHeaderCacheFormatVersion = 1;
+
+    // Header of a save file, which is stored in the save file header cache file to avoid reading of unchanged save files.
+    struct SaveHeaderCacheEntry
+    {
+        uint64_t fileSize{ 0 };
+        int64_t modificationTime{ 0 };
+
+        // False if the file is not a save file of a supported version
+        bool isValid{ false };
+
+        HeaderSAV header;
+    };
+
+    std::string getSaveHeaderCacheFilePath()
+    {
+        return System::concatPath( System::GetDataDirectory( "fheroes2" ), "saves.cache" );
+    }
+
+    std::map<std::string, SaveHeaderCacheEntry> loadSaveHeaderCache()
+    {
+        StreamFile fs;
+        fs.setbigendian( true );
+
+        if ( !fs.open( getSaveHeaderCacheFilePath(), "rb" ) ) {
+            return {};
+        }
+
+        uint16_t cacheFormatVersion = 0;
+        uint16_t saveFileFormatVersion = 0;
+        uint32_t entryCount = 0;
+
+        fs >> cacheFormatVersion >> saveFileFormatVersion >> entryCount;
+
+        // Headers are serialized the same way as in save files, so the cache becomes outdated along with the save file format
+        if ( fs.fail() || cacheFormatVersion != saveHeaderCacheFormatVersion || saveFileFormatVersion != CURRENT_FORMAT_VERSION ) {
+            return {};
+        }
+
+        // Header deserialization depends on the version of the currently loaded save file
+        const uint16_t currentSaveFileVersion = Game::GetVersionOfCurrentSaveFile();
+        Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+        std::map<std::string, SaveHeaderCacheEntry> cache;
+
+        for ( uint32_t i = 0; i < entryCount && !fs.fail(); ++i ) {
+            std::string saveFile;
+            SaveHeaderCacheEntry entry;
+            int64_t fileSize = 0;
+
+            fs >> saveFile >> fileSize >> entry.modificationTime >> entry.isValid >> entry.header;
+
+            entry.fileSize = static_cast<uint64_t>( fileSize );
+            entry.header.info.file = saveFile;
+
+            cache.emplace( std::move( saveFile ), std::move( entry ) );
+        }
+
+        Game::SetVersionOfCurrentSaveFile( currentSaveFileVersion );
+
+        if ( fs.fail() ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Save file header cache file is corrupted" )
+            return {};
+        }
+
+        return cache;
+    }
+
+    void saveSaveHeaderCache( const std::map<std::string, SaveHeaderCacheEntry> & cache )
+    {
+        StreamFile fs;
+        fs.setbigendian( true );
+
+        if ( !fs.open( getSaveHeaderCacheFilePath(), "wb" ) ) {
+            return;
+        }
+
+        fs << saveHeaderCacheFormatVersion << static_cast<uint16_t>( CURRENT_FORMAT_VERSION ) << static_cast<uint32_t>( cache.size() );
+
+        for ( const auto & [saveFile, entry] : cache ) {
+            fs << saveFile << static_cast<int64_t>( entry.fileSize ) << entry.modificationTime << entry.isValid << entry.header;
+        }
+    }
+
+    // Reads the header of the save file. Returns false if the file is not a save file of a supported version.
+    bool readSaveFileHeader( const std::string & filePath, HeaderSAV & header )
+    {
+        StreamFile fs;
+        fs.setbigendian( true );
+
+        if ( !fs.open( filePath, "rb" ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
+            return false;
+        }
+
+        uint16_t savId = 0;
+        fs >> savId;
+
+        if ( savId != SAV2ID3 ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid SAV2ID in the file " << filePath )
+            return false;
+        }
+
+        std::string saveFileVersionStr;
+        uint16_t saveFileVersion = 0;
+
+        fs >> saveFileVersionStr >> saveFileVersion;
+
+        DEBUG_LOG( DBG_GAME, DBG_TRACE, "Version of the file " << filePath << ": " << saveFileVersion )
+
+        if ( saveFileVersion > CURRENT_FORMAT_VERSION || saveFileVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
+            return false;
+        }
+
+        Game::SetVersionOfCurrentSaveFile( saveFileVersion );
+
+        fs >> header;
+
+        header.info.file = filePath;
+
+        return true;
+    }
+
+    void writeGameData( StreamBase & msg )
+    {
+        msg << World::Get() << Settings::Get() << GameOver::Result::Get();
+
+        if ( Settings::Get().isCampaignGameType() ) {
+            msg << Campaign::CampaignSaveData::Get();
+        }
+
+        // End-of-data marker
+        msg << SAV2ID3;
+    }
 }
 
 bool Game::AutoSave()
@@ -109,8 +266,13 @@ bool Game::AutoSave()
 
 bool Game::Save( const std::string & filePath, const bool autoSave /* = false */ )
 {
+    PROFILE_ZONE( "Save game" );
+
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
+    // The previous autosave may still be writing to the same file
+    waitForPendingAutoSave();
+
     const Settings & conf = Settings::Get();
 
     StreamFile fs;
@@ -130,20 +292,40 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
        << HeaderSAV( conf.CurrentFileInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
     fs.close();
 
-    ZStreamBuf zb;
-    zb.setbigendian( true );
+    MultiThreading::ThreadPool & threadPool = MultiThreading::getThreadPool();
 
-    // Game data in ZIP format
-    zb << World::Get() << Settings::Get() << GameOver::Result::Get();
+    if ( autoSave && threadPool.getWorkerCount() > 0 ) {
+        // Take a snapshot of the game data right away, zipping it and writing it to the file is done by a worker thread
+        ZStreamBuf zb;
+        zb.setbigendian( true );
 
-    if ( conf.isCampaignGameType() ) {
-        zb << Campaign::CampaignSaveData::Get();
+        writeGameData( zb );
+
+        if ( zb.fail() ) {
+            return false;
+        }
+
+        pendingAutoSave = threadPool.submit( [zb = std::move( zb ), filePath]() {
+            PROFILE_ZONE( "Write autosave" );
+
+            return zb.write( filePath, true );
+        } );
+
+        return true;
     }
 
-    // End-of-data marker
-    zb << SAV2ID3;
+    // Game data in ZIP format, zipped on the fly while it is being serialized
+    ZStreamFile zf;
+    zf.setbigendian( true );
 
-    if ( zb.fail() || !zb.write( filePath, true ) ) {
+    if ( !zf.open( filePath ) ) {
+        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
+        return false;
+    }
+
+    writeGameData( zf );
+
+    if ( !zf.close() ) {
         return false;
     }
 
@@ -156,8 +338,12 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
 
 fheroes2::GameMode Game::Load( const std::string & filePath )
 {
+    PROFILE_ZONE( "Load game" );
+
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
+    waitForPendingAutoSave();
+
     auto showGenericErrorMessage = []() { fheroes2::showStandardTextMessage( _( "Error" ), _( "The save file is corrupted." ), Dialog::OK ); };
 
     StreamFile fs;
@@ -302,46 +488,65 @@ bool Game::LoadSAV2FileInfo( const std::string & filePath, Maps::FileInfo & file
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
-    StreamFile fs;
-    fs.setbigendian( true );
-
-    if ( !fs.open( filePath, "rb" ) ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
+    HeaderSAV header;
+    if ( !readSaveFileHeader( filePath, header ) ) {
         return false;
     }
 
-    uint16_t savId = 0;
-    fs >> savId;
-
-    if ( savId != SAV2ID3 ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid SAV2ID in the file " << filePath )
+    if ( ( Settings::Get().GameType() & header.gameType ) == 0 ) {
         return false;
     }
 
-    std::string saveFileVersionStr;
-    uint16_t saveFileVersion = 0;
+    fileInfo = header.info;
 
-    fs >> saveFileVersionStr >> saveFileVersion;
+    return true;
+}
 
-    DEBUG_LOG( DBG_GAME, DBG_TRACE, "Version of the file " << filePath << ": " << saveFileVersion )
+std::vector<Maps::FileInfo> Game::LoadSAV2FilesInfo( const ListFiles & files )
+{
+    // The autosave which is still being written would be parsed half-written otherwise.
+    waitForPendingAutoSave();
 
-    if ( saveFileVersion > CURRENT_FORMAT_VERSION || saveFileVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
-        return false;
-    }
+    // Only the save files that were added or changed since the last time are read, the rest is taken from the cache
+    std::map<std::string, SaveHeaderCacheEntry> cache = loadSaveHeaderCache();
+    std::map<std::string, SaveHeaderCacheEntry> updatedCache;
+    bool isCacheChanged = false;
 
-    SetVersionOfCurrentSaveFile( saveFileVersion );
+    for ( const std::string & saveFile : files ) {
+        SaveHeaderCacheEntry entry;
 
-    HeaderSAV header;
-    fs >> header;
+        if ( !System::getFileStatus( saveFile, entry.fileSize, entry.modificationTime ) ) {
+            continue;
+        }
 
-    if ( ( Settings::Get().GameType() & header.gameType ) == 0 ) {
-        return false;
+        auto cacheIter = cache.find( saveFile );
+        if ( cacheIter != cache.end() && cacheIter->second.fileSize == entry.fileSize && cacheIter->second.modificationTime == entry.modificationTime ) {
+            updatedCache.emplace( saveFile, std::move( cacheIter->second ) );
+            continue;
+        }
+
+        entry.isValid = readSaveFileHeader( saveFile, entry.header );
+        updatedCache.emplace( saveFile, std::move( entry ) );
+
+        isCacheChanged = true;
     }
 
-    fileInfo = header.info;
-    fileInfo.file = filePath;
+    if ( isCacheChanged || updatedCache.size() != cache.size() ) {
+        saveSaveHeaderCache( updatedCache );
+    }
 
-    return true;
+    const int gameType = Settings::Get().GameType();
+
+    std::vector<Maps::FileInfo> result;
+    result.reserve( updatedCache.size() );
+
+    for ( const auto & [saveFile, entry] : updatedCache ) {
+        if ( entry.isValid && ( gameType & entry.header.gameType ) != 0 ) {
+            result.emplace_back( entry.header.info );
+        }
+    }
+
+    return result;
 }
 
 void Game::SetVersionOfCurrentSaveFile( const uint16_t version )
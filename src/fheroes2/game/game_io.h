@@ -26,9 +26,12 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "game_mode.h"
 
+struct ListFiles;
+
 namespace Maps
 {
     struct FileInfo;
@@ -55,6 +58,10 @@ namespace Game
 
     bool LoadSAV2FileInfo( const std::string & filePath, Maps::FileInfo & fileInfo );
 
+    // Returns info of the save files from the list which can be loaded in the current game mode.
+    // Save file headers are kept in a cache file and read again only for new or changed files.
+    std::vector<Maps::FileInfo> LoadSAV2FilesInfo( const ListFiles & files );
+
     bool SaveCompletedCampaignScenario();
 }
 
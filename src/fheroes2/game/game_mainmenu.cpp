@@ -100,6 +100,9 @@ void Game::mainGameLoop( bool isFirstGameRun )
     fheroes2::GameMode result = fheroes2::GameMode::MAIN_MENU;
 
     while ( result != fheroes2::GameMode::QUIT_GAME ) {
+        // No sprite references are being held between game modes so it is safe to release not recently used resources.
+        fheroes2::AGG::trimICNCache();
+
         switch ( result ) {
         case fheroes2::GameMode::MAIN_MENU:
             result = Game::MainMenu( isFirstGameRun );
@@ -248,6 +251,9 @@ fheroes2::GameMode Game::MainMenu( bool isFirstGameRun )
 
     outputMainMenuInTextSupportMode();
 
+    // Scale all main menu sprites in advance to avoid delays while the menu is being animated.
+    fheroes2::AGG::prepareScaledICNs();
+
     LocalEvent & le = LocalEvent::Get();
 
     fheroes2::Button buttonNewGame( 0, 0, ICN::BTNSHNGL, NEWGAME_DEFAULT, NEWGAME_DEFAULT + 2 );
@@ -27,6 +27,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <ostream>
 #include <string>
 #include <type_traits>
@@ -72,10 +73,12 @@
 #include "mp2.h"
 #include "mus.h"
 #include "players.h"
+#include "rand.h"
 #include "resource.h"
 #include "route.h"
 #include "screen.h"
 #include "settings.h"
+#include "timing.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_dialog.h"
@@ -83,6 +86,7 @@
 #include "ui_tool.h"
 #include "week.h"
 #include "world.h"
+#include "world_pathfinding.h"
 
 namespace
 {
@@ -156,6 +160,107 @@ fheroes2::GameMode Game::StartGame()
     return Interface::AdventureMap::Get().StartGame();
 }
 
+void Game::runAIBenchmark( const std::string & filePath, const uint32_t days )
+{
+    if ( Game::Load( filePath ) != fheroes2::GameMode::START_GAME ) {
+        ERROR_LOG( "Failed to load the saved game " << filePath << " for the AI benchmark." )
+        return;
+    }
+
+    AI::Get().Reset();
+
+    Settings & conf = Settings::Get();
+
+    // AI heroes are never shown without human players so there are no animations and delays. AI move speed is not saved into the config file.
+    conf.SetAIMoveSpeed( 0 );
+    Audio::Mute();
+
+    std::vector<Player *> sortedPlayers = conf.GetPlayers().getVector();
+    for ( Player * player : sortedPlayers ) {
+        if ( player->isControlHuman() ) {
+            player->SetControl( CONTROL_AI );
+        }
+    }
+
+    std::sort( sortedPlayers.begin(), sortedPlayers.end(), SortPlayers );
+
+    // AI uses the random generator of the main thread. Seed it by the map seed so every run of the same saved game is identical.
+    Rand::CurrentThreadRandomDevice().seed( world.GetMapSeed() );
+
+    Interface::AdventureMap::Get().reset();
+
+    const CursorRestorer cursorRestorer( true, Cursor::WAIT );
+
+    struct KingdomStatistics
+    {
+        uint32_t turns{ 0 };
+        uint64_t totalTimeMs{ 0 };
+        uint64_t maxTimeMs{ 0 };
+    };
+
+    std::map<int, KingdomStatistics> statistics;
+
+    const uint64_t initialMapProcessingCount = getWorldMapProcessingCount();
+    const fheroes2::Time benchmarkTimer;
+
+    // The game was saved during the turn of the current player. The day is continued from this player as it is done when loading a game normally.
+    bool skipTurns = true;
+
+    for ( uint32_t day = 0; day < days; ++day ) {
+        if ( day > 0 ) {
+            world.NewDay();
+        }
+
+        for ( const Player * player : sortedPlayers ) {
+            const int playerColor = player->GetColor();
+
+            if ( skipTurns && !player->isColor( conf.CurrentColor() ) ) {
+                continue;
+            }
+
+            const bool isLoadedTurn = skipTurns;
+            skipTurns = false;
+
+            Kingdom & kingdom = world.GetKingdom( playerColor );
+            if ( !kingdom.isPlay() ) {
+                continue;
+            }
+
+            conf.SetCurrentColor( playerColor );
+
+            if ( !isLoadedTurn ) {
+                kingdom.ActionNewDayResourceUpdate( nullptr );
+            }
+
+            kingdom.ActionBeforeTurn();
+
+            const fheroes2::Time turnTimer;
+
+            AI::Get().KingdomTurn( kingdom );
+
+            const uint64_t turnTimeMs = turnTimer.getMs();
+
+            KingdomStatistics & kingdomStatistics = statistics[playerColor];
+            ++kingdomStatistics.turns;
+            kingdomStatistics.totalTimeMs += turnTimeMs;
+            kingdomStatistics.maxTimeMs = std::max( kingdomStatistics.maxTimeMs, turnTimeMs );
+        }
+
+        if ( skipTurns ) {
+            ERROR_LOG( "The current player from the saved game was not found, player color: " << Color::String( conf.CurrentColor() ) )
+            return;
+        }
+    }
+
+    COUT( "AI benchmark of " << filePath << ": " << days << " days in " << benchmarkTimer.getMs() << " ms, world map processed by pathfinders "
+                             << getWorldMapProcessingCount() - initialMapProcessingCount << " times" )
+
+    for ( const auto & [color, kingdomStatistics] : statistics ) {
+        COUT( Color::String( color ) << ": " << kingdomStatistics.turns << " turns, total " << kingdomStatistics.totalTimeMs << " ms, average "
+                                     << kingdomStatistics.totalTimeMs / kingdomStatistics.turns << " ms, max " << kingdomStatistics.maxTimeMs << " ms" )
+    }
+}
+
 void Game::DialogPlayers( int color, std::string title, std::string message )
 {
     const Player * player = Players::Get( color );
@@ -878,9 +983,7 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isload )
 
     const Settings & conf = Settings::Get();
     if ( conf.IsGameType( Game::TYPE_HOTSEAT ) ) {
-        // TODO: Cache fog directions for all Human players in array to not perform full update at every turn start.
-
-        // Fully update fog directions at the start of player's move in Hot Seat mode as the previous move could be done by opposing player.
+        // Update fog directions at the start of player's move in Hot Seat mode as the previous move could be done by opposing player.
         Interface::GameArea::updateMapFogDirections();
     }
 
@@ -1293,7 +1396,11 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isload )
             // map objects animation
             if ( Game::validateAnimationDelay( Game::MAPS_DELAY ) ) {
                 Game::updateAdventureMapAnimationIndex();
-                _gameArea.SetRedraw();
+
+                // Nothing changes on the screen with the next animation frame if there are no animated objects in the visible area.
+                if ( !_gameArea.getAnimatedArea().empty() ) {
+                    setRedraw( REDRAW_GAMEAREA_ANIMATION );
+                }
             }
 
             if ( needRedraw() ) {
@@ -40,9 +40,15 @@ namespace Interface
 
             setRedraw( REDRAW_GAMEAREA );
         }
-        else {
+        else if ( _isFullAreaRedrawn || _redrawnArea.empty() ) {
             fheroes2::Display::instance().render();
         }
+        else {
+            fheroes2::Display::instance().render( _redrawnArea );
+        }
+
+        _redrawnArea.clear();
+        _isFullAreaRedrawn = false;
     }
 
 }
@@ -54,6 +54,10 @@ namespace Interface
         // The next value is base for Map Editor interface.
         REDRAW_PANEL = 0x100,
 
+        // To render the game area after the change of the adventure map animation frame. Only the areas of animated objects are rendered
+        // to the screen while REDRAW_GAMEAREA is not set.
+        REDRAW_GAMEAREA_ANIMATION = 0x200,
+
         REDRAW_ALL = 0x1FF
     };
 
@@ -129,13 +133,29 @@ namespace Interface
     protected:
         BaseInterface();
 
-        // If display fade-in state is set reset it to false and fade-in the full display image. Otherwise render full display image without fade-in.
+        // If display fade-in state is set reset it to false and fade-in the full display image. Otherwise render the display areas changed
+        // by redraw() calls since the previous call of this method without fade-in.
         void validateFadeInAndRender();
 
+        // Marks an area of the display as changed by redraw(). Interfaces which do not track changed areas always render the full display image.
+        void addRedrawnArea( const fheroes2::Rect & roi )
+        {
+            _redrawnArea.add( roi );
+        }
+
+        void setFullRedrawnArea()
+        {
+            _isFullAreaRedrawn = true;
+        }
+
         GameArea _gameArea;
         Radar _radar;
         StatusWindow _statusWindow;
 
         uint32_t _redraw{ 0 };
+
+    private:
+        fheroes2::RenderRegion _redrawnArea;
+        bool _isFullAreaRedrawn{ false };
     };
 }
@@ -25,23 +25,47 @@
 #include <cassert>
 #include <vector>
 
+#include "agg_image.h"
 #include "audio.h"
 #include "audio_manager.h"
 #include "castle.h"
+#include "castle_building_info.h"
 #include "game.h"
 #include "game_interface.h"
 #include "heroes.h"
+#include "icn.h"
 #include "interface_base.h"
 #include "interface_gamearea.h"
 #include "interface_icons.h"
 #include "interface_status.h"
 #include "kingdom.h"
+#include "maps_fileinfo.h"
 #include "maps_tiles.h"
 #include "mus.h"
 #include "players.h"
 #include "settings.h"
 #include "world.h"
 
+namespace
+{
+    // Castle buildings are drawn using many big sprites so start decoding them before the castle screen is opened.
+    void prefetchCastleSprites( const Castle & castle )
+    {
+        std::vector<int> icnIds;
+
+        for ( const building_t building : fheroes2::getBuildingDrawingPriorities( castle.GetRace(), Settings::Get().CurrentFileInfo().version ) ) {
+            if ( castle.isBuild( building ) ) {
+                const int icnId = Castle::GetICNBuilding( building, castle.GetRace() );
+                if ( icnId != ICN::UNKNOWN ) {
+                    icnIds.emplace_back( icnId );
+                }
+            }
+        }
+
+        fheroes2::AGG::prefetchICNs( icnIds );
+    }
+}
+
 void Interface::AdventureMap::SetFocus( Heroes * hero, const bool retainScrollBarPosition )
 {
     assert( hero != nullptr );
@@ -104,6 +128,10 @@ void Interface::AdventureMap::SetFocus( Castle * castle )
 
     focus.Set( castle );
 
+    if ( player->isControlHuman() ) {
+        prefetchCastleSprites( *castle );
+    }
+
     redraw( REDRAW_BUTTONS );
 
     iconsPanel.Select( castle );
@@ -26,11 +26,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
-#include <deque>
-#include <list>
-#include <map>
 #include <ostream>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -51,10 +50,12 @@
 #include "maps_tiles_render.h"
 #include "pal.h"
 #include "players.h"
+#include "profiler.h"
 #include "route.h"
 #include "screen.h"
 #include "settings.h"
 #include "skill.h"
+#include "thread.h"
 #include "ui_object_rendering.h"
 #include "world.h"
 
@@ -64,18 +65,64 @@ namespace
 
     static_assert( std::is_trivially_copyable<fheroes2::ObjectRenderingInfo>::value, "This class is not trivially copyable anymore. Add std::move where required." );
 
+    // Images of tile-unfit objects to be rendered on tiles. The images are collected into a flat list and sorted by tile only
+    // before rendering. The order is the same as if every tile had its own queue where images can be added to both ends.
+    class TileImageList
+    {
+    public:
+        void pushBack( const fheroes2::Point & tilePos, const fheroes2::ObjectRenderingInfo & info )
+        {
+            _images.push_back( { tilePos, ++_lastBackOrder, info } );
+        }
+
+        void pushFront( const fheroes2::Point & tilePos, const fheroes2::ObjectRenderingInfo & info )
+        {
+            _images.push_back( { tilePos, --_lastFrontOrder, info } );
+        }
+
+        void render( fheroes2::Image & output, const Interface::GameArea & area )
+        {
+            std::sort( _images.begin(), _images.end(), []( const TileImage & first, const TileImage & second ) {
+                if ( first.tilePos == second.tilePos ) {
+                    return first.order < second.order;
+                }
+
+                return first.tilePos < second.tilePos;
+            } );
+
+            for ( const TileImage & image : _images ) {
+                const fheroes2::ObjectRenderingInfo & info = image.info;
+                area.BlitOnTile( output, fheroes2::AGG::GetICN( info.icnId, info.icnIndex ), info.area, info.imageOffset.x, info.imageOffset.y, image.tilePos,
+                                 info.isFlipped, info.alphaValue );
+            }
+        }
+
+    private:
+        struct TileImage
+        {
+            fheroes2::Point tilePos;
+            // Images added to the front have negative order values and images added to the back have positive ones
+            int32_t order;
+            fheroes2::ObjectRenderingInfo info;
+        };
+
+        std::vector<TileImage> _images;
+        int32_t _lastFrontOrder{ 0 };
+        int32_t _lastBackOrder{ 0 };
+    };
+
     struct TileUnfitRenderObjectInfo
     {
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> bottomImages;
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> bottomBackgroundImages;
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> topImages;
+        TileImageList bottomImages;
+        TileImageList bottomBackgroundImages;
+        TileImageList topImages;
 
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> lowPriorityBottomImages;
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> highPriorityBottomImages;
+        TileImageList lowPriorityBottomImages;
+        TileImageList highPriorityBottomImages;
 
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> heroBackgroundImages;
+        TileImageList heroBackgroundImages;
 
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> shadowImages;
+        TileImageList shadowImages;
     };
 
     void populateStaticTileUnfitObjectInfo( TileUnfitRenderObjectInfo & tileUnfit, std::vector<fheroes2::ObjectRenderingInfo> & imageInfo,
@@ -87,26 +134,26 @@ namespace
 
             if ( imagePos.y > 0 ) {
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.bottomBackgroundImages[imagePos + offset].emplace_front( objectInfo );
+                    tileUnfit.bottomBackgroundImages.pushFront( imagePos + offset, objectInfo );
                 }
                 else {
-                    tileUnfit.bottomBackgroundImages[imagePos + offset].emplace_back( objectInfo );
+                    tileUnfit.bottomBackgroundImages.pushBack( imagePos + offset, objectInfo );
                 }
             }
             else if ( imagePos.y == 0 ) {
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.bottomImages[imagePos + offset].emplace_front( objectInfo );
+                    tileUnfit.bottomImages.pushFront( imagePos + offset, objectInfo );
                 }
                 else {
-                    tileUnfit.bottomImages[imagePos + offset].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.pushBack( imagePos + offset, objectInfo );
                 }
             }
             else {
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.topImages[imagePos + offset].emplace_front( objectInfo );
+                    tileUnfit.topImages.pushFront( imagePos + offset, objectInfo );
                 }
                 else {
-                    tileUnfit.topImages[imagePos + offset].emplace_back( objectInfo );
+                    tileUnfit.topImages.pushBack( imagePos + offset, objectInfo );
                 }
             }
         }
@@ -122,7 +169,7 @@ namespace
 
             objectInfo.alphaValue = alphaValue;
 
-            tileUnfit.shadowImages[imagePos].emplace_back( objectInfo );
+            tileUnfit.shadowImages.pushBack( imagePos, objectInfo );
         }
     }
 
@@ -134,17 +181,24 @@ namespace
             objectInfo.alphaValue = alphaValue;
 
             if ( imagePos.y > 0 ) {
-                tileUnfit.bottomBackgroundImages[imagePos + offset].emplace_front( objectInfo );
+                tileUnfit.bottomBackgroundImages.pushFront( imagePos + offset, objectInfo );
             }
             else if ( imagePos.y == 0 ) {
-                tileUnfit.bottomImages[imagePos + offset].emplace_front( objectInfo );
+                tileUnfit.bottomImages.pushFront( imagePos + offset, objectInfo );
             }
             else {
-                tileUnfit.topImages[imagePos + offset].emplace_front( objectInfo );
+                tileUnfit.topImages.pushFront( imagePos + offset, objectInfo );
             }
         }
     }
 
+    void addAnimatedTiles( const Interface::GameArea & area, const std::vector<fheroes2::ObjectRenderingInfo> & imageInfo, const fheroes2::Point & offset )
+    {
+        for ( const fheroes2::ObjectRenderingInfo & objectInfo : imageInfo ) {
+            area.addAnimatedTile( objectInfo.tileOffset + offset );
+        }
+    }
+
     void populateHeroObjectInfo( TileUnfitRenderObjectInfo & tileUnfit, const Heroes * hero )
     {
         assert( hero != nullptr );
@@ -169,35 +223,32 @@ namespace
         const uint8_t heroAlphaValue = hero->getAlphaValue();
         const int32_t worldHeight = world.h();
 
-        auto spriteInfo = hero->getHeroSpritesPerTile();
-        auto spriteShadowInfo = hero->getHeroShadowSpritesPerTile();
-
-        for ( auto & objectInfo : spriteInfo ) {
+        for ( fheroes2::ObjectRenderingInfo objectInfo : hero->getHeroSpritesPerTile() ) {
             const fheroes2::Point imagePos = objectInfo.tileOffset;
             objectInfo.alphaValue = heroAlphaValue;
 
             if ( movingHero && imagePos.y == 0 ) {
                 if ( nextHeroPos.y > heroPos.y && nextHeroPos.x > heroPos.x && imagePos.x > 0 ) {
                     // The hero moves south-east. We need to render it over everything.
-                    tileUnfit.highPriorityBottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.highPriorityBottomImages.pushBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y > heroPos.y && nextHeroPos.x < heroPos.x && imagePos.x < 0 ) {
                     // The hero moves south-west. We need to render it over everything.
-                    tileUnfit.highPriorityBottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.highPriorityBottomImages.pushBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y < heroPos.y && nextHeroPos.x < heroPos.x && imagePos.x < 0 ) {
                     // The hero moves north-west. We need to render it under all other objects.
-                    tileUnfit.lowPriorityBottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.lowPriorityBottomImages.pushBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y < heroPos.y && nextHeroPos.x > heroPos.x && imagePos.x > 0 ) {
                     // The hero moves north-east. We need to render it under all other objects.
-                    tileUnfit.lowPriorityBottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.lowPriorityBottomImages.pushBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
             }
@@ -205,13 +256,13 @@ namespace
             if ( movingHero && imagePos.y == 1 ) {
                 if ( nextHeroPos.y > heroPos.y && nextHeroPos.x > heroPos.x && imagePos.x > 0 ) {
                     // The hero moves south-east. We need to render it over everything.
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.pushBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y > heroPos.y && nextHeroPos.x < heroPos.x && imagePos.x < 0 ) {
                     // The hero moves south-west. We need to render it over everything.
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.pushBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
             }
@@ -219,13 +270,13 @@ namespace
             if ( movingHero && imagePos.y == -1 ) {
                 if ( nextHeroPos.y < heroPos.y && nextHeroPos.x < heroPos.x && imagePos.x < 0 ) {
                     // The hero moves north-west. We need to render it under all other objects.
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.pushBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y < heroPos.y && nextHeroPos.x > heroPos.x && imagePos.x > 0 ) {
                     // The hero moves north-east. We need to render it under all other objects.
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.pushBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
             }
@@ -238,31 +289,31 @@ namespace
 
                 // The very bottom part of hero (or hero on boat) image should not be rendered before it's shadow so we place it in the extra deque.
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.heroBackgroundImages[imagePos + heroPos].emplace_front( objectInfo );
+                    tileUnfit.heroBackgroundImages.pushFront( imagePos + heroPos, objectInfo );
                 }
                 else {
-                    tileUnfit.heroBackgroundImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.heroBackgroundImages.pushBack( imagePos + heroPos, objectInfo );
                 }
             }
             else if ( imagePos.y == 0 || ( isHeroInCastle && imagePos.y > 0 ) ) {
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_front( objectInfo );
+                    tileUnfit.bottomImages.pushFront( imagePos + heroPos, objectInfo );
                 }
                 else {
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.pushBack( imagePos + heroPos, objectInfo );
                 }
             }
             else {
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.topImages[imagePos + heroPos].emplace_front( objectInfo );
+                    tileUnfit.topImages.pushFront( imagePos + heroPos, objectInfo );
                 }
                 else {
-                    tileUnfit.topImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.topImages.pushBack( imagePos + heroPos, objectInfo );
                 }
             }
         }
 
-        for ( auto & objectInfo : spriteShadowInfo ) {
+        for ( fheroes2::ObjectRenderingInfo objectInfo : hero->getHeroShadowSpritesPerTile() ) {
             const fheroes2::Point imagePos = objectInfo.tileOffset + heroPos;
 
             // Shadows outside the game area should not be rendered.
@@ -272,18 +323,7 @@ namespace
 
             objectInfo.alphaValue = heroAlphaValue;
 
-            tileUnfit.shadowImages[imagePos].emplace_back( objectInfo );
-        }
-    }
-
-    void renderImagesOnTiles( fheroes2::Image & output, const std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> & images,
-                              const Interface::GameArea & area )
-    {
-        for ( const auto & [offset, imgInfo] : images ) {
-            for ( const auto & info : imgInfo ) {
-                area.BlitOnTile( output, fheroes2::AGG::GetICN( info.icnId, info.icnIndex ), info.area, info.imageOffset.x, info.imageOffset.y, offset, info.isFlipped,
-                                 info.alphaValue );
-            }
+            tileUnfit.shadowImages.pushBack( imagePos, objectInfo );
         }
     }
 
@@ -374,6 +414,20 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
                          overlappedRoi.height, alpha, flip );
 }
 
+void Interface::GameArea::addAnimatedArea( const fheroes2::Image & src, const int32_t ox, const int32_t oy, const fheroes2::Point & mp ) const
+{
+    const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
+
+    _animatedArea.add( _windowROI ^ fheroes2::Rect( tileOffset.x + ox, tileOffset.y + oy, src.width(), src.height() ) );
+}
+
+void Interface::GameArea::addAnimatedTile( const fheroes2::Point & mp ) const
+{
+    const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
+
+    _animatedArea.add( _windowROI ^ fheroes2::Rect( tileOffset.x, tileOffset.y, TILEWIDTH, TILEWIDTH ) );
+}
+
 void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Image & src, const fheroes2::Rect & srcRoi, int32_t ox, int32_t oy,
                                       const fheroes2::Point & mp, bool flip, uint8_t alpha ) const
 {
@@ -396,8 +450,123 @@ void Interface::GameArea::DrawTile( fheroes2::Image & dst, const fheroes2::Image
     fheroes2::Copy( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width, overlappedRoi.height );
 }
 
+void Interface::GameArea::_redrawTerrain( fheroes2::Image & dst, const fheroes2::Rect & tileROI ) const
+{
+    const fheroes2::Rect cacheRoi{ 0, 0, _windowROI.width, _windowROI.height };
+
+    if ( _terrainCache.width() != cacheRoi.width || _terrainCache.height() != cacheRoi.height ) {
+        // Ground tiles are single-layer images so there is no need to keep the transform layer for the cached terrain.
+        _terrainCache._disableTransformLayer();
+        _terrainCacheBuffer._disableTransformLayer();
+        _terrainCache.resize( cacheRoi.width, cacheRoi.height );
+        _terrainCache.fill( 0 );
+
+        _terrainCacheTiles.assign( static_cast<size_t>( tileROI.width ) * tileROI.height, nullptr );
+        _terrainCacheTileROI = tileROI;
+        _terrainCacheOffset = _topLeftTileOffset;
+    }
+    else if ( _terrainCacheOffset != _topLeftTileOffset || _terrainCacheTileROI != tileROI ) {
+        // Move the part of the cached terrain which is still visible and keep track of tiles which are fully inside it.
+        const fheroes2::Point shift = _terrainCacheOffset - _topLeftTileOffset;
+        const fheroes2::Rect validRoi = cacheRoi ^ ( cacheRoi + shift );
+        const bool isValidRoiEmpty = validRoi.width <= 0 || validRoi.height <= 0;
+
+        if ( !isValidRoiEmpty ) {
+            _terrainCacheBuffer.resize( cacheRoi.width, cacheRoi.height );
+            fheroes2::Copy( _terrainCache, validRoi.x - shift.x, validRoi.y - shift.y, _terrainCacheBuffer, validRoi.x, validRoi.y, validRoi.width, validRoi.height );
+            std::swap( _terrainCache, _terrainCacheBuffer );
+        }
+
+        std::vector<const fheroes2::Image *> cachedTiles( static_cast<size_t>( tileROI.width ) * tileROI.height, nullptr );
+
+        if ( !isValidRoiEmpty ) {
+            for ( int32_t y = 0; y < tileROI.height; ++y ) {
+                for ( int32_t x = 0; x < tileROI.width; ++x ) {
+                    const fheroes2::Point tileId{ tileROI.x + x, tileROI.y + y };
+                    if ( !( _terrainCacheTileROI & tileId ) ) {
+                        continue;
+                    }
+
+                    const fheroes2::Rect tileRoi = cacheRoi ^ fheroes2::Rect{ GetRelativeTilePosition( tileId ) - _windowROI.getPosition(), { TILEWIDTH, TILEWIDTH } };
+                    if ( tileRoi.x < validRoi.x || tileRoi.y < validRoi.y || tileRoi.x + tileRoi.width > validRoi.x + validRoi.width
+                         || tileRoi.y + tileRoi.height > validRoi.y + validRoi.height ) {
+                        continue;
+                    }
+
+                    const fheroes2::Point cachedTileId = tileId - _terrainCacheTileROI.getPosition();
+                    cachedTiles[static_cast<size_t>( y ) * tileROI.width + x] = _terrainCacheTiles[static_cast<size_t>( cachedTileId.y ) * _terrainCacheTileROI.width + cachedTileId.x];
+                }
+            }
+        }
+
+        _terrainCacheTiles.swap( cachedTiles );
+        _terrainCacheTileROI = tileROI;
+        _terrainCacheOffset = _topLeftTileOffset;
+    }
+
+    // Redraw only those tiles which have a different terrain image comparing to the cached one.
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+    std::vector<std::pair<const fheroes2::Image *, fheroes2::Rect>> tilesToCopy;
+
+    for ( int32_t y = 0; y < tileROI.height; ++y ) {
+        for ( int32_t x = 0; x < tileROI.width; ++x ) {
+            const fheroes2::Point tileId{ tileROI.x + x, tileROI.y + y };
+
+            const bool isOutsideMap = tileId.x < 0 || tileId.y < 0 || tileId.x >= worldWidth || tileId.y >= worldHeight;
+            const fheroes2::Image & surface = isOutsideMap ? Maps::getEmptyTileSurface( tileId ) : Maps::getTileSurface( world.GetTiles( tileId.x, tileId.y ) );
+
+            const fheroes2::Image *& cachedSurface = _terrainCacheTiles[static_cast<size_t>( y ) * tileROI.width + x];
+            if ( cachedSurface == &surface ) {
+                continue;
+            }
+
+            tilesToCopy.emplace_back( &surface, fheroes2::Rect{ GetRelativeTilePosition( tileId ) - _windowROI.getPosition(), { surface.width(), surface.height() } } );
+
+            cachedSurface = &surface;
+        }
+    }
+
+    // Terrain images do not overlap each other so they can be copied in any order by several threads. Scrolling usually
+    // changes only a few tiles for which it is cheaper to copy them right away.
+    const size_t minTilesForParallelCopy = 64;
+
+    const auto copyTile = [this, &cacheRoi, &tilesToCopy]( const size_t i ) {
+        const auto & [surface, imageRoi] = tilesToCopy[i];
+        const fheroes2::Rect overlappedRoi = cacheRoi ^ imageRoi;
+
+        fheroes2::Copy( *surface, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, _terrainCache, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width,
+                        overlappedRoi.height );
+    };
+
+    if ( tilesToCopy.size() >= minTilesForParallelCopy ) {
+        _terrainCache.makeUnique();
+
+        MultiThreading::getThreadPool().parallelFor( 0, tilesToCopy.size(), copyTile );
+    }
+    else {
+        for ( size_t i = 0; i < tilesToCopy.size(); ++i ) {
+            copyTile( i );
+        }
+    }
+
+    // Rows of the output are independent so the cached terrain is copied in horizontal bands.
+    const int32_t bandHeight = TILEWIDTH * 4;
+    const int32_t bandCount = ( _windowROI.height + bandHeight - 1 ) / bandHeight;
+
+    dst.makeUnique();
+
+    MultiThreading::getThreadPool().parallelFor( 0, static_cast<size_t>( bandCount ), [this, &dst, bandHeight]( const size_t band ) {
+        const int32_t offsetY = static_cast<int32_t>( band ) * bandHeight;
+        fheroes2::Copy( _terrainCache, 0, offsetY, dst, _windowROI.x, _windowROI.y + offsetY, _windowROI.width, std::min( bandHeight, _windowROI.height - offsetY ) );
+    } );
+}
+
 void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw ) const
 {
+    PROFILE_ZONE( "Game area redraw" );
+
     const fheroes2::Rect & tileROI = GetVisibleTileROI();
 
     int32_t minX = tileROI.x;
@@ -411,30 +580,9 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     const bool renderFog = ( flag & LEVEL_FOG ) == LEVEL_FOG;
 #endif
 
-    // Render terrain.
-    for ( int32_t y = 0; y < tileROI.height; ++y ) {
-        fheroes2::Point offset( tileROI.x, tileROI.y + y );
+    _redrawTerrain( dst, tileROI );
 
-        if ( offset.y < 0 || offset.y >= world.h() ) {
-            for ( ; offset.x < maxX; ++offset.x ) {
-                Maps::redrawEmptyTile( dst, offset, *this );
-            }
-        }
-        else {
-            for ( ; offset.x < maxX; ++offset.x ) {
-                if ( offset.x < 0 || offset.x >= world.w() ) {
-                    Maps::redrawEmptyTile( dst, offset, *this );
-                }
-                else {
-                    const Maps::Tiles & tile = world.GetTiles( offset.x, offset.y );
-                    // Do not render terrain on the tiles fully covered with the fog.
-                    if ( tile.getFogDirection() != DIRECTION_ALL || !renderFog ) {
-                        DrawTile( dst, getTileSurface( tile ), offset );
-                    }
-                }
-            }
-        }
-    }
+    _animatedArea.clear();
 
     minX = std::max( minX, 0 );
     minY = std::max( minY, 0 );
@@ -470,6 +618,10 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
     TileUnfitRenderObjectInfo tileUnfit;
 
+    // The same containers are used for all tiles to avoid memory allocations
+    std::vector<fheroes2::ObjectRenderingInfo> spriteInfo;
+    std::vector<fheroes2::ObjectRenderingInfo> spriteShadowInfo;
+
     const Heroes * currentHero = drawHeroes ? GetFocusHeroes() : nullptr;
 
     // TODO: Dragon City with Object ICN Type OBJ_ICN_TYPE_OBJNMUL2 and object index 46 is a bottom layer sprite.
@@ -517,6 +669,9 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
                 populateHeroObjectInfo( tileUnfit, hero );
 
+                // Hero flags are animated.
+                addAnimatedTiles( *this, hero->getHeroSpritesPerTile(), hero->GetCenter() );
+
                 // Update object type as it could be an object under the hero.
                 objectType = tile.GetObject( false );
 
@@ -530,8 +685,11 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
                 const uint8_t alphaValue = getObjectAlphaValue( tile.GetIndex(), MP2::OBJ_MONSTER );
 
-                auto spriteInfo = getMonsterSpritesPerTile( tile );
-                auto spriteShadowInfo = getMonsterShadowSpritesPerTile( tile );
+                getMonsterSpritesPerTile( tile, spriteInfo );
+                getMonsterShadowSpritesPerTile( tile, spriteShadowInfo );
+
+                addAnimatedTiles( *this, spriteInfo, tile.GetCenter() );
+                addAnimatedTiles( *this, spriteShadowInfo, tile.GetCenter() );
 
                 populateStaticTileUnfitObjectInfo( tileUnfit, spriteInfo, spriteShadowInfo, tile.GetCenter(), alphaValue );
 
@@ -549,8 +707,8 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
                 const uint8_t alphaValue = getObjectAlphaValue( tile.GetIndex(), MP2::OBJ_BOAT );
 
-                auto spriteInfo = getBoatSpritesPerTile( tile );
-                auto spriteShadowInfo = getBoatShadowSpritesPerTile( tile );
+                getBoatSpritesPerTile( tile, spriteInfo );
+                getBoatShadowSpritesPerTile( tile, spriteShadowInfo );
 
                 populateStaticTileUnfitObjectInfo( tileUnfit, spriteInfo, spriteShadowInfo, tile.GetCenter(), alphaValue );
 
@@ -563,7 +721,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
             // These are parts of original action objects which must be rendered under heroes.
             if ( objectType == MP2::OBJ_MINES ) {
-                auto spriteInfo = getMineGuardianSpritesPerTile( tile );
+                getMineGuardianSpritesPerTile( tile, spriteInfo );
                 if ( !spriteInfo.empty() ) {
                     const uint8_t alphaValue = getObjectAlphaValue( tile.GetObjectUID() );
                     populateStaticTileUnfitBackgroundObjectInfo( tileUnfit, spriteInfo, tile.GetCenter(), alphaValue );
@@ -589,7 +747,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw the lower part of tile-unfit object's sprite.
-    renderImagesOnTiles( dst, tileUnfit.bottomBackgroundImages, *this );
+    tileUnfit.bottomBackgroundImages.render( dst, *this );
 
     for ( int32_t y = minY; y < maxY; ++y ) {
         for ( int32_t x = minX; x < maxX; ++x ) {
@@ -604,13 +762,13 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw all shadows from tile-unfit objects.
-    renderImagesOnTiles( dst, tileUnfit.shadowImages, *this );
+    tileUnfit.shadowImages.render( dst, *this );
 
     // Draw the lower part of hero's sprite including boat sprite when it is controlled by hero.
-    renderImagesOnTiles( dst, tileUnfit.heroBackgroundImages, *this );
+    tileUnfit.heroBackgroundImages.render( dst, *this );
 
     // Low priority images are drawn before any other object on this tile.
-    renderImagesOnTiles( dst, tileUnfit.lowPriorityBottomImages, *this );
+    tileUnfit.lowPriorityBottomImages.render( dst, *this );
 
     for ( int32_t y = minY; y < maxY; ++y ) {
         for ( int32_t x = minX; x < maxX; ++x ) {
@@ -626,10 +784,10 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw middle part of tile-unfit sprites.
-    renderImagesOnTiles( dst, tileUnfit.bottomImages, *this );
+    tileUnfit.bottomImages.render( dst, *this );
 
     // High priority images are drawn after any other object on this tile.
-    renderImagesOnTiles( dst, tileUnfit.highPriorityBottomImages, *this );
+    tileUnfit.highPriorityBottomImages.render( dst, *this );
 
     std::vector<const Maps::TilesAddon *> topLayerTallObjects;
 
@@ -675,7 +833,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw upper part of tile-unfit sprites.
-    renderImagesOnTiles( dst, tileUnfit.topImages, *this );
+    tileUnfit.topImages.render( dst, *this );
 
     // Draw hero's route. It should be drawn on top of everything.
     const bool drawRoutes = ( flag & LEVEL_ROUTES ) != 0;
@@ -773,7 +931,7 @@ void Interface::GameArea::updateMapFogDirections()
 {
     const int32_t friendColors = Players::FriendColors();
 
-    Maps::Tiles::updateFogDirectionsInArea( { 0, 0 }, { world.w(), world.h() }, friendColors );
+    world.updateFogDirections( friendColors );
 }
 
 void Interface::GameArea::Scroll()
@@ -33,6 +33,7 @@
 #include "image.h"
 #include "math_base.h"
 #include "mp2.h"
+#include "screen.h"
 #include "timing.h"
 
 namespace Interface
@@ -209,6 +210,19 @@ namespace Interface
         void BlitOnTile( fheroes2::Image & dst, const fheroes2::Image & src, const fheroes2::Rect & srcRoi, int32_t ox, int32_t oy, const fheroes2::Point & mp, bool flip,
                          uint8_t alpha ) const;
 
+        // Marks the area of an image rendered by BlitOnTile() with the same parameters as changing with adventure map animation frames.
+        void addAnimatedArea( const fheroes2::Image & src, const int32_t ox, const int32_t oy, const fheroes2::Point & mp ) const;
+
+        // Marks the whole tile as changing with adventure map animation frames.
+        void addAnimatedTile( const fheroes2::Point & mp ) const;
+
+        // Returns the display areas of the animated objects rendered by the last Redraw() call.
+        // Nothing else in the game area changes when only the adventure map animation frame is updated.
+        const fheroes2::RenderRegion & getAnimatedArea() const
+        {
+            return _animatedArea;
+        }
+
         // Use this method to draw TIL images
         void DrawTile( fheroes2::Image & src, const fheroes2::Image & dst, const fheroes2::Point & mp ) const;
 
@@ -284,6 +298,18 @@ namespace Interface
         // This member needs to be mutable because it is modified during rendering.
         mutable std::vector<std::shared_ptr<BaseObjectAnimationInfo>> _animationInfo;
 
+        // Terrain of the visible area which is kept between frames and shifted while scrolling so only changed or newly visible tiles are redrawn.
+        // These members need to be mutable because they are modified during rendering.
+        mutable fheroes2::Image _terrainCache;
+        mutable fheroes2::Image _terrainCacheBuffer;
+        // Terrain images drawn on each tile of the cached tile ROI. A null pointer means that a tile must be redrawn.
+        mutable std::vector<const fheroes2::Image *> _terrainCacheTiles;
+        mutable fheroes2::Rect _terrainCacheTileROI;
+        mutable fheroes2::Point _terrainCacheOffset;
+
+        // This member needs to be mutable because it is modified during rendering.
+        mutable fheroes2::RenderRegion _animatedArea;
+
         fheroes2::Point _lastMouseDragPosition;
         bool _mouseDraggingInitiated;
         bool _mouseDraggingMovement;
@@ -300,6 +326,8 @@ namespace Interface
         void _setCenterToTile( const fheroes2::Point & tile ); // set center to the middle of tile (input is tile ID)
 
         void updateObjectAnimationInfo() const;
+
+        void _redrawTerrain( fheroes2::Image & dst, const fheroes2::Rect & tileROI ) const;
     };
 }
 
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -49,6 +50,7 @@
 #endif
 #include "settings.h"
 #include "text.h"
+#include "tools.h"
 #include "translations.h"
 #include "world.h"
 
@@ -156,6 +158,7 @@ Interface::Radar::Radar( const Radar & radar, const fheroes2::Display & display
     , _radarType( RadarType::ViewWorld )
     , _interface( radar._interface )
     , _roi( 0, 0, world.w(), world.h() )
+    , _zoomOffsets( radar._zoomOffsets )
     , _zoom( radar._zoom )
     , _hide( false )
 {
@@ -180,6 +183,7 @@ void Interface::Radar::Build()
 {
     SetZoom();
     _roi = { 0, 0, world.w(), world.h() };
+    _isPartialRedraw = false;
 }
 
 void Interface::Radar::SetZoom()
@@ -193,6 +197,11 @@ void Interface::Radar::SetZoom()
 
     // Currently we have and support only maps with 36 - 144 tiles width and height.
     assert( ( _zoom >= 1.0 ) && ( _zoom <= 4.0 ) );
+
+    _zoomOffsets.resize( static_cast<size_t>( worldWidth ) + 1 );
+    for ( int32_t i = 0; i <= worldWidth; ++i ) {
+        _zoomOffsets[i] = static_cast<int32_t>( i * _zoom );
+    }
 }
 
 void Interface::Radar::SetRedraw( const uint32_t redrawMode ) const
@@ -209,7 +218,11 @@ void Interface::Radar::SetRenderArea( const fheroes2::Rect & roi )
     // We set ROI only if radar is visible as there will be no render of radar map image if it is hidden.
     if ( !conf.isHideInterfaceEnabled() || conf.ShowRadar() ) {
         // "_roi" should not be outside the "world".
-        _roi = roi ^ fheroes2::Rect( 0, 0, world.w(), world.h() );
+        const fheroes2::Rect worldRoi = roi ^ fheroes2::Rect( 0, 0, world.w(), world.h() );
+
+        // Several areas can be changed before the next radar map redraw so all of them must be updated.
+        _roi = _isPartialRedraw ? fheroes2::getBoundaryRect( _roi, worldRoi ) : worldRoi;
+        _isPartialRedraw = true;
     }
 }
 
@@ -225,6 +238,7 @@ void Interface::Radar::_redraw( const bool redrawMapObjects )
 
             // Force set radar ROI for the whole world to be prepared to fully update radar when it will be shown.
             _roi = { 0, 0, world.w(), world.h() };
+            _isPartialRedraw = false;
             return;
         }
     }
@@ -236,6 +250,7 @@ void Interface::Radar::_redraw( const bool redrawMapObjects )
 
         // Force set radar ROI for the whole world to be prepared to fully update radar when it will be shown.
         _roi = { 0, 0, world.w(), world.h() };
+        _isPartialRedraw = false;
     }
     else {
         _cursorArea.hide();
@@ -307,14 +322,16 @@ void Interface::Radar::RedrawObjects( const int32_t playerColor, const ViewWorld
 
     const int32_t radarWidth = _map.width();
 
+    assert( _zoomOffsets.size() == static_cast<size_t>( world.w() ) + 1 );
+
     const bool isZoomIn = _zoom > 1.0;
 
     const int32_t maxRoiX = _roi.width + _roi.x;
     const int32_t maxRoiY = _roi.height + _roi.y;
 
     for ( int32_t y = _roi.y; y < maxRoiY; ++y ) {
-        uint8_t * radarY = radarImage + static_cast<ptrdiff_t>( y * _zoom ) * radarWidth;
-        const ptrdiff_t radarYStep = isZoomIn ? ( static_cast<ptrdiff_t>( ( y + 1 ) * _zoom ) * radarWidth ) : 0;
+        uint8_t * radarY = radarImage + static_cast<ptrdiff_t>( _zoomOffsets[y] ) * radarWidth;
+        const ptrdiff_t radarYStep = isZoomIn ? ( static_cast<ptrdiff_t>( _zoomOffsets[y + 1] ) * radarWidth ) : 0;
 
         for ( int32_t x = _roi.x; x < maxRoiX; ++x ) {
             const Maps::Tiles & tile = world.GetTiles( x, y );
@@ -397,10 +414,10 @@ void Interface::Radar::RedrawObjects( const int32_t playerColor, const ViewWorld
                 }
             }
 
-            uint8_t * radarX = radarY + static_cast<ptrdiff_t>( x * _zoom );
+            uint8_t * radarX = radarY + _zoomOffsets[x];
             if ( isZoomIn ) {
-                const uint8_t * radarYEnd = radarImage + radarYStep + static_cast<ptrdiff_t>( x * _zoom );
-                uint8_t * radarXEnd = radarY + static_cast<ptrdiff_t>( ( x + 1 ) * _zoom );
+                const uint8_t * radarYEnd = radarImage + radarYStep + _zoomOffsets[x];
+                uint8_t * radarXEnd = radarY + _zoomOffsets[x + 1];
 
                 for ( ; radarX != radarYEnd; radarX += radarWidth, radarXEnd += radarWidth ) {
                     std::fill( radarX, radarXEnd, fillColor );
@@ -414,6 +431,7 @@ void Interface::Radar::RedrawObjects( const int32_t playerColor, const ViewWorld
 
     // Reset ROI to full radar image to be able to redraw the mini-map without calling 'SetMapRedraw()'.
     _roi = { 0, 0, world.w(), world.h() };
+    _isPartialRedraw = false;
 }
 
 // Redraw radar cursor. RoiRectangle is a rectangle in tile unit of the current radar view.
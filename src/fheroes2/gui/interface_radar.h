@@ -25,6 +25,7 @@
 #define H2INTERFACE_RADAR_H
 
 #include <cstdint>
+#include <vector>
 
 #include "gamedefs.h"
 #include "image.h"
@@ -104,7 +105,11 @@ namespace Interface
         fheroes2::Image _map{ RADARWIDTH, RADARWIDTH };
         fheroes2::MovableSprite _cursorArea;
         fheroes2::Rect _roi;
+        // Radar image offset of every tile row and column (and the end of the last one) for the current zoom.
+        std::vector<int32_t> _zoomOffsets;
         double _zoom{ 1.0 };
+        // Whether '_roi' contains only the areas changed since the last radar map redraw rather than the whole world.
+        bool _isPartialRedraw{ false };
         bool _hide{ true };
         bool _mouseDraggingMovement{ false };
     };
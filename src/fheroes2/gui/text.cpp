@@ -22,7 +22,13 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cctype>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "text.h"
@@ -33,6 +39,73 @@ namespace
     {
         return font == Font::SMALL || font == Font::YELLOW_SMALL || font == Font::GRAY_SMALL;
     }
+
+    int calculateCharWidth( const uint8_t character, const int ft )
+    {
+        if ( character < 0x21 || character > fheroes2::AGG::ASCIILastSupportedCharacter( ft ) ) {
+            if ( isSmallFont( ft ) )
+                return 4;
+            else
+                return 6;
+        }
+        else {
+            return fheroes2::AGG::GetLetter( character, ft ).width();
+        }
+    }
+
+    // Character widths are requested for every character of every text. Fonts change only with a language so the widths are stored per font.
+    class CharWidthTable
+    {
+    public:
+        int getWidth( const uint8_t character, const int ft )
+        {
+            const uint32_t alphabetVersion = fheroes2::AGG::getAlphabetVersion();
+            if ( _alphabetVersion != alphabetVersion ) {
+                for ( std::array<int, 256> & widths : _widths ) {
+                    widths.fill( unknownWidth );
+                }
+                _alphabetVersion = alphabetVersion;
+            }
+
+            int & width = _widths[getFontIndex( ft )][character];
+            if ( width == unknownWidth ) {
+                width = calculateCharWidth( character, ft );
+            }
+
+            return width;
+        }
+
+    private:
+        static size_t getFontIndex( const int ft )
+        {
+            switch ( ft ) {
+            case Font::SMALL:
+                return 0;
+            case Font::BIG:
+                return 1;
+            case Font::YELLOW_BIG:
+                return 2;
+            case Font::YELLOW_SMALL:
+                return 3;
+            case Font::GRAY_SMALL:
+                return 4;
+            default:
+                assert( 0 );
+                break;
+            }
+
+            return 0;
+        }
+
+        static const int unknownWidth = std::numeric_limits<int>::min();
+
+        std::array<std::array<int, 256>, 5> _widths;
+
+        // The version is set to a value which is never returned by AGG to force initialization on the first call.
+        uint32_t _alphabetVersion = std::numeric_limits<uint32_t>::max();
+    };
+
+    CharWidthTable charWidthTable;
 }
 
 class TextAscii
@@ -88,15 +161,7 @@ size_t TextAscii::size() const
 
 int TextAscii::charWidth( const uint8_t character, const int ft )
 {
-    if ( character < 0x21 || character > fheroes2::AGG::ASCIILastSupportedCharacter( ft ) ) {
-        if ( isSmallFont( ft ) )
-            return 4;
-        else
-            return 6;
-    }
-    else {
-        return fheroes2::AGG::GetLetter( character, ft ).width();
-    }
+    return charWidthTable.getWidth( character, ft );
 }
 
 int TextAscii::fontHeight( const int f )
@@ -309,6 +374,137 @@ int32_t Text::getFitWidth( const std::string & text, const int fontId, const int
     return fitWidth;
 }
 
+namespace
+{
+    struct TextBoxLayout
+    {
+        std::vector<std::string> rows;
+        int32_t height{ 0 };
+    };
+
+    // Splits one line of the text into rows which fit into the given width
+    void appendTextBoxRows( const std::string & msg, int ft, uint32_t width_, TextBoxLayout & layout )
+    {
+        uint32_t www = 0;
+
+        std::string::const_iterator pos1 = msg.begin();
+        std::string::const_iterator pos2 = pos1;
+        std::string::const_iterator pos3 = msg.end();
+        std::string::const_iterator space = pos2;
+
+        const uint32_t maxSupportedCharacter = fheroes2::AGG::ASCIILastSupportedCharacter( ft );
+
+        const int fontHeight = TextAscii::fontHeight( ft );
+
+        while ( pos2 < pos3 ) {
+            // To use std::isspace safely with plain chars (or signed chars), the argument should first be converted to unsigned char:
+            // https://en.cppreference.com/w/cpp/string/byte/isspace
+            const uint8_t character = static_cast<uint8_t>( *pos2 );
+
+            if ( std::isspace( character ) || character > maxSupportedCharacter ) {
+                space = pos2;
+            }
+            const int charWidth = TextAscii::charWidth( character, ft );
+
+            if ( www + charWidth >= width_ ) {
+                www = 0;
+                layout.height += fontHeight;
+                if ( pos3 != space ) {
+                    if ( space == msg.begin() ) {
+                        if ( pos2 - pos1 < 1 ) // this should never happen!
+                            return;
+                        layout.rows.emplace_back( msg.substr( pos1 - msg.begin(), pos2 - pos1 ) );
+                    }
+                    else {
+                        pos2 = space + 1;
+                        layout.rows.emplace_back( msg.substr( pos1 - msg.begin(), pos2 - pos1 - 1 ) );
+                    }
+                }
+                else {
+                    layout.rows.emplace_back( msg.substr( pos1 - msg.begin(), pos2 - pos1 ) );
+                }
+
+                pos1 = pos2;
+                space = pos3;
+                continue;
+            }
+
+            www += charWidth;
+            ++pos2;
+        }
+
+        if ( pos1 != pos2 ) {
+            layout.height += fontHeight;
+            layout.rows.emplace_back( msg.substr( pos1 - msg.begin(), pos2 - pos1 ) );
+        }
+    }
+
+    // Dialogs set the same texts to text boxes several times, e.g. once to find the size of the dialog and once to render it, so the row breaks
+    // of the most recent texts are kept.
+    class TextBoxLayoutCache
+    {
+    public:
+        const TextBoxLayout & get( const std::string & msg, const int ft, const uint32_t width_ )
+        {
+            assert( !msg.empty() );
+
+            const uint32_t alphabetVersion = fheroes2::AGG::getAlphabetVersion();
+
+            for ( auto iter = _entries.begin(); iter != _entries.end(); ++iter ) {
+                if ( iter->width == width_ && iter->font == ft && iter->alphabetVersion == alphabetVersion && iter->text == msg ) {
+                    if ( iter != _entries.begin() ) {
+                        Entry entry = std::move( *iter );
+                        _entries.erase( iter );
+                        _entries.emplace_front( std::move( entry ) );
+                    }
+                    return _entries.front().layout;
+                }
+            }
+
+            TextBoxLayout layout;
+
+            const char sep = '\n';
+            std::string substr;
+            substr.reserve( msg.size() );
+            std::string::const_iterator pos1 = msg.begin();
+            std::string::const_iterator pos2;
+            while ( msg.end() != ( pos2 = std::find( pos1, msg.end(), sep ) ) ) {
+                substr.assign( pos1, pos2 );
+                appendTextBoxRows( substr, ft, width_, layout );
+                pos1 = pos2 + 1;
+            }
+            if ( pos1 < msg.end() ) {
+                substr.assign( pos1, msg.end() );
+                appendTextBoxRows( substr, ft, width_, layout );
+            }
+
+            if ( _entries.size() >= maxEntries ) {
+                _entries.pop_back();
+            }
+
+            _entries.push_front( { msg, ft, width_, alphabetVersion, std::move( layout ) } );
+
+            return _entries.front().layout;
+        }
+
+    private:
+        struct Entry
+        {
+            std::string text;
+            int font;
+            uint32_t width;
+            uint32_t alphabetVersion;
+            TextBoxLayout layout;
+        };
+
+        static const size_t maxEntries = 16;
+
+        std::deque<Entry> _entries;
+    };
+
+    TextBoxLayoutCache textBoxLayoutCache;
+}
+
 TextBox::TextBox( const std::string & msg, int ft, uint32_t width_ )
     : align( ALIGN_CENTER )
 {
@@ -329,77 +525,15 @@ void TextBox::Set( const std::string & msg, int ft, uint32_t width_ )
     if ( msg.empty() )
         return;
 
-    const char sep = '\n';
-    std::string substr;
-    substr.reserve( msg.size() );
-    std::string::const_iterator pos1 = msg.begin();
-    std::string::const_iterator pos2;
-    while ( msg.end() != ( pos2 = std::find( pos1, msg.end(), sep ) ) ) {
-        substr.assign( pos1, pos2 );
-        Append( substr, ft, width_ );
-        pos1 = pos2 + 1;
-    }
-    if ( pos1 < msg.end() ) {
-        substr.assign( pos1, msg.end() );
-        Append( substr, ft, width_ );
-    }
-}
-
-void TextBox::Append( const std::string & msg, int ft, uint32_t width_ )
-{
-    uint32_t www = 0;
     fheroes2::Rect::width = width_;
 
-    std::string::const_iterator pos1 = msg.begin();
-    std::string::const_iterator pos2 = pos1;
-    std::string::const_iterator pos3 = msg.end();
-    std::string::const_iterator space = pos2;
-
-    const uint32_t maxSupportedCharacter = fheroes2::AGG::ASCIILastSupportedCharacter( ft );
-
-    const int fontHeight = TextAscii::fontHeight( ft );
-
-    while ( pos2 < pos3 ) {
-        // To use std::isspace safely with plain chars (or signed chars), the argument should first be converted to unsigned char:
-        // https://en.cppreference.com/w/cpp/string/byte/isspace
-        const uint8_t character = static_cast<uint8_t>( *pos2 );
-
-        if ( std::isspace( character ) || character > maxSupportedCharacter ) {
-            space = pos2;
-        }
-        const int charWidth = TextAscii::charWidth( character, ft );
-
-        if ( www + charWidth >= width_ ) {
-            www = 0;
-            fheroes2::Rect::height += fontHeight;
-            if ( pos3 != space ) {
-                if ( space == msg.begin() ) {
-                    if ( pos2 - pos1 < 1 ) // this should never happen!
-                        return;
-                    messages.emplace_back( msg.substr( pos1 - msg.begin(), pos2 - pos1 ), ft );
-                }
-                else {
-                    pos2 = space + 1;
-                    messages.emplace_back( msg.substr( pos1 - msg.begin(), pos2 - pos1 - 1 ), ft );
-                }
-            }
-            else {
-                messages.emplace_back( msg.substr( pos1 - msg.begin(), pos2 - pos1 ), ft );
-            }
+    const TextBoxLayout & layout = textBoxLayoutCache.get( msg, ft, width_ );
 
-            pos1 = pos2;
-            space = pos3;
-            continue;
-        }
-
-        www += charWidth;
-        ++pos2;
+    for ( const std::string & row : layout.rows ) {
+        messages.emplace_back( row, ft );
     }
 
-    if ( pos1 != pos2 ) {
-        fheroes2::Rect::height += fontHeight;
-        messages.emplace_back( msg.substr( pos1 - msg.begin(), pos2 - pos1 ), ft );
-    }
+    fheroes2::Rect::height = layout.height;
 }
 
 void TextBox::Blit( int32_t ax, int32_t ay, fheroes2::Image & sf )
@@ -162,8 +162,6 @@ public:
     void Blit( int32_t, int32_t, fheroes2::Image & sf = fheroes2::Display::instance() );
 
 private:
-    void Append( const std::string &, int, uint32_t );
-
     std::list<Text> messages;
     int align;
 };
@@ -21,10 +21,13 @@
 #include "ui_text.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <deque>
+#include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "agg_image.h"
@@ -76,11 +79,50 @@ namespace
         return 0;
     }
 
+    // Character widths are requested for every character of every text. Fonts change only with a language so the widths are stored per font.
+    class GlyphWidthTable
+    {
+    public:
+        int32_t getWidth( const uint8_t character, const fheroes2::FontType & fontType )
+        {
+            const uint32_t alphabetVersion = fheroes2::AGG::getAlphabetVersion();
+            if ( _alphabetVersion != alphabetVersion ) {
+                for ( std::array<int32_t, 256> & widths : _widths ) {
+                    widths.fill( unknownWidth );
+                }
+                _alphabetVersion = alphabetVersion;
+            }
+
+            const size_t fontId = static_cast<size_t>( fontType.size ) * fontColorCount + static_cast<size_t>( fontType.color );
+            assert( fontId < _widths.size() );
+
+            int32_t & width = _widths[fontId][character];
+            if ( width == unknownWidth ) {
+                const fheroes2::Sprite & image = fheroes2::AGG::getChar( character, fontType );
+                assert( ( fontType.size != fheroes2::FontSize::BUTTON_RELEASED && fontType.size != fheroes2::FontSize::BUTTON_PRESSED && image.x() >= 0 )
+                        || image.x() < 0 );
+                width = image.x() + image.width();
+            }
+
+            return width;
+        }
+
+    private:
+        static const size_t fontSizeCount = static_cast<size_t>( fheroes2::FontSize::BUTTON_PRESSED ) + 1;
+        static const size_t fontColorCount = static_cast<size_t>( fheroes2::FontColor::YELLOW ) + 1;
+        static const int32_t unknownWidth = std::numeric_limits<int32_t>::min();
+
+        std::array<std::array<int32_t, 256>, fontSizeCount * fontColorCount> _widths;
+
+        // The version is set to a value which is never returned by AGG to force initialization on the first call.
+        uint32_t _alphabetVersion = std::numeric_limits<uint32_t>::max();
+    };
+
+    GlyphWidthTable glyphWidthTable;
+
     int32_t getCharWidth( const uint8_t character, const fheroes2::FontType & fontType )
     {
-        const fheroes2::Sprite & image = fheroes2::AGG::getChar( character, fontType );
-        assert( ( fontType.size != fheroes2::FontSize::BUTTON_RELEASED && fontType.size != fheroes2::FontSize::BUTTON_PRESSED && image.x() >= 0 ) || image.x() < 0 );
-        return image.x() + image.width();
+        return glyphWidthTable.getWidth( character, fontType );
     }
 
     int32_t getLineWidth( const uint8_t * data, const int32_t size, const fheroes2::FontType & fontType )
@@ -465,6 +507,73 @@ namespace
 
         return maxWidth;
     }
+
+    struct MultiRowSize
+    {
+        int32_t maxRowWidth{ 0 };
+        int32_t lastRowOffsetY{ 0 };
+    };
+
+    // Dialogs ask for the width, height and number of rows of the same text several times in a row. Each query requires
+    // a full text layout so the results of the most recent layouts are kept.
+    class MultiRowSizeCache
+    {
+    public:
+        MultiRowSize get( const std::string & text, const fheroes2::FontType & fontType, const int32_t maxWidth )
+        {
+            assert( !text.empty() );
+
+            const uint32_t alphabetVersion = fheroes2::AGG::getAlphabetVersion();
+
+            for ( auto iter = _entries.begin(); iter != _entries.end(); ++iter ) {
+                if ( iter->maxWidth == maxWidth && iter->fontType.size == fontType.size && iter->fontType.color == fontType.color
+                     && iter->alphabetVersion == alphabetVersion && iter->text == text ) {
+                    const MultiRowSize size = iter->size;
+                    if ( iter != _entries.begin() ) {
+                        Entry entry = std::move( *iter );
+                        _entries.erase( iter );
+                        _entries.emplace_front( std::move( entry ) );
+                    }
+                    return size;
+                }
+            }
+
+            std::deque<fheroes2::Point> offsets;
+            getMultiRowInfo( reinterpret_cast<const uint8_t *>( text.data() ), static_cast<int32_t>( text.size() ), maxWidth, fontType,
+                             fheroes2::getFontHeight( fontType.size ), offsets );
+
+            MultiRowSize size;
+            size.maxRowWidth = offsets.front().x;
+            for ( const fheroes2::Point & point : offsets ) {
+                size.maxRowWidth = std::max( size.maxRowWidth, point.x );
+            }
+            size.lastRowOffsetY = offsets.back().y;
+
+            if ( _entries.size() >= maxEntries ) {
+                _entries.pop_back();
+            }
+
+            _entries.push_front( { text, fontType, maxWidth, alphabetVersion, size } );
+
+            return size;
+        }
+
+    private:
+        struct Entry
+        {
+            std::string text;
+            fheroes2::FontType fontType;
+            int32_t maxWidth;
+            uint32_t alphabetVersion;
+            MultiRowSize size;
+        };
+
+        static const size_t maxEntries = 16;
+
+        std::deque<Entry> _entries;
+    };
+
+    MultiRowSizeCache multiRowSizeCache;
 }
 
 namespace fheroes2
@@ -522,17 +631,7 @@ namespace fheroes2
             return 0;
         }
 
-        const int32_t fontHeight = getFontHeight( _fontType.size );
-
-        std::deque<Point> offsets;
-        getMultiRowInfo( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), maxWidth, _fontType, fontHeight, offsets );
-
-        int32_t maxRowWidth = offsets.front().x;
-        for ( const Point & point : offsets ) {
-            maxRowWidth = std::max( maxRowWidth, point.x );
-        }
-
-        return maxRowWidth;
+        return multiRowSizeCache.get( _text, _fontType, maxWidth ).maxRowWidth;
     }
 
     int32_t Text::height( const int32_t maxWidth ) const
@@ -541,12 +640,7 @@ namespace fheroes2
             return 0;
         }
 
-        const int32_t fontHeight = getFontHeight( _fontType.size );
-
-        std::deque<Point> offsets;
-        getMultiRowInfo( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), maxWidth, _fontType, fontHeight, offsets );
-
-        return offsets.back().y + fontHeight;
+        return multiRowSizeCache.get( _text, _fontType, maxWidth ).lastRowOffsetY + getFontHeight( _fontType.size );
     }
 
     int32_t Text::rows( const int32_t maxWidth ) const
@@ -555,12 +649,7 @@ namespace fheroes2
             return 0;
         }
 
-        const int32_t fontHeight = getFontHeight( _fontType.size );
-
-        std::deque<Point> offsets;
-        getMultiRowInfo( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), maxWidth, _fontType, fontHeight, offsets );
-
-        return offsets.back().y / fontHeight + 1;
+        return multiRowSizeCache.get( _text, _fontType, maxWidth ).lastRowOffsetY / getFontHeight( _fontType.size ) + 1;
     }
 
     void Text::draw( const int32_t x, const int32_t y, Image & output ) const
@@ -33,15 +33,20 @@
 #include <utility>
 
 #include "agg_image.h"
+#include "ai.h"
+#include "audio_manager.h"
 #include "cursor.h"
 #include "game_delays.h"
 #include "image_palette.h"
 #include "localevent.h"
+#include "logging.h"
 #include "screen.h"
 #include "settings.h"
 #include "system.h"
 #include "text.h"
+#include "thread.h"
 #include "translations.h"
+#include "world.h"
 
 namespace
 {
@@ -123,7 +128,78 @@ namespace
         std::deque<double> _fps;
     };
 
+    // Renderer of frame timings, sprite cache, image pool and AI statistics on screen
+    class PerformanceOverlayRenderer
+    {
+    public:
+        void preRender()
+        {
+            if ( !Settings::Get().isPerformanceOverlayEnabled() ) {
+                return;
+            }
+
+            const fheroes2::Display::FrameStatistics & frame = fheroes2::Display::instance().lastFrameStatistics();
+
+            const uint64_t fpsX10 = frame.frameTime == 0 ? 0 : 10000000 / frame.frameTime;
+
+            const fheroes2::AGG::ICNCacheStatistics & cache = fheroes2::AGG::getICNCacheStatistics();
+            const uint64_t requestCount = cache.hits + cache.misses;
+            const uint64_t hitRateX10 = requestCount == 0 ? 0 : cache.hits * 1000 / requestCount;
+
+            const size_t cacheMemoryKb = fheroes2::AGG::getICNMemoryUsage() / 1024;
+
+            _lines[0].SetText( "FPS: " + toFixedPoint( fpsX10, 10 ) + ", frame: " + toFixedPoint( frame.frameTime, 1000 ) + " ms", Font::SMALL );
+            _lines[1].SetText( "events: " + toFixedPoint( frame.eventProcessingTime, 1000 ) + " ms, redraw: " + toFixedPoint( frame.redrawTime, 1000 )
+                               + " ms, present: " + toFixedPoint( frame.presentTime, 1000 ) + " ms, idle: " + toFixedPoint( frame.idleTime, 1000 ) + " ms", Font::SMALL );
+            _lines[2].SetText( "render: " + std::to_string( frame.renderAreaCount ) + " areas, " + std::to_string( frame.renderPixelCount ) + " pixels", Font::SMALL );
+            _lines[3].SetText( "sprite cache: " + toFixedPoint( cacheMemoryKb, 1024 ) + " MB, hit rate: " + toFixedPoint( hitRateX10, 10 ) + "%", Font::SMALL );
+            _lines[4].SetText( "AI turn: " + std::to_string( AI::Get().getLastKingdomTurnDuration() ) + " ms", Font::SMALL );
+
+            const fheroes2::ImageBufferPoolStatistics pool = fheroes2::getImageBufferPoolStatistics();
+            const uint64_t poolRequestCount = pool.hits + pool.misses;
+            const uint64_t poolHitRateX10 = poolRequestCount == 0 ? 0 : pool.hits * 1000 / poolRequestCount;
+
+            _lines[5].SetText( "image pool: " + toFixedPoint( pool.cachedBytes / 1024, 1024 ) + " MB, hit rate: " + toFixedPoint( poolHitRateX10, 10 ) + "%",
+                               Font::SMALL );
+
+            // Audio caches are not shown here as it would require to wait for the audio thread on every frame.
+            _lines[6].SetText( "world: " + toFixedPoint( world.getMemoryUsage() / 1024, 1024 ) + " MB, AI pathfinder: "
+                                   + toFixedPoint( AI::Get().getPathfinderMemoryUsage() / 1024, 1024 ) + " MB",
+                               Font::SMALL );
+
+            const int32_t offsetX = 26;
+            int32_t offsetY = 10;
+
+            for ( TextSprite & line : _lines ) {
+                line.SetPos( offsetX, offsetY );
+                line.Show();
+
+                offsetY += line.h() - 2;
+            }
+        }
+
+        void postRender()
+        {
+            // Restore the background in the reverse order as each line keeps the screen area behind it.
+            for ( auto iter = _lines.rbegin(); iter != _lines.rend(); ++iter ) {
+                if ( iter->isShow() ) {
+                    iter->Hide();
+                }
+            }
+        }
+
+    private:
+        std::array<TextSprite, 7> _lines;
+
+        // Formats the value divided by the given divisor with one decimal digit.
+        static std::string toFixedPoint( const uint64_t value, const uint64_t divisor )
+        {
+            return std::to_string( value / divisor ) + '.' + std::to_string( value % divisor * 10 / divisor );
+        }
+    };
+
     SystemInfoRenderer systemInfoRenderer;
+    PerformanceOverlayRenderer performanceOverlayRenderer;
 
     void fadeDisplay( const uint8_t startAlpha, const uint8_t endAlpha, const fheroes2::Rect & roi, const uint32_t fadeTimeMs, const uint32_t frameCount )
     {
@@ -477,14 +553,18 @@ namespace fheroes2
         Image out( width, height );
         std::fill( out.transform(), out.transform() + static_cast<size_t>( width * height ), static_cast<uint8_t>( 0 ) );
 
-        uint8_t * imageOutX = out.image();
+        uint8_t * imageOut = out.image();
         const uint8_t * imageIn = in.image();
 
         const uint8_t * gamePalette = getGamePalette();
 
         // The spell effect represents as a blurry image. The blur algorithm should blur only horizontally and vertically from current pixel.
         // So the color data is averaged in a "cross" around the current pixel (not a square or circle like other blur algorithms).
-        for ( int32_t y = 0; y < height; ++y ) {
+        // Every row of the output depends only on the input image, so the rows are processed in parallel.
+        MultiThreading::getThreadPool().parallelFor( 0, static_cast<size_t>( height ), [=]( const size_t row ) {
+            const int32_t y = static_cast<int32_t>( row );
+            uint8_t * imageOutX = imageOut + static_cast<ptrdiff_t>( y ) * width;
+
             const int32_t startY = std::max( y - blurRadius, 0 );
             const int32_t rangeY = std::min( y + blurRadius + 1, height ) - startY;
             const uint8_t * imageInXStart = imageIn + static_cast<ptrdiff_t>( y ) * width;
@@ -527,7 +607,8 @@ namespace fheroes2
                 *imageOutX = GetColorId( static_cast<uint8_t>( redCoeff * sumRed / roiSize ), static_cast<uint8_t>( greenBlueCoeff * sumGreen / roiSize ),
                                          static_cast<uint8_t>( greenBlueCoeff * sumBlue / roiSize ) );
             }
-        }
+        } );
+
         return out;
     }
 
@@ -714,10 +795,22 @@ namespace fheroes2
     void PreRenderSystemInfo()
     {
         systemInfoRenderer.preRender();
+        performanceOverlayRenderer.preRender();
     }
 
     void PostRenderSystemInfo()
     {
+        performanceOverlayRenderer.postRender();
         systemInfoRenderer.postRender();
     }
+
+    void logMemoryUsage()
+    {
+        const size_t bytesInKb = 1024;
+
+        VERBOSE_LOG( "Memory usage: ICN sprites: " << AGG::getICNMemoryUsage() / bytesInKb << " KB, image buffer pool: "
+                                                   << getImageBufferPoolStatistics().cachedBytes / bytesInKb << " KB, sounds and music: "
+                                                   << AudioManager::getCacheMemoryUsage() / bytesInKb << " KB, world: " << world.getMemoryUsage() / bytesInKb
+                                                   << " KB, AI pathfinder: " << AI::Get().getPathfinderMemoryUsage() / bytesInKb << " KB" )
+    }
 }
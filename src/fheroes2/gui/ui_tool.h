@@ -146,9 +146,12 @@ namespace fheroes2
 
     void InvertedShadow( Image & image, const Rect & roi, const Rect & excludedRoi, const uint8_t paletteId, const int32_t paletteCount );
 
-    // Display pre-render function to show screen system info
+    // Display pre-render function to show screen system info and performance overlay
     void PreRenderSystemInfo();
 
-    // Display post-render function to hide screen system info
+    // Display post-render function to hide screen system info and performance overlay
     void PostRenderSystemInfo();
+
+    // Writes the memory occupied by the caches of every subsystem to the log
+    void logMemoryUsage();
 }
@@ -21,6 +21,8 @@
 #include "ui_window.h"
 
 #include <algorithm>
+#include <cassert>
+#include <vector>
 
 #include "agg_image.h"
 #include "gamedefs.h"
@@ -39,6 +41,110 @@ namespace
 
     // Offset from window edges to background copy area.
     const int32_t backgroundOffset{ 22 };
+
+    // Maximum number of window backgrounds kept in the cache.
+    const size_t maxCachedBackgroundCount{ 8 };
+
+    struct CachedBackground
+    {
+        int32_t width{ 0 };
+        int32_t height{ 0 };
+        bool isEvilInterface{ false };
+        uint32_t lastUseTime{ 0 };
+        fheroes2::Image image;
+    };
+
+    void renderBackground( fheroes2::Image & output, const bool isEvilInterface )
+    {
+        const fheroes2::Sprite & backgroundSprite = fheroes2::AGG::GetICN( ( isEvilInterface ? ICN::STONEBAK_EVIL : ICN::STONEBAK ), 0 );
+        const int32_t backgroundSpriteWidth{ backgroundSprite.width() };
+        const int32_t backgroundSpriteHeight{ backgroundSprite.height() };
+
+        const int32_t backgroundWidth = output.width();
+        const int32_t backgroundHeight = output.height();
+        const int32_t backgroundHorizontalCopies = ( backgroundWidth - 1 - transitionSize ) / ( backgroundSpriteWidth - transitionSize );
+        const int32_t backgroundVerticalCopies = ( backgroundHeight - 1 - transitionSize ) / ( backgroundSpriteHeight - transitionSize );
+
+        const int32_t backgroundCopyWidth = std::min( backgroundSpriteWidth, backgroundWidth );
+        const int32_t backgroundCopyHeight = std::min( backgroundSpriteHeight, backgroundHeight );
+
+        // We do a copy as the background image does not have transparent pixels.
+        fheroes2::Copy( backgroundSprite, 0, 0, output, 0, 0, backgroundCopyWidth, backgroundCopyHeight );
+
+        // If we need more copies to fill background horizontally we make a transition and copy existing image.
+        if ( backgroundHorizontalCopies > 0 ) {
+            int32_t toOffsetX = backgroundSpriteWidth;
+            fheroes2::CreateDitheringTransition( backgroundSprite, 0, 0, output, toOffsetX - transitionSize, 0, transitionSize, backgroundCopyHeight, true, false );
+
+            const int32_t stepX = backgroundSpriteWidth - transitionSize;
+            const int32_t fromOffsetX = transitionSize;
+
+            for ( int32_t i = 0; i < backgroundHorizontalCopies; ++i ) {
+                fheroes2::Copy( output, fromOffsetX, 0, output, toOffsetX, 0, std::min( backgroundSpriteWidth, backgroundWidth - toOffsetX ), backgroundCopyHeight );
+                toOffsetX += stepX;
+            }
+        }
+
+        // If we need more copies to fill background vertically we make a transition and copy existing image in full background width.
+        if ( backgroundVerticalCopies > 0 ) {
+            int32_t toOffsetY = backgroundSpriteHeight;
+            fheroes2::CreateDitheringTransition( output, 0, 0, output, 0, toOffsetY - transitionSize, backgroundWidth, transitionSize, false, false );
+
+            const int32_t stepY = backgroundSpriteHeight - transitionSize;
+            const int32_t fromOffsetY = transitionSize;
+
+            for ( int32_t i = 0; i < backgroundVerticalCopies; ++i ) {
+                fheroes2::Copy( output, 0, fromOffsetY, output, 0, toOffsetY, backgroundWidth, std::min( backgroundSpriteHeight, backgroundHeight - toOffsetY ) );
+                toOffsetY += stepY;
+            }
+        }
+    }
+
+    // Windows of the same kind usually have the same size, so the generated backgrounds of the recently opened windows are kept
+    // to be copied as a whole. The least recently used background is replaced when the cache is full.
+    const fheroes2::Image & getCachedBackground( const int32_t width, const int32_t height, const bool isEvilInterface, const bool isSingleLayer )
+    {
+        static std::vector<CachedBackground> cachedBackgrounds;
+        static uint32_t useTime{ 0 };
+
+        ++useTime;
+
+        CachedBackground * leastRecentlyUsed = nullptr;
+
+        for ( CachedBackground & background : cachedBackgrounds ) {
+            if ( background.width == width && background.height == height && background.isEvilInterface == isEvilInterface
+                 && background.image.singleLayer() == isSingleLayer ) {
+                background.lastUseTime = useTime;
+                return background.image;
+            }
+
+            if ( leastRecentlyUsed == nullptr || background.lastUseTime < leastRecentlyUsed->lastUseTime ) {
+                leastRecentlyUsed = &background;
+            }
+        }
+
+        if ( cachedBackgrounds.size() < maxCachedBackgroundCount ) {
+            leastRecentlyUsed = &cachedBackgrounds.emplace_back();
+        }
+
+        assert( leastRecentlyUsed != nullptr );
+
+        CachedBackground & background = *leastRecentlyUsed;
+        background.width = width;
+        background.height = height;
+        background.isEvilInterface = isEvilInterface;
+        background.lastUseTime = useTime;
+
+        background.image = {};
+        if ( isSingleLayer ) {
+            background.image._disableTransformLayer();
+        }
+        background.image.resize( width, height );
+
+        renderBackground( background.image, isEvilInterface );
+
+        return background.image;
+    }
 }
 
 namespace fheroes2
@@ -270,53 +376,14 @@ namespace fheroes2
 
     void StandardWindow::_renderBackground( const bool isEvilInterface )
     {
-        const Sprite & backgroundSprite = AGG::GetICN( ( isEvilInterface ? ICN::STONEBAK_EVIL : ICN::STONEBAK ), 0 );
-        const int32_t backgroundSpriteWidth{ backgroundSprite.width() };
-        const int32_t backgroundSpriteHeight{ backgroundSprite.height() };
-
         const int32_t backgroundWidth = _windowArea.width - backgroundOffset * 2;
         const int32_t backgroundHeight = _windowArea.height - backgroundOffset * 2;
-        const int32_t backgroundHorizontalCopies = ( backgroundWidth - 1 - transitionSize ) / ( backgroundSpriteWidth - transitionSize );
-        const int32_t backgroundVerticalCopies = ( backgroundHeight - 1 - transitionSize ) / ( backgroundSpriteHeight - transitionSize );
-
-        const int32_t backgroundCopyWidth = std::min( backgroundSpriteWidth, backgroundWidth );
-        const int32_t backgroundCopyHeight = std::min( backgroundSpriteHeight, backgroundHeight );
-        const int32_t backgroundOffsetX = _windowArea.x + backgroundOffset;
-        const int32_t backgroundOffsetY = _windowArea.y + backgroundOffset;
-
-        // We do a copy as the background image does not have transparent pixels.
-        Copy( backgroundSprite, 0, 0, _output, backgroundOffsetX, backgroundOffsetY, backgroundCopyWidth, backgroundCopyHeight );
-
-        // If we need more copies to fill background horizontally we make a transition and copy existing image.
-        if ( backgroundHorizontalCopies > 0 ) {
-            int32_t toOffsetX = backgroundOffset + backgroundSpriteWidth;
-            CreateDitheringTransition( backgroundSprite, 0, 0, _output, _windowArea.x + toOffsetX - transitionSize, backgroundOffsetY, transitionSize,
-                                       backgroundCopyHeight, true, false );
-
-            const int32_t stepX = backgroundSpriteWidth - transitionSize;
-            const int32_t fromOffsetX = backgroundOffset + transitionSize;
-
-            for ( int32_t i = 0; i < backgroundHorizontalCopies; ++i ) {
-                Copy( _output, _windowArea.x + fromOffsetX, backgroundOffsetY, _output, _windowArea.x + toOffsetX, backgroundOffsetY,
-                      std::min( backgroundSpriteWidth, _windowArea.width - backgroundOffset - toOffsetX ), backgroundCopyHeight );
-                toOffsetX += stepX;
-            }
+        if ( backgroundWidth <= 0 || backgroundHeight <= 0 ) {
+            return;
         }
 
-        // If we need more copies to fill background vertically we make a transition and copy existing image in full background width.
-        if ( backgroundVerticalCopies > 0 ) {
-            int32_t toOffsetY = backgroundOffset + backgroundSpriteHeight;
-            CreateDitheringTransition( _output, backgroundOffsetX, backgroundOffsetY, _output, backgroundOffsetX, _windowArea.y + toOffsetY - transitionSize,
-                                       backgroundWidth, transitionSize, false, false );
-
-            const int32_t stepY = backgroundSpriteHeight - transitionSize;
-            const int32_t fromOffsetY = backgroundOffset + transitionSize;
+        const Image & background = getCachedBackground( backgroundWidth, backgroundHeight, isEvilInterface, _output.singleLayer() );
 
-            for ( int32_t i = 0; i < backgroundVerticalCopies; ++i ) {
-                Copy( _output, backgroundOffsetX, _windowArea.y + fromOffsetY, _output, backgroundOffsetX, _windowArea.y + toOffsetY, backgroundWidth,
-                      std::min( backgroundSpriteHeight, _windowArea.height - backgroundOffset - toOffsetY ) );
-                toOffsetY += stepY;
-            }
-        }
+        Copy( background, 0, 0, _output, _windowArea.x + backgroundOffset, _windowArea.y + backgroundOffset, backgroundWidth, backgroundHeight );
     }
 }
@@ -67,6 +67,7 @@
 #include "settings.h"
 #include "speed.h"
 #include "spell_book.h"
+#include "thread.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_dialog.h"
@@ -1485,42 +1486,7 @@ int Heroes::getNumOfTravelDays( int32_t dstIdx ) const
 {
     assert( Maps::isValidAbsIndex( dstIdx ) );
 
-    const uint32_t maxMovePoints = GetMaxMovePoints();
-    const std::list<Route::Step> routePath = world.getPath( *this, dstIdx );
-
-    if ( routePath.empty() ) {
-        return 0;
-    }
-
-    uint32_t movePoints = GetMovePoints();
-    int days = 1;
-
-    for ( const Route::Step & step : routePath ) {
-        const uint32_t stepPenalty = step.GetPenalty();
-
-        if ( movePoints >= stepPenalty ) {
-            // This movement takes place on the same day
-            movePoints -= stepPenalty;
-        }
-        else {
-            // This movement takes place at the beginning of a new day: start with max
-            // movement points, don't carry leftovers from the previous day
-            assert( maxMovePoints >= stepPenalty );
-
-            movePoints = maxMovePoints - stepPenalty;
-            ++days;
-
-            // Stop at 8 days
-            if ( days >= 8 ) {
-                break;
-            }
-        }
-    }
-
-    // Return no more than 8 days
-    assert( days <= 8 );
-
-    return days;
+    return world.getNumOfTravelDays( *this, dstIdx );
 }
 
 void Heroes::LevelUp( bool skipsecondary, bool autoselect )
@@ -1971,6 +1937,11 @@ Heroes * VecHeroes::Get( const fheroes2::Point & center ) const
     return end() != it ? *it : nullptr;
 }
 
+void AllHeroes::NewDay()
+{
+    MultiThreading::getThreadPool().parallelFor( 0, size(), [this]( const size_t i ) { ( *this )[i]->ActionNewDay(); } );
+}
+
 Heroes * AllHeroes::GetHero( const Castle & castle ) const
 {
     const_iterator it = std::find_if( begin(), end(), [&castle]( const Heroes * hero ) { return castle.GetCenter() == hero->GetCenter(); } );
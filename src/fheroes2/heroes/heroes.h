@@ -44,6 +44,7 @@
 #include "route.h"
 #include "skill.h"
 #include "spell.h"
+#include "ui_object_rendering.h"
 #include "visit.h"
 
 class Castle;
@@ -63,7 +64,6 @@ namespace fheroes2
 {
     class Image;
     class Sprite;
-    struct ObjectRenderingInfo;
 }
 
 struct HeroSeedsForLevelUp
@@ -388,6 +388,7 @@ public:
     bool Recruit( const int col, const fheroes2::Point & pt );
     bool Recruit( const Castle & castle );
 
+    // Restores the movement and spell points. Only this hero is modified so heroes can be processed in parallel.
     void ActionNewDay();
     void ActionNewWeek();
     void ActionNewMonth();
@@ -407,8 +408,7 @@ public:
     }
 
     // Returns the number of travel days to the tile with the dstIdx index using the pathfinder from the World global
-    // object, or zero if the destination tile is unreachable. The number of days returned is limited, see the source
-    // of this method.
+    // object, or zero if the destination tile is unreachable. The number of days returned is limited to 8.
     int getNumOfTravelDays( int32_t dstIdx ) const;
 
     void ShowPath( const bool show )
@@ -468,8 +468,9 @@ public:
     bool MayCastAdventureSpells() const;
 
     // Since heroes sprite are much bigger than a tile we need to 'cut' the sprite and the shadow's sprite into pieces. Each piece is for a separate tile.
-    std::vector<fheroes2::ObjectRenderingInfo> getHeroSpritesPerTile() const;
-    std::vector<fheroes2::ObjectRenderingInfo> getHeroShadowSpritesPerTile() const;
+    // The result is cached and stays valid until the hero's sprite, direction, position within a tile or color changes.
+    const std::vector<fheroes2::ObjectRenderingInfo> & getHeroSpritesPerTile() const;
+    const std::vector<fheroes2::ObjectRenderingInfo> & getHeroShadowSpritesPerTile() const;
 
     void PortraitRedraw( const int32_t px, const int32_t py, const PortraitType type, fheroes2::Image & dstsf ) const override;
 
@@ -589,6 +590,36 @@ private:
 
     bool isInDeepOcean() const;
 
+    // All the hero's properties which affect the sprites returned by getHeroSpritesPerTile() and getHeroShadowSpritesPerTile().
+    struct SpriteRenderingKey
+    {
+        fheroes2::Point offset;
+        int direction{ Direction::UNKNOWN };
+        int spriteIndex{ 0 };
+        int flagFrameId{ 0 };
+        int color{ 0 };
+        int race{ 0 };
+        bool isShipMaster{ false };
+        bool isMoving{ false };
+        bool isInDeepOcean{ false };
+
+        bool operator==( const SpriteRenderingKey & other ) const
+        {
+            return offset == other.offset && direction == other.direction && spriteIndex == other.spriteIndex && flagFrameId == other.flagFrameId
+                   && color == other.color && race == other.race && isShipMaster == other.isShipMaster && isMoving == other.isMoving
+                   && isInDeepOcean == other.isInDeepOcean;
+        }
+    };
+
+    struct SpriteRenderingCache
+    {
+        std::vector<fheroes2::ObjectRenderingInfo> info;
+        SpriteRenderingKey key;
+        bool isValid{ false };
+    };
+
+    SpriteRenderingKey getSpriteRenderingKey() const;
+
     enum
     {
         SKILL_VALUE = 100
@@ -623,6 +654,10 @@ private:
 
     mutable int _alphaValue;
 
+    // The adventure map requests the hero sprites on every redraw while they change only when the hero moves or turns.
+    mutable SpriteRenderingCache _spritesCache;
+    mutable SpriteRenderingCache _shadowSpritesCache;
+
     int _attackedMonsterTileIndex; // used only when hero attacks a group of wandering monsters
 
     // This value should NOT be saved in save file as it's dynamically set during AI turn.
@@ -659,10 +694,7 @@ struct AllHeroes : public VecHeroes
         std::for_each( begin(), end(), [modes]( Heroes * hero ) { hero->ResetModes( modes ); } );
     }
 
-    void NewDay()
-    {
-        std::for_each( begin(), end(), []( Heroes * hero ) { hero->ActionNewDay(); } );
-    }
+    void NewDay();
 
     void NewWeek()
     {
@@ -2665,8 +2665,6 @@ namespace
                     hero.SetVisited( dst_index, Visit::GLOBAL );
                     hero.setVisitedForAllies( dst_index );
 
-                    // Fully update fog directions and redraw radar and game area.
-                    Interface::GameArea::updateMapFogDirections();
                     Interface::AdventureMap & I = Interface::AdventureMap::Get();
                     I.setRedraw( Interface::REDRAW_GAMEAREA | Interface::REDRAW_RADAR );
                 }
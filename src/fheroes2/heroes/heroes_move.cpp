@@ -502,7 +502,7 @@ bool Heroes::isInDeepOcean() const
     const bool isHeroMovedHalfOfCell = ( sprite_index < 45 && ( sprite_index % heroFrameCountPerTile ) > 4 );
     const int32_t tileIndex
         = ( isHeroMovedHalfOfCell && Maps::isValidDirection( GetIndex(), direction ) ) ? Maps::GetDirectionIndex( GetIndex(), direction ) : GetIndex();
-    for ( const int32_t nearbyIndex : Maps::getAroundIndexes( tileIndex ) ) {
+    for ( const int32_t nearbyIndex : Maps::getAdjacentIndexes( tileIndex ) ) {
         if ( !world.GetTiles( nearbyIndex ).isWater() ) {
             return false;
         }
@@ -511,19 +511,47 @@ bool Heroes::isInDeepOcean() const
     return true;
 }
 
-std::vector<fheroes2::ObjectRenderingInfo> Heroes::getHeroSpritesPerTile() const
+Heroes::SpriteRenderingKey Heroes::getSpriteRenderingKey() const
 {
-    // Reflected hero sprite should be shifted by 1 pixel to right.
-    const bool reflect = doesHeroImageNeedToBeReflected( direction );
+    SpriteRenderingKey key;
+
+    key.isShipMaster = isShipMaster();
+    key.isMoving = isMoveEnabled();
+    key.isInDeepOcean = key.isShipMaster && key.isMoving && isInDeepOcean();
+    key.direction = direction;
+    key.spriteIndex = sprite_index;
+    key.color = GetColor();
+    key.race = GetRace();
+
+    key.flagFrameId = sprite_index;
+    if ( !key.isMoving ) {
+        key.flagFrameId = key.isShipMaster ? 0 : static_cast<int>( Game::getAdventureMapAnimationIndex() );
+    }
+
+    key.offset = getCurrentPixelOffset();
 
-    int flagFrameID = sprite_index;
-    if ( !isMoveEnabled() ) {
-        flagFrameID = isShipMaster() ? 0 : static_cast<int>( Game::getAdventureMapAnimationIndex() );
+    return key;
+}
+
+const std::vector<fheroes2::ObjectRenderingInfo> & Heroes::getHeroSpritesPerTile() const
+{
+    const SpriteRenderingKey key = getSpriteRenderingKey();
+    if ( _spritesCache.isValid && _spritesCache.key == key ) {
+        return _spritesCache.info;
     }
 
+    _spritesCache.key = key;
+    _spritesCache.isValid = true;
+
+    std::vector<fheroes2::ObjectRenderingInfo> & objectInfo = _spritesCache.info;
+    objectInfo.clear();
+
+    // Reflected hero sprite should be shifted by 1 pixel to right.
+    const bool reflect = doesHeroImageNeedToBeReflected( direction );
+
     fheroes2::Point offset;
     // Boat sprite has to be shifted so it matches other boats.
-    if ( isShipMaster() ) {
+    if ( key.isShipMaster ) {
         offset.y -= 11;
     }
     else {
@@ -531,7 +559,7 @@ std::vector<fheroes2::ObjectRenderingInfo> Heroes::getHeroSpritesPerTile() const
     }
 
     // Apply hero offset when he moves from one tile to another.
-    offset += getCurrentPixelOffset();
+    offset += key.offset;
 
     int icnId{ 0 };
     uint32_t icnIndex{ 0 };
@@ -547,7 +575,6 @@ std::vector<fheroes2::ObjectRenderingInfo> Heroes::getHeroSpritesPerTile() const
 
     assert( outputSquareInfo.size() == outputImageInfo.size() );
 
-    std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
     for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
         objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, reflect, static_cast<uint8_t>( 255 ) );
     }
@@ -556,7 +583,7 @@ std::vector<fheroes2::ObjectRenderingInfo> Heroes::getHeroSpritesPerTile() const
     outputImageInfo.clear();
 
     fheroes2::Point flagOffset;
-    getFlagSpriteInfo( *this, flagFrameID, false, flagOffset, icnId, icnIndex );
+    getFlagSpriteInfo( *this, key.flagFrameId, false, flagOffset, icnId, icnIndex );
 
     const fheroes2::Sprite & spriteFlag = fheroes2::AGG::GetICN( icnId, icnIndex );
     const fheroes2::Point flagSpriteOffset( offset.x + ( reflect ? ( TILEWIDTH - spriteFlag.x() - flagOffset.x - spriteFlag.width() ) : spriteFlag.x() + flagOffset.x ),
@@ -573,7 +600,7 @@ std::vector<fheroes2::ObjectRenderingInfo> Heroes::getHeroSpritesPerTile() const
     outputSquareInfo.clear();
     outputImageInfo.clear();
 
-    if ( isShipMaster() && isMoveEnabled() && isInDeepOcean() ) {
+    if ( key.isInDeepOcean ) {
         // TODO: draw froth for all boats in deep water, not only for a moving boat.
         getFrothSpriteInfo( *this, sprite_index, icnId, icnIndex );
         const fheroes2::Sprite & spriteFroth = fheroes2::AGG::GetICN( icnId, icnIndex );
@@ -590,16 +617,27 @@ std::vector<fheroes2::ObjectRenderingInfo> Heroes::getHeroSpritesPerTile() const
     return objectInfo;
 }
 
-std::vector<fheroes2::ObjectRenderingInfo> Heroes::getHeroShadowSpritesPerTile() const
+const std::vector<fheroes2::ObjectRenderingInfo> & Heroes::getHeroShadowSpritesPerTile() const
 {
+    const SpriteRenderingKey key = getSpriteRenderingKey();
+    if ( _shadowSpritesCache.isValid && _shadowSpritesCache.key == key ) {
+        return _shadowSpritesCache.info;
+    }
+
+    _shadowSpritesCache.key = key;
+    _shadowSpritesCache.isValid = true;
+
+    std::vector<fheroes2::ObjectRenderingInfo> & objectInfo = _shadowSpritesCache.info;
+    objectInfo.clear();
+
     fheroes2::Point offset;
     // Boat sprite has to be shifted so it matches other boats.
-    if ( isShipMaster() ) {
+    if ( key.isShipMaster ) {
         offset.y -= 11;
     }
 
     // Apply hero offset when he moves from one tile to another.
-    offset += getCurrentPixelOffset();
+    offset += key.offset;
 
     int icnId{ 0 };
     uint32_t icnIndex{ 0 };
@@ -614,7 +652,6 @@ std::vector<fheroes2::ObjectRenderingInfo> Heroes::getHeroShadowSpritesPerTile()
 
     assert( outputSquareInfo.size() == outputImageInfo.size() );
 
-    std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
     for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
         objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, false, static_cast<uint8_t>( 255 ) );
     }
@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <memory>
+#include <utility>
 
 #include "heroes.h"
 #include "maps.h"
@@ -71,9 +72,9 @@ int32_t Route::Path::GetDestinationIndex( const bool returnLastStep /* = false *
     return dst;
 }
 
-void Route::Path::setPath( const std::list<Route::Step> & path, int32_t destIndex )
+void Route::Path::setPath( std::deque<Route::Step> && path, int32_t destIndex )
 {
-    assign( path.begin(), path.end() );
+    std::deque<Step>::operator=( std::move( path ) );
 
     dst = destIndex;
 }
@@ -423,7 +424,7 @@ StreamBase & Route::operator<<( StreamBase & msg, const Step & step )
 
 StreamBase & Route::operator<<( StreamBase & msg, const Path & path )
 {
-    return msg << path.dst << path.hide << static_cast<const std::list<Step> &>( path );
+    return msg << path.dst << path.hide << static_cast<const std::deque<Step> &>( path );
 }
 
 StreamBase & Route::operator>>( StreamBase & msg, Step & step )
@@ -435,6 +436,6 @@ StreamBase & Route::operator>>( StreamBase & msg, Step & step )
 
 StreamBase & Route::operator>>( StreamBase & msg, Path & path )
 {
-    std::list<Step> & base = path;
+    std::deque<Step> & base = path;
     return msg >> path.dst >> path.hide >> base;
 }
@@ -24,7 +24,7 @@
 #define H2HEROPATH_H
 
 #include <cstdint>
-#include <list>
+#include <deque>
 #include <string>
 
 #include "direction.h"
@@ -75,7 +75,7 @@ namespace Route
         uint32_t penalty = 0;
     };
 
-    class Path : public std::list<Step>
+    class Path : public std::deque<Step>
     {
     public:
         explicit Path( const Heroes & );
@@ -90,7 +90,7 @@ namespace Route
         int32_t GetDestinationIndex( const bool returnLastStep = false ) const;
         int GetFrontDirection() const;
         uint32_t GetFrontPenalty() const;
-        void setPath( const std::list<Step> & path, int32_t destIndex );
+        void setPath( std::deque<Step> && path, int32_t destIndex );
 
         void Show()
         {
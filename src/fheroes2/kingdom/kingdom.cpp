@@ -96,11 +96,6 @@ namespace
     }
 }
 
-bool HeroesStrongestArmy( const Heroes * h1, const Heroes * h2 )
-{
-    return h1 && h2 && h2->GetArmy().isStrongerThan( h1->GetArmy() );
-}
-
 Kingdom::Kingdom()
     : color( Color::NONE )
     , _lastBattleWinHeroID( 0 )
@@ -148,6 +143,7 @@ void Kingdom::clear()
     heroes.clear();
     castles.clear();
     visit_object.clear();
+    updateVisitedObjectIndex();
 
     recruits.Reset();
 
@@ -219,6 +215,7 @@ void Kingdom::ActionNewDay()
 {
     // Clear the visited objects with a lifetime of one day, even if this kingdom has already been vanquished
     visit_object.remove_if( Visit::isDayLife );
+    updateVisitedObjectIndex();
 
     if ( !isPlay() ) {
         return;
@@ -261,12 +258,13 @@ void Kingdom::ActionNewDayResourceUpdate( const std::function<void( const EventD
     }
 
     // Resources from events
-    const EventsDate events = world.GetEventsDate( GetColor() );
-    for ( const EventDate & event : events ) {
-        const Funds fundsUpdate = Resource::CalculateEventResourceUpdate( GetFunds(), event.resource );
+    for ( const EventDate * event : world.GetEventsDate( GetColor() ) ) {
+        assert( event != nullptr );
+
+        const Funds fundsUpdate = Resource::CalculateEventResourceUpdate( GetFunds(), event->resource );
         AddFundsResource( fundsUpdate );
         if ( displayEventDialog )
-            displayEventDialog( event, fundsUpdate );
+            displayEventDialog( *event, fundsUpdate );
     }
 }
 
@@ -274,6 +272,7 @@ void Kingdom::ActionNewWeek()
 {
     // Clear the visited objects with a lifetime of one week, even if this kingdom has already been vanquished
     visit_object.remove_if( Visit::isWeekLife );
+    updateVisitedObjectIndex();
 
     if ( !isPlay() ) {
         return;
@@ -297,6 +296,7 @@ void Kingdom::ActionNewMonth()
 {
     // Clear the visited objects with a lifetime of one month, even if this kingdom has already been vanquished
     visit_object.remove_if( Visit::isMonthLife );
+    updateVisitedObjectIndex();
 }
 
 void Kingdom::AddHeroes( Heroes * hero )
@@ -436,25 +436,41 @@ bool Kingdom::isVisited( const Maps::Tiles & tile ) const
 
 bool Kingdom::isVisited( int32_t index, const MP2::MapObjectType objectType ) const
 {
-    std::list<IndexObject>::const_iterator it = std::find_if( visit_object.begin(), visit_object.end(), [index]( const IndexObject & v ) { return v.isIndex( index ); } );
-    return visit_object.end() != it && ( *it ).isObject( objectType );
+    const auto iter = _visitedTileObjectTypes.find( index );
+    return iter != _visitedTileObjectTypes.end() && iter->second == objectType;
 }
 
 bool Kingdom::isVisited( const MP2::MapObjectType objectType ) const
 {
-    return std::any_of( visit_object.begin(), visit_object.end(), [objectType]( const IndexObject & v ) { return v.isObject( objectType ); } );
+    return CountVisitedObjects( objectType ) > 0;
 }
 
 uint32_t Kingdom::CountVisitedObjects( const MP2::MapObjectType objectType ) const
 {
-    // Safe to downcast as we don't deal with gigantic amount of data.
-    return static_cast<uint32_t>( std::count_if( visit_object.begin(), visit_object.end(), [objectType]( const IndexObject & v ) { return v.isObject( objectType ); } ) );
+    const auto iter = _visitedObjectTypeCounts.find( objectType );
+    return iter != _visitedObjectTypeCounts.end() ? iter->second : 0;
 }
 
 void Kingdom::SetVisited( int32_t index, const MP2::MapObjectType objectType )
 {
-    if ( !isVisited( index, objectType ) && objectType != MP2::OBJ_NONE )
+    if ( !isVisited( index, objectType ) && objectType != MP2::OBJ_NONE ) {
         visit_object.emplace_front( index, objectType );
+
+        _visitedTileObjectTypes[index] = objectType;
+        ++_visitedObjectTypeCounts[objectType];
+    }
+}
+
+void Kingdom::updateVisitedObjectIndex()
+{
+    _visitedTileObjectTypes.clear();
+    _visitedObjectTypeCounts.clear();
+
+    for ( const IndexObject & visit : visit_object ) {
+        // The most recent visits are at the beginning of the list so only the first visit of every tile is taken into account.
+        _visitedTileObjectTypes.emplace( visit.first, visit.second );
+        ++_visitedObjectTypeCounts[visit.second];
+    }
 }
 
 bool Kingdom::isValidKingdomObject( const Maps::Tiles & tile, const MP2::MapObjectType objectType ) const
@@ -655,12 +671,12 @@ Funds Kingdom::GetIncome( int type /* INCOME_ALL */ ) const
     Funds totalIncome;
 
     if ( INCOME_CAPTURED & type ) {
-        // captured object
-        const int resources[8]
-            = { Resource::WOOD, Resource::ORE, Resource::MERCURY, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD, Resource::UNKNOWN };
+        // captured object, all the mines are counted at once
+        const Funds mines = world.CountCapturedMines( GetColor() );
 
-        for ( uint32_t index = 0; resources[index] != Resource::UNKNOWN; ++index )
-            totalIncome += ProfitConditions::FromMine( resources[index] ) * world.CountCapturedMines( resources[index], GetColor() );
+        for ( const int resourceType : { Resource::WOOD, Resource::ORE, Resource::MERCURY, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD } ) {
+            totalIncome += ProfitConditions::FromMine( resourceType ) * static_cast<uint32_t>( mines.Get( resourceType ) );
+        }
     }
 
     if ( INCOME_CASTLES & type ) {
@@ -719,7 +735,25 @@ Funds Kingdom::GetIncome( int type /* INCOME_ALL */ ) const
 
 Heroes * Kingdom::GetBestHero() const
 {
-    return !heroes.empty() ? *std::max_element( heroes.begin(), heroes.end(), HeroesStrongestArmy ) : nullptr;
+    // The army strength of every hero is evaluated only once.
+    Heroes * bestHero = nullptr;
+    double bestStrength = 0;
+
+    for ( Heroes * hero : heroes ) {
+        if ( hero == nullptr ) {
+            continue;
+        }
+
+        const Army & army = hero->GetArmy();
+        const double strength = army.GetStrength();
+
+        if ( bestHero == nullptr || !bestHero->GetArmy().isValid() || strength > bestStrength ) {
+            bestHero = hero;
+            bestStrength = strength;
+        }
+    }
+
+    return bestHero;
 }
 
 Monster Kingdom::GetStrongestMonster() const
@@ -990,9 +1024,13 @@ StreamBase & operator<<( StreamBase & msg, const Kingdom & kingdom )
 
 StreamBase & operator>>( StreamBase & msg, Kingdom & kingdom )
 {
-    return msg >> kingdom.modes >> kingdom.color >> kingdom.resource >> kingdom.lost_town_days >> kingdom.castles >> kingdom.heroes >> kingdom.recruits
-           >> kingdom.visit_object >> kingdom.puzzle_maps >> kingdom.visited_tents_colors >> kingdom._lastBattleWinHeroID >> kingdom._topCastleInKingdomView
-           >> kingdom._topHeroInKingdomView;
+    msg >> kingdom.modes >> kingdom.color >> kingdom.resource >> kingdom.lost_town_days >> kingdom.castles >> kingdom.heroes >> kingdom.recruits
+        >> kingdom.visit_object >> kingdom.puzzle_maps >> kingdom.visited_tents_colors >> kingdom._lastBattleWinHeroID >> kingdom._topCastleInKingdomView
+        >> kingdom._topHeroInKingdomView;
+
+    kingdom.updateVisitedObjectIndex();
+
+    return msg;
 }
 
 StreamBase & operator<<( StreamBase & msg, const Kingdoms & obj )
@@ -27,7 +27,9 @@
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <map>
 #include <set>
+#include <unordered_map>
 
 #include "bitmodes.h"
 #include "castle.h"
@@ -210,6 +212,9 @@ public:
 private:
     cost_t _getKingdomStartingResources( const int difficulty ) const;
 
+    // Must be called after every change of visit_object other than SetVisited().
+    void updateVisitedObjectIndex();
+
     friend StreamBase & operator<<( StreamBase &, const Kingdom & );
     friend StreamBase & operator>>( StreamBase &, Kingdom & );
 
@@ -226,6 +231,11 @@ private:
 
     std::list<IndexObject> visit_object;
 
+    // Lookup tables for visit_object which are not saved: the object type of the most recent visit of every tile
+    // and the number of visits of every object type.
+    std::unordered_map<int32_t, int> _visitedTileObjectTypes;
+    std::map<int, uint32_t> _visitedObjectTypeCounts;
+
     Puzzle puzzle_maps;
     uint32_t visited_tents_colors;
 
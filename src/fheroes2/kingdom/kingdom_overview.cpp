@@ -22,6 +22,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -70,6 +71,8 @@ namespace
 
     bool needFadeIn{ false };
 
+    const std::array<int, 7> incomeResources{ Resource::WOOD, Resource::MERCURY, Resource::ORE, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD };
+
     std::string CapturedExtInfoString( int res, int color, const Funds & funds )
     {
         std::string output = std::to_string( world.CountCapturedMines( res, color ) );
@@ -87,6 +90,81 @@ namespace
 
         return output;
     }
+
+    bool isSameFunds( const Funds & first, const Funds & second )
+    {
+        return first.wood == second.wood && first.mercury == second.mercury && first.ore == second.ore && first.sulfur == second.sulfur
+               && first.crystal == second.crystal && first.gems == second.gems && first.gold == second.gold;
+    }
+
+    // The income and the numbers of captured objects are calculated by iterating over all the captured objects of the world, so they are
+    // not calculated again on every redraw of the dialog. They can only change after such actions as constructing a building or dismissing
+    // a hero, which change either the funds or the number of heroes and castles of the kingdom.
+    class KingdomStatistics
+    {
+    public:
+        explicit KingdomStatistics( const Kingdom & kingdom )
+            : _kingdom( kingdom )
+        {
+            // Do nothing.
+        }
+
+        void update()
+        {
+            const Funds & funds = _kingdom.GetFunds();
+            const size_t heroCount = _kingdom.GetHeroes().size();
+            const size_t castleCount = _kingdom.GetCastles().size();
+
+            if ( _isValid && isSameFunds( funds, _funds ) && heroCount == _heroCount && castleCount == _castleCount ) {
+                return;
+            }
+
+            _isValid = true;
+            _funds = funds;
+            _heroCount = heroCount;
+            _castleCount = castleCount;
+
+            const int color = _kingdom.GetColor();
+            const Funds income = _kingdom.GetIncome( Kingdom::INCOME_ARTIFACTS | Kingdom::INCOME_HERO_SKILLS | Kingdom::INCOME_CAMPAIGN_BONUS );
+
+            for ( size_t i = 0; i < incomeResources.size(); ++i ) {
+                _incomeInfo[i] = CapturedExtInfoString( incomeResources[i], color, income );
+            }
+
+            _goldPerDay = _kingdom.GetIncome().Get( Resource::GOLD );
+            _lighthouseCount = world.CountCapturedObject( MP2::OBJ_LIGHTHOUSE, color );
+        }
+
+        const std::string & getIncomeInfo( const size_t resourceId ) const
+        {
+            assert( _isValid && resourceId < _incomeInfo.size() );
+            return _incomeInfo[resourceId];
+        }
+
+        int32_t getGoldPerDay() const
+        {
+            assert( _isValid );
+            return _goldPerDay;
+        }
+
+        uint32_t getLighthouseCount() const
+        {
+            assert( _isValid );
+            return _lighthouseCount;
+        }
+
+    private:
+        const Kingdom & _kingdom;
+
+        Funds _funds;
+        size_t _heroCount{ 0 };
+        size_t _castleCount{ 0 };
+        bool _isValid{ false };
+
+        std::array<std::string, 7> _incomeInfo;
+        int32_t _goldPerDay{ 0 };
+        uint32_t _lighthouseCount{ 0 };
+    };
 }
 
 struct HeroRow
@@ -647,34 +725,20 @@ void StatsCastlesList::RedrawBackground( const fheroes2::Point & dst )
     fheroes2::Copy( overback, 29, 12, display, dst.x + 29, dst.y + 12, 1, 357 );
 }
 
-void RedrawIncomeInfo( const fheroes2::Point & pt, const Kingdom & myKingdom )
+void RedrawIncomeInfo( const fheroes2::Point & pt, const KingdomStatistics & statistics )
 {
-    const Funds income = myKingdom.GetIncome( Kingdom::INCOME_ARTIFACTS | Kingdom::INCOME_HERO_SKILLS | Kingdom::INCOME_CAMPAIGN_BONUS );
     Text text( "", Font::SMALL );
 
-    text.Set( CapturedExtInfoString( Resource::WOOD, myKingdom.GetColor(), income ) );
-    text.Blit( pt.x + 54 - text.w() / 2, pt.y + 408 );
-
-    text.Set( CapturedExtInfoString( Resource::MERCURY, myKingdom.GetColor(), income ) );
-    text.Blit( pt.x + 146 - text.w() / 2, pt.y + 408 );
+    // The centers of the texts in the same order as the resources in 'incomeResources'
+    const std::array<int32_t, 7> offsetsX{ 54, 146, 228, 294, 360, 428, 494 };
 
-    text.Set( CapturedExtInfoString( Resource::ORE, myKingdom.GetColor(), income ) );
-    text.Blit( pt.x + 228 - text.w() / 2, pt.y + 408 );
-
-    text.Set( CapturedExtInfoString( Resource::SULFUR, myKingdom.GetColor(), income ) );
-    text.Blit( pt.x + 294 - text.w() / 2, pt.y + 408 );
-
-    text.Set( CapturedExtInfoString( Resource::CRYSTAL, myKingdom.GetColor(), income ) );
-    text.Blit( pt.x + 360 - text.w() / 2, pt.y + 408 );
-
-    text.Set( CapturedExtInfoString( Resource::GEMS, myKingdom.GetColor(), income ) );
-    text.Blit( pt.x + 428 - text.w() / 2, pt.y + 408 );
-
-    text.Set( CapturedExtInfoString( Resource::GOLD, myKingdom.GetColor(), income ) );
-    text.Blit( pt.x + 494 - text.w() / 2, pt.y + 408 );
+    for ( size_t i = 0; i < offsetsX.size(); ++i ) {
+        text.Set( statistics.getIncomeInfo( i ) );
+        text.Blit( pt.x + offsetsX[i] - text.w() / 2, pt.y + 408 );
+    }
 }
 
-void RedrawFundsInfo( const fheroes2::Point & pt, const Kingdom & myKingdom )
+void RedrawFundsInfo( const fheroes2::Point & pt, const Kingdom & myKingdom, const KingdomStatistics & statistics )
 {
     const Funds & funds = myKingdom.GetFunds();
     Text text( "", Font::SMALL );
@@ -703,7 +767,7 @@ void RedrawFundsInfo( const fheroes2::Point & pt, const Kingdom & myKingdom )
     text.Set( std::to_string( funds.gold ) );
     text.Blit( pt.x + 496 - text.w() / 2, pt.y + 448 );
 
-    text.Set( _( "Gold Per Day:" ) + std::string( " " ) + std::to_string( myKingdom.GetIncome().Get( Resource::GOLD ) ) );
+    text.Set( _( "Gold Per Day:" ) + std::string( " " ) + std::to_string( statistics.getGoldPerDay() ) );
     text.Blit( pt.x + 180, pt.y + 462 );
 
     std::string msg = _( "Day: %{day}" );
@@ -712,8 +776,7 @@ void RedrawFundsInfo( const fheroes2::Point & pt, const Kingdom & myKingdom )
     text.Blit( pt.x + 360, pt.y + 462 );
 
     // Show Lighthouse count
-    const uint32_t lighthouseCount = world.CountCapturedObject( MP2::OBJ_LIGHTHOUSE, myKingdom.GetColor() );
-    text.Set( std::to_string( lighthouseCount ) );
+    text.Set( std::to_string( statistics.getLighthouseCount() ) );
     text.Blit( pt.x + 105, pt.y + 462 );
 
     const fheroes2::Sprite & lighthouse = fheroes2::AGG::GetICN( ICN::OVERVIEW, 14 );
@@ -740,8 +803,11 @@ void Kingdom::openOverviewDialog()
 
     fheroes2::Blit( fheroes2::AGG::GetICN( ICN::OVERBACK, 0 ), display, dst_pt.x, dst_pt.y );
 
-    RedrawIncomeInfo( cur_pt, *this );
-    RedrawFundsInfo( cur_pt, *this );
+    KingdomStatistics statistics( *this );
+    statistics.update();
+
+    RedrawIncomeInfo( cur_pt, statistics );
+    RedrawFundsInfo( cur_pt, *this, statistics );
 
     StatsHeroesList listHeroes( background.windowArea(), dst_pt, heroes );
     StatsCastlesList listCastles( background.windowArea(), dst_pt, castles );
@@ -883,8 +949,11 @@ void Kingdom::openOverviewDialog()
         }
 
         listStats->Redraw();
-        RedrawIncomeInfo( cur_pt, *this );
-        RedrawFundsInfo( cur_pt, *this );
+
+        statistics.update();
+
+        RedrawIncomeInfo( cur_pt, statistics );
+        RedrawFundsInfo( cur_pt, *this, statistics );
 
         if ( needFadeIn ) {
             needFadeIn = false;
@@ -25,6 +25,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <utility>
 
 #include "agg_image.h"
@@ -49,6 +50,7 @@
 #include "resource.h"
 #include "screen.h"
 #include "settings.h"
+#include "thread.h"
 #include "ui_button.h"
 #include "ui_tool.h"
 #include "world.h"
@@ -212,9 +214,16 @@ namespace
             const int32_t redrawAreaCenterX = blockSizeX * TILEWIDTH / 2;
             const int32_t redrawAreaCenterY = blockSizeY * TILEWIDTH / 2;
 
-            // Create temporary image where we will draw blocks of the main map on
-            fheroes2::Image temporaryImg( redrawAreaWidth, redrawAreaHeight );
-            temporaryImg._disableTransformLayer();
+            // Create temporary images where we will draw blocks of the main map on. Blocks are drawn one by one, but the scaling of an already
+            // drawn block into the cached images is done by a worker thread while the next block is drawn on the other image.
+            std::array<fheroes2::Image, 2> temporaryImages;
+            for ( fheroes2::Image & temporaryImg : temporaryImages ) {
+                temporaryImg.resize( redrawAreaWidth, redrawAreaHeight );
+                temporaryImg._disableTransformLayer();
+            }
+
+            size_t temporaryImageId = 0;
+            std::future<void> blockScaling;
 
             Interface::GameArea gamearea = Interface::AdventureMap::Get().getGameArea();
             gamearea.SetAreaPosition( 0, 0, redrawAreaWidth, redrawAreaHeight );
@@ -234,16 +243,31 @@ namespace
             // Draw sub-blocks of the main map, and resize them to draw them on lower-res cached versions:
             for ( int32_t x = 0; x < worldWidth; x += blockSizeX ) {
                 for ( int32_t y = 0; y < worldHeight; y += blockSizeY ) {
+                    const fheroes2::Image & temporaryImg = temporaryImages[temporaryImageId];
+
                     gamearea.SetCenterInPixels( { x * TILEWIDTH + redrawAreaCenterX, y * TILEWIDTH + redrawAreaCenterY } );
-                    gamearea.Redraw( temporaryImg, drawingFlags );
+                    gamearea.Redraw( temporaryImages[temporaryImageId], drawingFlags );
 
-                    for ( int32_t i = 0; i < zoomLevels; ++i ) {
-                        fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), cachedImages[i], x * tileSizePerZoomLevel[i],
-                                          y * tileSizePerZoomLevel[i], blockSizeX * tileSizePerZoomLevel[i], blockSizeY * tileSizePerZoomLevel[i] );
+                    // The previous block must be scaled before its image is used for drawing again.
+                    if ( blockScaling.valid() ) {
+                        blockScaling.get();
                     }
+
+                    blockScaling = MultiThreading::getThreadPool().submit( [this, &temporaryImg, x, y]() {
+                        for ( int32_t i = 0; i < zoomLevels; ++i ) {
+                            fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), cachedImages[i], x * tileSizePerZoomLevel[i],
+                                              y * tileSizePerZoomLevel[i], blockSizeX * tileSizePerZoomLevel[i], blockSizeY * tileSizePerZoomLevel[i] );
+                        }
+                    } );
+
+                    temporaryImageId ^= 1;
                 }
             }
 
+            if ( blockScaling.valid() ) {
+                blockScaling.get();
+            }
+
 #if defined( SAVE_WORLD_MAP )
             fheroes2::Save( cachedImages[3], Settings::Get().MapsName() + saveFilePrefix + ".bmp" );
 #endif
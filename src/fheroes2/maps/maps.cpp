@@ -45,12 +45,13 @@
 
 namespace
 {
-    Maps::Indexes MapsIndexesFilteredObject( const Maps::Indexes & indexes, const MP2::MapObjectType objectType, const bool ignoreHeroes = true )
+    template <typename T>
+    Maps::Indexes MapsIndexesFilteredObject( const T & indexes, const MP2::MapObjectType objectType, const bool ignoreHeroes = true )
     {
         Maps::Indexes result;
-        for ( size_t idx = 0; idx < indexes.size(); ++idx ) {
-            if ( world.GetTiles( indexes[idx] ).GetObject( !ignoreHeroes ) == objectType ) {
-                result.push_back( indexes[idx] );
+        for ( const int32_t index : indexes ) {
+            if ( world.GetTiles( index ).GetObject( !ignoreHeroes ) == objectType ) {
+                result.push_back( index );
             }
         }
         return result;
@@ -58,15 +59,50 @@ namespace
 
     Maps::Indexes MapsIndexesObject( const MP2::MapObjectType objectType, const bool ignoreHeroes = true )
     {
-        Maps::Indexes result;
-        const int32_t size = static_cast<int32_t>( world.getSize() );
-        for ( int32_t idx = 0; idx < size; ++idx ) {
-            if ( world.GetTiles( idx ).GetObject( !ignoreHeroes ) == objectType ) {
-                result.push_back( idx );
+        Maps::Indexes result = world.getObjectTileIndexes( objectType );
+
+        if ( !ignoreHeroes ) {
+            // Heroes standing on objects of the requested type hide them on their tiles.
+            if ( objectType == MP2::OBJ_HEROES ) {
+                result.clear();
+            }
+
+            bool isAdded = false;
+            for ( const int32_t idx : world.getObjectTileIndexes( MP2::OBJ_HEROES ) ) {
+                if ( world.GetTiles( idx ).GetObject( false ) == objectType ) {
+                    result.push_back( idx );
+                    isAdded = true;
+                }
+            }
+
+            if ( isAdded ) {
+                std::sort( result.begin(), result.end() );
             }
         }
+
         return result;
     }
+
+    // Returns the largest horizontal distance from the center of the scouting area to its tiles in the row located at the given vertical distance
+    // from the center, so the rows of the area can be traversed without checking the distance to each tile.
+    int32_t getScoutingAreaHalfWidth( const int32_t scoutingDistance, const int32_t dy )
+    {
+        // constant factor for "backwards compatibility"
+        const int32_t distanceSquaredLeft = scoutingDistance * scoutingDistance + 4 - dy * dy;
+        assert( distanceSquaredLeft >= 0 );
+
+        int32_t halfWidth = static_cast<int32_t>( std::sqrt( static_cast<double>( distanceSquaredLeft ) ) );
+
+        // Fix possible rounding errors of the floating point calculation
+        while ( halfWidth * halfWidth > distanceSquaredLeft ) {
+            --halfWidth;
+        }
+        while ( ( halfWidth + 1 ) * ( halfWidth + 1 ) <= distanceSquaredLeft ) {
+            ++halfWidth;
+        }
+
+        return std::min( halfWidth, scoutingDistance );
+    }
 }
 
 struct ComparisonDistance
@@ -294,6 +330,55 @@ Maps::Indexes Maps::getAroundIndexes( const int32_t tileIndex, const int32_t max
     return results;
 }
 
+Maps::AdjacentIndexes Maps::getAdjacentIndexes( const int32_t tileIndex )
+{
+    AdjacentIndexes results;
+
+    if ( !isValidAbsIndex( tileIndex ) ) {
+        return results;
+    }
+
+    const int32_t width = world.w();
+    const int32_t height = world.h();
+
+    assert( width > 0 );
+
+    const int32_t centerX = tileIndex % width;
+    const int32_t centerY = tileIndex / width;
+
+    // Most tiles are not on the edge of the map so all their neighbours are valid
+    if ( centerX > 0 && centerX < width - 1 && centerY > 0 && centerY < height - 1 ) {
+        results.push_back( tileIndex - width - 1 );
+        results.push_back( tileIndex - width );
+        results.push_back( tileIndex - width + 1 );
+        results.push_back( tileIndex - 1 );
+        results.push_back( tileIndex + 1 );
+        results.push_back( tileIndex + width - 1 );
+        results.push_back( tileIndex + width );
+        results.push_back( tileIndex + width + 1 );
+
+        return results;
+    }
+
+    for ( int32_t y = -1; y <= 1; ++y ) {
+        for ( int32_t x = -1; x <= 1; ++x ) {
+            // the central tile is not included
+            if ( x == 0 && y == 0 ) {
+                continue;
+            }
+
+            const int32_t tileX = centerX + x;
+            const int32_t tileY = centerY + y;
+
+            if ( isValidAbsPoint( tileX, tileY ) ) {
+                results.push_back( tileY * width + tileX );
+            }
+        }
+    }
+
+    return results;
+}
+
 MapsIndexes Maps::getVisibleMonstersAroundHero( const Heroes & hero )
 {
     const uint32_t dist = hero.GetVisionsDistance();
@@ -324,8 +409,6 @@ void Maps::ClearFog( const int32_t tileIndex, int scoutingDistance, const int pl
     const int alliedColors = Players::GetPlayerFriends( playerColor );
     const bool isHumanOrHumanFriend = !isAIPlayer || Players::isFriends( playerColor, Players::HumanColors() );
 
-    const int revealRadiusSquared = scoutingDistance * scoutingDistance + 4; // constant factor for "backwards compatibility"
-
     const int32_t minY = std::max( center.y - scoutingDistance, 0 );
     const int32_t maxY = std::min( center.y + scoutingDistance, world.h() - 1 );
     assert( minY < maxY );
@@ -338,27 +421,25 @@ void Maps::ClearFog( const int32_t tileIndex, int scoutingDistance, const int pl
     fheroes2::Point fogRevealMaxPos( 0, 0 );
 
     for ( int32_t y = minY; y <= maxY; ++y ) {
-        const int32_t dy = y - center.y;
-
-        for ( int32_t x = minX; x <= maxX; ++x ) {
-            const int32_t dx = x - center.x;
-            if ( revealRadiusSquared >= dx * dx + dy * dy ) {
-                Maps::Tiles & tile = world.GetTiles( x, y );
-                if ( isAIPlayer && tile.isFog( playerColor ) ) {
-                    AI::Get().revealFog( tile, kingdom );
-                }
+        const int32_t halfWidth = getScoutingAreaHalfWidth( scoutingDistance, y - center.y );
+        const int32_t rowMaxX = std::min( center.x + halfWidth, maxX );
+
+        for ( int32_t x = std::max( center.x - halfWidth, minX ); x <= rowMaxX; ++x ) {
+            Maps::Tiles & tile = world.GetTiles( x, y );
+            if ( isAIPlayer && tile.isFog( playerColor ) ) {
+                AI::Get().revealFog( tile, kingdom );
+            }
 
-                if ( tile.isFog( alliedColors ) ) {
-                    // Clear fog only if it is not already cleared.
-                    tile.ClearFog( alliedColors );
-
-                    if ( isHumanOrHumanFriend ) {
-                        // Update fog reveal area points only for human player and his allies.
-                        fogRevealMinPos.x = std::min( fogRevealMinPos.x, x );
-                        fogRevealMinPos.y = std::min( fogRevealMinPos.y, y );
-                        fogRevealMaxPos.x = std::max( fogRevealMaxPos.x, x );
-                        fogRevealMaxPos.y = std::max( fogRevealMaxPos.y, y );
-                    }
+            if ( tile.isFog( alliedColors ) ) {
+                // Clear fog only if it is not already cleared.
+                tile.ClearFog( alliedColors );
+
+                if ( isHumanOrHumanFriend ) {
+                    // Update fog reveal area points only for human player and his allies.
+                    fogRevealMinPos.x = std::min( fogRevealMinPos.x, x );
+                    fogRevealMinPos.y = std::min( fogRevealMinPos.y, y );
+                    fogRevealMaxPos.x = std::max( fogRevealMaxPos.x, x );
+                    fogRevealMaxPos.y = std::max( fogRevealMaxPos.y, y );
                 }
             }
         }
@@ -387,8 +468,6 @@ int32_t Maps::getFogTileCountToBeRevealed( const int32_t tileIndex, int scouting
         scoutingDistance += Difficulty::GetScoutingBonus( Game::getDifficulty() );
     }
 
-    const int revealRadiusSquared = scoutingDistance * scoutingDistance + 4; // constant factor for "backwards compatibility"
-
     const int32_t minY = std::max( center.y - scoutingDistance, 0 );
     const int32_t maxY = std::min( center.y + scoutingDistance, world.h() - 1 );
     assert( minY < maxY );
@@ -400,17 +479,9 @@ int32_t Maps::getFogTileCountToBeRevealed( const int32_t tileIndex, int scouting
     int32_t tileCount = 0;
 
     for ( int32_t y = minY; y <= maxY; ++y ) {
-        const int32_t dy = y - center.y;
-
-        for ( int32_t x = minX; x <= maxX; ++x ) {
-            const int32_t dx = x - center.x;
-            if ( revealRadiusSquared >= dx * dx + dy * dy ) {
-                const Maps::Tiles & tile = world.GetTiles( x, y );
-                if ( tile.isFog( playerColor ) ) {
-                    ++tileCount;
-                }
-            }
-        }
+        const int32_t halfWidth = getScoutingAreaHalfWidth( scoutingDistance, y - center.y );
+
+        tileCount += world.getFogTileCountInRow( y, std::max( center.x - halfWidth, minX ), std::min( center.x + halfWidth, maxX ), playerColor );
     }
 
     return tileCount;
@@ -418,14 +489,17 @@ int32_t Maps::getFogTileCountToBeRevealed( const int32_t tileIndex, int scouting
 
 Maps::Indexes Maps::ScanAroundObject( const int32_t center, const MP2::MapObjectType objectType, const bool ignoreHeroes )
 {
-    Indexes results = getAroundIndexes( center );
-    return MapsIndexesFilteredObject( results, objectType, ignoreHeroes );
+    return MapsIndexesFilteredObject( getAdjacentIndexes( center ), objectType, ignoreHeroes );
 }
 
 Maps::Indexes Maps::GetFreeIndexesAroundTile( const int32_t center )
 {
-    Indexes results = getAroundIndexes( center );
-    results.erase( std::remove_if( results.begin(), results.end(), []( const int32_t tile ) { return !world.GetTiles( tile ).isClearGround(); } ), results.end() );
+    Indexes results;
+    for ( const int32_t tile : getAdjacentIndexes( center ) ) {
+        if ( world.GetTiles( tile ).isClearGround() ) {
+            results.push_back( tile );
+        }
+    }
     return results;
 }
 
@@ -437,8 +511,7 @@ bool Maps::isValidForDimensionDoor( int32_t targetIndex, bool isWater )
 
 Maps::Indexes Maps::ScanAroundObject( const int32_t center, const MP2::MapObjectType objectType )
 {
-    Indexes results = getAroundIndexes( center );
-    return MapsIndexesFilteredObject( results, objectType );
+    return MapsIndexesFilteredObject( getAdjacentIndexes( center ), objectType );
 }
 
 Maps::Indexes Maps::ScanAroundObjectWithDistance( const int32_t center, const uint32_t dist, const MP2::MapObjectType objectType )
@@ -462,7 +535,7 @@ Maps::Indexes Maps::GetObjectPositions( int32_t center, const MP2::MapObjectType
 
 bool Maps::isTileUnderProtection( const int32_t tileIndex )
 {
-    return world.GetTiles( tileIndex ).GetObject() == MP2::OBJ_MONSTER ? true : !getMonstersProtectingTile( tileIndex ).empty();
+    return world.GetTiles( tileIndex ).GetObject() == MP2::OBJ_MONSTER ? true : world.getMonsterProtectionMask( tileIndex ) != 0;
 }
 
 Maps::Indexes Maps::getMonstersProtectingTile( const int32_t tileIndex, const bool checkObjectOnTile /* = true */ )
@@ -471,26 +544,38 @@ Maps::Indexes Maps::getMonstersProtectingTile( const int32_t tileIndex, const bo
         return {};
     }
 
+    const uint16_t protectionMask = checkObjectOnTile ? world.getMonsterProtectionMask( tileIndex ) : calculateMonsterProtectionMask( tileIndex, false );
+    if ( protectionMask == 0 ) {
+        return {};
+    }
+
     Indexes result;
+    result.reserve( 9 );
+
+    const int32_t width = world.w();
+
+    for ( int32_t position = 0; position < 9; ++position ) {
+        if ( protectionMask & ( 1 << position ) ) {
+            result.push_back( tileIndex + ( position / 3 - 1 ) * width + ( position % 3 - 1 ) );
+        }
+    }
 
+    return result;
+}
+
+uint16_t Maps::calculateMonsterProtectionMask( const int32_t tileIndex, const bool checkObjectOnTile )
+{
     const Maps::Tiles & tile = world.GetTiles( tileIndex );
 
+    // The bit of the tile itself in the 3x3 block around it
+    const uint16_t centerBit = 1 << 4;
+
     // If a tile contains an object that you can interact with without visiting this tile, then this interaction doesn't trigger a monster attack...
     if ( checkObjectOnTile && MP2::isNeedStayFront( tile.GetObject() ) ) {
         // ... unless the tile itself contains a monster
-        if ( tile.GetObject() == MP2::OBJ_MONSTER ) {
-            result.push_back( tileIndex );
-        }
-
-        return result;
+        return tile.GetObject() == MP2::OBJ_MONSTER ? centerBit : 0;
     }
 
-    result.reserve( 9 );
-
-    const int width = world.w();
-    const int x = tileIndex % width;
-    const int y = tileIndex / width;
-
     auto isProtectedBy = [tileIndex, &tile]( const int32_t monsterTileIndex ) {
         const Maps::Tiles & monsterTile = world.GetTiles( monsterTileIndex );
 
@@ -524,49 +609,35 @@ Maps::Indexes Maps::getMonstersProtectingTile( const int32_t tileIndex, const bo
         return false;
     };
 
-    auto validateAndAdd = [&result, &isProtectedBy]( const int monsterTileIndex ) {
-        if ( isProtectedBy( monsterTileIndex ) ) {
-            result.push_back( monsterTileIndex );
-        }
-    };
+    const int32_t width = world.w();
+    const int32_t height = world.h();
+    const int32_t x = tileIndex % width;
+    const int32_t y = tileIndex / width;
 
-    if ( y > 0 ) {
-        if ( x > 0 ) {
-            validateAndAdd( tileIndex - width - 1 );
-        }
+    uint16_t protectionMask = 0;
 
-        validateAndAdd( tileIndex - width );
+    for ( int32_t position = 0; position < 9; ++position ) {
+        const int32_t offsetX = position % 3 - 1;
+        const int32_t offsetY = position / 3 - 1;
 
-        if ( x < width - 1 ) {
-            validateAndAdd( tileIndex - width + 1 );
+        if ( x + offsetX < 0 || x + offsetX >= width || y + offsetY < 0 || y + offsetY >= height ) {
+            continue;
         }
-    }
 
-    if ( x > 0 ) {
-        validateAndAdd( tileIndex - 1 );
-    }
-
-    if ( tile.GetObject() == MP2::OBJ_MONSTER ) {
-        result.push_back( tileIndex );
-    }
-
-    if ( x < width - 1 ) {
-        validateAndAdd( tileIndex + 1 );
-    }
+        if ( position == 4 ) {
+            if ( tile.GetObject() == MP2::OBJ_MONSTER ) {
+                protectionMask |= centerBit;
+            }
 
-    if ( y < world.h() - 1 ) {
-        if ( x > 0 ) {
-            validateAndAdd( tileIndex + width - 1 );
+            continue;
         }
 
-        validateAndAdd( tileIndex + width );
-
-        if ( x < width - 1 ) {
-            validateAndAdd( tileIndex + width + 1 );
+        if ( isProtectedBy( tileIndex + offsetY * width + offsetX ) ) {
+            protectionMask |= ( 1 << position );
         }
     }
 
-    return result;
+    return protectionMask;
 }
 
 uint32_t Maps::GetApproximateDistance( const int32_t pos1, const int32_t pos2 )
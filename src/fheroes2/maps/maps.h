@@ -24,6 +24,9 @@
 #define H2MAPS_H
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -67,6 +70,46 @@ namespace Maps
 
     Indexes getAroundIndexes( const int32_t tileIndex, const int32_t maxDistanceFromTile = 1 );
 
+    // Fixed-capacity list of indexes of tiles adjacent to a tile, it is used instead of Indexes to avoid memory allocations.
+    class AdjacentIndexes
+    {
+    public:
+        const int32_t * begin() const
+        {
+            return _indexes.data();
+        }
+
+        const int32_t * end() const
+        {
+            return _indexes.data() + _size;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        void push_back( const int32_t index )
+        {
+            assert( _size < _indexes.size() );
+
+            _indexes[_size] = index;
+            ++_size;
+        }
+
+    private:
+        std::array<int32_t, 8> _indexes{};
+        size_t _size{ 0 };
+    };
+
+    // Returns the same indexes as getAroundIndexes( tileIndex, 1 ) in the same order but without allocating memory.
+    AdjacentIndexes getAdjacentIndexes( const int32_t tileIndex );
+
     MapsIndexes getVisibleMonstersAroundHero( const Heroes & hero );
 
     Indexes ScanAroundObject( const int32_t center, const MP2::MapObjectType objectType );
@@ -81,6 +124,9 @@ namespace Maps
     // is set to true, then an additional check is performed to see if it is possible to interact with an object on this
     // tile without triggering a monster attack.
     Indexes getMonstersProtectingTile( const int32_t tileIndex, const bool checkObjectOnTile = true );
+    // Returns a mask of the tiles in the 3x3 block around the specified tile (bit 'dy * 3 + dx' for the offsets 'dx - 1' and 'dy - 1') with monsters
+    // guarding this tile. Use World::getMonsterProtectionMask() to get the cached value for the 'checkObjectOnTile' parameter set to true.
+    uint16_t calculateMonsterProtectionMask( const int32_t tileIndex, const bool checkObjectOnTile );
 
     Indexes GetObjectPositions( const MP2::MapObjectType objectType, bool ignoreHeroes );
     Indexes GetObjectPositions( int32_t center, const MP2::MapObjectType objectType, bool ignoreHeroes );
@@ -33,6 +33,7 @@
 #include <list>
 #include <locale>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <type_traits>
 #include <utility>
@@ -43,7 +44,6 @@
 #include "game_io.h"
 #include "game_over.h"
 #include "logging.h"
-#include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "mp2.h"
 #include "mp2_helper.h"
@@ -52,6 +52,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "tools.h"
 
 namespace
@@ -59,6 +60,92 @@ namespace
     const size_t mapNameLength = 16;
     const size_t mapDescriptionLength = 200;
 
+    // Increase this version every time the format of the map info cache file changes
+    const uint16_t mapInfoCacheFormatVersion = 1;
+
+    // Information about a map file, which is stored in the map info cache file to avoid parsing of unchanged map files.
+    struct MapInfoCacheEntry
+    {
+        uint64_t fileSize{ 0 };
+        int64_t modificationTime{ 0 };
+
+        // False if the map file is not a valid map file
+        bool isValid{ false };
+
+        Maps::FileInfo info;
+    };
+
+    std::string getMapInfoCacheFilePath()
+    {
+        return System::concatPath( System::GetDataDirectory( "fheroes2" ), "maps.cache" );
+    }
+
+    std::map<std::string, MapInfoCacheEntry> loadMapInfoCache()
+    {
+        StreamFile fs;
+        fs.setbigendian( true );
+
+        if ( !fs.open( getMapInfoCacheFilePath(), "rb" ) ) {
+            return {};
+        }
+
+        uint16_t cacheFormatVersion = 0;
+        uint16_t saveFileFormatVersion = 0;
+        uint32_t entryCount = 0;
+
+        fs >> cacheFormatVersion >> saveFileFormatVersion >> entryCount;
+
+        // Map info is serialized the same way as in save files, so the cache becomes outdated along with the save file format
+        if ( fs.fail() || cacheFormatVersion != mapInfoCacheFormatVersion || saveFileFormatVersion != CURRENT_FORMAT_VERSION ) {
+            return {};
+        }
+
+        // Map info deserialization depends on the version of the currently loaded save file
+        const uint16_t currentSaveFileVersion = Game::GetVersionOfCurrentSaveFile();
+        Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+        std::map<std::string, MapInfoCacheEntry> cache;
+
+        for ( uint32_t i = 0; i < entryCount && !fs.fail(); ++i ) {
+            std::string mapFile;
+            MapInfoCacheEntry entry;
+            int64_t fileSize = 0;
+
+            fs >> mapFile >> fileSize >> entry.modificationTime >> entry.isValid >> entry.info;
+
+            // Only the basename of the map file is serialized
+            entry.fileSize = static_cast<uint64_t>( fileSize );
+            entry.info.file = mapFile;
+
+            cache.emplace( std::move( mapFile ), std::move( entry ) );
+        }
+
+        Game::SetVersionOfCurrentSaveFile( currentSaveFileVersion );
+
+        if ( fs.fail() ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Map info cache file is corrupted" )
+            return {};
+        }
+
+        return cache;
+    }
+
+    void saveMapInfoCache( const std::map<std::string, MapInfoCacheEntry> & cache )
+    {
+        StreamFile fs;
+        fs.setbigendian( true );
+
+        if ( !fs.open( getMapInfoCacheFilePath(), "wb" ) ) {
+            return;
+        }
+
+        fs << mapInfoCacheFormatVersion << static_cast<uint16_t>( CURRENT_FORMAT_VERSION ) << static_cast<uint32_t>( cache.size() );
+
+        for ( const auto & [mapFile, entry] : cache ) {
+            fs << mapFile << static_cast<int64_t>( entry.fileSize ) << entry.modificationTime << entry.isValid << entry.info;
+        }
+    }
+
     template <typename CharType>
     bool CaseInsensitiveCompare( const std::basic_string<CharType> & lhs, const std::basic_string<CharType> & rhs )
     {
@@ -331,10 +418,12 @@ bool Maps::FileInfo::ReadMP2( const std::string & filePath )
         MP2::mp2tile_t mp2tile;
         MP2::loadTile( fs, mp2tile );
 
-        Maps::Tiles tile;
-        tile.Init( 0, mp2tile );
+        // Maps::Tiles::Init() is not used here because it changes the state of the world while map files can be read in parallel.
+        // An object marked as a shadow or ground is stored as an addon, so it is not the main object of the tile (see Maps::Tiles::Init()).
+        const bool isObjectAddon = ( mp2tile.mapObjectType == MP2::OBJ_NONE ) && ( ( mp2tile.quantity1 >> 1 ) & 1 );
+        const uint8_t objectSpriteIndex = isObjectAddon ? 255 : mp2tile.level1IcnImageIndex;
 
-        std::pair<int, int> colorRace = getColorRaceFromHeroSprite( tile.GetObjectSpriteIndex() );
+        std::pair<int, int> colorRace = getColorRaceFromHeroSprite( objectSpriteIndex );
         if ( ( colorRace.first & colorsAvailableForHumans ) == 0 ) {
             const int side1 = colorRace.first | colorsAvailableForHumans;
             const int side2 = colorsAvailableForComp ^ colorRace.first;
@@ -591,18 +680,51 @@ MapsFileInfoList Maps::PrepareMapsFileInfoList( const bool multi )
         maps.Append( Settings::FindFiles( "maps", ".mx2", false ) );
     }
 
+    // Only the map files that were added or changed since the last time are parsed, the rest is taken from the cache
+    std::map<std::string, MapInfoCacheEntry> cache = loadMapInfoCache();
+    std::map<std::string, MapInfoCacheEntry> updatedCache;
+    std::vector<std::pair<const std::string *, MapInfoCacheEntry *>> mapsToRead;
+
+    for ( const std::string & mapFile : maps ) {
+        MapInfoCacheEntry entry;
+
+        if ( !System::getFileStatus( mapFile, entry.fileSize, entry.modificationTime ) ) {
+            continue;
+        }
+
+        auto cacheIter = cache.find( mapFile );
+        const bool isCached = cacheIter != cache.end() && cacheIter->second.fileSize == entry.fileSize && cacheIter->second.modificationTime == entry.modificationTime;
+
+        auto [iter, isInserted] = updatedCache.emplace( mapFile, isCached ? std::move( cacheIter->second ) : std::move( entry ) );
+        if ( isInserted && !isCached ) {
+            mapsToRead.emplace_back( &iter->first, &iter->second );
+        }
+    }
+
+    // Entries of std::map are not moved on insertion so they can be safely filled in parallel
+    MultiThreading::getThreadPool().parallelFor( 0, mapsToRead.size(), [&mapsToRead]( const size_t i ) {
+        MapInfoCacheEntry & entry = *mapsToRead[i].second;
+
+        entry.isValid = entry.info.ReadMP2( *mapsToRead[i].first );
+    } );
+
+    if ( !mapsToRead.empty() || updatedCache.size() != cache.size() ) {
+        saveMapInfoCache( updatedCache );
+    }
+
     // create a list of unique maps (based on the map file name) and filter it by the preferred number of players
     std::map<std::string, Maps::FileInfo> uniqueMaps;
 
     const int prefNumOfPlayers = conf.PreferablyCountPlayers();
 
     for ( const std::string & mapFile : maps ) {
-        Maps::FileInfo fi;
-
-        if ( !fi.ReadMP2( mapFile ) ) {
+        auto cacheIter = updatedCache.find( mapFile );
+        if ( cacheIter == updatedCache.end() || !cacheIter->second.isValid ) {
             continue;
         }
 
+        Maps::FileInfo fi = cacheIter->second.info;
+
         if ( multi ) {
             assert( prefNumOfPlayers > 1 );
 
@@ -570,6 +570,13 @@ void Maps::Tiles::SetHeroes( Heroes * hero )
     }
 }
 
+void Maps::Tiles::markAsChanged()
+{
+    ++_version;
+
+    world.registerTileChange( _index );
+}
+
 fheroes2::Point Maps::Tiles::GetCenter() const
 {
     return Maps::GetPoint( _index );
@@ -587,9 +594,17 @@ MP2::MapObjectType Maps::Tiles::GetObject( bool ignoreObjectUnderHero /* true */
 
 void Maps::Tiles::SetObject( const MP2::MapObjectType objectType )
 {
+    const MP2::MapObjectType previousObjectType = _mainObjectType;
     _mainObjectType = objectType;
 
-    world.resetPathfinder();
+    // Only the tiles of the world are indexed, not their copies.
+    if ( isValidAbsIndex( _index ) && &world.GetTiles( _index ) == this ) {
+        world.updateObjectTileIndex( _index, previousObjectType, objectType );
+    }
+
+    markAsChanged();
+
+    world.resetPathfinder( _index );
 }
 
 void Maps::Tiles::setBoat( const int direction, const int color )
@@ -702,6 +717,8 @@ int Maps::Tiles::getOriginalPassability() const
 
 void Maps::Tiles::setInitialPassability()
 {
+    markAsChanged();
+
     using TilePassableType = decltype( tilePassable );
     static_assert( std::is_same_v<TilePassableType, uint16_t>, "Type of tilePassable has been changed, check the logic below" );
 
@@ -713,6 +730,8 @@ void Maps::Tiles::setInitialPassability()
 
 void Maps::Tiles::updatePassability()
 {
+    markAsChanged();
+
     if ( !Maps::isValidDirection( _index, Direction::LEFT ) ) {
         tilePassable &= ~( Direction::LEFT | Direction::TOP_LEFT | Direction::BOTTOM_LEFT );
     }
@@ -846,11 +865,14 @@ bool Maps::Tiles::doesObjectExist( const uint32_t uid ) const
 
 void Maps::Tiles::UpdateRegion( uint32_t newRegionID )
 {
-    if ( tilePassable ) {
-        _region = newRegionID;
+    if ( !tilePassable ) {
+        newRegionID = REGION_NODE_BLOCKED;
     }
-    else {
-        _region = REGION_NODE_BLOCKED;
+
+    if ( _region != newRegionID ) {
+        _region = newRegionID;
+
+        markAsChanged();
     }
 }
 
@@ -920,7 +942,7 @@ void Maps::Tiles::AddonsSort()
 {
     // Push everything to the container and sort it by level.
     if ( _objectIcnType != MP2::OBJ_ICN_TYPE_UNKNOWN && _imageIndex != 255 ) {
-        addons_level1.emplace_front( _layerType, _uid, _objectIcnType, _imageIndex, false, false );
+        addons_level1.emplace( addons_level1.begin(), _layerType, _uid, _objectIcnType, _imageIndex, false, false );
     }
 
     // Some original maps have issues with identifying tiles as roads. This code fixes it. It's not an ideal solution but works fine in most of cases.
@@ -933,7 +955,7 @@ void Maps::Tiles::AddonsSort()
         }
     }
 
-    addons_level1.sort( TilesAddon::PredicateSortRules1 );
+    std::stable_sort( addons_level1.begin(), addons_level1.end(), TilesAddon::PredicateSortRules1 );
 
     if ( !addons_level1.empty() ) {
         const TilesAddon & highestPriorityAddon = addons_level1.back();
@@ -1155,6 +1177,8 @@ bool Maps::Tiles::isPassableFrom( const int direction, const bool fromWater, con
 
 void Maps::Tiles::SetObjectPassable( bool pass )
 {
+    markAsChanged();
+
     switch ( GetObject( false ) ) {
     case MP2::OBJ_TROLL_BRIDGE:
         if ( pass )
@@ -1319,11 +1343,13 @@ void Maps::Tiles::removeOwnershipFlag( const MP2::MapObjectType objectType )
 
 void Maps::Tiles::updateFlag( const int color, const uint8_t objectSpriteIndex, const uint32_t uid, const bool setOnUpperLayer )
 {
+    markAsChanged();
+
     // Flag deletion or installation must be done in relation to object UID as flag is attached to the object.
     if ( color == Color::NONE ) {
         auto isFlag = [uid]( const TilesAddon & addon ) { return addon._uid == uid && addon._objectIcnType == MP2::OBJ_ICN_TYPE_FLAG32; };
-        addons_level1.remove_if( isFlag );
-        addons_level2.remove_if( isFlag );
+        addons_level1.erase( std::remove_if( addons_level1.begin(), addons_level1.end(), isFlag ), addons_level1.end() );
+        addons_level2.erase( std::remove_if( addons_level2.begin(), addons_level2.end(), isFlag ), addons_level2.end() );
         return;
     }
 
@@ -1470,8 +1496,11 @@ void Maps::Tiles::fixTileObjectType( Tiles & tile )
 
 void Maps::Tiles::Remove( uint32_t uniqID )
 {
-    addons_level1.remove_if( [uniqID]( const Maps::TilesAddon & v ) { return v.isUniq( uniqID ); } );
-    addons_level2.remove_if( [uniqID]( const Maps::TilesAddon & v ) { return v.isUniq( uniqID ); } );
+    markAsChanged();
+
+    auto isUniq = [uniqID]( const Maps::TilesAddon & v ) { return v.isUniq( uniqID ); };
+    addons_level1.erase( std::remove_if( addons_level1.begin(), addons_level1.end(), isUniq ), addons_level1.end() );
+    addons_level2.erase( std::remove_if( addons_level2.begin(), addons_level2.end(), isUniq ), addons_level2.end() );
 
     if ( _uid == uniqID ) {
         resetObjectSprite();
@@ -1482,6 +1511,8 @@ void Maps::Tiles::Remove( uint32_t uniqID )
 void Maps::Tiles::replaceObject( const uint32_t objectUid, const MP2::ObjectIcnType originalObjectIcnType, const MP2::ObjectIcnType newObjectIcnType,
                                  const uint8_t originalImageIndex, const uint8_t newImageIndex )
 {
+    markAsChanged();
+
     // We can immediately return from the function as only one object per tile can have the same UID.
     for ( TilesAddon & addon : addons_level1 ) {
         if ( addon._uid == objectUid && addon._objectIcnType == originalObjectIcnType && addon._imageIndex == originalImageIndex ) {
@@ -1507,6 +1538,8 @@ void Maps::Tiles::replaceObject( const uint32_t objectUid, const MP2::ObjectIcnT
 
 void Maps::Tiles::updateObjectImageIndex( const uint32_t objectUid, const MP2::ObjectIcnType objectIcnType, const int imageIndexOffset )
 {
+    markAsChanged();
+
     // We can immediately return from the function as only one object per tile can have the same UID.
     for ( TilesAddon & addon : addons_level1 ) {
         if ( addon._uid == objectUid && addon._objectIcnType == objectIcnType ) {
@@ -1532,6 +1565,8 @@ void Maps::Tiles::updateObjectImageIndex( const uint32_t objectUid, const MP2::O
 
 void Maps::Tiles::RemoveObjectSprite()
 {
+    markAsChanged();
+
     switch ( GetObject() ) {
     case MP2::OBJ_MONSTER:
         Remove( _uid );
@@ -1610,12 +1645,25 @@ void Maps::Tiles::RemoveJailSprite()
 
 void Maps::Tiles::ClearFog( const int colors )
 {
+    if ( ( _fogColors & colors ) == 0 ) {
+        // The fog is already cleared for all these colors.
+        return;
+    }
+
+    const int previousFogColors = _fogColors;
     _fogColors &= ~colors;
 
+    markAsChanged();
+
+    // Only the tiles of the world are tracked, not their copies.
+    if ( isValidAbsIndex( _index ) && &world.GetTiles( _index ) == this ) {
+        world.registerFogChange( _index, previousFogColors );
+    }
+
     // The fog might be cleared even without the hero's movement - for example, the hero can gain a new level of Scouting
     // skill by picking up a Treasure Chest from a nearby tile or buying a map in a Magellan's Maps object using the space
     // bar button. Reset the pathfinder(s) to make the newly discovered tiles immediately available for this hero.
-    world.resetPathfinder();
+    world.resetPathfinder( _index );
 }
 
 void Maps::Tiles::updateFogDirectionsInArea( const fheroes2::Point & minPos, const fheroes2::Point & maxPos, const int32_t color )
@@ -1775,13 +1823,7 @@ void Maps::Tiles::setAsEmpty()
 
     bool isCoast = false;
 
-    const Indexes tileIndices = Maps::getAroundIndexes( _index, 1 );
-    for ( const int tileIndex : tileIndices ) {
-        if ( tileIndex < 0 ) {
-            // Invalid tile index.
-            continue;
-        }
-
+    for ( const int32_t tileIndex : Maps::getAdjacentIndexes( _index ) ) {
         if ( world.GetTiles( tileIndex ).isWater() ) {
             isCoast = true;
             break;
@@ -2140,16 +2182,20 @@ StreamBase & Maps::operator>>( StreamBase & msg, Tiles & tile )
         world.setOldTileQuantityData( tile.GetIndex(), quantity1, quantity2, additionalMetadata );
     }
     else {
-        // We want to verify the size of array being present in the file.
-        std::vector<uint32_t> temp;
-        msg >> temp;
+        // We want to verify the size of array being present in the file. The values are read in place to avoid an allocation for every tile.
+        uint32_t metadataSize = 0;
+        msg >> metadataSize;
 
-        if ( tile._metadata.size() != temp.size() ) {
+        if ( tile._metadata.size() != metadataSize ) {
             // This is a corrupted file!
             assert( 0 );
+
+            msg.skip( static_cast<size_t>( metadataSize ) * sizeof( uint32_t ) );
         }
         else {
-            std::copy_n( temp.begin(), tile._metadata.size(), tile._metadata.begin() );
+            for ( uint32_t & value : tile._metadata ) {
+                msg >> value;
+            }
         }
     }
 
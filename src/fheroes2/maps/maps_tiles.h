@@ -25,7 +25,6 @@
 
 #include <array>
 #include <cstdint>
-#include <list>
 #include <string>
 #include <vector>
 
@@ -37,6 +36,7 @@
 
 class Heroes;
 class StreamBase;
+class World;
 
 namespace Maps
 {
@@ -59,7 +59,7 @@ namespace Maps
 
         ~TilesAddon() = default;
 
-        TilesAddon & operator=( const TilesAddon & ) = delete;
+        TilesAddon & operator=( const TilesAddon & ) = default;
 
         bool isUniq( const uint32_t id ) const
         {
@@ -101,7 +101,8 @@ namespace Maps
         bool _isMarkedAsRoad{ false };
     };
 
-    using Addons = std::list<TilesAddon>;
+    // Tiles rarely have more than a few addons so keep them in contiguous memory.
+    using Addons = std::vector<TilesAddon>;
 
     class Tiles
     {
@@ -115,6 +116,13 @@ namespace Maps
             return _index;
         }
 
+        // Returns the version of the tile state. It is incremented every time the tile is changed by its mutators (except for the direct
+        // modifications of addons or metadata) so it can be used to check whether the tile has been changed since some point in time.
+        uint32_t getVersion() const
+        {
+            return _version;
+        }
+
         fheroes2::Point GetCenter() const;
 
         MP2::MapObjectType GetObject( bool ignoreObjectUnderHero = true ) const;
@@ -127,6 +135,8 @@ namespace Maps
         void setObjectIcnType( const MP2::ObjectIcnType type )
         {
             _objectIcnType = type;
+
+            markAsChanged();
         }
 
         uint8_t GetObjectSpriteIndex() const
@@ -137,6 +147,8 @@ namespace Maps
         void setObjectSpriteIndex( const uint8_t index )
         {
             _imageIndex = index;
+
+            markAsChanged();
         }
 
         uint32_t GetObjectUID() const
@@ -147,6 +159,8 @@ namespace Maps
         void setObjectUID( const uint32_t uid )
         {
             _uid = uid;
+
+            markAsChanged();
         }
 
         uint8_t getLayerType() const
@@ -213,6 +227,8 @@ namespace Maps
         void resetBoatOwnerColor()
         {
             _boatOwnerColor = Color::NONE;
+
+            markAsChanged();
         }
 
         int getBoatOwnerColor() const
@@ -227,6 +243,8 @@ namespace Maps
         {
             _objectIcnType = MP2::OBJ_ICN_TYPE_UNKNOWN;
             _imageIndex = 255;
+
+            markAsChanged();
         }
 
         void FixObject();
@@ -269,6 +287,8 @@ namespace Maps
         void AddonsPushLevel1( TilesAddon ta )
         {
             addons_level1.emplace_back( ta );
+
+            markAsChanged();
         }
 
         void AddonsPushLevel2( const MP2::mp2tile_t & mt );
@@ -363,6 +383,9 @@ namespace Maps
         void fixOldArtifactIDs();
 
     private:
+        // Increments the version of the tile and registers the change in the world's journal of changed tiles.
+        void markAsChanged();
+
         TilesAddon * getAddonWithFlag( const uint32_t uid );
 
         // Set or remove a flag which belongs to UID of the object.
@@ -378,20 +401,30 @@ namespace Maps
             _fogDirection = fogDirection;
         }
 
+        friend class ::World;
         friend StreamBase & operator<<( StreamBase &, const Tiles & );
         friend StreamBase & operator>>( StreamBase &, Tiles & );
 
         static uint8_t convertOldMainObjectType( const uint8_t mainObjectType );
 
-        Addons addons_level1; // bottom layer
-        Addons addons_level2; // top layer
-
+        // The members are ordered to avoid padding. The fields used by the pathfinding and the map scans (index, region, passability,
+        // object type, fog and ground) come first so that they share the same cache line.
         int32_t _index = 0;
 
+        // This field does not persist in savegame.
+        uint32_t _region = REGION_NODE_BLOCKED;
+
+        uint16_t tilePassable = DIRECTION_ALL;
+
         uint16_t _terrainImageIndex{ 0 };
 
+        MP2::MapObjectType _mainObjectType{ MP2::OBJ_NONE };
+        uint8_t _fogColors = Color::ALL;
+
         uint8_t _terrainFlags{ 0 };
 
+        uint8_t heroID = 0;
+
         // Unique identifier of an object. UID can be shared among multiple object parts if an object is bigger than 1 tile.
         uint32_t _uid{ 0 };
 
@@ -410,24 +443,21 @@ namespace Maps
         // An indicator that this tile is a road. Logically it shouldn't be set for addons.
         bool _isMarkedAsRoad{ false };
 
-        MP2::MapObjectType _mainObjectType{ MP2::OBJ_NONE };
-        uint16_t tilePassable = DIRECTION_ALL;
-        uint8_t _fogColors = Color::ALL;
+        bool tileIsRoad = false;
+
+        // Heroes can only summon neutral empty boats or empty boats belonging to their kingdom.
+        uint8_t _boatOwnerColor = Color::NONE;
 
         // Fog direction to render fog in Game Area.
         uint16_t _fogDirection{ DIRECTION_ALL };
 
-        uint8_t heroID = 0;
-
         std::array<uint32_t, 3> _metadata{ 0 };
 
-        bool tileIsRoad = false;
-
-        // Heroes can only summon neutral empty boats or empty boats belonging to their kingdom.
-        uint8_t _boatOwnerColor = Color::NONE;
-
         // This field does not persist in savegame.
-        uint32_t _region = REGION_NODE_BLOCKED;
+        uint32_t _version{ 0 };
+
+        Addons addons_level1; // bottom layer
+        Addons addons_level2; // top layer
     };
 
     StreamBase & operator<<( StreamBase & msg, const TilesAddon & ta );
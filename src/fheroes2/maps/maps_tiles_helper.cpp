@@ -25,10 +25,10 @@
 #include <cassert>
 #include <cstdint>
 #include <limits>
-#include <list>
 #include <optional>
 #include <ostream>
 #include <type_traits>
+#include <vector>
 
 #include "army.h"
 #include "army_troop.h"
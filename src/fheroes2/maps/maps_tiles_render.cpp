@@ -25,11 +25,11 @@
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
-#include <list>
 #include <map>
 #include <memory>
 #include <ostream>
 #include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "direction.h"
@@ -104,6 +104,7 @@ namespace
                     && animationSprite.height() + animationSprite.y() <= TILEWIDTH );
 
             area.BlitOnTile( output, animationSprite, animationSprite.x(), animationSprite.y(), offset, false, alphaValue );
+            area.addAnimatedTile( offset );
         }
     }
 
@@ -138,6 +139,7 @@ namespace
                     && animationSprite.height() + animationSprite.y() <= TILEWIDTH );
 
             area.BlitOnTile( output, animationSprite, animationSprite.x(), animationSprite.y(), offset, false, mainObjectAlphaValue );
+            area.addAnimatedTile( offset );
         }
     }
 
@@ -284,27 +286,46 @@ namespace
         }
         return spriteIndices;
     }
+
+    // Divides the sprite by tile squares and appends the rendering information of every part to the given container
+    void appendSpriteSquares( const fheroes2::Point & spriteOffset, const fheroes2::Sprite & sprite, const int icnId, const uint32_t icnIndex, const bool isFlipped,
+                              std::vector<fheroes2::ObjectRenderingInfo> & objectInfo )
+    {
+        // The adventure map is rendered by the main thread only so these buffers are reused to avoid memory allocations for every tile
+        static std::vector<fheroes2::Point> outputSquareInfo;
+        static std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
+
+        outputSquareInfo.clear();
+        outputImageInfo.clear();
+
+        fheroes2::DivideImageBySquares( spriteOffset, sprite, TILEWIDTH, outputSquareInfo, outputImageInfo );
+
+        assert( outputSquareInfo.size() == outputImageInfo.size() );
+
+        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
+            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, isFlipped, static_cast<uint8_t>( 255 ) );
+        }
+    }
 }
 
 namespace Maps
 {
-    void redrawEmptyTile( fheroes2::Image & dst, const fheroes2::Point & mp, const Interface::GameArea & area )
+    const fheroes2::Image & getEmptyTileSurface( const fheroes2::Point & mp )
     {
         if ( mp.y == -1 && mp.x >= 0 && mp.x < world.w() ) { // top first row
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, 20 + ( mp.x % 4 ), 0 ), mp );
+            return fheroes2::AGG::GetTIL( TIL::STON, 20 + ( mp.x % 4 ), 0 );
         }
-        else if ( mp.x == world.w() && mp.y >= 0 && mp.y < world.h() ) { // right first row
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, 24 + ( mp.y % 4 ), 0 ), mp );
+        if ( mp.x == world.w() && mp.y >= 0 && mp.y < world.h() ) { // right first row
+            return fheroes2::AGG::GetTIL( TIL::STON, 24 + ( mp.y % 4 ), 0 );
         }
-        else if ( mp.y == world.h() && mp.x >= 0 && mp.x < world.w() ) { // bottom first row
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, 28 + ( mp.x % 4 ), 0 ), mp );
+        if ( mp.y == world.h() && mp.x >= 0 && mp.x < world.w() ) { // bottom first row
+            return fheroes2::AGG::GetTIL( TIL::STON, 28 + ( mp.x % 4 ), 0 );
         }
-        else if ( mp.x == -1 && mp.y >= 0 && mp.y < world.h() ) { // left first row
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, 32 + ( mp.y % 4 ), 0 ), mp );
-        }
-        else {
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, ( std::abs( mp.y ) % 4 ) * 4 + std::abs( mp.x ) % 4, 0 ), mp );
+        if ( mp.x == -1 && mp.y >= 0 && mp.y < world.h() ) { // left first row
+            return fheroes2::AGG::GetTIL( TIL::STON, 32 + ( mp.y % 4 ), 0 );
         }
+
+        return fheroes2::AGG::GetTIL( TIL::STON, ( std::abs( mp.y ) % 4 ) * 4 + std::abs( mp.x ) % 4, 0 );
     }
 
     void redrawTopLayerExtraObjects( const Tiles & tile, fheroes2::Image & dst, const bool isPuzzleDraw, const Interface::GameArea & area )
@@ -351,6 +372,7 @@ namespace Maps
             const uint8_t alphaValue = area.getObjectAlphaValue( tile.GetObjectUID() );
 
             area.BlitOnTile( dst, image, image.x(), image.y(), Maps::GetPoint( tile.GetIndex() ), false, alphaValue );
+            area.addAnimatedArea( image, image.x(), image.y(), Maps::GetPoint( tile.GetIndex() ) );
         }
     }
 
@@ -675,10 +697,12 @@ namespace Maps
         }
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getMonsterSpritesPerTile( const Tiles & tile )
+    void getMonsterSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.GetObject() == MP2::OBJ_MONSTER );
 
+        objectInfo.clear();
+
         const Monster & monster = getMonsterFromTile( tile );
         const std::pair<uint32_t, uint32_t> spriteIndices = GetMonsterSpriteIndices( tile, monster.GetSpriteIndex() );
 
@@ -686,42 +710,22 @@ namespace Maps
         const fheroes2::Sprite & monsterSprite = fheroes2::AGG::GetICN( icnId, spriteIndices.first );
         const fheroes2::Point monsterSpriteOffset( monsterSprite.x() + 16, monsterSprite.y() + 30 );
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( monsterSpriteOffset, monsterSprite, TILEWIDTH, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, spriteIndices.first, false,
-                                     static_cast<uint8_t>( 255 ) );
-        }
-
-        outputSquareInfo.clear();
-        outputImageInfo.clear();
+        appendSpriteSquares( monsterSpriteOffset, monsterSprite, icnId, spriteIndices.first, false, objectInfo );
 
         if ( spriteIndices.second > 0 ) {
             const fheroes2::Sprite & secondaryMonsterSprite = fheroes2::AGG::GetICN( icnId, spriteIndices.second );
             const fheroes2::Point secondaryMonsterSpriteOffset( secondaryMonsterSprite.x() + 16, secondaryMonsterSprite.y() + 30 );
 
-            fheroes2::DivideImageBySquares( secondaryMonsterSpriteOffset, secondaryMonsterSprite, TILEWIDTH, outputSquareInfo, outputImageInfo );
-
-            assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-            for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-                objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, spriteIndices.second, false,
-                                         static_cast<uint8_t>( 255 ) );
-            }
+            appendSpriteSquares( secondaryMonsterSpriteOffset, secondaryMonsterSprite, icnId, spriteIndices.second, false, objectInfo );
         }
-
-        return objectInfo;
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getMonsterShadowSpritesPerTile( const Tiles & tile )
+    void getMonsterShadowSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.GetObject() == MP2::OBJ_MONSTER );
 
+        objectInfo.clear();
+
         const Monster & monster = getMonsterFromTile( tile );
         const std::pair<uint32_t, uint32_t> spriteIndices = GetMonsterSpriteIndices( tile, monster.GetSpriteIndex() );
 
@@ -729,43 +733,23 @@ namespace Maps
         const fheroes2::Sprite & monsterSprite = fheroes2::AGG::GetICN( icnId, spriteIndices.first );
         const fheroes2::Point monsterSpriteOffset( monsterSprite.x() + 16, monsterSprite.y() + 30 );
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( monsterSpriteOffset, monsterSprite, TILEWIDTH, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, spriteIndices.first, false,
-                                     static_cast<uint8_t>( 255 ) );
-        }
-
-        outputSquareInfo.clear();
-        outputImageInfo.clear();
+        appendSpriteSquares( monsterSpriteOffset, monsterSprite, icnId, spriteIndices.first, false, objectInfo );
 
         if ( spriteIndices.second > 0 ) {
             const fheroes2::Sprite & secondaryMonsterSprite = fheroes2::AGG::GetICN( icnId, spriteIndices.second );
             const fheroes2::Point secondaryMonsterSpriteOffset( secondaryMonsterSprite.x() + 16, secondaryMonsterSprite.y() + 30 );
 
-            fheroes2::DivideImageBySquares( secondaryMonsterSpriteOffset, secondaryMonsterSprite, TILEWIDTH, outputSquareInfo, outputImageInfo );
-
-            assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-            for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-                objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, spriteIndices.second, false,
-                                         static_cast<uint8_t>( 255 ) );
-            }
+            appendSpriteSquares( secondaryMonsterSpriteOffset, secondaryMonsterSprite, icnId, spriteIndices.second, false, objectInfo );
         }
-
-        return objectInfo;
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getBoatSpritesPerTile( const Tiles & tile )
+    void getBoatSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         // TODO: combine both boat image generation for heroes and empty boats.
         assert( tile.GetObject() == MP2::OBJ_BOAT );
 
+        objectInfo.clear();
+
         const uint32_t spriteIndex = ( tile.GetObjectSpriteIndex() == 255 ) ? 18 : tile.GetObjectSpriteIndex();
 
         const bool isReflected = ( spriteIndex > 128 );
@@ -777,25 +761,15 @@ namespace Maps
         const fheroes2::Point boatSpriteOffset( ( isReflected ? ( TILEWIDTH + 1 - boatSprite.x() - boatSprite.width() ) : boatSprite.x() ),
                                                 boatSprite.y() + TILEWIDTH - 11 );
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( boatSpriteOffset, boatSprite, TILEWIDTH, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, isReflected,
-                                     static_cast<uint8_t>( 255 ) );
-        }
-
-        return objectInfo;
+        appendSpriteSquares( boatSpriteOffset, boatSprite, icnId, icnIndex, isReflected, objectInfo );
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getBoatShadowSpritesPerTile( const Tiles & tile )
+    void getBoatShadowSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.GetObject() == MP2::OBJ_BOAT );
 
+        objectInfo.clear();
+
         // TODO: boat shadow logic is more complex than this and it is not directly depend on spriteIndex. Find the proper logic and fix it!
         const uint32_t spriteIndex = ( tile.GetObjectSpriteIndex() == 255 ) ? 18 : tile.GetObjectSpriteIndex();
 
@@ -805,25 +779,14 @@ namespace Maps
         const fheroes2::Point boatShadowSpriteOffset( boatShadowSprite.x(), TILEWIDTH + boatShadowSprite.y() - 11 );
 
         // Shadows cannot be flipped so flip flag is always false.
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( boatShadowSpriteOffset, boatShadowSprite, TILEWIDTH, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, false, static_cast<uint8_t>( 255 ) );
-        }
-
-        return objectInfo;
+        appendSpriteSquares( boatShadowSpriteOffset, boatShadowSprite, icnId, icnIndex, false, objectInfo );
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getMineGuardianSpritesPerTile( const Tiles & tile )
+    void getMineGuardianSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.GetObject( false ) == MP2::OBJ_MINES );
 
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
+        objectInfo.clear();
 
         const int32_t spellID = Maps::getMineSpellIdFromTile( tile );
         switch ( spellID ) {
@@ -839,22 +802,12 @@ namespace Maps
             const uint32_t icnIndex = spellID - Spell::SETEGUARDIAN;
             const fheroes2::Sprite & image = fheroes2::AGG::GetICN( icnId, icnIndex );
 
-            std::vector<fheroes2::Point> outputSquareInfo;
-            std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-            fheroes2::DivideImageBySquares( { image.x(), image.y() }, image, TILEWIDTH, outputSquareInfo, outputImageInfo );
-
-            assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-            for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-                objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, false, static_cast<uint8_t>( 255 ) );
-            }
+            appendSpriteSquares( { image.x(), image.y() }, image, icnId, icnIndex, false, objectInfo );
             break;
         }
         default:
             break;
         }
-
-        return objectInfo;
     }
 
     const fheroes2::Image & getTileSurface( const Tiles & tile )
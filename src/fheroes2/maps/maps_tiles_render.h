@@ -41,8 +41,6 @@ namespace Maps
     class Tiles;
     struct TilesAddon;
 
-    void redrawEmptyTile( fheroes2::Image & dst, const fheroes2::Point & mp, const Interface::GameArea & area );
-
     void redrawTopLayerExtraObjects( const Tiles & tile, fheroes2::Image & dst, const bool isPuzzleDraw, const Interface::GameArea & area );
     void redrawTopLayerObject( const Tiles & tile, fheroes2::Image & dst, const bool isPuzzleDraw, const Interface::GameArea & area, const TilesAddon & addon );
 
@@ -54,11 +52,15 @@ namespace Maps
 
     void drawByObjectIcnType( const Tiles & tile, fheroes2::Image & output, const Interface::GameArea & area, const MP2::ObjectIcnType objectIcnType );
 
-    std::vector<fheroes2::ObjectRenderingInfo> getMonsterSpritesPerTile( const Tiles & tile );
-    std::vector<fheroes2::ObjectRenderingInfo> getMonsterShadowSpritesPerTile( const Tiles & tile );
-    std::vector<fheroes2::ObjectRenderingInfo> getBoatSpritesPerTile( const Tiles & tile );
-    std::vector<fheroes2::ObjectRenderingInfo> getBoatShadowSpritesPerTile( const Tiles & tile );
-    std::vector<fheroes2::ObjectRenderingInfo> getMineGuardianSpritesPerTile( const Tiles & tile );
+    // These functions fill the given container (clearing it first) so that the caller can reuse it for all rendered tiles.
+    void getMonsterSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getMonsterShadowSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getBoatSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getBoatShadowSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getMineGuardianSpritesPerTile( const Tiles & tile, std::vector<fheroes2::ObjectRenderingInfo> & objectInfo );
 
     const fheroes2::Image & getTileSurface( const Tiles & tile );
+
+    // Returns the image of a tile outside of the map borders. The point is in tile coordinates.
+    const fheroes2::Image & getEmptyTileSurface( const fheroes2::Point & mp );
 }
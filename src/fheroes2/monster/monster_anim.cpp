@@ -39,7 +39,7 @@ namespace fheroes2
     }
 
     RandomMonsterAnimation::RandomMonsterAnimation( const Monster & monster )
-        : _reference( monster.GetID() )
+        : _reference( AnimationReference::get( monster.GetID() ) )
         , _icnID( fheroes2::getMonsterData( monster.GetID() ).icnId )
         , _frameId( 0 )
         , _frameOffset( 0 )
@@ -93,7 +93,7 @@ namespace fheroes2
         void reset(); // reset to static animation
 
     private:
-        AnimationReference _reference;
+        const AnimationReference & _reference;
         int _icnID;
         std::vector<int> _validMoves;
         std::list<int> _frameSet;
@@ -42,8 +42,6 @@
 
 namespace
 {
-    std::vector<fheroes2::MonsterData> monsterData;
-
     bool isAbilityPresent( const std::vector<fheroes2::MonsterAbility> & abilities, const fheroes2::MonsterAbilityType abilityType )
     {
         return std::find( abilities.begin(), abilities.end(), fheroes2::MonsterAbility( abilityType ) ) != abilities.end();
@@ -134,7 +132,9 @@ namespace
         return sqrt( damagePotential * effectiveHP ) * monsterSpecial;
     }
 
-    void populateMonsterData()
+    static_assert( static_cast<int>( fheroes2::MonsterAbilityType::SOUL_EATER ) < 32, "Monster ability mask cannot hold all ability types" );
+
+    std::vector<fheroes2::MonsterData> createMonsterData()
     {
         const int monsterIcnIds[Monster::MONSTER_COUNT]
             = { ICN::UNKNOWN,  ICN::PEASANT,  ICN::ARCHER,   ICN::ARCHER2,  ICN::PIKEMAN,  ICN::PIKEMAN2, ICN::SWORDSMN, ICN::SWORDSM2, ICN::CAVALRYR,
@@ -384,6 +384,7 @@ namespace
                 { gettext_noop( "Random Monster 3" ), gettext_noop( "Random Monsters 3" ), 0, Race::NONE, 3, { 0, 0, 0, 0, 0, 0, 0 } },
                 { gettext_noop( "Random Monster 4" ), gettext_noop( "Random Monsters 4" ), 0, Race::NONE, 4, { 0, 0, 0, 0, 0, 0, 0 } } };
 
+        std::vector<fheroes2::MonsterData> monsterData;
         monsterData.reserve( Monster::MONSTER_COUNT );
 
         for ( int i = 0; i < Monster::MONSTER_COUNT; ++i ) {
@@ -553,14 +554,24 @@ namespace
         monsterData[Monster::WATER_ELEMENT].battleStats.abilities.emplace_back( fheroes2::MonsterAbilityType::COLD_SPELL_IMMUNITY );
         monsterData[Monster::WATER_ELEMENT].battleStats.weaknesses.emplace_back( fheroes2::MonsterWeaknessType::EXTRA_DAMAGE_FROM_FIRE_SPELL );
 
-        // Calculate base value of monster strength.
+        // Calculate base value of monster strength and cache the set of present abilities.
         for ( fheroes2::MonsterData & data : monsterData ) {
             data.battleStats.monsterBaseStrength = getMonsterBaseStrength( data );
+
+            for ( const fheroes2::MonsterAbility & ability : data.battleStats.abilities ) {
+                data.abilityMask |= fheroes2::MonsterData::getAbilityBit( ability.type );
+            }
         }
 
         // TODO: verify that no duplicates of abilities and weaknesses exist.
+
+        return monsterData;
     }
 
+    // All monster data consists of compile time constants so it is safe to build it during static initialization.
+    // This way accessing it never has to check whether it has been populated.
+    const std::vector<fheroes2::MonsterData> monsterData = createMonsterData();
+
     void removeDuplicateSpell( std::set<int> & sortedSpellIds, const int massSpellId, const int spellId )
     {
         if ( sortedSpellIds.count( massSpellId ) > 0 && sortedSpellIds.count( spellId ) > 0 ) {
@@ -589,10 +600,6 @@ namespace fheroes2
 {
     const MonsterData & getMonsterData( const int monsterId )
     {
-        if ( monsterData.empty() ) {
-            populateMonsterData();
-        }
-
         assert( monsterId >= 0 && static_cast<size_t>( monsterId ) < monsterData.size() );
         if ( monsterId < 0 || static_cast<size_t>( monsterId ) >= monsterData.size() ) {
             return monsterData.front();
@@ -718,10 +725,6 @@ namespace fheroes2
 
     std::string getMonsterDescription( const int monsterId )
     {
-        if ( monsterData.empty() ) {
-            populateMonsterData();
-        }
-
         assert( monsterId >= 0 && static_cast<size_t>( monsterId ) < monsterData.size() );
         if ( monsterId < 0 || static_cast<size_t>( monsterId ) >= monsterData.size() ) {
             return "";
@@ -860,61 +863,52 @@ namespace fheroes2
 
     uint32_t getSpellResistance( const int monsterId, const int spellId )
     {
-        const std::vector<MonsterAbility> & abilities = getMonsterData( monsterId ).battleStats.abilities;
+        const MonsterData & data = getMonsterData( monsterId );
+        const std::vector<MonsterAbility> & abilities = data.battleStats.abilities;
 
         Spell spell( spellId );
 
-        std::vector<MonsterAbility>::const_iterator foundAbility;
-
         if ( spell.isMindInfluence() ) {
-            foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::MIND_SPELL_IMMUNITY ) );
-            if ( foundAbility != abilities.end() ) {
+            if ( data.isAbilityPresent( MonsterAbilityType::MIND_SPELL_IMMUNITY ) ) {
                 return 100;
             }
 
-            foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::UNDEAD ) );
-            if ( foundAbility != abilities.end() ) {
+            if ( data.isAbilityPresent( MonsterAbilityType::UNDEAD ) ) {
                 return 100;
             }
 
-            foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::ELEMENTAL ) );
-            if ( foundAbility != abilities.end() ) {
+            if ( data.isAbilityPresent( MonsterAbilityType::ELEMENTAL ) ) {
                 return 100;
             }
         }
 
         if ( spell.isAliveOnly() ) {
-            foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::UNDEAD ) );
-            if ( foundAbility != abilities.end() ) {
+            if ( data.isAbilityPresent( MonsterAbilityType::UNDEAD ) ) {
                 return 100;
             }
         }
 
         if ( spell.isUndeadOnly() ) {
-            foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::UNDEAD ) );
-            if ( foundAbility == abilities.end() ) {
+            if ( !data.isAbilityPresent( MonsterAbilityType::UNDEAD ) ) {
                 return 100;
             }
         }
 
         if ( spell.isCold() ) {
-            foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::COLD_SPELL_IMMUNITY ) );
-            if ( foundAbility != abilities.end() ) {
+            if ( data.isAbilityPresent( MonsterAbilityType::COLD_SPELL_IMMUNITY ) ) {
                 return 100;
             }
         }
 
         if ( spell.isFire() ) {
-            foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::FIRE_SPELL_IMMUNITY ) );
-            if ( foundAbility != abilities.end() ) {
+            if ( data.isAbilityPresent( MonsterAbilityType::FIRE_SPELL_IMMUNITY ) ) {
                 return 100;
             }
         }
 
         if ( spell == Spell::COLDRAY || spell == Spell::COLDRING || spell == Spell::FIREBALL || spell == Spell::FIREBLAST || spell == Spell::LIGHTNINGBOLT
              || spell == Spell::CHAINLIGHTNING || spell == Spell::ELEMENTALSTORM ) {
-            foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::ELEMENTAL_SPELL_IMMUNITY ) );
-            if ( foundAbility != abilities.end() ) {
+            if ( data.isAbilityPresent( MonsterAbilityType::ELEMENTAL_SPELL_IMMUNITY ) ) {
                 return 100;
             }
         }
@@ -922,7 +916,7 @@ namespace fheroes2
         uint32_t spellResistance = 0;
 
         // Find magic immunity for every spell.
-        foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::MAGIC_RESISTANCE ) );
+        const auto foundAbility = std::find( abilities.begin(), abilities.end(), MonsterAbility( MonsterAbilityType::MAGIC_RESISTANCE ) );
         if ( foundAbility != abilities.end() ) {
             if ( foundAbility->percentage == 100 ) {
                 // Immune to everything.
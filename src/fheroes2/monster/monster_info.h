@@ -176,6 +176,16 @@ namespace fheroes2
             , generalStats( generalStats_ )
         {}
 
+        bool isAbilityPresent( const MonsterAbilityType abilityType ) const
+        {
+            return ( abilityMask & getAbilityBit( abilityType ) ) != 0;
+        }
+
+        static uint32_t getAbilityBit( const MonsterAbilityType abilityType )
+        {
+            return 1u << static_cast<int>( abilityType );
+        }
+
         int icnId;
 
         const char * binFileName;
@@ -185,6 +195,9 @@ namespace fheroes2
         MonsterBattleStats battleStats;
 
         MonsterGeneralStats generalStats;
+
+        // A bit per ability type present in battleStats.abilities, filled once all monster data is populated.
+        uint32_t abilityMask{ 0 };
     };
 
     const MonsterData & getMonsterData( const int monsterId );
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -69,6 +70,22 @@ namespace
         ART_RNDUSED = 0x02
     };
 
+    // Artifact IDs are dense so a bitset is used instead of std::set to avoid memory allocations in the frequently called bonus lookups.
+    using ArtifactIdSet = std::bitset<Artifact::ARTIFACT_COUNT>;
+
+    // Returns false if the artifact ID is already present in the set.
+    bool addArtifactId( ArtifactIdSet & artifactIds, const int artifactId )
+    {
+        assert( artifactId >= 0 && artifactId < Artifact::ARTIFACT_COUNT );
+
+        if ( artifactIds[artifactId] ) {
+            return false;
+        }
+
+        artifactIds.set( artifactId );
+        return true;
+    }
+
     void transferArtifactsByCondition( std::vector<Artifact> & artifacts, BagArtifacts & artifactBag, const std::function<bool( const Artifact & )> & condition )
     {
         for ( auto iter = artifacts.begin(); iter != artifacts.end(); ) {
@@ -561,40 +578,71 @@ bool BagArtifacts::isArtifactCursePresent( const fheroes2::ArtifactCurseType typ
     return false;
 }
 
-int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonusType bonus ) const
+const BagArtifacts::EffectValueCache & BagArtifacts::getEffectValueCache() const
 {
-    // If this assertion blows up you're calling the method for a wrong type.
-    assert( !fheroes2::isBonusMultiplied( bonus ) && !fheroes2::isBonusUnique( bonus ) );
+    EffectValueCache & cache = _effectValueCache;
 
-    int32_t totalValue = 0;
+    if ( cache.artifactIds.size() == size()
+         && std::equal( begin(), end(), cache.artifactIds.begin(), []( const Artifact & artifact, const int id ) { return artifact.GetID() == id; } ) ) {
+        return cache;
+    }
 
-    if ( fheroes2::isBonusCumulative( bonus ) ) {
-        for ( const Artifact & artifact : *this ) {
-            const std::vector<fheroes2::ArtifactBonus> & bonuses = fheroes2::getArtifactData( artifact.GetID() ).bonuses;
-            auto bonusIter = std::find( bonuses.begin(), bonuses.end(), fheroes2::ArtifactBonus( bonus ) );
-            if ( bonusIter != bonuses.end() ) {
-                totalValue += bonusIter->value;
+    cache.artifactIds.clear();
+    cache.bonusValues.clear();
+    cache.curseValues.clear();
+
+    const auto addValue = []( std::vector<int32_t> & values, const int32_t type, const int32_t value ) {
+        const size_t index = static_cast<size_t>( type );
+        if ( index >= values.size() ) {
+            values.resize( index + 1, 0 );
+        }
+
+        values[index] += value;
+    };
+
+    ArtifactIdSet usedArtifactIds;
+    for ( const Artifact & artifact : *this ) {
+        const int artifactId = artifact.GetID();
+        cache.artifactIds.push_back( artifactId );
+
+        // Non-cumulative bonuses and curses of an artifact present in multiple copies are counted only once.
+        const bool isFirstCopy = addArtifactId( usedArtifactIds, artifactId );
+
+        const fheroes2::ArtifactData & data = fheroes2::getArtifactData( artifactId );
+
+        for ( const fheroes2::ArtifactBonus & bonus : data.bonuses ) {
+            if ( fheroes2::isBonusMultiplied( bonus.type ) || fheroes2::isBonusUnique( bonus.type ) ) {
+                continue;
+            }
+
+            if ( isFirstCopy || fheroes2::isBonusCumulative( bonus.type ) ) {
+                addValue( cache.bonusValues, static_cast<int32_t>( bonus.type ), bonus.value );
             }
         }
-    }
-    else {
-        std::set<int> usedArtifactIds;
-        for ( const Artifact & artifact : *this ) {
-            const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
-                // The artifact is present in multiple copies.
+
+        for ( const fheroes2::ArtifactCurse & curse : data.curses ) {
+            if ( fheroes2::isCurseMultiplied( curse.type ) || fheroes2::isCurseUnique( curse.type ) ) {
                 continue;
             }
 
-            const std::vector<fheroes2::ArtifactBonus> & bonuses = fheroes2::getArtifactData( artifactId ).bonuses;
-            auto bonusIter = std::find( bonuses.begin(), bonuses.end(), fheroes2::ArtifactBonus( bonus ) );
-            if ( bonusIter != bonuses.end() ) {
-                totalValue += bonusIter->value;
+            if ( isFirstCopy || fheroes2::isCurseCumulative( curse.type ) ) {
+                addValue( cache.curseValues, static_cast<int32_t>( curse.type ), curse.value );
             }
         }
     }
 
-    return totalValue;
+    return cache;
+}
+
+int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonusType bonus ) const
+{
+    // If this assertion blows up you're calling the method for a wrong type.
+    assert( !fheroes2::isBonusMultiplied( bonus ) && !fheroes2::isBonusUnique( bonus ) );
+
+    const std::vector<int32_t> & values = getEffectValueCache().bonusValues;
+    const size_t index = static_cast<size_t>( bonus );
+
+    return index < values.size() ? values[index] : 0;
 }
 
 int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonusType bonus, std::string & description ) const
@@ -626,10 +674,10 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonus
         }
     }
     else {
-        std::set<int> usedArtifactIds;
+        ArtifactIdSet usedArtifactIds;
         for ( const Artifact & artifact : *this ) {
             const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
+            if ( !addArtifactId( usedArtifactIds, artifactId ) ) {
                 // The artifact is present in multiple copies.
                 continue;
             }
@@ -656,35 +704,10 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactCurse
     // If this assertion blows up you're calling the method for a wrong type.
     assert( !fheroes2::isCurseMultiplied( curse ) && !fheroes2::isCurseUnique( curse ) );
 
-    int32_t totalValue = 0;
-
-    if ( fheroes2::isCurseCumulative( curse ) ) {
-        for ( const Artifact & artifact : *this ) {
-            const std::vector<fheroes2::ArtifactCurse> & curses = fheroes2::getArtifactData( artifact.GetID() ).curses;
-            auto curseIter = std::find( curses.begin(), curses.end(), fheroes2::ArtifactCurse( curse ) );
-            if ( curseIter != curses.end() ) {
-                totalValue += curseIter->value;
-            }
-        }
-    }
-    else {
-        std::set<int> usedArtifactIds;
-        for ( const Artifact & artifact : *this ) {
-            const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
-                // The artifact is present in multiple copies.
-                continue;
-            }
-
-            const std::vector<fheroes2::ArtifactCurse> & curses = fheroes2::getArtifactData( artifactId ).curses;
-            auto curseIter = std::find( curses.begin(), curses.end(), fheroes2::ArtifactCurse( curse ) );
-            if ( curseIter != curses.end() ) {
-                totalValue += curseIter->value;
-            }
-        }
-    }
+    const std::vector<int32_t> & values = getEffectValueCache().curseValues;
+    const size_t index = static_cast<size_t>( curse );
 
-    return totalValue;
+    return index < values.size() ? values[index] : 0;
 }
 
 int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactCurseType curse, std::string & description ) const
@@ -716,10 +739,10 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactCurse
         }
     }
     else {
-        std::set<int> usedArtifactIds;
+        ArtifactIdSet usedArtifactIds;
         for ( const Artifact & artifact : *this ) {
             const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
+            if ( !addArtifactId( usedArtifactIds, artifactId ) ) {
                 // The artifact is present in multiple copies.
                 continue;
             }
@@ -751,10 +774,10 @@ std::vector<int32_t> BagArtifacts::getTotalArtifactMultipliedPercent( const fher
 
     std::vector<int32_t> values;
 
-    std::set<int> usedArtifactIds;
+    ArtifactIdSet usedArtifactIds;
     for ( const Artifact & artifact : *this ) {
         const int artifactId = artifact.GetID();
-        if ( !usedArtifactIds.insert( artifactId ).second ) {
+        if ( !addArtifactId( usedArtifactIds, artifactId ) ) {
             // The artifact is present in multiple copies.
             continue;
         }
@@ -779,10 +802,10 @@ std::vector<int32_t> BagArtifacts::getTotalArtifactMultipliedPercent( const fher
 
     std::vector<int32_t> values;
 
-    std::set<int> usedArtifactIds;
+    ArtifactIdSet usedArtifactIds;
     for ( const Artifact & artifact : *this ) {
         const int artifactId = artifact.GetID();
-        if ( !usedArtifactIds.insert( artifactId ).second ) {
+        if ( !addArtifactId( usedArtifactIds, artifactId ) ) {
             // The artifact is present in multiple copies.
             continue;
         }
@@ -331,6 +331,20 @@ public:
     std::set<ArtifactSetData> assembleArtifactSetIfPossible();
 
     std::string String() const;
+
+private:
+    // Total values of all cumulative bonuses and curses of the bag indexed by their types. The bag can be modified through
+    // the interface of std::vector so the cache is validated by comparing the IDs of the artifacts it was computed for.
+    struct EffectValueCache
+    {
+        std::vector<int> artifactIds;
+        std::vector<int32_t> bonusValues;
+        std::vector<int32_t> curseValues;
+    };
+
+    mutable EffectValueCache _effectValueCache;
+
+    const EffectValueCache & getEffectValueCache() const;
 };
 
 class ArtifactsBar : public Interface::ItemsActionBar<Artifact>
@@ -22,9 +22,40 @@
  ***************************************************************************/
 
 #include "artifact_ultimate.h"
+
+#include <algorithm>
+
 #include "interface_gamearea.h"
+#include "maps.h"
+#include "maps_tiles.h"
 #include "rand.h"
 #include "serialize.h"
+#include "world.h"
+
+namespace
+{
+    uint64_t getPuzzleMapTilesVersion( const int32_t index, const fheroes2::Point & offset )
+    {
+        if ( !Maps::isValidAbsIndex( index ) ) {
+            return 0;
+        }
+
+        // The puzzle map shows 14 x 14 tiles. Some more tiles around are taken into account since objects can be bigger than one tile.
+        const int32_t radius = 10;
+        const fheroes2::Point center = Maps::GetPoint( index ) + offset;
+
+        // Tile versions are only increased so their sum is changed whenever any of the tiles is changed
+        uint64_t version = 0;
+
+        for ( int32_t y = std::max( 0, center.y - radius ); y <= std::min( world.h() - 1, center.y + radius ); ++y ) {
+            for ( int32_t x = std::max( 0, center.x - radius ); x <= std::min( world.w() - 1, center.x + radius ); ++x ) {
+                version += world.GetTiles( x, y ).getVersion();
+            }
+        }
+
+        return version;
+    }
+}
 
 UltimateArtifact::UltimateArtifact()
     : _index( -1 )
@@ -42,11 +73,26 @@ void UltimateArtifact::Set( const int32_t position, const Artifact & a )
     // harder to find, but it should be shown behind one of the last four central pieces of the puzzle.
     _offset.x = Rand::Get( 0, 4 ) - 2;
     _offset.y = Rand::Get( 0, 2 ) - 1;
+
+    resetPuzzleMapSurface();
 }
 
-fheroes2::Image UltimateArtifact::GetPuzzleMapSurface() const
+const fheroes2::Image & UltimateArtifact::GetPuzzleMapSurface() const
 {
-    return Interface::GameArea::GenerateUltimateArtifactAreaSurface( _index, _offset );
+    const uint64_t tilesVersion = getPuzzleMapTilesVersion( _index, _offset );
+
+    if ( _puzzleMapSurface.empty() || tilesVersion != _puzzleMapTilesVersion ) {
+        _puzzleMapSurface = Interface::GameArea::GenerateUltimateArtifactAreaSurface( _index, _offset );
+        _puzzleMapTilesVersion = tilesVersion;
+    }
+
+    return _puzzleMapSurface;
+}
+
+void UltimateArtifact::resetPuzzleMapSurface()
+{
+    _puzzleMapSurface.clear();
+    _puzzleMapTilesVersion = 0;
 }
 
 const Artifact & UltimateArtifact::GetArtifact() const
@@ -66,6 +112,8 @@ void UltimateArtifact::Reset()
     _offset = fheroes2::Point();
     _index = -1;
     _isFound = false;
+
+    resetPuzzleMapSurface();
 }
 
 StreamBase & operator<<( StreamBase & msg, const UltimateArtifact & ultimate )
@@ -76,5 +124,9 @@ StreamBase & operator<<( StreamBase & msg, const UltimateArtifact & ultimate )
 StreamBase & operator>>( StreamBase & msg, UltimateArtifact & ultimate )
 {
     Artifact & artifact = ultimate;
-    return msg >> artifact >> ultimate._index >> ultimate._isFound >> ultimate._offset;
+    msg >> artifact >> ultimate._index >> ultimate._isFound >> ultimate._offset;
+
+    ultimate.resetPuzzleMapSurface();
+
+    return msg;
 }
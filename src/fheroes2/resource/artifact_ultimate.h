@@ -57,16 +57,23 @@ public:
     void Set( const int32_t position, const Artifact & );
     void Reset();
 
-    fheroes2::Image GetPuzzleMapSurface() const;
+    // The surface is rendered from the map tiles around the artifact, it is cached and regenerated only if any of these tiles was changed.
+    const fheroes2::Image & GetPuzzleMapSurface() const;
     const Artifact & GetArtifact() const;
 
 private:
     friend StreamBase & operator<<( StreamBase &, const UltimateArtifact & );
     friend StreamBase & operator>>( StreamBase &, UltimateArtifact & );
 
+    void resetPuzzleMapSurface();
+
     fheroes2::Point _offset;
     int32_t _index;
     bool _isFound;
+
+    mutable fheroes2::Image _puzzleMapSurface;
+    // The sum of versions of the tiles shown on the cached puzzle map surface
+    mutable uint64_t _puzzleMapTilesVersion{ 0 };
 };
 
 StreamBase & operator<<( StreamBase &, const UltimateArtifact & );
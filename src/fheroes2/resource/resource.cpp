@@ -23,7 +23,6 @@
 
 #include "resource.h"
 
-#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <memory>
@@ -194,49 +193,6 @@ Funds & Funds::operator=( const cost_t & cost )
     return *this;
 }
 
-Funds Funds::operator+( const Funds & pm ) const
-{
-    Funds res;
-
-    res.wood = wood + pm.wood;
-    res.mercury = mercury + pm.mercury;
-    res.ore = ore + pm.ore;
-    res.sulfur = sulfur + pm.sulfur;
-    res.crystal = crystal + pm.crystal;
-    res.gems = gems + pm.gems;
-    res.gold = gold + pm.gold;
-
-    return res;
-}
-
-Funds & Funds::operator+=( const Funds & pm )
-{
-    wood += pm.wood;
-    mercury += pm.mercury;
-    ore += pm.ore;
-    sulfur += pm.sulfur;
-    crystal += pm.crystal;
-    gems += pm.gems;
-    gold += pm.gold;
-
-    return *this;
-}
-
-Funds Funds::operator-( const Funds & pm ) const
-{
-    Funds res;
-
-    res.wood = wood - pm.wood;
-    res.mercury = mercury - pm.mercury;
-    res.ore = ore - pm.ore;
-    res.sulfur = sulfur - pm.sulfur;
-    res.crystal = crystal - pm.crystal;
-    res.gems = gems - pm.gems;
-    res.gold = gold - pm.gold;
-
-    return res;
-}
-
 Funds Funds::operator/( const int32_t div ) const
 {
     if ( div == 0 ) {
@@ -257,34 +213,6 @@ Funds Funds::operator/( const int32_t div ) const
     return res;
 }
 
-Funds & Funds::operator-=( const Funds & pm )
-{
-    wood -= pm.wood;
-    mercury -= pm.mercury;
-    ore -= pm.ore;
-    sulfur -= pm.sulfur;
-    crystal -= pm.crystal;
-    gems -= pm.gems;
-    gold -= pm.gold;
-
-    return *this;
-}
-
-Funds Funds::max( const Funds & other ) const
-{
-    Funds max;
-
-    max.wood = std::max( wood, other.wood );
-    max.mercury = std::max( mercury, other.mercury );
-    max.ore = std::max( ore, other.ore );
-    max.sulfur = std::max( sulfur, other.sulfur );
-    max.crystal = std::max( crystal, other.crystal );
-    max.gems = std::max( gems, other.gems );
-    max.gold = std::max( gold, other.gold );
-
-    return max;
-}
-
 int Funds::getLowestQuotient( const Funds & divisor ) const
 {
     int result = ( divisor.gold ) ? gold / divisor.gold : gold;
@@ -307,34 +235,6 @@ int Funds::getLowestQuotient( const Funds & divisor ) const
     return result;
 }
 
-Funds Funds::operator*( uint32_t mul ) const
-{
-    Funds res;
-
-    res.wood = wood * mul;
-    res.mercury = mercury * mul;
-    res.ore = ore * mul;
-    res.sulfur = sulfur * mul;
-    res.crystal = crystal * mul;
-    res.gems = gems * mul;
-    res.gold = gold * mul;
-
-    return res;
-}
-
-Funds & Funds::operator*=( uint32_t mul )
-{
-    wood *= mul;
-    mercury *= mul;
-    ore *= mul;
-    sulfur *= mul;
-    crystal *= mul;
-    gems *= mul;
-    gold *= mul;
-
-    return *this;
-}
-
 Funds & Funds::operator/=( const int32_t div )
 {
     if ( div == 0 ) {
@@ -353,11 +253,6 @@ Funds & Funds::operator/=( const int32_t div )
     return *this;
 }
 
-bool Funds::operator>=( const Funds & pm ) const
-{
-    return wood >= pm.wood && mercury >= pm.mercury && ore >= pm.ore && sulfur >= pm.sulfur && crystal >= pm.crystal && gems >= pm.gems && gold >= pm.gold;
-}
-
 std::string Funds::String() const
 {
     std::ostringstream os;
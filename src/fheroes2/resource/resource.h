@@ -23,6 +23,7 @@
 #ifndef H2RESOURCE_H
 #define H2RESOURCE_H
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <string>
@@ -73,23 +74,99 @@ public:
     Funds( int rs, uint32_t count );
     explicit Funds( const cost_t & );
 
-    Funds operator+( const Funds & ) const;
-    Funds operator*( uint32_t mul ) const;
-    Funds operator-( const Funds & ) const;
+    // The element-wise operations below are called very often by AI budget planning so they are defined here to be inlined.
+    Funds operator+( const Funds & pm ) const
+    {
+        Funds res( *this );
+        res += pm;
+        return res;
+    }
+
+    Funds operator*( const uint32_t mul ) const
+    {
+        Funds res( *this );
+        res *= mul;
+        return res;
+    }
+
+    Funds operator-( const Funds & pm ) const
+    {
+        Funds res( *this );
+        res -= pm;
+        return res;
+    }
+
     Funds operator/( const int32_t div ) const;
-    Funds & operator+=( const Funds & );
-    Funds & operator*=( uint32_t mul );
+
+    Funds & operator+=( const Funds & pm )
+    {
+        wood += pm.wood;
+        mercury += pm.mercury;
+        ore += pm.ore;
+        sulfur += pm.sulfur;
+        crystal += pm.crystal;
+        gems += pm.gems;
+        gold += pm.gold;
+
+        return *this;
+    }
+
+    Funds & operator*=( const uint32_t mul )
+    {
+        wood *= mul;
+        mercury *= mul;
+        ore *= mul;
+        sulfur *= mul;
+        crystal *= mul;
+        gems *= mul;
+        gold *= mul;
+
+        return *this;
+    }
+
     Funds & operator/=( const int32_t div );
-    Funds & operator-=( const Funds & );
+
+    Funds & operator-=( const Funds & pm )
+    {
+        wood -= pm.wood;
+        mercury -= pm.mercury;
+        ore -= pm.ore;
+        sulfur -= pm.sulfur;
+        crystal -= pm.crystal;
+        gems -= pm.gems;
+        gold -= pm.gold;
+
+        return *this;
+    }
+
     Funds & operator=( const cost_t & );
 
-    bool operator>=( const Funds & ) const;
+    bool operator>=( const Funds & pm ) const
+    {
+        // Evaluate all comparisons without short-circuiting to avoid branches.
+        return ( wood >= pm.wood ) & ( mercury >= pm.mercury ) & ( ore >= pm.ore ) & ( sulfur >= pm.sulfur ) & ( crystal >= pm.crystal ) & ( gems >= pm.gems )
+               & ( gold >= pm.gold );
+    }
+
     bool operator<( const Funds & funds ) const
     {
         return !operator>=( funds );
     }
 
-    Funds max( const Funds & ) const;
+    Funds max( const Funds & other ) const
+    {
+        Funds res;
+
+        res.wood = std::max( wood, other.wood );
+        res.mercury = std::max( mercury, other.mercury );
+        res.ore = std::max( ore, other.ore );
+        res.sulfur = std::max( sulfur, other.sulfur );
+        res.crystal = std::max( crystal, other.crystal );
+        res.gems = std::max( gems, other.gems );
+        res.gold = std::max( gold, other.gold );
+
+        return res;
+    }
     int32_t Get( int rs ) const;
     int32_t * GetPtr( int rs );
 
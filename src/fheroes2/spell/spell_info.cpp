@@ -384,7 +384,7 @@ namespace fheroes2
 
     bool isHeroNearWater( const Heroes & hero )
     {
-        const MapsIndexes tilesAround = Maps::getAroundIndexes( hero.GetIndex() );
+        const Maps::AdjacentIndexes tilesAround = Maps::getAdjacentIndexes( hero.GetIndex() );
         return std::any_of( tilesAround.begin(), tilesAround.end(), []( const int32_t tileId ) { return world.GetTiles( tileId ).isWater(); } );
     }
 }
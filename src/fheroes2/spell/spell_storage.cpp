@@ -49,8 +49,12 @@ void SpellStorage::Append( const Spell & sp )
 
 void SpellStorage::Append( const SpellStorage & st )
 {
+    SpellIdSet presentSpells = getSpellIdSet();
+
     for ( const Spell & sp : st ) {
-        if ( std::find( begin(), end(), sp ) == end() ) {
+        const int spellId = sp.GetID();
+        if ( !presentSpells[spellId] ) {
+            presentSpells.set( spellId );
             push_back( sp );
         }
     }
@@ -61,6 +65,17 @@ bool SpellStorage::isPresentSpell( const Spell & spell ) const
     return end() != std::find( begin(), end(), spell );
 }
 
+SpellStorage::SpellIdSet SpellStorage::getSpellIdSet() const
+{
+    SpellIdSet spellIds;
+
+    for ( const Spell & spell : *this ) {
+        spellIds.set( spell.GetID() );
+    }
+
+    return spellIds;
+}
+
 std::string SpellStorage::String() const
 {
     std::string output;
@@ -75,8 +90,16 @@ std::string SpellStorage::String() const
 
 void SpellStorage::Append( const BagArtifacts & bag )
 {
-    for ( BagArtifacts::const_iterator it = bag.begin(); it != bag.end(); ++it )
-        Append( *it );
+    SpellIdSet presentSpells = getSpellIdSet();
+
+    for ( const Artifact & artifact : bag ) {
+        const Spell spell( artifact.getSpellId() );
+        const int spellId = spell.GetID();
+        if ( spell != Spell::NONE && !presentSpells[spellId] ) {
+            presentSpells.set( spellId );
+            push_back( spell );
+        }
+    }
 }
 
 void SpellStorage::Append( const Artifact & art )
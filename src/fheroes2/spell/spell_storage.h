@@ -24,6 +24,7 @@
 #ifndef H2SPELLSTORAGE_H
 #define H2SPELLSTORAGE_H
 
+#include <bitset>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,9 @@ class BagArtifacts;
 class SpellStorage : public std::vector<Spell>
 {
 public:
+    // Spell IDs are dense so sets of spells can be checked and combined word by word.
+    using SpellIdSet = std::bitset<Spell::SPELL_COUNT>;
+
     SpellStorage();
 
     SpellStorage GetSpells( int lvl = -1 ) const;
@@ -43,6 +47,7 @@ public:
     void Append( const BagArtifacts & );
     void Append( const Artifact & );
     bool isPresentSpell( const Spell & ) const;
+    SpellIdSet getSpellIdSet() const;
     std::string String() const;
 };
 
@@ -28,6 +28,8 @@ enum SaveFileFormat : uint16_t
     // If you're adding a new version you must assign it to CURRENT_FORMAT_VERSION located at the bottom.
     // If you're removing an old version you must assign the oldest available to LAST_SUPPORTED_FORMAT_VERSION located at the bottom.
 
+    FORMAT_VERSION_PRE2_1006_RELEASE = 10012,
+    FORMAT_VERSION_PRE1_1006_RELEASE = 10011,
     FORMAT_VERSION_1005_RELEASE = 10010,
     FORMAT_VERSION_PRE1_1005_RELEASE = 10009,
     FORMAT_VERSION_1004_RELEASE = 10008,
@@ -42,5 +44,5 @@ enum SaveFileFormat : uint16_t
 
     LAST_SUPPORTED_FORMAT_VERSION = FORMAT_VERSION_1000_RELEASE,
 
-    CURRENT_FORMAT_VERSION = FORMAT_VERSION_1005_RELEASE
+    CURRENT_FORMAT_VERSION = FORMAT_VERSION_PRE2_1006_RELEASE
 };
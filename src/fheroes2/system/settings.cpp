@@ -77,7 +77,9 @@ namespace
         GLOBAL_BATTLE_AUTO_RESOLVE = 0x04000000,
         GLOBAL_BATTLE_AUTO_SPELLCAST = 0x08000000,
         GLOBAL_AUTO_SAVE_AT_BEGINNING_OF_TURN = 0x10000000,
-        GLOBAL_SCREEN_SCALING_TYPE_NEAREST = 0x20000000
+        GLOBAL_SCREEN_SCALING_TYPE_NEAREST = 0x20000000,
+        GLOBAL_PERFORMANCE_OVERLAY = 0x40000000,
+        GLOBAL_SCREEN_INTEGER_SCALING = 0x80000000
     };
 }
 
@@ -93,6 +95,7 @@ Settings::Settings()
     , music_volume( 6 )
     , _musicType( MUSIC_EXTERNAL )
     , _controllerPointerSpeed( 10 )
+    , _aiTurnTimeLimit( 0 )
     , heroes_speed( DEFAULT_SPEED_DELAY )
     , ai_speed( DEFAULT_SPEED_DELAY )
     , scroll_speed( SCROLL_SPEED_NORMAL )
@@ -184,6 +187,10 @@ bool Settings::Read( const std::string & filePath )
         SetAIMoveSpeed( config.IntParams( "ai speed" ) );
     }
 
+    if ( config.Exists( "ai turn time limit" ) ) {
+        _aiTurnTimeLimit = std::clamp( config.IntParams( "ai turn time limit" ), 0, 600 );
+    }
+
     if ( config.Exists( "heroes speed" ) ) {
         SetHeroesMoveSpeed( config.IntParams( "heroes speed" ) );
     }
@@ -300,6 +307,10 @@ bool Settings::Read( const std::string & filePath )
         setSystemInfo( config.StrParams( "system info" ) == "on" );
     }
 
+    if ( config.Exists( "performance overlay" ) ) {
+        setPerformanceOverlay( config.StrParams( "performance overlay" ) == "on" );
+    }
+
     if ( config.Exists( "auto save at the beginning of the turn" ) ) {
         setAutoSaveAtBeginningOfTurn( config.StrParams( "auto save at the beginning of the turn" ) == "on" );
     }
@@ -319,6 +330,10 @@ bool Settings::Read( const std::string & filePath )
         setScreenScalingTypeNearest( config.StrParams( "screen scaling type" ) == "nearest" );
     }
 
+    if ( config.Exists( "screen integer scaling" ) ) {
+        setScreenIntegerScaling( config.StrParams( "screen integer scaling" ) == "on" );
+    }
+
     return true;
 }
 
@@ -385,6 +400,9 @@ std::string Settings::String() const
     os << std::endl << "# AI movement speed: 0 - 10" << std::endl;
     os << "ai speed = " << ai_speed << std::endl;
 
+    os << std::endl << "# time limit in seconds for AI heroes planning per turn: 0 - 600. 0 means no limit" << std::endl;
+    os << "ai turn time limit = " << _aiTurnTimeLimit << std::endl;
+
     os << std::endl << "# battle speed: 1 - 10" << std::endl;
     os << "battle speed = " << battle_speed << std::endl;
 
@@ -457,6 +475,9 @@ std::string Settings::String() const
     os << std::endl << "# display system information: on/off" << std::endl;
     os << "system info = " << ( _optGlobal.Modes( GLOBAL_SYSTEM_INFO ) ? "on" : "off" ) << std::endl;
 
+    os << std::endl << "# display frame timings, sprite cache and AI turn statistics: on/off" << std::endl;
+    os << "performance overlay = " << ( _optGlobal.Modes( GLOBAL_PERFORMANCE_OVERLAY ) ? "on" : "off" ) << std::endl;
+
     os << std::endl << "# should auto save be performed at the beginning of the turn instead of the end of the turn: on/off" << std::endl;
     os << "auto save at the beginning of the turn = " << ( _optGlobal.Modes( GLOBAL_AUTO_SAVE_AT_BEGINNING_OF_TURN ) ? "on" : "off" ) << std::endl;
 
@@ -466,6 +487,9 @@ std::string Settings::String() const
     os << std::endl << "# scaling type: nearest or linear (set by default)" << std::endl;
     os << "screen scaling type = " << ( _optGlobal.Modes( GLOBAL_SCREEN_SCALING_TYPE_NEAREST ) ? "nearest" : "linear" ) << std::endl;
 
+    os << std::endl << "# scale the screen only by a whole factor: on/off" << std::endl;
+    os << "screen integer scaling = " << ( _optGlobal.Modes( GLOBAL_SCREEN_INTEGER_SCALING ) ? "on" : "off" ) << std::endl;
+
     return os.str();
 }
 
@@ -730,6 +754,16 @@ void Settings::setSystemInfo( const bool enable )
     }
 }
 
+void Settings::setPerformanceOverlay( const bool enable )
+{
+    if ( enable ) {
+        _optGlobal.SetModes( GLOBAL_PERFORMANCE_OVERLAY );
+    }
+    else {
+        _optGlobal.ResetModes( GLOBAL_PERFORMANCE_OVERLAY );
+    }
+}
+
 void Settings::setAutoSaveAtBeginningOfTurn( const bool enable )
 {
     if ( enable ) {
@@ -782,6 +816,18 @@ void Settings::setScreenScalingTypeNearest( const bool enable )
     }
 }
 
+void Settings::setScreenIntegerScaling( const bool enable )
+{
+    if ( enable ) {
+        _optGlobal.SetModes( GLOBAL_SCREEN_INTEGER_SCALING );
+        fheroes2::engine().setIntegerScaling( true );
+    }
+    else {
+        _optGlobal.ResetModes( GLOBAL_SCREEN_INTEGER_SCALING );
+        fheroes2::engine().setIntegerScaling( false );
+    }
+}
+
 void Settings::SetScrollSpeed( int speed )
 {
     scroll_speed = std::clamp( speed, static_cast<int>( SCROLL_SPEED_NONE ), static_cast<int>( SCROLL_SPEED_VERY_FAST ) );
@@ -812,6 +858,11 @@ bool Settings::isSystemInfoEnabled() const
     return _optGlobal.Modes( GLOBAL_SYSTEM_INFO );
 }
 
+bool Settings::isPerformanceOverlayEnabled() const
+{
+    return _optGlobal.Modes( GLOBAL_PERFORMANCE_OVERLAY );
+}
+
 bool Settings::isAutoSaveAtBeginningOfTurnEnabled() const
 {
     return _optGlobal.Modes( GLOBAL_AUTO_SAVE_AT_BEGINNING_OF_TURN );
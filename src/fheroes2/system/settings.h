@@ -183,6 +183,7 @@ public:
     bool isTextSupportModeEnabled() const;
     bool is3DAudioEnabled() const;
     bool isSystemInfoEnabled() const;
+    bool isPerformanceOverlayEnabled() const;
     bool isAutoSaveAtBeginningOfTurnEnabled() const;
     bool isBattleShowDamageInfoEnabled() const;
     bool isHideInterfaceEnabled() const;
@@ -243,11 +244,13 @@ public:
     void set3DAudio( const bool enable );
     void setVSync( const bool enable );
     void setSystemInfo( const bool enable );
+    void setPerformanceOverlay( const bool enable );
     void setAutoSaveAtBeginningOfTurn( const bool enable );
     void setBattleDamageInfo( const bool enable );
     void setHideInterface( const bool enable );
     void setEvilInterface( const bool enable );
     void setScreenScalingTypeNearest( const bool enable );
+    void setScreenIntegerScaling( const bool enable );
 
     void SetSoundVolume( int v );
     void SetMusicVolume( int v );
@@ -405,6 +408,12 @@ public:
         return _controllerPointerSpeed;
     }
 
+    // Time limit in seconds for the AI heroes planning during a turn of one kingdom, 0 means no limit.
+    int aiTurnTimeLimit() const
+    {
+        return _aiTurnTimeLimit;
+    }
+
     void SetMapsFile( const std::string & file )
     {
         current_maps_file.file = file;
@@ -456,6 +465,7 @@ private:
     int music_volume;
     MusicSource _musicType;
     int _controllerPointerSpeed;
+    int _aiTurnTimeLimit;
     int heroes_speed;
     int ai_speed;
     int scroll_speed;
@@ -31,6 +31,7 @@
 #include <ostream>
 #include <set>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "ai.h"
@@ -44,6 +45,7 @@
 #include "game_io.h"
 #include "game_over.h"
 #include "gamedefs.h"
+#include "ground.h"
 #include "heroes.h"
 #include "logging.h"
 #include "maps_fileinfo.h"
@@ -60,6 +62,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "spell.h"
+#include "thread.h"
 #include "tools.h"
 #include "translations.h"
 #include "week.h"
@@ -93,9 +96,7 @@ namespace
     {
         std::vector<int32_t> suitableIds;
 
-        const MapsIndexes & indexes = Maps::getAroundIndexes( tileId );
-
-        for ( const int32_t indexId : indexes ) {
+        for ( const int32_t indexId : Maps::getAdjacentIndexes( tileId ) ) {
             // If allDirections is false, we should only consider tiles below the current object
             if ( !allDirections && indexId < tileId + world.w() - 2 ) {
                 continue;
@@ -130,9 +131,7 @@ namespace
     {
         int32_t count = 0;
 
-        const MapsIndexes & indexes = Maps::getAroundIndexes( tileId );
-
-        for ( const int32_t indexId : indexes ) {
+        for ( const int32_t indexId : Maps::getAdjacentIndexes( tileId ) ) {
             const Maps::Tiles & indexedTile = mapTiles[indexId];
             if ( indexedTile.isWater() || !indexedTile.isClearGround() ) {
                 continue;
@@ -160,15 +159,24 @@ void MapObjects::clear()
     for ( iterator it = begin(); it != end(); ++it )
         delete ( *it ).second;
     std::map<uint32_t, MapObjectSimple *>::clear();
+    _objectsByPosition.clear();
 }
 
 void MapObjects::add( MapObjectSimple * obj )
 {
     if ( obj ) {
         std::map<uint32_t, MapObjectSimple *> & currentMap = *this;
-        if ( currentMap[obj->GetUID()] )
-            delete currentMap[obj->GetUID()];
-        currentMap[obj->GetUID()] = obj;
+        MapObjectSimple *& currentObject = currentMap[obj->GetUID()];
+        if ( currentObject ) {
+            const fheroes2::Point & pos = currentObject->GetCenter();
+            _objectsByPosition.erase( std::make_tuple( pos.y, pos.x, currentObject->GetUID() ) );
+            delete currentObject;
+        }
+
+        currentObject = obj;
+
+        const fheroes2::Point & pos = obj->GetCenter();
+        _objectsByPosition.emplace( pos.y, pos.x, obj->GetUID() );
     }
 }
 
@@ -181,29 +189,88 @@ MapObjectSimple * MapObjects::get( uint32_t uid )
 std::list<MapObjectSimple *> MapObjects::get( const fheroes2::Point & pos )
 {
     std::list<MapObjectSimple *> res;
-    for ( iterator it = begin(); it != end(); ++it )
-        if ( ( *it ).second && ( *it ).second->isPosition( pos ) )
-            res.push_back( ( *it ).second );
+
+    for ( auto it = _objectsByPosition.lower_bound( std::make_tuple( pos.y, pos.x, 0U ) ); it != _objectsByPosition.end(); ++it ) {
+        if ( std::get<0>( *it ) != pos.y || std::get<1>( *it ) != pos.x ) {
+            break;
+        }
+
+        MapObjectSimple * obj = get( std::get<2>( *it ) );
+        if ( obj ) {
+            res.push_back( obj );
+        }
+    }
+
     return res;
 }
 
 void MapObjects::remove( uint32_t uid )
 {
     iterator it = find( uid );
-    if ( it != end() )
+    if ( it == end() ) {
+        return;
+    }
+
+    if ( ( *it ).second ) {
+        const fheroes2::Point & pos = ( *it ).second->GetCenter();
+        _objectsByPosition.erase( std::make_tuple( pos.y, pos.x, uid ) );
         delete ( *it ).second;
+    }
+
     erase( it );
 }
 
 CapturedObject & CapturedObjects::Get( int32_t index )
 {
-    std::map<int32_t, CapturedObject> & my = *this;
-    return my[index];
+    const auto [it, isInserted] = try_emplace( index );
+    if ( isInserted ) {
+        _addObjectIndex( index, it->second.objcol );
+    }
+
+    return it->second;
+}
+
+void CapturedObjects::clear()
+{
+    std::map<int32_t, CapturedObject>::clear();
+    _objectIndexes.clear();
+}
+
+void CapturedObjects::updateObjectIndexes()
+{
+    _objectIndexes.clear();
+
+    for ( const auto & [index, object] : *this ) {
+        _addObjectIndex( index, object.objcol );
+    }
+}
+
+void CapturedObjects::_addObjectIndex( const int32_t index, const ObjectColor & objcol )
+{
+    _objectIndexes[objcol].insert( index );
+}
+
+void CapturedObjects::_removeObjectIndex( const int32_t index, const ObjectColor & objcol )
+{
+    auto it = _objectIndexes.find( objcol );
+    if ( it == _objectIndexes.end() ) {
+        return;
+    }
+
+    it->second.erase( index );
+
+    if ( it->second.empty() ) {
+        _objectIndexes.erase( it );
+    }
 }
 
 void CapturedObjects::SetColor( int32_t index, int col )
 {
-    Get( index ).SetColor( col );
+    CapturedObject & co = Get( index );
+
+    _removeObjectIndex( index, co.objcol );
+    co.SetColor( col );
+    _addObjectIndex( index, co.objcol );
 }
 
 void CapturedObjects::Set( int32_t index, int obj, int col )
@@ -213,36 +280,30 @@ void CapturedObjects::Set( int32_t index, int obj, int col )
     if ( co.GetColor() != col && co.guardians.isValid() )
         co.guardians.Reset();
 
+    _removeObjectIndex( index, co.objcol );
     co.Set( obj, col );
+    _addObjectIndex( index, co.objcol );
 }
 
 uint32_t CapturedObjects::GetCount( int obj, int col ) const
 {
-    uint32_t result = 0;
-
-    const ObjectColor objcol( obj, col );
-
-    for ( const_iterator it = begin(); it != end(); ++it ) {
-        if ( objcol == ( *it ).second.objcol )
-            ++result;
-    }
-
-    return result;
+    const auto it = _objectIndexes.find( { obj, col } );
+    return it != _objectIndexes.end() ? static_cast<uint32_t>( it->second.size() ) : 0;
 }
 
 uint32_t CapturedObjects::GetCountMines( int type, int col ) const
 {
     uint32_t result = 0;
 
-    const ObjectColor objcol1( MP2::OBJ_MINES, col );
-    const ObjectColor objcol2( MP2::OBJ_HEROES, col );
-
-    for ( const_iterator it = begin(); it != end(); ++it ) {
-        const ObjectColor & objcol = ( *it ).second.objcol;
+    for ( const int objectType : { MP2::OBJ_MINES, MP2::OBJ_HEROES } ) {
+        const auto it = _objectIndexes.find( { objectType, col } );
+        if ( it == _objectIndexes.end() ) {
+            continue;
+        }
 
-        if ( objcol == objcol1 || objcol == objcol2 ) {
+        for ( const int32_t tileIndex : it->second ) {
             // scan for find mines
-            const uint8_t index = world.GetTiles( ( *it ).first ).GetObjectSpriteIndex();
+            const uint8_t index = world.GetTiles( tileIndex ).GetObjectSpriteIndex();
 
             // index sprite EXTRAOVR
             if ( 0 == index && Resource::ORE == type )
@@ -261,6 +322,43 @@ uint32_t CapturedObjects::GetCountMines( int type, int col ) const
     return result;
 }
 
+Funds CapturedObjects::GetCountMines( const int col ) const
+{
+    Funds result;
+
+    for ( const int objectType : { MP2::OBJ_MINES, MP2::OBJ_HEROES } ) {
+        const auto it = _objectIndexes.find( { objectType, col } );
+        if ( it == _objectIndexes.end() ) {
+            continue;
+        }
+
+        for ( const int32_t tileIndex : it->second ) {
+            // index sprite EXTRAOVR
+            switch ( world.GetTiles( tileIndex ).GetObjectSpriteIndex() ) {
+            case 0:
+                ++result.ore;
+                break;
+            case 1:
+                ++result.sulfur;
+                break;
+            case 2:
+                ++result.crystal;
+                break;
+            case 3:
+                ++result.gems;
+                break;
+            case 4:
+                ++result.gold;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
 int CapturedObjects::GetColor( int32_t index ) const
 {
     const_iterator it = find( index );
@@ -301,7 +399,10 @@ void CapturedObjects::ResetColor( int color )
         if ( objcol.isColor( color ) ) {
             const MP2::MapObjectType objectType = static_cast<MP2::MapObjectType>( objcol.first );
 
+            _removeObjectIndex( it->first, objcol );
             objcol.second = objectType == MP2::OBJ_CASTLE ? Color::UNUSED : Color::NONE;
+            _addObjectIndex( it->first, objcol );
+
             world.GetTiles( it->first ).setOwnershipFlag( objectType, objcol.second );
         }
     }
@@ -338,6 +439,14 @@ void World::Reset()
 
     // maps tiles
     vec_tiles.clear();
+    _terrainPathfindingInfo.clear();
+    _changedTiles.clear();
+    _isTileChanged.clear();
+    _objectTileIndexes.clear();
+    _monsterProtectionMasks.clear();
+    _tileSounds.clear();
+    _fogRowCounts.clear();
+    _fogDirections.clear();
 
     // kingdoms
     vec_kingdoms.clear();
@@ -368,6 +477,8 @@ void World::Reset()
     heroes_cond_loss = Heroes::UNKNOWN;
 
     _seed = 0;
+
+    Rand::setLegacySeededGenerator( false );
 }
 
 void World::NewMaps( int32_t sw, int32_t sh )
@@ -413,6 +524,8 @@ void World::NewMaps( int32_t sw, int32_t sh )
 
         vec_tiles[i].Init( static_cast<int32_t>( i ), mp2tile );
     }
+
+    updateTerrainPathfindingInfo();
 }
 
 const Castle * World::getCastleEntrance( const fheroes2::Point & tilePosition ) const
@@ -433,6 +546,30 @@ Castle * World::getCastleEntrance( const fheroes2::Point & tilePosition )
     return vec_castles.Get( tilePosition );
 }
 
+const Heroes * World::GetHeroes( const fheroes2::Point & center ) const
+{
+    if ( Maps::isValidAbsPoint( center.x, center.y ) ) {
+        const Heroes * hero = GetTiles( center.x, center.y ).GetHeroes();
+        if ( hero != nullptr && hero->isPosition( center ) ) {
+            return hero;
+        }
+    }
+
+    return vec_heroes.Get( center );
+}
+
+Heroes * World::GetHeroes( const fheroes2::Point & center )
+{
+    if ( Maps::isValidAbsPoint( center.x, center.y ) ) {
+        Heroes * hero = GetTiles( center.x, center.y ).GetHeroes();
+        if ( hero != nullptr && hero->isPosition( center ) ) {
+            return hero;
+        }
+    }
+
+    return vec_heroes.Get( center );
+}
+
 bool World::isValidCastleEntrance( const fheroes2::Point & tilePosition ) const
 {
     return Maps::isValidAbsPoint( tilePosition.x, tilePosition.y ) && ( GetTiles( tilePosition.x, tilePosition.y ).GetObject( false ) == MP2::OBJ_CASTLE );
@@ -505,6 +642,12 @@ const Week & World::GetWeekType() const
 
 void World::NewDay()
 {
+    clearChangedTiles();
+
+    // Armies on the map can change without changing the tiles (e.g. the monsters grow every week). The AI pathfinder keeps its cached
+    // evaluations as long as there are no changes of the nearby tiles, so they should not survive the end of the day.
+    resetPathfinder();
+
     ++day;
 
     if ( BeginWeek() ) {
@@ -781,15 +924,15 @@ MapsIndexes World::GetTeleportEndPoints( const int32_t index ) const
         return result;
     }
 
-    // The type of destination stone liths must match the type of the source stone liths.
-    for ( const int32_t teleportIndex : _allTeleports.at( entranceTile.GetObjectSpriteIndex() ) ) {
-        const Maps::Tiles & teleportTile = GetTiles( teleportIndex );
+    const auto iter = _transitExits.find( index );
+    if ( iter == _transitExits.end() ) {
+        return result;
+    }
 
-        if ( teleportIndex == index || teleportTile.GetHeroes() != nullptr || teleportTile.isWater() != entranceTile.isWater() ) {
-            continue;
+    for ( const int32_t teleportIndex : iter->second ) {
+        if ( GetTiles( teleportIndex ).GetHeroes() == nullptr ) {
+            result.push_back( teleportIndex );
         }
-
-        result.push_back( teleportIndex );
     }
 
     return result;
@@ -816,15 +959,30 @@ MapsIndexes World::GetWhirlpoolEndPoints( const int32_t index ) const
         return result;
     }
 
-    // The exit point from the destination whirlpool must match the entry point in the source whirlpool.
-    for ( const int32_t whirlpoolIndex : _allWhirlpools.at( entranceTile.GetObjectSpriteIndex() ) ) {
-        const Maps::Tiles & whirlpoolTile = GetTiles( whirlpoolIndex );
+    const auto iter = _transitExits.find( index );
+    if ( iter == _transitExits.end() ) {
+        return result;
+    }
 
-        if ( whirlpoolTile.GetObjectUID() == entranceTile.GetObjectUID() || whirlpoolTile.GetHeroes() != nullptr ) {
-            continue;
+    for ( const int32_t whirlpoolIndex : iter->second ) {
+        if ( GetTiles( whirlpoolIndex ).GetHeroes() == nullptr ) {
+            result.push_back( whirlpoolIndex );
         }
+    }
+
+    return result;
+}
+
+MapsIndexes World::getAllTeleportIndexes() const
+{
+    MapsIndexes result;
 
-        result.push_back( whirlpoolIndex );
+    for ( const auto & teleports : _allTeleports ) {
+        result.insert( result.end(), teleports.second.begin(), teleports.second.end() );
+    }
+
+    for ( const auto & whirlpools : _allWhirlpools ) {
+        result.insert( result.end(), whirlpools.second.begin(), whirlpools.second.end() );
     }
 
     return result;
@@ -860,6 +1018,16 @@ uint32_t World::CountCapturedMines( int type, int color ) const
     return map_captureobj.GetCountMines( type, color );
 }
 
+Funds World::CountCapturedMines( const int col ) const
+{
+    Funds result = map_captureobj.GetCountMines( col );
+
+    result.wood = static_cast<int32_t>( CountCapturedObject( MP2::OBJ_SAWMILL, col ) );
+    result.mercury = static_cast<int32_t>( CountCapturedObject( MP2::OBJ_ALCHEMIST_LAB, col ) );
+
+    return result;
+}
+
 void World::CaptureObject( int32_t index, int color )
 {
     const MP2::MapObjectType objectType = GetTiles( index ).GetObject( false );
@@ -938,13 +1106,15 @@ void World::AddEventDate( const EventDate & event )
     vec_eventsday.push_back( event );
 }
 
-EventsDate World::GetEventsDate( int color ) const
+std::vector<const EventDate *> World::GetEventsDate( const int color ) const
 {
-    EventsDate res;
+    std::vector<const EventDate *> res;
 
-    for ( EventsDate::const_iterator it = vec_eventsday.begin(); it != vec_eventsday.end(); ++it )
-        if ( ( *it ).isAllow( color, day ) )
-            res.push_back( *it );
+    for ( const EventDate & event : vec_eventsday ) {
+        if ( event.isAllow( color, day ) ) {
+            res.push_back( &event );
+        }
+    }
 
     return res;
 }
@@ -973,16 +1143,37 @@ void World::ActionForMagellanMaps( int color )
     const bool isAIPlayer = kingdom.isControlAI();
 
     const int alliedColors = Players::GetPlayerFriends( color );
+    const bool isHumanOrHumanFriend = !isAIPlayer || Players::isFriends( color, Players::HumanColors() );
+
+    fheroes2::Point fogRevealMinPos( width, height );
+    fheroes2::Point fogRevealMaxPos( -1, -1 );
 
     for ( Maps::Tiles & tile : vec_tiles ) {
-        if ( tile.isWater() ) {
-            if ( isAIPlayer && tile.isFog( color ) ) {
-                AI::Get().revealFog( tile, kingdom );
-            }
+        if ( !tile.isWater() ) {
+            continue;
+        }
 
+        if ( isAIPlayer && tile.isFog( color ) ) {
+            AI::Get().revealFog( tile, kingdom );
+        }
+
+        if ( tile.isFog( alliedColors ) ) {
             tile.ClearFog( alliedColors );
+
+            const fheroes2::Point pos = Maps::GetPoint( tile.GetIndex() );
+            fogRevealMinPos.x = std::min( fogRevealMinPos.x, pos.x );
+            fogRevealMinPos.y = std::min( fogRevealMinPos.y, pos.y );
+            fogRevealMaxPos.x = std::max( fogRevealMaxPos.x, pos.x );
+            fogRevealMaxPos.y = std::max( fogRevealMaxPos.y, pos.y );
         }
     }
+
+    // Only the area around the revealed tiles needs its fog directions to be updated.
+    if ( isHumanOrHumanFriend && ( fogRevealMaxPos.x >= fogRevealMinPos.x ) && ( fogRevealMaxPos.y >= fogRevealMinPos.y ) ) {
+        fogRevealMinPos -= { 1, 1 };
+        fogRevealMaxPos += { 1, 1 };
+        Maps::Tiles::updateFogDirectionsInArea( fogRevealMinPos, fogRevealMaxPos, alliedColors );
+    }
 }
 
 MapEvent * World::GetMapEvent( const fheroes2::Point & pos )
@@ -1219,31 +1410,308 @@ uint32_t World::getDistance( const Heroes & hero, int targetIndex )
     return _pathfinder.getDistance( targetIndex );
 }
 
-std::list<Route::Step> World::getPath( const Heroes & hero, int targetIndex )
+std::deque<Route::Step> World::getPath( const Heroes & hero, int targetIndex )
 {
     _pathfinder.reEvaluateIfNeeded( hero );
     return _pathfinder.buildPath( targetIndex );
 }
 
+int World::getNumOfTravelDays( const Heroes & hero, int targetIndex )
+{
+    _pathfinder.reEvaluateIfNeeded( hero );
+    return _pathfinder.getNumOfTravelDays( targetIndex );
+}
+
+void World::registerTileChange( const int32_t tileIndex )
+{
+    if ( tileIndex < 0 || static_cast<size_t>( tileIndex ) >= vec_tiles.size() ) {
+        return;
+    }
+
+    // The protection of the tile and all its neighbours depends on the objects and the passability of this tile. The masks are not
+    // built yet when the tiles are changed by the worker threads in PostLoad() so this does not modify anything in that case.
+    if ( !_monsterProtectionMasks.empty() ) {
+        const int32_t x = tileIndex % width;
+        const int32_t y = tileIndex / width;
+
+        for ( int32_t offsetY = -1; offsetY <= 1; ++offsetY ) {
+            for ( int32_t offsetX = -1; offsetX <= 1; ++offsetX ) {
+                if ( x + offsetX >= 0 && x + offsetX < width && y + offsetY >= 0 && y + offsetY < height ) {
+                    _monsterProtectionMasks[tileIndex + offsetY * width + offsetX] = 0;
+                }
+            }
+        }
+    }
+
+    if ( !_tileSounds.empty() ) {
+        _tileSounds[tileIndex] = -1;
+    }
+
+    if ( _isTileChanged.size() != vec_tiles.size() ) {
+        _isTileChanged.assign( vec_tiles.size(), 0 );
+        _changedTiles.clear();
+    }
+
+    // Tiles changed by the worker threads in PostLoad() are registered in advance, so that this check is the only access to the journal.
+    if ( _isTileChanged[tileIndex] ) {
+        return;
+    }
+
+    _isTileChanged[tileIndex] = 1;
+    _changedTiles.push_back( tileIndex );
+}
+
+const Maps::Indexes & World::getObjectTileIndexes( const MP2::MapObjectType objectType ) const
+{
+    if ( _objectTileIndexes.empty() ) {
+        _objectTileIndexes.resize( static_cast<size_t>( std::numeric_limits<std::underlying_type_t<MP2::MapObjectType>>::max() ) + 1 );
+
+        const int32_t size = static_cast<int32_t>( vec_tiles.size() );
+        for ( int32_t idx = 0; idx < size; ++idx ) {
+            _objectTileIndexes[vec_tiles[idx].GetObject()].push_back( idx );
+        }
+    }
+
+    return _objectTileIndexes[objectType];
+}
+
+uint16_t World::getMonsterProtectionMask( const int32_t tileIndex ) const
+{
+    // The highest bit marks the calculated masks
+    const uint16_t calculatedBit = 1 << 15;
+
+    if ( _monsterProtectionMasks.size() != vec_tiles.size() ) {
+        _monsterProtectionMasks.assign( vec_tiles.size(), 0 );
+    }
+
+    uint16_t & protectionMask = _monsterProtectionMasks[tileIndex];
+    if ( !( protectionMask & calculatedBit ) ) {
+        protectionMask = static_cast<uint16_t>( Maps::calculateMonsterProtectionMask( tileIndex, true ) | calculatedBit );
+    }
+
+    return static_cast<uint16_t>( protectionMask & ~calculatedBit );
+}
+
+M82::SoundType World::getTileSound( const int32_t tileIndex ) const
+{
+    if ( _tileSounds.size() != vec_tiles.size() ) {
+        _tileSounds.assign( vec_tiles.size(), -1 );
+    }
+
+    int16_t & sound = _tileSounds[tileIndex];
+    if ( sound < 0 ) {
+        sound = static_cast<int16_t>( M82::getAdventureMapTileSound( vec_tiles[tileIndex] ) );
+    }
+
+    return static_cast<M82::SoundType>( sound );
+}
+
+size_t World::getMemoryUsage() const
+{
+    size_t usedMemory = vec_tiles.capacity() * sizeof( Maps::Tiles );
+
+    for ( const Maps::Tiles & tile : vec_tiles ) {
+        usedMemory += ( tile.getLevel1Addons().capacity() + tile.getLevel2Addons().capacity() ) * sizeof( Maps::TilesAddon );
+    }
+
+    usedMemory += _changedTiles.capacity() * sizeof( int32_t ) + _isTileChanged.capacity() + _monsterProtectionMasks.capacity() * sizeof( uint16_t )
+                  + _tileSounds.capacity() * sizeof( int16_t ) + _terrainPathfindingInfo.capacity() * sizeof( TerrainPathfindingInfo );
+
+    for ( const Maps::Indexes & indexes : _objectTileIndexes ) {
+        usedMemory += indexes.capacity() * sizeof( int32_t );
+    }
+
+    for ( const FogRowCounts & fogRowCounts : _fogRowCounts ) {
+        usedMemory += fogRowCounts.counts.capacity() * sizeof( uint16_t );
+    }
+
+    for ( const FogDirections & fogDirections : _fogDirections ) {
+        usedMemory += fogDirections.directions.capacity() * sizeof( uint16_t );
+    }
+
+    return usedMemory + _pathfinder.getMemoryUsage();
+}
+
+int32_t World::getFogTileCountInRow( const int32_t y, const int32_t minX, const int32_t maxX, const int colors ) const
+{
+    assert( y >= 0 && y < height && minX >= 0 && minX <= maxX && maxX < width );
+
+    // Each row has an extra counter for the tiles preceding the column after the last one
+    const int32_t rowSize = width + 1;
+
+    auto iter = std::find_if( _fogRowCounts.begin(), _fogRowCounts.end(), [colors]( const FogRowCounts & rowCounts ) { return rowCounts.colors == colors; } );
+    if ( iter == _fogRowCounts.end() ) {
+        FogRowCounts & rowCounts = _fogRowCounts.emplace_back();
+        rowCounts.colors = colors;
+        rowCounts.counts.resize( static_cast<size_t>( rowSize ) * height );
+
+        for ( int32_t rowY = 0; rowY < height; ++rowY ) {
+            uint16_t * rowCount = rowCounts.counts.data() + static_cast<size_t>( rowY ) * rowSize;
+            const Maps::Tiles * tile = &vec_tiles[static_cast<size_t>( rowY ) * width];
+
+            rowCount[0] = 0;
+            for ( int32_t x = 0; x < width; ++x ) {
+                rowCount[x + 1] = static_cast<uint16_t>( rowCount[x] + ( tile[x].isFog( colors ) ? 1 : 0 ) );
+            }
+        }
+
+        iter = _fogRowCounts.end() - 1;
+    }
+
+    const uint16_t * rowCount = iter->counts.data() + static_cast<size_t>( y ) * rowSize;
+
+    return rowCount[maxX + 1] - rowCount[minX];
+}
+
+void World::registerFogChange( const int32_t tileIndex, const int previousFogColors )
+{
+    if ( tileIndex < 0 || static_cast<size_t>( tileIndex ) >= vec_tiles.size() ) {
+        return;
+    }
+
+    const Maps::Tiles & tile = vec_tiles[tileIndex];
+    const int32_t x = tileIndex % width;
+    const int32_t y = tileIndex / width;
+    const int32_t rowSize = width + 1;
+
+    for ( FogDirections & fogDirections : _fogDirections ) {
+        if ( ( previousFogColors & fogDirections.colors ) != fogDirections.colors || tile.isFog( fogDirections.colors ) ) {
+            continue;
+        }
+
+        if ( fogDirections.isChanged ) {
+            fogDirections.changedAreaMin.x = std::min( fogDirections.changedAreaMin.x, x );
+            fogDirections.changedAreaMin.y = std::min( fogDirections.changedAreaMin.y, y );
+            fogDirections.changedAreaMax.x = std::max( fogDirections.changedAreaMax.x, x );
+            fogDirections.changedAreaMax.y = std::max( fogDirections.changedAreaMax.y, y );
+        }
+        else {
+            fogDirections.changedAreaMin = { x, y };
+            fogDirections.changedAreaMax = { x, y };
+            fogDirections.isChanged = true;
+        }
+    }
+
+    for ( FogRowCounts & rowCounts : _fogRowCounts ) {
+        // The fog is never restored during the game, it can only be cleared
+        if ( ( previousFogColors & rowCounts.colors ) != rowCounts.colors || tile.isFog( rowCounts.colors ) ) {
+            continue;
+        }
+
+        uint16_t * rowCount = rowCounts.counts.data() + static_cast<size_t>( y ) * rowSize;
+        for ( int32_t column = x + 1; column <= width; ++column ) {
+            assert( rowCount[column] > 0 );
+            --rowCount[column];
+        }
+    }
+}
+
+void World::updateFogDirections( const int colors )
+{
+    if ( vec_tiles.empty() ) {
+        return;
+    }
+
+    auto iter = std::find_if( _fogDirections.begin(), _fogDirections.end(), [colors]( const FogDirections & fogDirections ) { return fogDirections.colors == colors; } );
+    if ( iter == _fogDirections.end() ) {
+        FogDirections & fogDirections = _fogDirections.emplace_back();
+        fogDirections.colors = colors;
+
+        iter = _fogDirections.end() - 1;
+    }
+
+    FogDirections & fogDirections = *iter;
+
+    if ( fogDirections.directions.size() != vec_tiles.size() ) {
+        Maps::Tiles::updateFogDirectionsInArea( { 0, 0 }, { width, height }, colors );
+
+        fogDirections.directions.resize( vec_tiles.size() );
+    }
+    else {
+        for ( size_t i = 0; i < vec_tiles.size(); ++i ) {
+            vec_tiles[i]._setFogDirection( fogDirections.directions[i] );
+        }
+
+        // Fog directions should be updated 1 tile outside of the cleared fog.
+        if ( fogDirections.isChanged ) {
+            Maps::Tiles::updateFogDirectionsInArea( fogDirections.changedAreaMin - fheroes2::Point( 1, 1 ), fogDirections.changedAreaMax + fheroes2::Point( 1, 1 ),
+                                                    colors );
+        }
+    }
+
+    for ( size_t i = 0; i < vec_tiles.size(); ++i ) {
+        fogDirections.directions[i] = vec_tiles[i].getFogDirection();
+    }
+
+    fogDirections.isChanged = false;
+}
+
+void World::updateObjectTileIndex( const int32_t tileIndex, const MP2::MapObjectType oldObjectType, const MP2::MapObjectType newObjectType )
+{
+    if ( _objectTileIndexes.empty() || oldObjectType == newObjectType ) {
+        return;
+    }
+
+    Maps::Indexes & oldIndexes = _objectTileIndexes[oldObjectType];
+    const auto oldIter = std::lower_bound( oldIndexes.begin(), oldIndexes.end(), tileIndex );
+    if ( oldIter != oldIndexes.end() && *oldIter == tileIndex ) {
+        oldIndexes.erase( oldIter );
+    }
+
+    Maps::Indexes & newIndexes = _objectTileIndexes[newObjectType];
+    const auto newIter = std::lower_bound( newIndexes.begin(), newIndexes.end(), tileIndex );
+    if ( newIter == newIndexes.end() || *newIter != tileIndex ) {
+        newIndexes.insert( newIter, tileIndex );
+    }
+}
+
+void World::clearChangedTiles()
+{
+    for ( const int32_t tileIndex : _changedTiles ) {
+        _isTileChanged[tileIndex] = 0;
+    }
+
+    _changedTiles.clear();
+}
+
 void World::resetPathfinder()
 {
     _pathfinder.reset();
     AI::Get().resetPathfinder();
 }
 
+void World::resetPathfinder( const int32_t tileIndex )
+{
+    _pathfinder.reset();
+    AI::Get().resetPathfinderAfterTileChange( tileIndex );
+}
+
 void World::PostLoad( const bool setTilePassabilities )
 {
+    // Tiles might have been replaced without the tile mutators so the object index and the other caches of tiles have to be built again.
+    _objectTileIndexes.clear();
+    _monsterProtectionMasks.clear();
+    _tileSounds.clear();
+    _fogRowCounts.clear();
+    _fogDirections.clear();
+
     if ( setTilePassabilities ) {
-        // update tile passable
+        // Empty tiles might become coast tiles. This changes object types and resets pathfinders so it must be done serially.
         for ( Maps::Tiles & tile : vec_tiles ) {
             tile.updateEmpty();
-            tile.setInitialPassability();
+
+            // The passabilities of all tiles are updated below in parallel. Register the changes in advance so that the change journal
+            // is only read by the worker threads.
+            registerTileChange( tile.GetIndex() );
         }
 
+        MultiThreading::ThreadPool & threadPool = MultiThreading::getThreadPool();
+
+        // Each tile sets only its own passability using information about objects on neighbouring tiles which are not modified here.
+        threadPool.parallelFor( 0, vec_tiles.size(), [this]( const size_t i ) { vec_tiles[i].setInitialPassability(); } );
+
         // Once the original passabilities are set we know all neighbours. Now we have to update passabilities based on neighbours.
-        for ( Maps::Tiles & tile : vec_tiles ) {
-            tile.updatePassability();
-        }
+        threadPool.parallelFor( 0, vec_tiles.size(), [this]( const size_t i ) { vec_tiles[i].updatePassability(); } );
     }
 
     // Cache all tiles that that contain stone liths of a certain type (depending on object sprite index).
@@ -1260,8 +1728,83 @@ void World::PostLoad( const bool setTilePassabilities )
         _allWhirlpools[GetTiles( index ).GetObjectSpriteIndex()].push_back( index );
     }
 
+    // Exits of stone liths and whirlpools depend only on the objects and the terrain which do not change during the game so they are
+    // calculated once. Only the heroes standing on the exits have to be checked when the exits are requested.
+    _transitExits.clear();
+
+    for ( const auto & teleports : _allTeleports ) {
+        for ( const int32_t entranceIndex : teleports.second ) {
+            Maps::Indexes & exits = _transitExits[entranceIndex];
+
+            // The type of destination stone liths must match the type of the source stone liths.
+            for ( const int32_t teleportIndex : teleports.second ) {
+                if ( teleportIndex != entranceIndex && GetTiles( teleportIndex ).isWater() == GetTiles( entranceIndex ).isWater() ) {
+                    exits.push_back( teleportIndex );
+                }
+            }
+        }
+    }
+
+    for ( const auto & whirlpools : _allWhirlpools ) {
+        for ( const int32_t entranceIndex : whirlpools.second ) {
+            Maps::Indexes & exits = _transitExits[entranceIndex];
+
+            // The exit point from the destination whirlpool must match the entry point in the source whirlpool.
+            for ( const int32_t whirlpoolIndex : whirlpools.second ) {
+                if ( GetTiles( whirlpoolIndex ).GetObjectUID() != GetTiles( entranceIndex ).GetObjectUID() ) {
+                    exits.push_back( whirlpoolIndex );
+                }
+            }
+        }
+    }
+
+    updateTerrainPathfindingInfo();
     resetPathfinder();
-    ComputeStaticAnalysis();
+
+    if ( !restoreStaticAnalysis() ) {
+        ComputeStaticAnalysis();
+    }
+}
+
+void World::updateTerrainPathfindingInfo()
+{
+    _terrainPathfindingInfo.clear();
+    _terrainPathfindingInfo.resize( vec_tiles.size() );
+
+    static_assert( Maps::Ground::slowestMovePenalty <= std::numeric_limits<uint8_t>::max(), "The movement penalty does not fit in the table" );
+
+    // Information for every tile depends only on the terrain of the tile and its neighbours.
+    MultiThreading::getThreadPool().parallelFor( 0, vec_tiles.size(), [this]( const size_t i ) {
+        const int32_t index = static_cast<int32_t>( i );
+        const Maps::Tiles & tile = vec_tiles[i];
+        const bool isWater = tile.isWater();
+
+        TerrainPathfindingInfo & info = _terrainPathfindingInfo[i];
+
+        for ( const int direction : Direction::All() ) {
+            if ( !Maps::isValidDirection( index, direction ) ) {
+                continue;
+            }
+
+            if ( isWater && Direction::isDiagonal( direction ) ) {
+                const int verticalDirection = ( direction & DIRECTION_TOP_ROW ) ? Direction::TOP : Direction::BOTTOM;
+                const int horizontalDirection = ( direction & DIRECTION_LEFT_COL ) ? Direction::LEFT : Direction::RIGHT;
+
+                if ( GetTiles( Maps::GetDirectionIndex( index, direction ) ).isWater()
+                     && ( !GetTiles( Maps::GetDirectionIndex( index, verticalDirection ) ).isWater()
+                          || !GetTiles( Maps::GetDirectionIndex( index, horizontalDirection ) ).isWater() ) ) {
+                    // Cannot sail through the corner of land.
+                    continue;
+                }
+            }
+
+            info.validDirections |= static_cast<uint8_t>( direction );
+        }
+
+        for ( uint32_t level = Skill::Level::NONE; level <= Skill::Level::EXPERT; ++level ) {
+            info.groundPenalties[level] = static_cast<uint8_t>( Maps::Ground::GetPenalty( tile, level ) );
+        }
+    } );
 }
 
 uint32_t World::GetMapSeed() const
@@ -1352,28 +1895,28 @@ StreamBase & operator>>( StreamBase & msg, MapObjects & objs )
         case MP2::OBJ_EVENT: {
             MapEvent * ptr = new MapEvent();
             msg >> *ptr;
-            objs[index] = ptr;
+            objs.add( ptr );
             break;
         }
 
         case MP2::OBJ_SPHINX: {
             MapSphinx * ptr = new MapSphinx();
             msg >> *ptr;
-            objs[index] = ptr;
+            objs.add( ptr );
             break;
         }
 
         case MP2::OBJ_SIGN: {
             MapSign * ptr = new MapSign();
             msg >> *ptr;
-            objs[index] = ptr;
+            objs.add( ptr );
             break;
         }
 
         default: {
             MapObjectSimple * ptr = new MapObjectSimple();
             msg >> *ptr;
-            objs[index] = ptr;
+            objs.add( ptr );
             break;
         }
         }
@@ -1388,8 +1931,24 @@ StreamBase & operator<<( StreamBase & msg, const World & w )
     const uint16_t width = static_cast<uint16_t>( w.width );
     const uint16_t height = static_cast<uint16_t>( w.height );
 
-    return msg << width << height << w.vec_tiles << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w._rumors << w.vec_eventsday << w.map_captureobj
-               << w.ultimate_artifact << w.day << w.week << w.month << w.heroes_cond_wins << w.heroes_cond_loss << w.map_objects << w._seed;
+    msg << width << height << w.vec_tiles << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w._rumors << w.vec_eventsday << w.map_captureobj << w.ultimate_artifact
+        << w.day << w.week << w.month << w.heroes_cond_wins << w.heroes_cond_loss << w.map_objects << w._seed;
+
+    // Region IDs of regions always match their positions in the container.
+    msg << w._staticAnalysisHash << static_cast<uint32_t>( w._regions.size() );
+
+    for ( const MapRegion & region : w._regions ) {
+        msg << region._isWater << std::vector<uint32_t>( region._neighbours.begin(), region._neighbours.end() );
+    }
+
+    std::vector<uint32_t> tileRegions;
+    tileRegions.reserve( w.vec_tiles.size() );
+
+    for ( const Maps::Tiles & tile : w.vec_tiles ) {
+        tileRegions.push_back( tile.GetRegion() );
+    }
+
+    return msg << tileRegions << Rand::isLegacySeededGenerator();
 }
 
 StreamBase & operator>>( StreamBase & msg, World & w )
@@ -1429,6 +1988,8 @@ StreamBase & operator>>( StreamBase & msg, World & w )
     msg >> w.vec_castles >> w.vec_kingdoms >> w._rumors >> w.vec_eventsday >> w.map_captureobj >> w.ultimate_artifact >> w.day >> w.week >> w.month >> w.heroes_cond_wins
         >> w.heroes_cond_loss;
 
+    w.map_captureobj.updateObjectIndexes();
+
     static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_PRE1_1002_RELEASE, "Remove the logic below." );
     if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_PRE1_1002_RELEASE ) {
         uint32_t dummy = 0xDEADBEEF;
@@ -1442,6 +2003,40 @@ StreamBase & operator>>( StreamBase & msg, World & w )
 
     msg >> w.map_objects >> w._seed;
 
+    w._regions.clear();
+    w._loadedTileRegions.clear();
+
+    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_PRE1_1006_RELEASE, "Remove the logic below." );
+    if ( Game::GetVersionOfCurrentSaveFile() >= FORMAT_VERSION_PRE1_1006_RELEASE ) {
+        uint32_t regionCount = 0;
+        msg >> w._staticAnalysisHash >> regionCount;
+
+        w._regions.resize( regionCount );
+
+        for ( uint32_t id = 0; id < regionCount; ++id ) {
+            MapRegion & region = w._regions[id];
+            std::vector<uint32_t> neighbours;
+
+            msg >> region._isWater >> neighbours;
+
+            region._id = id;
+            region._neighbours.insert( neighbours.begin(), neighbours.end() );
+        }
+
+        msg >> w._loadedTileRegions;
+    }
+
+    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_PRE2_1006_RELEASE, "Remove the logic below." );
+    if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_PRE2_1006_RELEASE ) {
+        Rand::setLegacySeededGenerator( true );
+    }
+    else {
+        bool isLegacySeededGenerator = false;
+        msg >> isLegacySeededGenerator;
+
+        Rand::setLegacySeededGenerator( isLegacySeededGenerator );
+    }
+
     w.PostLoad( false );
 
     static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1003_RELEASE, "Remove the logic below." );
@@ -24,12 +24,16 @@
 #define H2WORLD_H
 
 #include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "army_troop.h"
@@ -37,6 +41,7 @@
 #include "castle.h"
 #include "heroes.h"
 #include "kingdom.h"
+#include "m82.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "math_base.h"
@@ -74,6 +79,10 @@ struct MapObjects : public std::map<uint32_t, MapObjectSimple *>
     std::list<MapObjectSimple *> get( const fheroes2::Point & );
     MapObjectSimple * get( uint32_t uid );
     void remove( uint32_t uid );
+
+private:
+    // Object UIDs sorted by object position (y, x) and then by UID.
+    std::set<std::tuple<int32_t, int32_t, uint32_t>> _objectsByPosition;
 };
 
 struct CapturedObject
@@ -109,11 +118,25 @@ struct CapturedObjects : std::map<int32_t, CapturedObject>
     void ClearFog( int );
     void ResetColor( int );
 
+    void clear();
+
+    // Should be called after the objects are loaded bypassing the methods above.
+    void updateObjectIndexes();
+
     CapturedObject & Get( int32_t );
 
     uint32_t GetCount( int, int ) const;
     uint32_t GetCountMines( int, int ) const;
+    // Returns the number of captured ore, sulfur, crystal, gems and gold mines of the given color in a single pass
+    Funds GetCountMines( const int col ) const;
     int GetColor( int32_t ) const;
+
+private:
+    void _addObjectIndex( const int32_t index, const ObjectColor & objcol );
+    void _removeObjectIndex( const int32_t index, const ObjectColor & objcol );
+
+    // Tile indexes of objects grouped by object type and color.
+    std::map<std::pair<int, int>, std::set<int32_t>> _objectIndexes;
 };
 
 struct EventDate
@@ -249,15 +272,9 @@ public:
         return vec_heroes.Get( id );
     }
 
-    const Heroes * GetHeroes( const fheroes2::Point & center ) const
-    {
-        return vec_heroes.Get( center );
-    }
-
-    Heroes * GetHeroes( const fheroes2::Point & center )
-    {
-        return vec_heroes.Get( center );
-    }
+    // The hero standing on the tile is found through the tile itself, all heroes are checked only if the tile is not occupied by this hero.
+    const Heroes * GetHeroes( const fheroes2::Point & center ) const;
+    Heroes * GetHeroes( const fheroes2::Point & center );
 
     Heroes * FromJailHeroes( int32_t );
     Heroes * GetFreemanHeroes( const int race, const int heroIDToIgnore = Heroes::UNKNOWN ) const;
@@ -314,9 +331,21 @@ public:
     int32_t NextWhirlpool( const int32_t index ) const;
     MapsIndexes GetWhirlpoolEndPoints( const int32_t index ) const;
 
+    const TerrainPathfindingInfo & getTerrainPathfindingInfo( const int32_t index ) const
+    {
+        assert( index >= 0 && static_cast<size_t>( index ) < _terrainPathfindingInfo.size() );
+
+        return _terrainPathfindingInfo[index];
+    }
+
+    // Returns the indexes of all tiles that can move the hero to another place on the map (stone liths and whirlpools)
+    MapsIndexes getAllTeleportIndexes() const;
+
     void CaptureObject( int32_t, int col );
     uint32_t CountCapturedObject( int obj, int col ) const;
     uint32_t CountCapturedMines( int type, int col ) const;
+    // Returns the number of captured mines (including sawmills and alchemist labs) of every resource type
+    Funds CountCapturedMines( const int col ) const;
     uint32_t CountObeliskOnMaps();
     int ColorCapturedObject( int32_t ) const;
     void ResetCapturedObjects( int );
@@ -332,7 +361,9 @@ public:
     uint32_t CheckKingdomLoss( const Kingdom & kingdom ) const;
 
     void AddEventDate( const EventDate & );
-    EventsDate GetEventsDate( int color ) const;
+
+    // Returns the events of the current day for the given color in the order of their addition. The pointers remain valid until the next day.
+    std::vector<const EventDate *> GetEventsDate( const int color ) const;
 
     MapEvent * GetMapEvent( const fheroes2::Point & );
     MapObjectSimple * GetMapObject( uint32_t uid );
@@ -341,8 +372,55 @@ public:
     size_t getRegionCount() const;
 
     uint32_t getDistance( const Heroes & hero, int targetIndex );
-    std::list<Route::Step> getPath( const Heroes & hero, int targetIndex );
+    std::deque<Route::Step> getPath( const Heroes & hero, int targetIndex );
+    int getNumOfTravelDays( const Heroes & hero, int targetIndex );
     void resetPathfinder();
+    // Should be called every time the object or the fog of the given tile is changed
+    void resetPathfinder( const int32_t tileIndex );
+
+    // Should be called every time the terrain of the map is changed
+    void updateTerrainPathfindingInfo();
+
+    // Adds the tile to the journal of changed tiles, should be called by the tile mutators only. The journal is not thread-safe: tiles which
+    // are changed by worker threads must be registered in advance on the calling thread, so that the workers only read the journal.
+    void registerTileChange( const int32_t tileIndex );
+
+    // Returns the indexes of the tiles changed since the journal was cleared (each index is listed once) so that the consumers can update
+    // their caches incrementally. The journal is cleared at the beginning of each day.
+    const std::vector<int32_t> & getChangedTiles() const
+    {
+        return _changedTiles;
+    }
+
+    void clearChangedTiles();
+
+    // Returns the indexes of all tiles with the given main object type in ascending order. The index is built on the first request
+    // and then kept up to date by the tile mutators.
+    const Maps::Indexes & getObjectTileIndexes( const MP2::MapObjectType objectType ) const;
+
+    // Returns the cached result of Maps::calculateMonsterProtectionMask() for the given tile. The mask is calculated on the first
+    // request and recalculated only after the tile or one of its neighbours is changed.
+    uint16_t getMonsterProtectionMask( const int32_t tileIndex ) const;
+
+    // Returns the cached result of M82::getAdventureMapTileSound() for the given tile. It is recalculated only after the tile is changed.
+    M82::SoundType getTileSound( const int32_t tileIndex ) const;
+
+    // Returns the number of tiles of the given row between the given columns (inclusive) which are covered by the fog for all the
+    // given colors. The counters are built on the first request for these colors and then kept up to date when the fog is cleared.
+    int32_t getFogTileCountInRow( const int32_t y, const int32_t minX, const int32_t maxX, const int colors ) const;
+
+    // Should be called by the tile mutators only
+    void registerFogChange( const int32_t tileIndex, const int previousFogColors );
+
+    // Updates the fog directions of all the tiles for the given colors. The directions calculated by the previous call for the same colors
+    // are restored and only the area around the tiles uncovered since then is recalculated.
+    void updateFogDirections( const int colors );
+
+    // Returns the estimated memory in bytes occupied by the map tiles and the caches built on top of them, including the pathfinder of the human player.
+    size_t getMemoryUsage() const;
+
+    // Should be called by the tile mutators only
+    void updateObjectTileIndex( const int32_t tileIndex, const MP2::MapObjectType oldObjectType, const MP2::MapObjectType newObjectType );
 
     void ComputeStaticAnalysis();
     static uint32_t GetUniq();
@@ -363,6 +441,10 @@ private:
     bool ProcessNewMap( const std::string & filename, const bool checkPoLObjects );
     void PostLoad( const bool setTilePassabilities );
 
+    // Applies the regions read from a save file if they were built for the same map. Returns false if the analysis must be computed again.
+    bool restoreStaticAnalysis();
+    uint32_t getStaticAnalysisHash() const;
+
     bool updateTileMetadata( Maps::Tiles & tile, const MP2::MapObjectType objectType, const bool checkPoLObjects );
 
     bool isValidCastleEntrance( const fheroes2::Point & tilePosition ) const;
@@ -394,15 +476,57 @@ private:
 
     uint32_t _seed{ 0 }; // Map seed
 
+    uint32_t _staticAnalysisHash{ 0 }; // Hash of the map properties the regions were built for
+    std::vector<MapRegion> _regions;
+
     // The following fields are not serialized
 
     std::map<uint8_t, Maps::Indexes> _allTeleports; // All indexes of tiles that contain stone liths of a certain type (sprite index)
     std::map<uint8_t, Maps::Indexes> _allWhirlpools; // All indexes of tiles that contain a certain part (sprite index) of the whirlpool
+    std::map<int32_t, Maps::Indexes> _transitExits; // Possible exits of every stone liths or whirlpool tile regardless of the heroes standing on them
 
-    std::vector<MapRegion> _regions;
+    std::vector<TerrainPathfindingInfo> _terrainPathfindingInfo;
     PlayerWorldPathfinder _pathfinder;
 
     std::vector<std::tuple<uint8_t, uint8_t, uint32_t>> _oldTileQuantityData;
+
+    // Tile region IDs read from a save file, they are applied by restoreStaticAnalysis()
+    std::vector<uint32_t> _loadedTileRegions;
+
+    // Journal of changed tiles
+    std::vector<int32_t> _changedTiles;
+    std::vector<uint8_t> _isTileChanged;
+
+    // Indexes of tiles for every main object type, empty until requested for the first time
+    mutable std::vector<Maps::Indexes> _objectTileIndexes;
+
+    // Monster protection masks of tiles, the highest bit is set for the tiles which have the mask calculated
+    mutable std::vector<uint16_t> _monsterProtectionMasks;
+
+    // Ambient sounds of tiles, -1 is set for the tiles which have the sound not calculated yet
+    mutable std::vector<int16_t> _tileSounds;
+
+    // Numbers of fogged tiles in each row of the map preceding each column, for every set of colors requested so far
+    struct FogRowCounts
+    {
+        int colors{ 0 };
+        std::vector<uint16_t> counts;
+    };
+
+    mutable std::vector<FogRowCounts> _fogRowCounts;
+
+    // Fog directions of all the tiles calculated by the last updateFogDirections() call for every set of colors along with the area of
+    // the fog cleared since then
+    struct FogDirections
+    {
+        int colors{ 0 };
+        std::vector<uint16_t> directions;
+        fheroes2::Point changedAreaMin;
+        fheroes2::Point changedAreaMax;
+        bool isChanged{ false };
+    };
+
+    std::vector<FogDirections> _fogDirections;
 };
 
 StreamBase & operator<<( StreamBase &, const CapturedObject & );
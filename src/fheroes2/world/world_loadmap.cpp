@@ -120,19 +120,33 @@ bool World::LoadMapMP2( const std::string & filename, const bool isOriginalMp2Fi
     Reset();
     Defaults();
 
-    StreamFile fs;
-    if ( !fs.open( filename, "rb" ) ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Map file not found " << filename.c_str() )
+    std::vector<uint8_t> mapData;
+
+    {
+        StreamFile mapFile;
+        if ( !mapFile.open( filename, "rb" ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Map file not found " << filename.c_str() )
+            return false;
+        }
+
+        // The whole map is read at once so parsing does not have to go to the file for every single value.
+        mapData = mapFile.getRaw();
+    }
+
+    if ( mapData.empty() ) {
+        DEBUG_LOG( DBG_GAME, DBG_WARN, "Map file " << filename.c_str() << " is corrupted" )
         return false;
     }
 
+    StreamBuf fs( mapData );
+
     // Read magic number.
     if ( fs.getBE32() != 0x5C000000 ) {
         // It is not a MP2 or MX2 file.
         return false;
     }
 
-    const size_t totalFileSize = fs.size();
+    const size_t totalFileSize = mapData.size();
     if ( totalFileSize < MP2::MP2_MAP_INFO_SIZE ) {
         DEBUG_LOG( DBG_GAME, DBG_WARN, "Map file " << filename.c_str() << " is corrupted" )
         return false;
@@ -402,7 +416,7 @@ bool World::LoadMapMP2( const std::string & filename, const bool isOriginalMp2Fi
         const uint32_t l = fs.get();
         const uint32_t h = fs.get();
 
-        if ( fs.tell() == fs.size() ) {
+        if ( fs.size() == 0 ) {
             DEBUG_LOG( DBG_GAME, DBG_WARN, "Map file " << filename.c_str() << " is corrupted" )
             return false;
         }
@@ -619,7 +633,7 @@ bool World::LoadMapMP2( const std::string & filename, const bool isOriginalMp2Fi
     }
 
     // If this assertion blows up it means that we are not reading the data properly from the file.
-    assert( fs.tell() + 4 == fs.size() );
+    assert( fs.size() == 4 );
 
     fixCastleNames( vec_castles );
 
@@ -21,6 +21,7 @@
 #include "world_pathfinding.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -43,6 +44,7 @@
 #include "maps_tiles_helper.h"
 #include "math_base.h"
 #include "pairs.h"
+#include "profiler.h"
 #include "rand.h"
 #include "route.h"
 #include "settings.h"
@@ -53,6 +55,8 @@
 
 namespace
 {
+    std::atomic<uint64_t> worldMapProcessingCount{ 0 };
+
     bool isFindArtifactVictoryConditionForHuman( const Artifact & art )
     {
         assert( art.isValid() );
@@ -201,62 +205,22 @@ namespace
         return !MP2::isNeedStayFront( objectType );
     }
 
+    // Checks whether it is possible to move from the tile with the given index to the adjacent tile in the given direction. Directions
+    // leading outside the map are considered invalid.
     bool isValidPath( const int index, const int direction, const int heroColor )
     {
-        const Maps::Tiles & fromTile = world.GetTiles( index );
-        const bool fromWater = fromTile.isWater();
-
-        // check corner water/coast
-        if ( fromWater ) {
-            const int mapWidth = world.w();
-            switch ( direction ) {
-            case Direction::TOP_LEFT: {
-                assert( index >= mapWidth + 1 );
-                if ( world.GetTiles( index - mapWidth - 1 ).isWater() && ( !world.GetTiles( index - 1 ).isWater() || !world.GetTiles( index - mapWidth ).isWater() ) ) {
-                    // Cannot sail through the corner of land.
-                    return false;
-                }
-
-                break;
-            }
-            case Direction::TOP_RIGHT: {
-                assert( index >= mapWidth && index + 1 < mapWidth * world.h() );
-                if ( world.GetTiles( index - mapWidth + 1 ).isWater() && ( !world.GetTiles( index + 1 ).isWater() || !world.GetTiles( index - mapWidth ).isWater() ) ) {
-                    // Cannot sail through the corner of land.
-                    return false;
-                }
-
-                break;
-            }
-            case Direction::BOTTOM_RIGHT: {
-                assert( index + mapWidth + 1 < mapWidth * world.h() );
-                if ( world.GetTiles( index + mapWidth + 1 ).isWater() && ( !world.GetTiles( index + 1 ).isWater() || !world.GetTiles( index + mapWidth ).isWater() ) ) {
-                    // Cannot sail through the corner of land.
-                    return false;
-                }
-
-                break;
-            }
-            case Direction::BOTTOM_LEFT: {
-                assert( index >= 1 && index + mapWidth - 1 < mapWidth * world.h() );
-                if ( world.GetTiles( index + mapWidth - 1 ).isWater() && ( !world.GetTiles( index - 1 ).isWater() || !world.GetTiles( index + mapWidth ).isWater() ) ) {
-                    // Cannot sail through the corner of land.
-                    return false;
-                }
-
-                break;
-            }
-            default:
-                break;
-            }
+        // Map borders and the corners of land which cannot be sailed through are taken into account by this precalculated mask
+        if ( ( world.getTerrainPathfindingInfo( index ).validDirections & direction ) == 0 ) {
+            return false;
         }
 
+        const Maps::Tiles & fromTile = world.GetTiles( index );
         if ( !fromTile.isPassableTo( direction ) ) {
             return false;
         }
 
         const Maps::Tiles & toTile = world.GetTiles( Maps::GetDirectionIndex( index, direction ) );
-        return toTile.isPassableFrom( Direction::Reflect( direction ), fromWater, false, heroColor );
+        return toTile.isPassableFrom( Direction::Reflect( direction ), fromTile.isWater(), false, heroColor );
     }
 
     bool isTileAccessibleForAIWithArmy( const int tileIndex, const double armyStrength, const double minimalAdvantage )
@@ -286,9 +250,8 @@ void WorldPathfinder::checkWorldSize()
 {
     const size_t worldSize = world.getSize();
 
-    if ( _cache.size() != worldSize ) {
-        _cache.clear();
-        _cache.resize( worldSize );
+    if ( getCacheSize() != worldSize ) {
+        resizeCache( worldSize );
 
         const Directions & directions = Direction::All();
         _mapOffset.resize( directions.size() );
@@ -298,7 +261,7 @@ void WorldPathfinder::checkWorldSize()
     }
 }
 
-uint32_t WorldPathfinder::calculatePathPenalty( const std::list<Route::Step> & path )
+uint32_t WorldPathfinder::calculatePathPenalty( const std::deque<Route::Step> & path )
 {
     uint32_t dist = 0;
     for ( const Route::Step & step : path ) {
@@ -312,7 +275,11 @@ uint32_t WorldPathfinder::getMovementPenalty( int src, int dst, int direction )
     const Maps::Tiles & srcTile = world.GetTiles( src );
     const Maps::Tiles & dstTile = world.GetTiles( dst );
 
-    uint32_t penalty = srcTile.isRoad() && dstTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( srcTile, _pathfindingSkill );
+    assert( _pathfindingSkill <= Skill::Level::EXPERT );
+
+    const uint32_t srcGroundPenalty = world.getTerrainPathfindingInfo( src ).groundPenalties[_pathfindingSkill];
+
+    uint32_t penalty = srcTile.isRoad() && dstTile.isRoad() ? Maps::Ground::roadPenalty : srcGroundPenalty;
 
     // Diagonal movement costs 50% more
     if ( Direction::isDiagonal( direction ) ) {
@@ -324,13 +291,13 @@ uint32_t WorldPathfinder::getMovementPenalty( int src, int dst, int direction )
     // tile (both in straight and diagonal direction) as long as we have enough movement points
     // to move over our current tile in the straight direction
     if ( _maxMovePoints > 0 ) {
-        const WorldNode & node = _cache[src];
+        const WorldNode & node = getCachedNode( src );
 
         // No dead ends allowed
         assert( src == _pathStart || node._from != -1 );
 
         const uint32_t remainingMovePoints = node._remainingMovePoints;
-        const uint32_t srcTilePenalty = srcTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( srcTile, _pathfindingSkill );
+        const uint32_t srcTilePenalty = srcTile.isRoad() ? Maps::Ground::roadPenalty : srcGroundPenalty;
 
         // If we still have enough movement points to move over the src tile in the straight
         // direction, but not enough to move to the dst tile, then the "last move" logic is
@@ -365,27 +332,68 @@ uint32_t WorldPathfinder::subtractMovePoints( const uint32_t movePoints, const u
 
 void WorldPathfinder::processWorldMap()
 {
+    PROFILE_ZONE( "Pathfinder: process world map" );
+
+    ++worldMapProcessingCount;
+
     // reset cache back to default value
-    for ( size_t idx = 0; idx < _cache.size(); ++idx ) {
-        _cache[idx].resetNode();
+    invalidateCache();
+    getCachedNode( _pathStart ) = WorldNode( -1, 0, MP2::OBJ_NONE, _remainingMovePoints );
+
+    _nodesToExplore.clear();
+    addNodeToExplore( _nodesToExplore, _pathStart );
+
+    exploreNodes( _nodesToExplore );
+}
+
+void WorldPathfinder::exploreNodes( PathfindingQueue & nodesToExplore )
+{
+    while ( !nodesToExplore.empty() ) {
+        const auto [key, currentNodeIdx] = nodesToExplore.pop();
+
+        // This node has been reached in a cheaper way after it was added to the queue (or it has been reset), this entry is obsolete
+        if ( key != getCachedNode( currentNodeIdx )._cost + getEstimatedCostToTarget( currentNodeIdx ) ) {
+            continue;
+        }
+
+        processCurrentNode( nodesToExplore, currentNodeIdx );
+
+        // The cost of the target node cannot be improved after it has been processed
+        if ( currentNodeIdx == _targetIndex ) {
+            break;
+        }
     }
-    _cache[_pathStart] = WorldNode( -1, 0, MP2::OBJ_NONE, _remainingMovePoints );
+}
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+uint32_t WorldPathfinder::getEstimatedCostToTarget( const int nodeIdx ) const
+{
+    if ( _targetIndex == -1 ) {
+        return 0;
+    }
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
+    auto getDistance = []( const fheroes2::Point & first, const fheroes2::Point & second ) {
+        return static_cast<uint32_t>( std::max( std::abs( first.x - second.x ), std::abs( first.y - second.y ) ) );
+    };
+
+    const fheroes2::Point nodePoint = Maps::GetPoint( nodeIdx );
+
+    // The target can be reached either by moving directly to it, or by using one of the teleports on the way
+    uint32_t distance = getDistance( nodePoint, _targetPoint );
+    for ( const fheroes2::Point & teleportPoint : _teleportPoints ) {
+        distance = std::min( distance, getDistance( nodePoint, teleportPoint ) );
     }
+
+    // Each move to an adjacent tile costs at least as much as a move along the road
+    return distance * Maps::Ground::roadPenalty;
 }
 
-void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, int currentNodeIdx )
+void WorldPathfinder::checkAdjacentNodes( PathfindingQueue & nodesToExplore, int currentNodeIdx )
 {
     const Directions & directions = Direction::All();
-    const WorldNode & currentNode = _cache[currentNodeIdx];
+    const WorldNode & currentNode = getCachedNode( currentNodeIdx );
 
     for ( size_t i = 0; i < directions.size(); ++i ) {
-        if ( !Maps::isValidDirection( currentNodeIdx, directions[i] ) || !isValidPath( currentNodeIdx, directions[i], _color ) ) {
+        if ( !isValidPath( currentNodeIdx, directions[i], _color ) ) {
             continue;
         }
 
@@ -397,7 +405,7 @@ void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, int
         const uint32_t movementPenalty = getMovementPenalty( currentNodeIdx, newIndex, directions[i] );
         const uint32_t movementCost = currentNode._cost + movementPenalty;
 
-        WorldNode & newNode = _cache[newIndex];
+        WorldNode & newNode = getCachedNode( newIndex );
 
         if ( newNode._from == -1 || newNode._cost > movementCost ) {
             const Maps::Tiles & newTile = world.GetTiles( newIndex );
@@ -407,7 +415,7 @@ void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, int
             newNode._objectID = newTile.GetObject();
             newNode._remainingMovePoints = subtractMovePoints( currentNode._remainingMovePoints, movementPenalty );
 
-            nodesToExplore.push_back( newIndex );
+            addNodeToExplore( nodesToExplore, newIndex );
         }
     }
 }
@@ -436,17 +444,69 @@ void PlayerWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
         currentSettings = newSettings;
 
         processWorldMap();
+
+        _travelDays.assign( getCacheSize(), 0 );
     }
 }
 
-std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex ) const
+int PlayerWorldPathfinder::getNumOfTravelDays( const int targetIndex )
+{
+    assert( _pathStart != -1 && targetIndex != -1 && _travelDays.size() == getCacheSize() );
+
+    // Destination is not reachable (or the hero is already there)
+    if ( getCachedNode( targetIndex )._cost == 0 ) {
+        return 0;
+    }
+
+    auto isNewDayRequired = [this]( const int nodeIdx ) {
+        const WorldNode & node = getCachedNode( nodeIdx );
+        const WorldNode & prevNode = getCachedNode( node._from );
+
+        // This movement takes place at the beginning of a new day
+        return prevNode._remainingMovePoints < node._cost - prevNode._cost;
+    };
+
+    // Find the nearest tile on the way for which the number of days is already known and count the new days after it
+    uint32_t days = 1;
+
+    int currentNode = targetIndex;
+
+    while ( currentNode != _pathStart && _travelDays[currentNode] == 0 ) {
+        assert( currentNode != -1 );
+
+        if ( isNewDayRequired( currentNode ) ) {
+            ++days;
+        }
+
+        currentNode = getCachedNode( currentNode )._from;
+    }
+
+    if ( currentNode != _pathStart ) {
+        days += _travelDays[currentNode] - 1;
+    }
+
+    // Store the values for all the tiles on the way that have been passed
+    const uint32_t targetDays = days;
+
+    for ( int node = targetIndex; node != currentNode; node = getCachedNode( node )._from ) {
+        _travelDays[node] = days;
+
+        if ( isNewDayRequired( node ) ) {
+            --days;
+        }
+    }
+
+    return static_cast<int>( std::min( targetDays, 8U ) );
+}
+
+std::deque<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex ) const
 {
     assert( _pathStart != -1 && targetIndex != -1 );
 
-    std::list<Route::Step> path;
+    std::deque<Route::Step> path;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( getCachedNode( targetIndex )._cost == 0 ) {
         return path;
     }
 
@@ -459,11 +519,11 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     while ( currentNode != _pathStart ) {
         assert( currentNode != -1 );
 
-        const WorldNode & node = _cache[currentNode];
+        const WorldNode & node = getCachedNode( currentNode );
 
         assert( node._from != -1 );
 
-        const uint32_t cost = node._cost - _cache[node._from]._cost;
+        const uint32_t cost = node._cost - getCachedNode( node._from )._cost;
 
         path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
 
@@ -476,10 +536,10 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     return path;
 }
 
-void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void PlayerWorldPathfinder::processCurrentNode( PathfindingQueue & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = currentNodeIdx == _pathStart;
-    const WorldNode & currentNode = _cache[currentNodeIdx];
+    const WorldNode & currentNode = getCachedNode( currentNodeIdx );
 
     if ( !isFirstNode && !isTileAvailableForWalkThrough( currentNodeIdx, world.GetTiles( _pathStart ).isWater() ) ) {
         return;
@@ -499,7 +559,7 @@ void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplor
             const uint32_t movementPenalty = getMovementPenalty( currentNodeIdx, monsterIndex, direction );
             const uint32_t movementCost = currentNode._cost + movementPenalty;
 
-            WorldNode & monsterNode = _cache[monsterIndex];
+            WorldNode & monsterNode = getCachedNode( monsterIndex );
 
             if ( monsterNode._from == -1 || monsterNode._cost > movementCost ) {
                 const Maps::Tiles & monsterTile = world.GetTiles( monsterIndex );
@@ -517,6 +577,92 @@ void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplor
 }
 
 void AIWorldPathfinder::reset()
+{
+    resetCurrentEvaluation();
+
+    _dimensionDoorTiles.clear();
+
+    // The cache storage is kept to be reused by the next evaluations
+    for ( CachedEvaluation & evaluation : _cachedEvaluations ) {
+        evaluation.isValid = false;
+    }
+}
+
+size_t AIWorldPathfinder::getMemoryUsage() const
+{
+    size_t usedMemory = WorldPathfinder::getMemoryUsage() + _nodesBuffer.capacity() * sizeof( int ) + _tileMarks.capacity() * sizeof( uint32_t )
+                        + _dimensionDoorTiles.capacity();
+
+    for ( const CachedEvaluation & evaluation : _cachedEvaluations ) {
+        usedMemory += evaluation.cache.getMemoryUsage();
+    }
+
+    return usedMemory;
+}
+
+void AIWorldPathfinder::resetAfterTileChange( const int32_t tileIndex )
+{
+    if ( !Maps::isValidAbsIndex( tileIndex ) ) {
+        reset();
+        return;
+    }
+
+    // Teleports connect distant tiles, so the change of a teleport tile (e.g. a hero stepping on it) can affect any evaluation
+    const MP2::MapObjectType objectType = world.GetTiles( tileIndex ).GetObject( false );
+    if ( objectType == MP2::OBJ_STONE_LITHS || objectType == MP2::OBJ_WHIRLPOOL ) {
+        reset();
+        return;
+    }
+
+    // The current full-map evaluation (if any) is subject to the same check as the other cached evaluations
+    storeCurrentEvaluation( _cachedEvaluations.size() );
+
+    resetCurrentEvaluation();
+
+    const int32_t width = world.w();
+    const int32_t height = world.h();
+    const int32_t tileX = tileIndex % width;
+    const int32_t tileY = tileIndex / width;
+
+    const size_t worldSize = static_cast<size_t>( width ) * height;
+
+    // The object of a tile affects the passability of this tile and its neighbours
+    if ( _dimensionDoorTiles.size() == worldSize ) {
+        for ( int32_t y = std::max( tileY - 1, 0 ); y <= std::min( tileY + 1, height - 1 ); ++y ) {
+            for ( int32_t x = std::max( tileX - 1, 0 ); x <= std::min( tileX + 1, width - 1 ); ++x ) {
+                _dimensionDoorTiles[y * width + x] = 0;
+            }
+        }
+    }
+
+    for ( CachedEvaluation & evaluation : _cachedEvaluations ) {
+        if ( !evaluation.isValid ) {
+            continue;
+        }
+
+        const PathfindingCache<WorldNode> & cache = evaluation.cache;
+        if ( cache.generations.size() != worldSize ) {
+            evaluation.isValid = false;
+            continue;
+        }
+
+        // The object of a tile affects the passability of this tile and the protection of its neighbours, which in turn affects the
+        // movement from the neighbours of the protected tiles. The evaluation could not be affected if none of the tiles within this
+        // distance have been visited by it.
+        const int32_t distance = 3;
+
+        for ( int32_t y = std::max( tileY - distance, 0 ); evaluation.isValid && y <= std::min( tileY + distance, height - 1 ); ++y ) {
+            for ( int32_t x = std::max( tileX - distance, 0 ); x <= std::min( tileX + distance, width - 1 ); ++x ) {
+                if ( cache.generations[y * width + x] == cache.currentGeneration ) {
+                    evaluation.isValid = false;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void AIWorldPathfinder::resetCurrentEvaluation()
 {
     WorldPathfinder::checkWorldSize();
 
@@ -534,6 +680,8 @@ void AIWorldPathfinder::reset()
 
         _townGateCastleIndex = -1;
         _townPortalCastleIndexes.clear();
+
+        _targetIndex = -1;
     }
 }
 
@@ -568,52 +716,135 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
         return result;
     }();
 
-    auto currentSettings = std::tie( _pathStart, _color, _remainingMovePoints, _maxMovePoints, _pathfindingSkill, _armyStrength, _spellPoints, _isArtifactsBagFull,
-                                     _townGateCastleIndex, _townPortalCastleIndexes );
-    const auto newSettings = std::make_tuple( hero.GetIndex(), hero.GetColor(), hero.GetMovePoints(), hero.GetMaxMovePoints(),
-                                              static_cast<uint8_t>( hero.GetLevelSkill( Skill::Secondary::PATHFINDING ) ), hero.GetArmy().GetStrength(),
-                                              hero.GetSpellPoints(), hero.IsFullBagArtifacts(), townGateCastleIndex, townPortalCastleIndexes );
+    evaluateMap( { hero.GetIndex(), hero.GetColor(), hero.GetMovePoints(), hero.GetMaxMovePoints(),
+                   static_cast<uint8_t>( hero.GetLevelSkill( Skill::Secondary::PATHFINDING ) ), hero.GetArmy().GetStrength(), hero.GetSpellPoints(),
+                   hero.IsFullBagArtifacts(), townGateCastleIndex, townPortalCastleIndexes } );
+}
 
-    if ( currentSettings != newSettings ) {
-        currentSettings = newSettings;
+void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const int color, const double armyStrength, const uint8_t skill )
+{
+    evaluateMap( { start, color, 0U, 0U, skill, armyStrength, 0U, false, -1, {} } );
+}
 
-        processWorldMap();
+void AIWorldPathfinder::evaluateMap( const EvaluationSettings & newSettings )
+{
+    auto currentSettings = getCurrentSettings();
+
+    // The cache should be re-evaluated for the entire map if only the goal-directed search was performed before
+    if ( currentSettings == newSettings && _targetIndex == -1 ) {
+        return;
+    }
+
+    const auto cachedEvaluationIter = std::find_if( _cachedEvaluations.begin(), _cachedEvaluations.end(), [&newSettings]( const CachedEvaluation & evaluation ) {
+        return evaluation.isValid && evaluation.settings == newSettings;
+    } );
+    const size_t cachedEvaluationIdx = static_cast<size_t>( cachedEvaluationIter - _cachedEvaluations.begin() );
+
+    storeCurrentEvaluation( cachedEvaluationIdx );
+
+    currentSettings = newSettings;
+
+    _targetIndex = -1;
+
+    if ( cachedEvaluationIdx < _cachedEvaluations.size() ) {
+        CachedEvaluation & evaluation = _cachedEvaluations[cachedEvaluationIdx];
+
+        swapCache( evaluation.cache );
+        evaluation.isValid = false;
+
+        return;
     }
+
+    // The cache storage could be taken from the cache of evaluations, make sure that it is suitable for the current map
+    checkWorldSize();
+
+    processWorldMap();
 }
 
-void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const int color, const double armyStrength, const uint8_t skill )
+void AIWorldPathfinder::storeCurrentEvaluation( const size_t evaluationIdxToKeep )
 {
-    auto currentSettings = std::tie( _pathStart, _color, _remainingMovePoints, _maxMovePoints, _pathfindingSkill, _armyStrength, _spellPoints, _isArtifactsBagFull,
-                                     _townGateCastleIndex, _townPortalCastleIndexes );
-    const auto newSettings = std::make_tuple( start, color, 0U, 0U, skill, armyStrength, 0U, false, -1, std::vector<int32_t>{} );
+    // There are no valid results of the full-map evaluation
+    if ( _pathStart == -1 || _targetIndex != -1 ) {
+        return;
+    }
 
-    if ( currentSettings != newSettings ) {
-        currentSettings = newSettings;
+    // Prefer to use an invalid cached evaluation, otherwise replace the least recently used one
+    size_t evaluationIdx = _cachedEvaluations.size();
 
-        processWorldMap();
+    for ( size_t idx = 0; idx < _cachedEvaluations.size(); ++idx ) {
+        if ( idx == evaluationIdxToKeep ) {
+            continue;
+        }
+
+        const CachedEvaluation & evaluation = _cachedEvaluations[idx];
+
+        if ( !evaluation.isValid ) {
+            evaluationIdx = idx;
+            break;
+        }
+
+        if ( evaluationIdx == _cachedEvaluations.size() || evaluation.lastUseTime < _cachedEvaluations[evaluationIdx].lastUseTime ) {
+            evaluationIdx = idx;
+        }
+    }
+
+    // Keep the results of evaluations for as many armies as the maximum number of heroes in a kingdom
+    const bool isInvalidEvaluationFound = ( evaluationIdx < _cachedEvaluations.size() && !_cachedEvaluations[evaluationIdx].isValid );
+    if ( !isInvalidEvaluationFound && _cachedEvaluations.size() < Kingdom::GetMaxHeroes() ) {
+        evaluationIdx = _cachedEvaluations.size();
+
+        _cachedEvaluations.emplace_back();
+    }
+    else if ( evaluationIdx == _cachedEvaluations.size() ) {
+        // There is nowhere to store the current evaluation
+        return;
     }
+
+    CachedEvaluation & evaluation = _cachedEvaluations[evaluationIdx];
+
+    evaluation.settings = getCurrentSettings();
+    evaluation.isValid = true;
+    evaluation.lastUseTime = ++_evaluationTime;
+
+    swapCache( evaluation.cache );
 }
 
 void AIWorldPathfinder::processWorldMap()
 {
+    PROFILE_ZONE( "AI pathfinder: process world map" );
+
+    ++worldMapProcessingCount;
+
     // reset cache back to default value
-    for ( auto & node : _cache ) {
-        node.resetNode();
+    invalidateCache();
+    getCachedNode( _pathStart ) = WorldNode( -1, 0, MP2::OBJ_NONE, _remainingMovePoints );
+
+    if ( _targetIndex != -1 ) {
+        // The estimated cost of movement to the target is valid only if the "last move" logic is not used
+        assert( _maxMovePoints == 0 && _townGateCastleIndex == -1 && _townPortalCastleIndexes.empty() );
+
+        _targetPoint = Maps::GetPoint( _targetIndex );
+
+        _teleportPoints.clear();
+        for ( const int32_t idx : world.getAllTeleportIndexes() ) {
+            _teleportPoints.push_back( Maps::GetPoint( idx ) );
+        }
     }
-    _cache[_pathStart] = WorldNode( -1, 0, MP2::OBJ_NONE, _remainingMovePoints );
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+    PathfindingQueue & nodesToExplore = _nodesToExplore;
+
+    nodesToExplore.clear();
+    addNodeToExplore( nodesToExplore, _pathStart );
 
     auto processTownPortal = [this, &nodesToExplore]( const Spell & spell, const int32_t castleIndex ) {
-        assert( castleIndex >= 0 && static_cast<size_t>( castleIndex ) < _cache.size() );
-        assert( castleIndex != _pathStart && _cache[castleIndex]._from == -1 );
+        assert( castleIndex >= 0 && static_cast<size_t>( castleIndex ) < getCacheSize() );
+        assert( castleIndex != _pathStart && getCachedNode( castleIndex )._from == -1 );
 
         const uint32_t movePointCost = spell.movePoints();
         const uint32_t movePointsAfter = ( _remainingMovePoints < movePointCost ) ? 0 : _remainingMovePoints - movePointCost;
 
-        _cache[castleIndex] = WorldNode( _pathStart, movePointCost, MP2::OBJ_CASTLE, movePointsAfter );
-        nodesToExplore.push_back( castleIndex );
+        getCachedNode( castleIndex ) = WorldNode( _pathStart, movePointCost, MP2::OBJ_CASTLE, movePointsAfter );
+        addNodeToExplore( nodesToExplore, castleIndex );
     };
 
     if ( _townGateCastleIndex != -1 ) {
@@ -637,15 +868,13 @@ void AIWorldPathfinder::processWorldMap()
         }
     }
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
-    }
+    exploreNodes( nodesToExplore );
 }
 
-void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void AIWorldPathfinder::processCurrentNode( PathfindingQueue & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = currentNodeIdx == _pathStart;
-    WorldNode & currentNode = _cache[currentNodeIdx];
+    WorldNode & currentNode = getCachedNode( currentNodeIdx );
 
     const bool isAccessible = isTileAccessibleForAIWithArmy( currentNodeIdx, _armyStrength, _minimalArmyStrengthAdvantage );
 
@@ -683,7 +912,7 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
             continue;
         }
 
-        WorldNode & teleportNode = _cache[teleportIdx];
+        WorldNode & teleportNode = getCachedNode( teleportIdx );
 
         // Check if move is actually faster through teleport
         if ( teleportNode._from == -1 || teleportNode._cost > currentNode._cost ) {
@@ -694,7 +923,7 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
             teleportNode._objectID = teleportTile.GetObject();
             teleportNode._remainingMovePoints = currentNode._remainingMovePoints;
 
-            nodesToExplore.push_back( teleportIdx );
+            addNodeToExplore( nodesToExplore, teleportIdx );
         }
     }
 }
@@ -706,7 +935,7 @@ uint32_t AIWorldPathfinder::getMovementPenalty( int src, int dst, int direction
     // If we perform pathfinding for a real AI-controlled hero on the map, we should encourage him
     // to overcome water obstacles using boats.
     if ( _maxMovePoints > 0 ) {
-        const WorldNode & node = _cache[src];
+        const WorldNode & node = getCachedNode( src );
 
         // No dead ends allowed
         assert( src == _pathStart || node._from != -1 );
@@ -740,11 +969,12 @@ int AIWorldPathfinder::getFogDiscoveryTile( const Heroes & hero, bool & isTerrit
     const int scoutingDistance = hero.GetScoutingDistance();
 
     const Directions & directions = Direction::All();
-    std::vector<bool> tilesVisited( world.getSize(), false );
-    std::vector<int> nodesToExplore;
 
-    tilesVisited[start] = true;
+    resetTileMarks();
+    markTile( start );
 
+    std::vector<int> & nodesToExplore = _nodesBuffer;
+    nodesToExplore.clear();
     nodesToExplore.push_back( start );
 
     int bestIndex = -1;
@@ -761,7 +991,7 @@ int AIWorldPathfinder::getFogDiscoveryTile( const Heroes & hero, bool & isTerrit
                     const int nodeIdx = nodesToExplore[i];
                     const int32_t tilesToReveal = Maps::getFogTileCountToBeRevealed( nodeIdx, scoutingDistance, _color );
 
-                    if ( std::make_tuple( maxTilesToReveal, _cache[nodeIdx]._cost ) < std::make_tuple( tilesToReveal, _cache[bestIndex]._cost ) ) {
+                    if ( std::make_tuple( maxTilesToReveal, getCachedNode( nodeIdx )._cost ) < std::make_tuple( tilesToReveal, getCachedNode( bestIndex )._cost ) ) {
                         maxTilesToReveal = tilesToReveal;
                         bestIndex = nodeIdx;
                     }
@@ -776,22 +1006,20 @@ int AIWorldPathfinder::getFogDiscoveryTile( const Heroes & hero, bool & isTerrit
 
             const int newIndex = currentNodeIdx + _mapOffset[i];
 
-            if ( tilesVisited[newIndex] ) {
+            if ( !markTile( newIndex ) ) {
                 continue;
             }
 
-            tilesVisited[newIndex] = true;
-
             if ( !MP2::isSafeForFogDiscoveryObject( world.GetTiles( newIndex ).GetObject( true ) ) ) {
                 continue;
             }
 
             // Tile is unreachable (maybe because it is guarded by too strong an army)
-            if ( _cache[newIndex]._cost == 0 ) {
+            if ( getCachedNode( newIndex )._cost == 0 ) {
                 continue;
             }
 
-            for ( const int32_t tileIndex : Maps::getAroundIndexes( newIndex ) ) {
+            for ( const int32_t tileIndex : Maps::getAdjacentIndexes( newIndex ) ) {
                 if ( world.GetTiles( tileIndex ).isFog( _color ) ) {
                     // We found a tile which has a neighboring tile covered in fog.
                     // Since the current tile is accessible for the hero, the tile covered by fog most likely is accessible too.
@@ -810,18 +1038,16 @@ int AIWorldPathfinder::getFogDiscoveryTile( const Heroes & hero, bool & isTerrit
             }
 
             for ( const int teleportIndex : teleports ) {
-                if ( tilesVisited[teleportIndex] ) {
+                if ( !markTile( teleportIndex ) ) {
                     continue;
                 }
 
-                tilesVisited[teleportIndex] = true;
-
                 // Teleport endpoint is unreachable (maybe because it is guarded by too strong an army)
-                if ( _cache[teleportIndex]._cost == 0 ) {
+                if ( getCachedNode( teleportIndex )._cost == 0 ) {
                     continue;
                 }
 
-                for ( const int32_t tileIndex : Maps::getAroundIndexes( teleportIndex ) ) {
+                for ( const int32_t tileIndex : Maps::getAdjacentIndexes( teleportIndex ) ) {
                     if ( world.GetTiles( tileIndex ).isFog( _color ) ) {
                         // We found a tile which has a neighboring tile covered in fog.
                         // Since the current tile is accessible for the hero, the tile covered by fog most likely is accessible too.
@@ -865,7 +1091,7 @@ int AIWorldPathfinder::getNearestTileToMove( const Heroes & hero )
             continue;
         }
 
-        const WorldNode & node = _cache[newIndex];
+        const WorldNode & node = getCachedNode( newIndex );
 
         // Tile is directly reachable (in one move) and the hero has enough army to defeat potential guards
         if ( node._cost > 0 && node._from == start ) {
@@ -881,17 +1107,7 @@ bool AIWorldPathfinder::isHeroPossiblyBlockingWay( const Heroes & hero )
     const int32_t heroIndex = hero.GetIndex();
     const int heroColor = hero.GetColor();
 
-    auto isReachableDirection = [heroIndex, heroColor]( const int direction ) {
-        if ( !Maps::isValidDirection( heroIndex, direction ) ) {
-            return false;
-        }
-
-        if ( !isValidPath( heroIndex, direction, heroColor ) ) {
-            return false;
-        }
-
-        return true;
-    };
+    auto isReachableDirection = [heroIndex, heroColor]( const int direction ) { return isValidPath( heroIndex, direction, heroColor ); };
 
     const bool leftReachable = isReachableDirection( Direction::LEFT );
     const bool rightReachable = isReachableDirection( Direction::RIGHT );
@@ -1040,23 +1256,23 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
     std::vector<IndexObject> result;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( getCachedNode( targetIndex )._cost == 0 ) {
         return result;
     }
 
     const Kingdom & kingdom = world.GetKingdom( _color );
     const Directions & directions = Direction::All();
 
-    std::set<int> uniqueIndices;
-    auto validateAndAdd = [&kingdom, &result, &uniqueIndices]( int index, const MP2::MapObjectType objectType ) {
-        // std::set insert returns a pair, second value is true if it was unique
-        if ( uniqueIndices.insert( index ).second && kingdom.isValidKingdomObject( world.GetTiles( index ), objectType ) ) {
+    resetTileMarks();
+
+    auto validateAndAdd = [this, &kingdom, &result]( int index, const MP2::MapObjectType objectType ) {
+        if ( markTile( index ) && kingdom.isValidKingdomObject( world.GetTiles( index ), objectType ) ) {
             result.emplace_back( index, objectType );
         }
     };
 
     // skip the target itself to make sure we don't double count
-    uniqueIndices.insert( targetIndex );
+    markTile( targetIndex );
 
 #ifndef NDEBUG
     std::set<int> uniqPathIndexes;
@@ -1067,7 +1283,7 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
     while ( currentNode != _pathStart ) {
         assert( currentNode != -1 );
 
-        const WorldNode & node = _cache[currentNode];
+        const WorldNode & node = getCachedNode( currentNode );
 
         assert( node._from != -1 );
 
@@ -1077,7 +1293,7 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
             for ( size_t i = 0; i < directions.size(); ++i ) {
                 if ( Maps::isValidDirection( currentNode, directions[i] ) ) {
                     const int newIndex = currentNode + _mapOffset[i];
-                    const WorldNode & adjacent = _cache[newIndex];
+                    const WorldNode & adjacent = getCachedNode( newIndex );
 
                     if ( adjacent._cost == 0 || adjacent._objectID == 0 )
                         continue;
@@ -1096,7 +1312,75 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
     return result;
 }
 
-std::list<Route::Step> AIWorldPathfinder::getDimensionDoorPath( const Heroes & hero, int targetIndex ) const
+double AIWorldPathfinder::getValueOfObjectsOnTheWay( const int targetIndex, const std::function<double( const IndexObject & )> & getObjectValue,
+                                                     std::vector<std::optional<double>> & valuesOnTheWay ) const
+{
+    assert( _pathStart != -1 && _color != Color::NONE && targetIndex != -1 );
+
+    // Destination is not reachable
+    if ( getCachedNode( targetIndex )._cost == 0 ) {
+        return 0;
+    }
+
+    if ( valuesOnTheWay.empty() ) {
+        valuesOnTheWay.resize( world.getSize() );
+    }
+
+    // Collect the tiles on the way for which the sum is not known yet, starting from the one closest to the target
+    std::vector<int> & newNodes = _nodesBuffer;
+    newNodes.clear();
+
+    int currentNode = getCachedNode( targetIndex )._from;
+
+    while ( currentNode != _pathStart && !valuesOnTheWay[currentNode] ) {
+        assert( currentNode != -1 );
+
+        newNodes.push_back( currentNode );
+        currentNode = getCachedNode( currentNode )._from;
+    }
+
+    double value = ( currentNode == _pathStart ) ? 0 : *valuesOnTheWay[currentNode];
+
+    const Kingdom & kingdom = world.GetKingdom( _color );
+
+    for ( auto iter = newNodes.rbegin(); iter != newNodes.rend(); ++iter ) {
+        const MP2::MapObjectType objectType = getCachedNode( *iter )._objectID;
+
+        if ( kingdom.isValidKingdomObject( world.GetTiles( *iter ), objectType ) ) {
+            value += getObjectValue( { *iter, objectType } );
+        }
+
+        valuesOnTheWay[*iter] = value;
+    }
+
+    return value;
+}
+
+bool AIWorldPathfinder::isValidForDimensionDoor( const int32_t tileIndex, const bool water ) const
+{
+    const size_t worldSize = world.getSize();
+    if ( _dimensionDoorTiles.size() != worldSize ) {
+        _dimensionDoorTiles.assign( worldSize, 0 );
+    }
+
+    assert( tileIndex >= 0 && static_cast<size_t>( tileIndex ) < worldSize );
+
+    const uint8_t knownFlag = water ? 0x4 : 0x1;
+    const uint8_t validFlag = water ? 0x8 : 0x2;
+
+    uint8_t & state = _dimensionDoorTiles[tileIndex];
+    if ( ( state & knownFlag ) == 0 ) {
+        state |= knownFlag;
+
+        if ( Maps::isValidForDimensionDoor( tileIndex, water ) ) {
+            state |= validFlag;
+        }
+    }
+
+    return ( state & validFlag ) != 0;
+}
+
+std::deque<Route::Step> AIWorldPathfinder::getDimensionDoorPath( const Heroes & hero, int targetIndex ) const
 {
     if ( hero.GetIndex() == targetIndex ) {
         return {};
@@ -1145,7 +1429,7 @@ std::list<Route::Step> AIWorldPathfinder::getDimensionDoorPath( const Heroes & h
     const Directions & directions = Direction::All();
     const int32_t distanceLimit = Spell::CalculateDimensionDoorDistance() / 2;
 
-    std::list<Route::Step> path;
+    std::deque<Route::Step> path;
 
     uint32_t spellsUsed = 0;
     while ( maxCasts > spellsUsed ) {
@@ -1155,7 +1439,7 @@ std::list<Route::Step> AIWorldPathfinder::getDimensionDoorPath( const Heroes & h
         another.y += ( difference.y > 0 ) ? std::min( difference.y, distanceLimit ) : std::max( difference.y, -distanceLimit );
 
         const int32_t anotherNodeIdx = Maps::GetIndexFromAbsPoint( another );
-        bool found = Maps::isValidForDimensionDoor( anotherNodeIdx, water );
+        bool found = isValidForDimensionDoor( anotherNodeIdx, water );
 
         if ( !found ) {
             fheroes2::Point bestDirectionDiff;
@@ -1166,7 +1450,7 @@ std::list<Route::Step> AIWorldPathfinder::getDimensionDoorPath( const Heroes & h
                     continue;
 
                 const int newIndex = anotherNodeIdx + _mapOffset[i];
-                if ( !Maps::isValidForDimensionDoor( newIndex, water ) )
+                if ( !isValidForDimensionDoor( newIndex, water ) )
                     continue;
 
                 // If we are near the destination and we cannot reach the cell, skip it.
@@ -1212,14 +1496,14 @@ std::list<Route::Step> AIWorldPathfinder::getDimensionDoorPath( const Heroes & h
     return {};
 }
 
-std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex, const bool isPlanningMode /* = false */ ) const
+std::deque<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex, const bool isPlanningMode /* = false */ ) const
 {
     assert( _pathStart != -1 && targetIndex != -1 );
 
-    std::list<Route::Step> path;
+    std::deque<Route::Step> path;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( getCachedNode( targetIndex )._cost == 0 ) {
         return path;
     }
 
@@ -1239,11 +1523,11 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex, cons
             lastValidNode = currentNode;
         }
 
-        const WorldNode & node = _cache[currentNode];
+        const WorldNode & node = getCachedNode( currentNode );
 
         assert( node._from != -1 );
 
-        const uint32_t cost = node._cost - _cache[node._from]._cost;
+        const uint32_t cost = node._cost - getCachedNode( node._from )._cost;
 
         path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
 
@@ -1261,11 +1545,46 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex, cons
     return path;
 }
 
+void AIWorldPathfinder::resetTileMarks() const
+{
+    const size_t worldSize = world.getSize();
+
+    if ( _tileMarks.size() != worldSize ) {
+        _tileMarks.assign( worldSize, 0 );
+        _tileMarksGeneration = 0;
+    }
+
+    ++_tileMarksGeneration;
+
+    // The counter has wrapped around, the old marks cannot be distinguished from the new ones anymore
+    if ( _tileMarksGeneration == 0 ) {
+        std::fill( _tileMarks.begin(), _tileMarks.end(), 0 );
+        _tileMarksGeneration = 1;
+    }
+}
+
 uint32_t AIWorldPathfinder::getDistance( int start, int targetIndex, int color, double armyStrength, uint8_t skill )
 {
-    reEvaluateIfNeeded( start, color, armyStrength, skill );
+    assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < getCacheSize() );
+
+    auto currentSettings = getCurrentSettings();
+    const EvaluationSettings newSettings{ start, color, 0U, 0U, skill, armyStrength, 0U, false, -1, {} };
+
+    // There is no need to evaluate the entire map to get the distance to a single target, so perform the goal-directed search unless
+    // the cache already contains the valid information for this target
+    if ( currentSettings != newSettings || ( _targetIndex != -1 && _targetIndex != targetIndex ) ) {
+        storeCurrentEvaluation( _cachedEvaluations.size() );
+
+        currentSettings = newSettings;
+
+        _targetIndex = targetIndex;
 
-    return _cache[targetIndex]._cost;
+        checkWorldSize();
+
+        processWorldMap();
+    }
+
+    return getCachedNode( targetIndex )._cost;
 }
 
 void AIWorldPathfinder::setMinimalArmyStrengthAdvantage( const double advantage )
@@ -1289,3 +1608,8 @@ void AIWorldPathfinder::setSpellPointsReserveRatio( const double ratio )
 
     reset();
 }
+
+uint64_t getWorldMapProcessingCount()
+{
+    return worldMapProcessingCount;
+}
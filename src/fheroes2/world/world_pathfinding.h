@@ -20,11 +20,17 @@
 
 #pragma once
 
+#include <array>
+#include <cassert>
 #include <cstdint>
-#include <list>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <tuple>
 #include <vector>
 
 #include "color.h"
+#include "math_base.h"
 #include "mp2.h"
 #include "pathfinding.h"
 #include "skill.h"
@@ -55,7 +61,8 @@ struct WorldNode : public PathfindingNode<MP2::MapObjectType>
     WorldNode & operator=( const WorldNode & ) = delete;
     WorldNode & operator=( WorldNode && ) = default;
 
-    void resetNode() override
+    // Hides the base class method, see the description of PathfindingNode
+    void resetNode()
     {
         PathfindingNode::resetNode();
 
@@ -63,6 +70,17 @@ struct WorldNode : public PathfindingNode<MP2::MapObjectType>
     }
 };
 
+// Properties of the map tile used by the pathfinder which depend only on the terrain and therefore do not change during the game
+struct TerrainPathfindingInfo
+{
+    // Bitmask of directions in which it is possible to move from this tile without leaving the map and without sailing
+    // through the corner of land
+    uint8_t validDirections = 0;
+
+    // Movement penalty for this tile (without taking roads into account) for each level of the Pathfinding skill
+    std::array<uint8_t, Skill::Level::EXPERT + 1> groundPenalties{};
+};
+
 // Abstract class that provides base functionality to path through World map
 class WorldPathfinder : public Pathfinder<WorldNode>
 {
@@ -75,14 +93,29 @@ public:
     // This method resizes the cache and re-calculates map offsets if values are out of sync with World class
     virtual void checkWorldSize();
 
-    static uint32_t calculatePathPenalty( const std::list<Route::Step> & path );
+    static uint32_t calculatePathPenalty( const std::deque<Route::Step> & path );
 
 protected:
     virtual void processWorldMap();
-    void checkAdjacentNodes( std::vector<int> & nodesToExplore, int currentNodeIdx );
+
+    // Extracts nodes from the queue in the order of their cost and processes them until all reachable nodes are processed
+    // or, in case of goal-directed search, until the target node is processed.
+    void exploreNodes( PathfindingQueue & nodesToExplore );
+
+    void checkAdjacentNodes( PathfindingQueue & nodesToExplore, int currentNodeIdx );
+
+    // Adds the node to the queue using its current cost (and the estimated cost to the target in case of goal-directed search) as a key
+    void addNodeToExplore( PathfindingQueue & nodesToExplore, const int nodeIdx ) const
+    {
+        nodesToExplore.push( getCachedNode( nodeIdx )._cost + getEstimatedCostToTarget( nodeIdx ), nodeIdx );
+    }
+
+    // Returns the estimated cost of movement from the given node to the target node. The estimate never exceeds the real cost.
+    // Returns 0 if no goal-directed search is performed.
+    uint32_t getEstimatedCostToTarget( const int nodeIdx ) const;
 
     // This method defines pathfinding rules. This has to be implemented by the derived class.
-    virtual void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) = 0;
+    virtual void processCurrentNode( PathfindingQueue & nodesToExplore, const int currentNodeIdx ) = 0;
 
     // Calculates the movement penalty when moving from the src tile to the adjacent dst tile in the specified direction.
     // If the "last move" logic should be taken into account (when performing pathfinding for a real hero on the map),
@@ -95,6 +128,16 @@ protected:
 
     std::vector<int> _mapOffset;
 
+    PathfindingQueue _nodesToExplore;
+
+    // Index of the target node if the goal-directed search is performed instead of evaluating the entire map. In this case the cache
+    // contains valid information only for the target node and the nodes that were processed before it.
+    int _targetIndex = -1;
+
+    // Positions of the target node and of all the teleports on the map, used to estimate the cost of movement to the target node
+    fheroes2::Point _targetPoint;
+    std::vector<fheroes2::Point> _teleportPoints;
+
     // Hero properties should be cached here because they can change even if the hero's position does not change,
     // so it should be possible to compare the old values with the new ones to detect the need to recalculate the
     // pathfinder's cache
@@ -115,11 +158,18 @@ public:
     void reset() override;
 
     void reEvaluateIfNeeded( const Heroes & hero );
-    std::list<Route::Step> buildPath( const int targetIndex ) const;
+    std::deque<Route::Step> buildPath( const int targetIndex ) const;
+
+    // Returns the number of days (no more than 8) required to reach the given tile, or 0 if this tile is not reachable. The results
+    // are memoized for all the tiles on the way until the next evaluation of the map.
+    int getNumOfTravelDays( const int targetIndex );
 
 private:
     // Follows regular passability rules (for the human player)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( PathfindingQueue & nodesToExplore, const int currentNodeIdx ) override;
+
+    // The number of days required to reach each tile, 0 means that this value has not been calculated yet
+    std::vector<uint32_t> _travelDays;
 };
 
 class AIWorldPathfinder : public WorldPathfinder
@@ -135,6 +185,11 @@ public:
 
     void reset() override;
 
+    // Same as reset(), but keeps the cached evaluations that cannot be affected by the change of the given tile
+    void resetAfterTileChange( const int32_t tileIndex );
+
+    size_t getMemoryUsage() const override;
+
     void reEvaluateIfNeeded( const Heroes & hero );
     void reEvaluateIfNeeded( const int start, const int color, const double armyStrength, const uint8_t skill );
     int getFogDiscoveryTile( const Heroes & hero, bool & isTerritoryExpansion );
@@ -146,13 +201,19 @@ public:
 
     std::vector<IndexObject> getObjectsOnTheWay( const int targetIndex, const bool checkAdjacent = false ) const;
 
-    std::list<Route::Step> getDimensionDoorPath( const Heroes & hero, int targetIndex ) const;
+    // Returns the sum of the values of the valid kingdom objects on the way to the given tile, excluding the tile itself. Sums for the tiles
+    // on the way are stored in 'valuesOnTheWay' so paths sharing a common part are walked only once. The stored sums are valid until the
+    // next evaluation of the map.
+    double getValueOfObjectsOnTheWay( const int targetIndex, const std::function<double( const IndexObject & )> & getObjectValue,
+                                      std::vector<std::optional<double>> & valuesOnTheWay ) const;
+
+    std::deque<Route::Step> getDimensionDoorPath( const Heroes & hero, int targetIndex ) const;
 
-    // Used for non-hero armies, like castles or monsters
+    // Used for non-hero armies, like castles or monsters. Performs the goal-directed search if the cache is not valid for the given parameters.
     uint32_t getDistance( int start, int targetIndex, int color, double armyStrength, uint8_t skill = Skill::Level::EXPERT );
 
     // Override builds path to the nearest valid object
-    std::list<Route::Step> buildPath( const int targetIndex, const bool isPlanningMode = false ) const;
+    std::deque<Route::Step> buildPath( const int targetIndex, const bool isPlanningMode = false ) const;
 
     // Faster, but does not re-evaluate the map (expose base class method)
     using Pathfinder::getDistance;
@@ -180,10 +241,39 @@ public:
     void setSpellPointsReserveRatio( const double ratio );
 
 private:
+    using EvaluationSettings = std::tuple<int, int, uint32_t, uint32_t, uint8_t, double, uint32_t, bool, int32_t, std::vector<int32_t>>;
+
+    // Results of the previous full-map evaluation made with the specified settings
+    struct CachedEvaluation
+    {
+        EvaluationSettings settings;
+        PathfindingCache<WorldNode> cache;
+
+        // Cached evaluation becomes invalid when the pathfinder is reset, or when a tile that could affect it is changed
+        bool isValid = false;
+        uint32_t lastUseTime = 0;
+    };
+
+    auto getCurrentSettings()
+    {
+        return std::tie( _pathStart, _color, _remainingMovePoints, _maxMovePoints, _pathfindingSkill, _armyStrength, _spellPoints, _isArtifactsBagFull,
+                         _townGateCastleIndex, _townPortalCastleIndexes );
+    }
+
+    // Resets the settings of the current evaluation, the cached evaluations are left untouched
+    void resetCurrentEvaluation();
+
+    // Evaluates the entire map using the given settings unless the results of such an evaluation are already available
+    void evaluateMap( const EvaluationSettings & newSettings );
+
+    // Moves the results of the current full-map evaluation (if any) to the cache of evaluations, so that they can be restored later without
+    // re-evaluation if the pathfinder is not reset in the meantime. The cached evaluation with the given index is never replaced.
+    void storeCurrentEvaluation( const size_t evaluationIdxToKeep );
+
     void processWorldMap() override;
 
     // Follows custom passability rules (for the AI)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( PathfindingQueue & nodesToExplore, const int currentNodeIdx ) override;
 
     // Adds special logic for AI-controlled heroes to encourage them to overcome water obstacles using boats.
     // If this logic should be taken into account (when performing pathfinding for a real hero on the map),
@@ -191,6 +281,26 @@ private:
     // about the hero's remaining movement points.
     uint32_t getMovementPenalty( int src, int dst, int direction ) const override;
 
+    // Unmarks all the tiles previously marked using the markTile() method
+    void resetTileMarks() const;
+
+    // Marks the given tile, returns true if this tile has not been marked since the last call of resetTileMarks()
+    bool markTile( const int index ) const
+    {
+        assert( index >= 0 && static_cast<size_t>( index ) < _tileMarks.size() );
+
+        if ( _tileMarks[index] == _tileMarksGeneration ) {
+            return false;
+        }
+
+        _tileMarks[index] = _tileMarksGeneration;
+
+        return true;
+    }
+
+    // Returns the cached result of Maps::isValidForDimensionDoor() for the given tile
+    bool isValidForDimensionDoor( const int32_t tileIndex, const bool water ) const;
+
     // Hero properties should be cached here because they can change even if the hero's position does not change,
     // so it should be possible to compare the old values with the new ones to detect the need to recalculate the
     // pathfinder's cache
@@ -205,6 +315,21 @@ private:
     int32_t _townGateCastleIndex{ -1 };
     std::vector<int32_t> _townPortalCastleIndexes;
 
+    // Evaluations for different heroes (or other armies) are often requested alternately, e.g. when the AI chooses the hero to move next,
+    // so the results of several recent evaluations are kept until the pathfinder is reset
+    std::vector<CachedEvaluation> _cachedEvaluations;
+    uint32_t _evaluationTime{ 0 };
+
+    // Scratch buffers reused between calls to avoid memory allocations during the AI turn. These members need to be mutable because they are
+    // also used by const methods, they do not hold any results between calls.
+    mutable std::vector<int> _nodesBuffer;
+    mutable std::vector<uint32_t> _tileMarks;
+    mutable uint32_t _tileMarksGeneration{ 0 };
+
+    // Results of Maps::isValidForDimensionDoor() for land (bits 0-1) and water (bits 2-3), the lower bit of each pair tells whether the result
+    // is already known. They are shared by all the calls to getDimensionDoorPath() and are discarded when the map tiles change.
+    mutable std::vector<uint8_t> _dimensionDoorTiles;
+
     // Coefficient of the minimum required advantage in army strength in order to be able to "pass through" protected
     // tiles from the AI pathfinder's point of view
     double _minimalArmyStrengthAdvantage{ 1.0 };
@@ -213,3 +338,6 @@ private:
     // (such as Dimension Door, Town Gate or Town Portal)
     double _spellPointsReserveRatio{ 0.5 };
 };
+
+// Returns how many times the world map has been processed by all pathfinders since the start of the application.
+uint64_t getWorldMapProcessingCount();
@@ -31,6 +31,8 @@
 #include "maps_tiles.h"
 #include "math_base.h"
 #include "mp2.h"
+#include "thread.h"
+#include "tools.h"
 #include "world.h"
 #include "world_regions.h"
 
@@ -173,6 +175,52 @@ const MapRegion & World::getRegion( size_t id ) const
     return region;
 }
 
+uint32_t World::getStaticAnalysisHash() const
+{
+    // Only the properties which never change during the game are taken into account.
+    uint32_t hash = 0;
+    fheroes2::hashCombine( hash, width );
+    fheroes2::hashCombine( hash, height );
+
+    for ( const Maps::Tiles & tile : vec_tiles ) {
+        fheroes2::hashCombine( hash, tile.isWater() );
+    }
+
+    for ( const Castle * castle : vec_castles ) {
+        fheroes2::hashCombine( hash, castle->GetIndex() );
+    }
+
+    return hash;
+}
+
+bool World::restoreStaticAnalysis()
+{
+    std::vector<uint32_t> tileRegions;
+    std::swap( tileRegions, _loadedTileRegions );
+
+    if ( tileRegions.size() != vec_tiles.size() || _regions.size() < REGION_NODE_FOUND || _staticAnalysisHash != getStaticAnalysisHash() ) {
+        return false;
+    }
+
+    const size_t regionCount = _regions.size();
+
+    for ( const MapRegion & region : _regions ) {
+        if ( std::any_of( region._neighbours.begin(), region._neighbours.end(), [regionCount]( const uint32_t id ) { return id >= regionCount; } ) ) {
+            return false;
+        }
+    }
+
+    if ( std::any_of( tileRegions.begin(), tileRegions.end(), [regionCount]( const uint32_t id ) { return id >= regionCount; } ) ) {
+        return false;
+    }
+
+    for ( size_t i = 0; i < vec_tiles.size(); ++i ) {
+        vec_tiles[i].UpdateRegion( tileRegions[i] );
+    }
+
+    return true;
+}
+
 void World::ComputeStaticAnalysis()
 {
     // Parameters that control region generation: size and spacing between initial points
@@ -180,6 +228,8 @@ void World::ComputeStaticAnalysis()
     const uint32_t extraRegionSize = 18;
     const uint32_t emptyLineFrequency = 7;
 
+    _staticAnalysisHash = getStaticAnalysisHash();
+
     // Reset the region information for all tiles
     std::for_each( vec_tiles.begin(), vec_tiles.end(), []( Maps::Tiles & tile ) { tile.UpdateRegion( REGION_NODE_BLOCKED ); } );
 
@@ -298,7 +348,8 @@ void World::ComputeStaticAnalysis()
     // Step 5. Initialize extended (by 2 tiles) map data used for region growing based on actual Maps::Tiles
     const uint32_t extendedWidth = width + 2;
     std::vector<MapRegionNode> data( extendedWidth * ( height + 2 ) );
-    for ( int y = 0; y < height; ++y ) {
+    MultiThreading::getThreadPool().parallelFor( 0, static_cast<size_t>( height ), [this, &data, extendedWidth]( const size_t row ) {
+        const int y = static_cast<int>( row );
         const int rowIndex = y * width;
         for ( int x = 0; x < width; ++x ) {
             const int index = rowIndex + x;
@@ -315,7 +366,7 @@ void World::ComputeStaticAnalysis()
                 node.type = REGION_NODE_OPEN;
             }
         }
-    }
+    } );
 
     // Step 6. Initialize regions
     size_t averageRegionSize = ( static_cast<size_t>( width ) * height * 2 ) / regionCenters.size();
@@ -26,6 +26,7 @@
 #include <filesystem>
 #include <fstream> // IWYU pragma: keep
 #include <iostream>
+#include <map>
 #include <optional>
 #include <set>
 #include <sstream>
@@ -66,7 +67,45 @@ namespace
 
         std::cerr << baseName << " manages the contents of the specified H2D file(s)." << std::endl
                   << "Syntax: " << baseName << " extract dst_dir palette_file.pal input_file.h2d ..." << std::endl
-                  << "        " << baseName << " combine target_file.h2d palette_file.pal input_file ..." << std::endl;
+                  << "        " << baseName << " combine target_file.h2d palette_file.pal input_file ..." << std::endl
+                  << "        " << baseName << " diff first_file.h2d second_file.h2d" << std::endl;
+    }
+
+    // Prints the items which are added, removed or changed in the new set of items compared to the old one. Returns true if there are any
+    // differences.
+    bool printDifferences( const std::map<std::string, uint32_t> & oldChecksums, const std::map<std::string, uint32_t> & newChecksums )
+    {
+        uint32_t itemsAdded = 0;
+        uint32_t itemsRemoved = 0;
+        uint32_t itemsChanged = 0;
+        uint32_t itemsUnchanged = 0;
+
+        for ( const auto & [name, checksum] : newChecksums ) {
+            const auto iter = oldChecksums.find( name );
+            if ( iter == oldChecksums.end() ) {
+                std::cout << "Added: " << name << std::endl;
+                ++itemsAdded;
+            }
+            else if ( iter->second != checksum ) {
+                std::cout << "Changed: " << name << std::endl;
+                ++itemsChanged;
+            }
+            else {
+                ++itemsUnchanged;
+            }
+        }
+
+        for ( const auto & [name, checksum] : oldChecksums ) {
+            if ( newChecksums.find( name ) == newChecksums.end() ) {
+                std::cout << "Removed: " << name << std::endl;
+                ++itemsRemoved;
+            }
+        }
+
+        std::cout << "Added items: " << itemsAdded << ", removed items: " << itemsRemoved << ", changed items: " << itemsChanged
+                  << ", unchanged items: " << itemsUnchanged << std::endl;
+
+        return itemsAdded > 0 || itemsRemoved > 0 || itemsChanged > 0;
     }
 
     bool loadPalette( const char * paletteFileName )
@@ -213,15 +252,12 @@ namespace
         std::error_code ec;
 
         // Using the non-throwing overload
-        if ( std::filesystem::exists( h2dFileName, ec ) ) {
-            const std::filesystem::path h2dFileBackupPath = std::filesystem::path( h2dFileName ).replace_extension( "bak" );
+        const bool isExistingFile = std::filesystem::exists( h2dFileName, ec );
 
-            // Using the non-throwing overload
-            if ( !std::filesystem::copy_file( h2dFileName, h2dFileBackupPath, std::filesystem::copy_options::overwrite_existing, ec ) ) {
-                std::cerr << "Cannot create backup file " << h2dFileBackupPath << std::endl;
-                return EXIT_FAILURE;
-            }
+        // Checksums of the items of the existing file, they are used to avoid rewriting the file if nothing has changed
+        std::map<std::string, uint32_t> originalChecksums;
 
+        if ( isExistingFile ) {
             fheroes2::H2DReader reader;
             if ( !reader.open( h2dFileName ) ) {
                 std::cerr << "Cannot open file " << h2dFileName << std::endl;
@@ -232,6 +268,8 @@ namespace
                 std::cerr << "Error reading from file " << h2dFileName << std::endl;
                 return EXIT_FAILURE;
             }
+
+            originalChecksums = writer.getFileChecksums();
         }
 
         uint32_t itemsAdded = 0;
@@ -305,15 +343,51 @@ namespace
             ++itemsAdded;
         }
 
+        std::cout << "Total added items: " << itemsAdded << std::endl;
+
+        if ( !printDifferences( originalChecksums, writer.getFileChecksums() ) && isExistingFile ) {
+            std::cout << "File " << h2dFileName << " is up to date" << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        if ( isExistingFile ) {
+            const std::filesystem::path h2dFileBackupPath = std::filesystem::path( h2dFileName ).replace_extension( "bak" );
+
+            // Using the non-throwing overload
+            if ( !std::filesystem::copy_file( h2dFileName, h2dFileBackupPath, std::filesystem::copy_options::overwrite_existing, ec ) ) {
+                std::cerr << "Cannot create backup file " << h2dFileBackupPath << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
         if ( !writer.write( h2dFileName ) ) {
             std::cerr << "Error writing to file " << h2dFileName << std::endl;
             return EXIT_FAILURE;
         }
 
-        std::cout << "Total added items: " << itemsAdded << std::endl;
-
         return EXIT_SUCCESS;
     }
+
+    int diffH2D( char ** argv )
+    {
+        const char * firstFileName = argv[2];
+        const char * secondFileName = argv[3];
+
+        fheroes2::H2DReader firstReader;
+        if ( !firstReader.open( firstFileName ) ) {
+            std::cerr << "Cannot open file " << firstFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        fheroes2::H2DReader secondReader;
+        if ( !secondReader.open( secondFileName ) ) {
+            std::cerr << "Cannot open file " << secondFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Just like diff, return a non-zero code if the files are different
+        return printDifferences( firstReader.getFileChecksums(), secondReader.getFileChecksums() ) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
 }
 
 int main( int argc, char ** argv )
@@ -326,6 +400,10 @@ int main( int argc, char ** argv )
         return combineH2D( argc, argv );
     }
 
+    if ( argc == 4 && strcmp( argv[1], "diff" ) == 0 ) {
+        return diffH2D( argv );
+    }
+
     printUsage( argv );
 
     return EXIT_FAILURE;
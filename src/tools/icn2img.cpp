@@ -30,6 +30,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <vector>
 
@@ -39,26 +40,44 @@
 #include "image_tool.h"
 #include "serialize.h"
 #include "system.h"
+#include "thread.h"
+#include "timing.h"
 
 namespace
 {
     constexpr size_t validPaletteSize = 768;
     constexpr uint8_t spriteBackground = 23;
+
+    // Result of the processing of a single sprite, it is reported after all sprites of the file are processed to keep the output ordered
+    struct SpriteResult
+    {
+        bool isProcessed{ false };
+        bool isSaved{ false };
+        std::string error;
+    };
 }
 
 int main( int argc, char ** argv )
 {
-    if ( argc < 4 ) {
+    int firstArgIdx = 1;
+    unsigned long threadCount = 1;
+
+    if ( argc > 2 && std::string_view( argv[1] ) == "-j" ) {
+        threadCount = std::strtoul( argv[2], nullptr, 10 );
+        firstArgIdx = 3;
+    }
+
+    if ( argc - firstArgIdx < 3 || threadCount == 0 ) {
         std::string baseName = System::GetBasename( argv[0] );
 
         std::cerr << baseName << " extracts sprites in BMP or PNG format (if supported) and their offsets from the specified ICN file(s) using the specified palette."
                   << std::endl
-                  << "Syntax: " << baseName << " dst_dir palette_file.pal input_file.icn ..." << std::endl;
+                  << "Syntax: " << baseName << " [-j threads] dst_dir palette_file.pal input_file.icn ..." << std::endl;
         return EXIT_FAILURE;
     }
 
-    const char * dstDir = argv[1];
-    const char * paletteFileName = argv[2];
+    const char * dstDir = argv[firstArgIdx];
+    const char * paletteFileName = argv[firstArgIdx + 1];
 
     {
         StreamFile paletteStream;
@@ -77,7 +96,7 @@ int main( int argc, char ** argv )
     }
 
     std::vector<std::string> inputFileNames;
-    for ( int i = 3; i < argc; ++i ) {
+    for ( int i = firstArgIdx + 2; i < argc; ++i ) {
         if ( System::isShellLevelGlobbingSupported() ) {
             inputFileNames.emplace_back( argv[i] );
         }
@@ -86,6 +105,11 @@ int main( int argc, char ** argv )
         }
     }
 
+    // The calling thread also takes part in the processing
+    MultiThreading::ThreadPool threadPool( threadCount - 1 );
+
+    const fheroes2::Time timer;
+
     uint32_t spritesExtracted = 0;
     uint32_t spritesFailed = 0;
 
@@ -127,34 +151,52 @@ int main( int argc, char ** argv )
             inputStream >> header;
         }
 
+        // The input file is read sequentially, then the sprites are decoded and saved in parallel
+        std::vector<std::vector<uint8_t>> spriteData( spritesCount );
+        std::vector<SpriteResult> results( spritesCount );
+
         for ( uint16_t spriteIdx = 0; spriteIdx < spritesCount; ++spriteIdx ) {
             const fheroes2::ICNHeader & header = headers[spriteIdx];
+            SpriteResult & result = results[spriteIdx];
 
             inputStream.seek( beginPos + header.offsetData );
 
             const uint32_t dataSize = ( spriteIdx + 1 < spritesCount ? headers[spriteIdx + 1].offsetData - header.offsetData : totalSize - header.offsetData );
             if ( dataSize == 0 ) {
-                ++spritesFailed;
-
-                std::cerr << inputFileName << ": sprite " << spriteIdx << " is empty" << std::endl;
+                result.error = "sprite " + std::to_string( spriteIdx ) + " is empty";
                 continue;
             }
 
-            const std::vector<uint8_t> buf = inputStream.getRaw( dataSize );
-            if ( buf.size() != dataSize ) {
-                ++spritesFailed;
-
-                std::cerr << inputFileName << ": invalid size of sprite " << spriteIdx << ": expected " << dataSize << ", got " << buf.size() << std::endl;
+            spriteData[spriteIdx] = inputStream.getRaw( dataSize );
+            if ( spriteData[spriteIdx].size() != dataSize ) {
+                result.error = "invalid size of sprite " + std::to_string( spriteIdx ) + ": expected " + std::to_string( dataSize ) + ", got "
+                               + std::to_string( spriteData[spriteIdx].size() );
                 continue;
             }
 
-            const fheroes2::Sprite sprite = fheroes2::decodeICNSprite( buf.data(), dataSize, header.width, header.height, header.offsetX, header.offsetY );
+            result.isProcessed = true;
+        }
 
+        auto getSpriteIdxString = []( const size_t spriteIdx ) {
             std::ostringstream spriteIdxStream;
             spriteIdxStream << std::setw( 3 ) << std::setfill( '0' ) << spriteIdx;
 
-            const std::string spriteIdxStr = spriteIdxStream.str();
-            std::string outputFileName = ( prefixPath / spriteIdxStr ).string();
+            return spriteIdxStream.str();
+        };
+
+        threadPool.parallelFor( 0, spritesCount, [&]( const size_t spriteIdx ) {
+            SpriteResult & result = results[spriteIdx];
+            if ( !result.isProcessed ) {
+                return;
+            }
+
+            const fheroes2::ICNHeader & header = headers[spriteIdx];
+            const std::vector<uint8_t> & buf = spriteData[spriteIdx];
+
+            const fheroes2::Sprite sprite = fheroes2::decodeICNSprite( buf.data(), static_cast<uint32_t>( buf.size() ), header.width, header.height, header.offsetX,
+                                                                       header.offsetY );
+
+            std::string outputFileName = ( prefixPath / getSpriteIdxString( spriteIdx ) ).string();
 
             if ( fheroes2::isPNGFormatSupported() ) {
                 outputFileName += ".png";
@@ -163,24 +205,43 @@ int main( int argc, char ** argv )
                 outputFileName += ".bmp";
             }
 
-            offsetStream << spriteIdxStr << " [" << header.offsetX << ", " << header.offsetY << "]" << std::endl;
-            if ( !offsetStream ) {
-                std::cerr << "Error writing to file " << offsetFilePath << std::endl;
-                return EXIT_FAILURE;
+            result.isSaved = fheroes2::Save( sprite, outputFileName, spriteBackground );
+            if ( !result.isSaved ) {
+                result.error = "error saving sprite " + std::to_string( spriteIdx );
             }
+        } );
 
-            if ( !fheroes2::Save( sprite, outputFileName, spriteBackground ) ) {
-                ++spritesFailed;
+        for ( uint16_t spriteIdx = 0; spriteIdx < spritesCount; ++spriteIdx ) {
+            const fheroes2::ICNHeader & header = headers[spriteIdx];
+            const SpriteResult & result = results[spriteIdx];
+
+            if ( result.isProcessed ) {
+                offsetStream << getSpriteIdxString( spriteIdx ) << " [" << header.offsetX << ", " << header.offsetY << "]" << std::endl;
+                if ( !offsetStream ) {
+                    std::cerr << "Error writing to file " << offsetFilePath << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
 
-                std::cerr << inputFileName << ": error saving sprite " << spriteIdx << std::endl;
-                continue;
+            if ( result.isSaved ) {
+                ++spritesExtracted;
             }
+            else {
+                ++spritesFailed;
 
-            ++spritesExtracted;
+                std::cerr << inputFileName << ": " << result.error << std::endl;
+            }
         }
     }
 
+    const double elapsedTime = timer.getS();
+
     std::cout << "Total extracted sprites: " << spritesExtracted << ", failed sprites: " << spritesFailed << std::endl;
+    std::cout << "Elapsed time: " << std::fixed << std::setprecision( 2 ) << elapsedTime << " s";
+    if ( elapsedTime > 0 ) {
+        std::cout << " (" << std::setprecision( 1 ) << ( spritesExtracted + spritesFailed ) / elapsedTime << " sprites per second)";
+    }
+    std::cout << std::endl;
 
     return ( spritesFailed == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -29,6 +29,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <vector>
 
@@ -37,6 +38,8 @@
 #include "image_tool.h"
 #include "serialize.h"
 #include "system.h"
+#include "thread.h"
+#include "timing.h"
 
 namespace
 {
@@ -46,16 +49,24 @@ namespace
 
 int main( int argc, char ** argv )
 {
-    if ( argc < 4 ) {
+    int firstArgIdx = 1;
+    unsigned long threadCount = 1;
+
+    if ( argc > 2 && std::string_view( argv[1] ) == "-j" ) {
+        threadCount = std::strtoul( argv[2], nullptr, 10 );
+        firstArgIdx = 3;
+    }
+
+    if ( argc - firstArgIdx < 3 || threadCount == 0 ) {
         std::string baseName = System::GetBasename( argv[0] );
 
         std::cerr << baseName << " extracts sprites in BMP or PNG format (if supported) from the specified TIL file(s) using the specified palette." << std::endl
-                  << "Syntax: " << baseName << " dst_dir palette_file.pal input_file.til ..." << std::endl;
+                  << "Syntax: " << baseName << " [-j threads] dst_dir palette_file.pal input_file.til ..." << std::endl;
         return EXIT_FAILURE;
     }
 
-    const char * dstDir = argv[1];
-    const char * paletteFileName = argv[2];
+    const char * dstDir = argv[firstArgIdx];
+    const char * paletteFileName = argv[firstArgIdx + 1];
 
     {
         StreamFile paletteStream;
@@ -74,7 +85,7 @@ int main( int argc, char ** argv )
     }
 
     std::vector<std::string> inputFileNames;
-    for ( int i = 3; i < argc; ++i ) {
+    for ( int i = firstArgIdx + 2; i < argc; ++i ) {
         if ( System::isShellLevelGlobbingSupported() ) {
             inputFileNames.emplace_back( argv[i] );
         }
@@ -83,6 +94,11 @@ int main( int argc, char ** argv )
         }
     }
 
+    // The calling thread also takes part in the processing
+    MultiThreading::ThreadPool threadPool( threadCount - 1 );
+
+    const fheroes2::Time timer;
+
     uint32_t spritesExtracted = 0;
 
     for ( const std::string & inputFileName : inputFileNames ) {
@@ -135,7 +151,10 @@ int main( int argc, char ** argv )
             return EXIT_FAILURE;
         }
 
-        for ( size_t spriteIdx = 0; spriteIdx < sprites.size(); ++spriteIdx ) {
+        // Sprites are saved in parallel, errors are reported afterwards in the order of sprites
+        std::vector<uint8_t> isSpriteSaved( sprites.size(), 0 );
+
+        threadPool.parallelFor( 0, sprites.size(), [&]( const size_t spriteIdx ) {
             std::ostringstream spriteIdxStream;
             spriteIdxStream << std::setw( 3 ) << std::setfill( '0' ) << spriteIdx;
 
@@ -149,7 +168,11 @@ int main( int argc, char ** argv )
                 outputFileName += ".bmp";
             }
 
-            if ( !fheroes2::Save( sprites[spriteIdx], outputFileName, spriteBackground ) ) {
+            isSpriteSaved[spriteIdx] = fheroes2::Save( sprites[spriteIdx], outputFileName, spriteBackground ) ? 1 : 0;
+        } );
+
+        for ( size_t spriteIdx = 0; spriteIdx < sprites.size(); ++spriteIdx ) {
+            if ( !isSpriteSaved[spriteIdx] ) {
                 std::cerr << inputFileName << ": error saving sprite " << spriteIdx << std::endl;
                 return EXIT_FAILURE;
             }
@@ -158,7 +181,14 @@ int main( int argc, char ** argv )
         }
     }
 
+    const double elapsedTime = timer.getS();
+
     std::cout << "Total extracted sprites: " << spritesExtracted << std::endl;
+    std::cout << "Elapsed time: " << std::fixed << std::setprecision( 2 ) << elapsedTime << " s";
+    if ( elapsedTime > 0 ) {
+        std::cout << " (" << std::setprecision( 1 ) << spritesExtracted / elapsedTime << " sprites per second)";
+    }
+    std::cout << std::endl;
 
     return EXIT_SUCCESS;
 }